@@ -0,0 +1,836 @@
+//**************************************
+// algorithm.h
+//
+// Holds the scanning algorithms for
+// contiguous ranges, the nids vectors,
+// and strided spans: find, count,
+// fill, equal, min_value, max_value,
+// and sum.
+//
+// Ranges of arithmetic types go through
+// SSE2 / AVX2 / AVX-512 kernels picked
+// at runtime (see simd.h), everything
+// else uses plain scalar loops
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "simd.h"
+#include "span.h"
+
+namespace nids
+{
+	//**************************************
+	// SIMD element trait
+	//
+	// Types the find, count, fill kernels
+	// handle
+	//**************************************
+	template<typename Type>
+	inline constexpr bool is_simd_element_v = (std::is_integral_v<Type> && !std::is_same_v<Type, bool>)
+		|| std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+	//**************************************
+	// SIMD reducible trait
+	//
+	// Types the min, max, sum kernels
+	// handle
+	//**************************************
+	template<typename Type>
+	inline constexpr bool is_simd_reducible_v = std::is_same_v<Type, int32_t>
+		|| std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+	// word wise operations combine_words can apply
+	enum class BitOperation
+	{
+		BIT_AND,
+		BIT_OR,
+		BIT_XOR
+	};
+
+	//**************************************
+	// Scalar bit operation helper
+	//**************************************
+	template<BitOperation Operation>
+	inline uint64_t apply_bit_operation(uint64_t lhs, uint64_t rhs) noexcept
+	{
+		if constexpr (Operation == BitOperation::BIT_AND)
+			return lhs & rhs;
+		else if constexpr (Operation == BitOperation::BIT_OR)
+			return lhs | rhs;
+		else
+			return lhs ^ rhs;
+	}
+}
+
+#ifdef NIDS_SIMD_X86
+//**************************************
+// SSE2 kernels
+//**************************************
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+namespace nids::simd_sse2
+{
+	struct ops
+	{
+		using reg = __m128i;
+		static const size_t WIDTH = 16;
+		static const bool BYTE_MASK = true;
+		static const uint64_t FULL_BYTE_MASK = 0xFFFF;
+
+		static inline reg load(const void* source) noexcept { return _mm_loadu_si128(static_cast<const __m128i*>(source)); }
+		static inline void store(void* dest, reg value) noexcept { _mm_storeu_si128(static_cast<__m128i*>(dest), value); }
+
+		template<typename Type>
+		static inline reg set1(Type value) noexcept
+		{
+			if constexpr (sizeof(Type) == 1) { int8_t bits; memcpy(&bits, &value, 1); return _mm_set1_epi8(bits); }
+			else if constexpr (sizeof(Type) == 2) { int16_t bits; memcpy(&bits, &value, 2); return _mm_set1_epi16(bits); }
+			else if constexpr (sizeof(Type) == 4) { int32_t bits; memcpy(&bits, &value, 4); return _mm_set1_epi32(bits); }
+			else { int64_t bits; memcpy(&bits, &value, 8); return _mm_set1_epi64x(bits); }
+		}
+
+		template<typename Type>
+		static inline uint64_t eq_mask(reg lhs, reg rhs) noexcept
+		{
+			reg equal;
+			if constexpr (std::is_same_v<Type, float>)
+				equal = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				equal = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(lhs), _mm_castsi128_pd(rhs)));
+			else if constexpr (sizeof(Type) == 1)
+				equal = _mm_cmpeq_epi8(lhs, rhs);
+			else if constexpr (sizeof(Type) == 2)
+				equal = _mm_cmpeq_epi16(lhs, rhs);
+			else if constexpr (sizeof(Type) == 4)
+				equal = _mm_cmpeq_epi32(lhs, rhs);
+			else
+			{
+				// no 64 bit compare until SSE4.1, so both halves have to match
+				equal = _mm_cmpeq_epi32(lhs, rhs);
+				equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+			return static_cast<uint32_t>(_mm_movemask_epi8(equal));
+		}
+
+		template<typename Type>
+		static inline reg min(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(lhs), _mm_castsi128_pd(rhs)));
+			else
+			{
+				reg greater = _mm_cmpgt_epi32(lhs, rhs);
+				return _mm_or_si128(_mm_and_si128(greater, rhs), _mm_andnot_si128(greater, lhs));
+			}
+		}
+
+		template<typename Type>
+		static inline reg max(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(lhs), _mm_castsi128_pd(rhs)));
+			else
+			{
+				reg greater = _mm_cmpgt_epi32(lhs, rhs);
+				return _mm_or_si128(_mm_and_si128(greater, lhs), _mm_andnot_si128(greater, rhs));
+			}
+		}
+
+		template<typename Type>
+		static inline reg add(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(lhs), _mm_castsi128_pd(rhs)));
+			else if constexpr (sizeof(Type) == 8)
+				return _mm_add_epi64(lhs, rhs);
+			else
+				return _mm_add_epi32(lhs, rhs);
+		}
+
+		static inline reg bit_and(reg lhs, reg rhs) noexcept { return _mm_and_si128(lhs, rhs); }
+		static inline reg bit_or(reg lhs, reg rhs) noexcept { return _mm_or_si128(lhs, rhs); }
+		static inline reg bit_xor(reg lhs, reg rhs) noexcept { return _mm_xor_si128(lhs, rhs); }
+
+		// no byte shuffle until SSSE3, so the bits are added up in place
+		static inline reg popcount64(reg value) noexcept
+		{
+			value = _mm_sub_epi8(value, _mm_and_si128(_mm_srli_epi16(value, 1), _mm_set1_epi8(0x55)));
+			value = _mm_add_epi8(_mm_and_si128(value, _mm_set1_epi8(0x33)), _mm_and_si128(_mm_srli_epi16(value, 2), _mm_set1_epi8(0x33)));
+			value = _mm_and_si128(_mm_add_epi8(value, _mm_srli_epi16(value, 4)), _mm_set1_epi8(0x0F));
+			return _mm_sad_epu8(value, _mm_setzero_si128());
+		}
+	};
+
+#include "simd_kernels.inl"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+//**************************************
+// AVX2 kernels
+//**************************************
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+namespace nids::simd_avx2
+{
+	struct ops
+	{
+		using reg = __m256i;
+		static const size_t WIDTH = 32;
+		static const bool BYTE_MASK = true;
+		static const uint64_t FULL_BYTE_MASK = 0xFFFFFFFF;
+
+		static inline reg load(const void* source) noexcept { return _mm256_loadu_si256(static_cast<const __m256i*>(source)); }
+		static inline void store(void* dest, reg value) noexcept { _mm256_storeu_si256(static_cast<__m256i*>(dest), value); }
+
+		template<typename Type>
+		static inline reg set1(Type value) noexcept
+		{
+			if constexpr (sizeof(Type) == 1) { int8_t bits; memcpy(&bits, &value, 1); return _mm256_set1_epi8(bits); }
+			else if constexpr (sizeof(Type) == 2) { int16_t bits; memcpy(&bits, &value, 2); return _mm256_set1_epi16(bits); }
+			else if constexpr (sizeof(Type) == 4) { int32_t bits; memcpy(&bits, &value, 4); return _mm256_set1_epi32(bits); }
+			else { int64_t bits; memcpy(&bits, &value, 8); return _mm256_set1_epi64x(bits); }
+		}
+
+		template<typename Type>
+		static inline uint64_t eq_mask(reg lhs, reg rhs) noexcept
+		{
+			reg equal;
+			if constexpr (std::is_same_v<Type, float>)
+				equal = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs), _CMP_EQ_OQ));
+			else if constexpr (std::is_same_v<Type, double>)
+				equal = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs), _CMP_EQ_OQ));
+			else if constexpr (sizeof(Type) == 1)
+				equal = _mm256_cmpeq_epi8(lhs, rhs);
+			else if constexpr (sizeof(Type) == 2)
+				equal = _mm256_cmpeq_epi16(lhs, rhs);
+			else if constexpr (sizeof(Type) == 4)
+				equal = _mm256_cmpeq_epi32(lhs, rhs);
+			else
+				equal = _mm256_cmpeq_epi64(lhs, rhs);
+			return static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+		}
+
+		template<typename Type>
+		static inline reg min(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs)));
+			else
+				return _mm256_min_epi32(lhs, rhs);
+		}
+
+		template<typename Type>
+		static inline reg max(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs)));
+			else
+				return _mm256_max_epi32(lhs, rhs);
+		}
+
+		template<typename Type>
+		static inline reg add(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs)));
+			else if constexpr (sizeof(Type) == 8)
+				return _mm256_add_epi64(lhs, rhs);
+			else
+				return _mm256_add_epi32(lhs, rhs);
+		}
+
+		static inline reg bit_and(reg lhs, reg rhs) noexcept { return _mm256_and_si256(lhs, rhs); }
+		static inline reg bit_or(reg lhs, reg rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+		static inline reg bit_xor(reg lhs, reg rhs) noexcept { return _mm256_xor_si256(lhs, rhs); }
+
+		// looks up the count of each nibble, then sums the bytes of each 64 bit lane
+		static inline reg popcount64(reg value) noexcept
+		{
+			const reg table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+				0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const reg nibble = _mm256_set1_epi8(0x0F);
+			reg counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(value, nibble)),
+				_mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(value, 4), nibble)));
+			return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+		}
+	};
+
+#include "simd_kernels.inl"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+//**************************************
+// AVX-512 kernels
+//**************************************
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx512bw"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+// GCC's own AVX-512 min/max wrappers trip this warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+namespace nids::simd_avx512
+{
+	struct ops
+	{
+		using reg = __m512i;
+		static const size_t WIDTH = 64;
+		static const bool BYTE_MASK = false;
+		static const uint64_t FULL_BYTE_MASK = ~0ull;
+
+		static inline reg load(const void* source) noexcept { return _mm512_loadu_si512(source); }
+		static inline void store(void* dest, reg value) noexcept { _mm512_storeu_si512(dest, value); }
+
+		template<typename Type>
+		static inline reg set1(Type value) noexcept
+		{
+			if constexpr (sizeof(Type) == 1) { int8_t bits; memcpy(&bits, &value, 1); return _mm512_set1_epi8(bits); }
+			else if constexpr (sizeof(Type) == 2) { int16_t bits; memcpy(&bits, &value, 2); return _mm512_set1_epi16(bits); }
+			else if constexpr (sizeof(Type) == 4) { int32_t bits; memcpy(&bits, &value, 4); return _mm512_set1_epi32(bits); }
+			else { int64_t bits; memcpy(&bits, &value, 8); return _mm512_set1_epi64(bits); }
+		}
+
+		template<typename Type>
+		static inline uint64_t eq_mask(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm512_cmp_ps_mask(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs), _CMP_EQ_OQ);
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm512_cmp_pd_mask(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs), _CMP_EQ_OQ);
+			else if constexpr (sizeof(Type) == 1)
+				return _mm512_cmpeq_epi8_mask(lhs, rhs);
+			else if constexpr (sizeof(Type) == 2)
+				return _mm512_cmpeq_epi16_mask(lhs, rhs);
+			else if constexpr (sizeof(Type) == 4)
+				return _mm512_cmpeq_epi32_mask(lhs, rhs);
+			else
+				return _mm512_cmpeq_epi64_mask(lhs, rhs);
+		}
+
+		template<typename Type>
+		static inline reg min(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm512_castps_si512(_mm512_min_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm512_castpd_si512(_mm512_min_pd(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs)));
+			else
+				return _mm512_min_epi32(lhs, rhs);
+		}
+
+		template<typename Type>
+		static inline reg max(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm512_castps_si512(_mm512_max_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm512_castpd_si512(_mm512_max_pd(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs)));
+			else
+				return _mm512_max_epi32(lhs, rhs);
+		}
+
+		template<typename Type>
+		static inline reg add(reg lhs, reg rhs) noexcept
+		{
+			if constexpr (std::is_same_v<Type, float>)
+				return _mm512_castps_si512(_mm512_add_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+			else if constexpr (std::is_same_v<Type, double>)
+				return _mm512_castpd_si512(_mm512_add_pd(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs)));
+			else if constexpr (sizeof(Type) == 8)
+				return _mm512_add_epi64(lhs, rhs);
+			else
+				return _mm512_add_epi32(lhs, rhs);
+		}
+
+		static inline reg bit_and(reg lhs, reg rhs) noexcept { return _mm512_and_si512(lhs, rhs); }
+		static inline reg bit_or(reg lhs, reg rhs) noexcept { return _mm512_or_si512(lhs, rhs); }
+		static inline reg bit_xor(reg lhs, reg rhs) noexcept { return _mm512_xor_si512(lhs, rhs); }
+
+		// the AVX2 nibble lookup, VPOPCNTQ needs a newer extension than F and BW
+		static inline reg popcount64(reg value) noexcept
+		{
+			const reg table = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+			const reg nibble = _mm512_set1_epi8(0x0F);
+			reg counts = _mm512_add_epi8(_mm512_shuffle_epi8(table, _mm512_and_si512(value, nibble)),
+				_mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(value, 4), nibble)));
+			return _mm512_sad_epu8(counts, _mm512_setzero_si512());
+		}
+	};
+
+#include "simd_kernels.inl"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+// calls the kernel for the active SIMD level, falls through when scalar
+#define NIDS_SIMD_DISPATCH(kernel, ...) \
+	switch (simd_level()) \
+	{ \
+	case SimdLevel::SIMD_AVX512: return simd_avx512::kernel(__VA_ARGS__); \
+	case SimdLevel::SIMD_AVX2: return simd_avx2::kernel(__VA_ARGS__); \
+	case SimdLevel::SIMD_SSE2: return simd_sse2::kernel(__VA_ARGS__); \
+	default: break; \
+	}
+#else
+#define NIDS_SIMD_DISPATCH(kernel, ...)
+#endif
+
+namespace nids
+{
+	//**************************************
+	// Find method
+	//
+	// Returns a pointer to the first
+	// element equal to value, or last
+	//**************************************
+	template<typename Type>
+	inline const Type* find(const Type* first, const Type* last, const Type& value) noexcept
+	{
+		if constexpr (is_simd_element_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(find, first, last, value)
+		}
+
+		for (; first != last; ++first)
+			if (*first == value)
+				return first;
+		return last;
+	}
+
+	//**************************************
+	// Find method (mutable range)
+	//**************************************
+	template<typename Type>
+	inline Type* find(Type* first, Type* last, const Type& value) noexcept
+	{
+		return const_cast<Type*>(find(static_cast<const Type*>(first), static_cast<const Type*>(last), value));
+	}
+
+	//**************************************
+	// Count method
+	//
+	// Returns the number of elements equal
+	// to value
+	//**************************************
+	template<typename Type>
+	inline size_t count(const Type* first, const Type* last, const Type& value) noexcept
+	{
+		if constexpr (is_simd_element_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(count, first, last, value)
+		}
+
+		size_t matches{ 0 };
+		for (; first != last; ++first)
+			if (*first == value)
+				++matches;
+		return matches;
+	}
+
+	//**************************************
+	// Fill method
+	//
+	// Assigns value to every element, the
+	// range must hold live objects or be
+	// of a trivially copyable type
+	//**************************************
+	template<typename Type>
+	inline void fill(Type* first, Type* last, const Type& value) noexcept
+	{
+		if constexpr (is_simd_element_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(fill, first, last, value)
+		}
+
+		for (; first != last; ++first)
+			*first = value;
+	}
+
+	//**************************************
+	// Equality method
+	//
+	// True if [first, last) matches the
+	// range starting at other
+	//**************************************
+	template<typename Type>
+	inline bool equal(const Type* first, const Type* last, const Type* other) noexcept
+	{
+		// floats can't be compared bytewise (NaN, -0.0)
+		if constexpr (is_simd_element_v<Type> && std::is_integral_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(equal, first, other, static_cast<size_t>(last - first))
+		}
+
+		for (; first != last; ++first, ++other)
+			if (!(*first == *other))
+				return false;
+		return true;
+	}
+
+	//**************************************
+	// Minimum value method
+	//
+	// The range must not be empty
+	//**************************************
+	template<typename Type>
+	inline Type min_value(const Type* first, const Type* last) noexcept
+	{
+		assert(first != last);
+		if constexpr (is_simd_reducible_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(min_value, first, last)
+		}
+
+		Type result = *first;
+		for (++first; first != last; ++first)
+			if (*first < result)
+				result = *first;
+		return result;
+	}
+
+	//**************************************
+	// Maximum value method
+	//
+	// The range must not be empty
+	//**************************************
+	template<typename Type>
+	inline Type max_value(const Type* first, const Type* last) noexcept
+	{
+		assert(first != last);
+		if constexpr (is_simd_reducible_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(max_value, first, last)
+		}
+
+		Type result = *first;
+		for (++first; first != last; ++first)
+			if (result < *first)
+				result = *first;
+		return result;
+	}
+
+	//**************************************
+	// Sum method
+	//
+	// Floating point sums can round
+	// differently than a scalar loop
+	//**************************************
+	template<typename Type>
+	inline Type sum(const Type* first, const Type* last) noexcept
+	{
+		if constexpr (is_simd_reducible_v<Type>)
+		{
+			NIDS_SIMD_DISPATCH(sum, first, last)
+		}
+
+		Type result{};
+		for (; first != last; ++first)
+			result += *first;
+		return result;
+	}
+
+	//**************************************
+	// Word combining method
+	//
+	// Applies Operation between each word
+	// of dest and the matching word of
+	// source, storing into dest
+	//**************************************
+	template<BitOperation Operation>
+	inline void combine_words(uint64_t* dest, const uint64_t* source, size_t words) noexcept
+	{
+		NIDS_SIMD_DISPATCH(combine_words<Operation>, dest, source, words)
+
+		for (size_t word{ 0 }; word < words; ++word)
+			dest[word] = apply_bit_operation<Operation>(dest[word], source[word]);
+	}
+
+	//**************************************
+	// Bitwise and method
+	//**************************************
+	inline void bitwise_and(uint64_t* dest, const uint64_t* source, size_t words) noexcept { combine_words<BitOperation::BIT_AND>(dest, source, words); }
+
+	//**************************************
+	// Bitwise or method
+	//**************************************
+	inline void bitwise_or(uint64_t* dest, const uint64_t* source, size_t words) noexcept { combine_words<BitOperation::BIT_OR>(dest, source, words); }
+
+	//**************************************
+	// Bitwise xor method
+	//**************************************
+	inline void bitwise_xor(uint64_t* dest, const uint64_t* source, size_t words) noexcept { combine_words<BitOperation::BIT_XOR>(dest, source, words); }
+
+	//**************************************
+	// Population count method
+	//
+	// Returns the number of set bits in
+	// count words
+	//**************************************
+	inline size_t popcount(const uint64_t* words, size_t count) noexcept
+	{
+		NIDS_SIMD_DISPATCH(popcount_words, words, count)
+
+		size_t bits{ 0 };
+		for (size_t word{ 0 }; word < count; ++word)
+			bits += population_count(words[word]);
+		return bits;
+	}
+
+	//*****************[ Container Methods ]
+	// These take anything with data() and
+	// size(), like the nids vectors
+	//**************************************
+	//**************************************
+	// Find method (container)
+	//
+	// Returns the index of the first
+	// match, or size() if there is none
+	//**************************************
+	template<typename Container>
+	inline size_t find(const Container& container, const typename Container::value_type& value) noexcept
+	{
+		const auto* first = container.data();
+		return static_cast<size_t>(find(first, first + container.size(), value) - first);
+	}
+
+	//**************************************
+	// Count method (container)
+	//**************************************
+	template<typename Container>
+	inline size_t count(const Container& container, const typename Container::value_type& value) noexcept
+	{
+		return count(container.data(), container.data() + container.size(), value);
+	}
+
+	//**************************************
+	// Fill method (container)
+	//
+	// Assigns value to every element up
+	// to size(), also takes temporary
+	// views like span
+	//**************************************
+	template<typename Container>
+	inline void fill(Container&& container, const typename std::remove_reference_t<Container>::value_type& value) noexcept
+	{
+		fill(container.data(), container.data() + container.size(), value);
+	}
+
+	//**************************************
+	// Equality method (container)
+	//**************************************
+	template<typename Container>
+	inline bool equal(const Container& lhs, const Container& rhs) noexcept
+	{
+		return lhs.size() == rhs.size() && equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());
+	}
+
+	//**************************************
+	// Minimum value method (container)
+	//**************************************
+	template<typename Container>
+	inline typename Container::value_type min_value(const Container& container) noexcept
+	{
+		return min_value(container.data(), container.data() + container.size());
+	}
+
+	//**************************************
+	// Maximum value method (container)
+	//**************************************
+	template<typename Container>
+	inline typename Container::value_type max_value(const Container& container) noexcept
+	{
+		return max_value(container.data(), container.data() + container.size());
+	}
+
+	//**************************************
+	// Sum method (container)
+	//**************************************
+	template<typename Container>
+	inline typename Container::value_type sum(const Container& container) noexcept
+	{
+		return sum(container.data(), container.data() + container.size());
+	}
+
+	//*************[ Strided Span Methods ]
+	// Gathering elements a stride apart
+	// costs more than the SIMD kernels
+	// save, so these are scalar loops,
+	// except that packed spans go to the
+	// contiguous versions
+	//**************************************
+	//**************************************
+	// Find method (strided)
+	//
+	// Returns the index of the first
+	// match, or size() if there is none
+	//**************************************
+	template<typename Type>
+	inline size_t find(strided_span<Type> elements, const std::remove_cv_t<Type>& value) noexcept
+	{
+		if (elements.is_contiguous())
+			return find(span<const Type>(elements.as_span()), value);
+
+		size_t index{ 0 };
+		for (typename strided_span<Type>::iterator iter = elements.begin(); index < elements.size(); ++iter, ++index)
+			if (*iter == value)
+				break;
+		return index;
+	}
+
+	//**************************************
+	// Count method (strided)
+	//**************************************
+	template<typename Type>
+	inline size_t count(strided_span<Type> elements, const std::remove_cv_t<Type>& value) noexcept
+	{
+		if (elements.is_contiguous())
+			return count(span<const Type>(elements.as_span()), value);
+
+		size_t matches{ 0 };
+		for (const Type& element : elements)
+			matches += element == value ? 1 : 0;
+		return matches;
+	}
+
+	//**************************************
+	// Fill method (strided)
+	//
+	// Assigns value to every viewed
+	// element, leaving what lies between
+	// them alone
+	//**************************************
+	template<typename Type>
+	inline void fill(strided_span<Type> elements, const Type& value) noexcept
+	{
+		if (elements.is_contiguous())
+			return fill(elements.as_span(), value);
+
+		for (Type& element : elements)
+			element = value;
+	}
+
+	//**************************************
+	// Equality method (strided)
+	//**************************************
+	template<typename Type>
+	inline bool equal(strided_span<Type> lhs, strided_span<Type> rhs) noexcept
+	{
+		if (lhs.size() != rhs.size())
+			return false;
+		if (lhs.is_contiguous() && rhs.is_contiguous())
+			return equal(lhs.as_span(), rhs.as_span());
+
+		typename strided_span<Type>::iterator right = rhs.begin();
+		for (const Type& element : lhs)
+			if (!(element == *right++))
+				return false;
+		return true;
+	}
+
+	//**************************************
+	// Minimum value method (strided)
+	//
+	// The span must not be empty
+	//**************************************
+	template<typename Type>
+	inline std::remove_cv_t<Type> min_value(strided_span<Type> elements) noexcept
+	{
+		assert(!elements.empty());
+		if (elements.is_contiguous())
+			return min_value(span<const Type>(elements.as_span()));
+
+		std::remove_cv_t<Type> result = elements.front();
+		for (const Type& element : elements)
+			if (element < result)
+				result = element;
+		return result;
+	}
+
+	//**************************************
+	// Maximum value method (strided)
+	//
+	// The span must not be empty
+	//**************************************
+	template<typename Type>
+	inline std::remove_cv_t<Type> max_value(strided_span<Type> elements) noexcept
+	{
+		assert(!elements.empty());
+		if (elements.is_contiguous())
+			return max_value(span<const Type>(elements.as_span()));
+
+		std::remove_cv_t<Type> result = elements.front();
+		for (const Type& element : elements)
+			if (result < element)
+				result = element;
+		return result;
+	}
+
+	//**************************************
+	// Sum method (strided)
+	//
+	// Four running sums hide the add
+	// latency, so floating point sums
+	// can round differently than a plain
+	// loop
+	//**************************************
+	template<typename Type>
+	inline std::remove_cv_t<Type> sum(strided_span<Type> elements) noexcept
+	{
+		if (elements.is_contiguous())
+			return sum(span<const Type>(elements.as_span()));
+
+		std::remove_cv_t<Type> sums[4] = {};
+		size_t index{ 0 };
+		for (; index + 4 <= elements.size(); index += 4)
+		{
+			sums[0] += elements[index];
+			sums[1] += elements[index + 1];
+			sums[2] += elements[index + 2];
+			sums[3] += elements[index + 3];
+		}
+		for (; index < elements.size(); ++index)
+			sums[0] += elements[index];
+		return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+	}
+}
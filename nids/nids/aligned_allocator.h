@@ -0,0 +1,311 @@
+//**************************************
+// aligned_allocator.h
+//
+// Holds the over-aligned and huge page
+// backed allocators for the nids
+// containers.
+//
+// aligned_allocator hands out blocks
+// aligned to a cache line (or more) and
+// keeps that alignment when the block
+// grows, which plain realloc does not.
+//
+// huge_page_allocator does the same for
+// small blocks, but maps large ones
+// straight from the OS on 2 MB
+// boundaries and asks for transparent
+// huge pages with madvise, to cut down
+// on TLB misses when scanning them.
+// Outside of Linux it behaves like
+// aligned_allocator
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace nids
+{
+	// size of a cache line, used to keep data written by different threads apart
+	const size_t CACHE_LINE_SIZE = 64;
+
+	// size of an x86-64 transparent huge page
+	const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	//**************************************
+	// Aligned allocator
+	//
+	// Stateless allocator whose blocks
+	// start on an Alignment byte boundary
+	//
+	// Alignment must be a power of two, the
+	// default of 64 is one cache line (and
+	// one AVX-512 register)
+	//**************************************
+	template<size_t Alignment = 64>
+	struct aligned_allocator
+	{
+		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+		static_assert(Alignment >= sizeof(void*), "Alignment must be at least the size of a pointer");
+
+		static const size_t ALIGNMENT = Alignment;
+
+		//**********************************
+		// Allocation method
+		//**********************************
+		inline void* allocate(size_t bytes) noexcept
+		{
+#ifdef _MSC_VER
+			return _aligned_malloc(bytes, Alignment);
+#else
+			void* block;
+			if (posix_memalign(&block, Alignment, bytes) != 0)
+				return nullptr;
+			return block;
+#endif
+		}
+
+		//**********************************
+		// Reallocation method
+		//
+		// realloc may hand back a block
+		// that is only 16 byte aligned, so
+		// outside of MSVC (which has an
+		// aligned realloc) growing means
+		// copying into a new aligned block
+		//**********************************
+		inline void* reallocate(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+#ifdef _MSC_VER
+			(void)oldBytes;
+			return _aligned_realloc(block, newBytes, Alignment);
+#else
+			void* newBlock = allocate(newBytes);
+			if (newBlock == nullptr)
+				return nullptr;
+
+			if (block != nullptr)
+			{
+				memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+				free(block);
+			}
+			return newBlock;
+#endif
+		}
+
+		//**********************************
+		// In place expansion method
+		//**********************************
+		inline bool expand(void*, size_t, size_t) noexcept { return false; }
+
+		//**********************************
+		// Deallocation method
+		//**********************************
+		inline void deallocate(void* block, size_t) noexcept
+		{
+#ifdef _MSC_VER
+			_aligned_free(block);
+#else
+			free(block);
+#endif
+		}
+
+		inline bool operator==(const aligned_allocator&) const noexcept { return true; }
+		inline bool operator!=(const aligned_allocator&) const noexcept { return false; }
+	};
+
+	//**************************************
+	// Huge page allocator
+	//
+	// Blocks of Threshold bytes or more
+	// are mapped on a HUGE_PAGE_SIZE
+	// boundary and rounded up to a whole
+	// number of huge pages, everything
+	// smaller comes from
+	// aligned_allocator<Alignment>
+	//
+	// The huge pages are only a hint, the
+	// kernel falls back to normal pages
+	// if transparent huge pages are off
+	// (see /sys/kernel/mm/
+	// transparent_hugepage/enabled)
+	//**************************************
+	template<size_t Alignment = 64, size_t Threshold = HUGE_PAGE_SIZE>
+	struct huge_page_allocator
+	{
+		static_assert(Alignment <= HUGE_PAGE_SIZE, "Alignment can't be larger than a huge page");
+
+		static const size_t ALIGNMENT = Alignment;
+		static const size_t THRESHOLD = Threshold;
+
+		//**********************************
+		// Allocation method
+		//**********************************
+		inline void* allocate(size_t bytes) noexcept
+		{
+#ifdef __linux__
+			if (bytes >= Threshold)
+				return map_huge(huge_size(bytes));
+#endif
+			return aligned_allocator<Alignment>().allocate(bytes);
+		}
+
+		//**********************************
+		// Reallocation method
+		//
+		// Tries to resize the block in
+		// place first, otherwise moves it
+		// into a new block
+		//**********************************
+		inline void* reallocate(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+			if (block == nullptr)
+				return allocate(newBytes);
+			if (expand(block, oldBytes, newBytes))
+				return block;
+			if (!is_huge(oldBytes) && !is_huge(newBytes))
+				return aligned_allocator<Alignment>().reallocate(block, oldBytes, newBytes);
+
+			void* newBlock = allocate(newBytes);
+			if (newBlock == nullptr)
+				return nullptr;
+
+			memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+			deallocate(block, oldBytes);
+			return newBlock;
+		}
+
+		//**********************************
+		// In place expansion method
+		//
+		// Mapped blocks can change size
+		// within their last huge page for
+		// free, and grow past it if the
+		// address space after them is
+		// still open
+		//**********************************
+		inline bool expand(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+#ifdef __linux__
+			if (block == nullptr || !is_huge(oldBytes) || !is_huge(newBytes))
+				return false;
+
+			size_t oldSize = huge_size(oldBytes);
+			size_t newSize = huge_size(newBytes);
+			char* base = static_cast<char*>(block);
+			if (newSize < oldSize)
+				munmap(base + newSize, oldSize - newSize);
+			else if (newSize > oldSize)
+			{
+				// without MREMAP_MAYMOVE this fails rather than moving the block
+				if (mremap(block, oldSize, newSize, 0) == MAP_FAILED)
+					return false;
+				advise_huge(base + oldSize, newSize - oldSize);
+			}
+			return true;
+#else
+			(void)block;
+			(void)oldBytes;
+			(void)newBytes;
+			return false;
+#endif
+		}
+
+		//**********************************
+		// Deallocation method
+		//**********************************
+		inline void deallocate(void* block, size_t bytes) noexcept
+		{
+			if (block == nullptr)
+				return;
+#ifdef __linux__
+			if (is_huge(bytes))
+			{
+				munmap(block, huge_size(bytes));
+				return;
+			}
+#endif
+			aligned_allocator<Alignment>().deallocate(block, bytes);
+		}
+
+		inline bool operator==(const huge_page_allocator&) const noexcept { return true; }
+		inline bool operator!=(const huge_page_allocator&) const noexcept { return false; }
+
+	private:
+		//**********************************
+		// Mapped block check
+		//**********************************
+		static inline bool is_huge(size_t bytes) noexcept
+		{
+#ifdef __linux__
+			return bytes >= Threshold;
+#else
+			(void)bytes;
+			return false;
+#endif
+		}
+
+		//**********************************
+		// Huge page rounding method
+		//**********************************
+		static inline size_t huge_size(size_t bytes) noexcept
+		{
+			return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+		}
+
+#ifdef __linux__
+		//**********************************
+		// Huge page hint method
+		//**********************************
+		static inline void advise_huge(void* region, size_t size) noexcept
+		{
+#ifdef MADV_HUGEPAGE
+			madvise(region, size, MADV_HUGEPAGE);
+#else
+			(void)region;
+			(void)size;
+#endif
+		}
+
+		//**********************************
+		// Mapping method
+		//
+		// Over-maps by one huge page and
+		// trims both ends so the block
+		// starts on a huge page boundary
+		//**********************************
+		static inline void* map_huge(size_t size) noexcept
+		{
+			void* raw = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED)
+				return nullptr;
+
+			uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+			uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~static_cast<uintptr_t>(HUGE_PAGE_SIZE - 1);
+			size_t head = aligned - start;
+			size_t tail = HUGE_PAGE_SIZE - head;
+			if (head > 0)
+				munmap(raw, head);
+			if (tail > 0)
+				munmap(reinterpret_cast<void*>(aligned + size), tail);
+
+			advise_huge(reinterpret_cast<void*>(aligned), size);
+			return reinterpret_cast<void*>(aligned);
+		}
+#endif
+	};
+}
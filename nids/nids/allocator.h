@@ -0,0 +1,223 @@
+//**************************************
+// allocator.h
+//
+// Holds the allocator interface used
+// by the nids containers and the
+// default malloc based allocator.
+//
+// An allocator is any copyable type
+// with these member functions:
+//
+//	void* allocate(size_t bytes)
+//	void* reallocate(void* block,
+//		size_t oldBytes, size_t newBytes)
+//	bool expand(void* block,
+//		size_t oldBytes, size_t newBytes)
+//	void deallocate(void* block,
+//		size_t bytes)
+//
+// reallocate behaves like realloc (the
+// contents may be moved bitwise, and
+// nullptr is returned on failure with
+// block left alone), while expand only
+// succeeds if the block can be resized
+// without moving it
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace nids
+{
+	//**************************************
+	// Malloc allocator
+	//
+	// Stateless allocator that goes to the
+	// global heap
+	//**************************************
+	struct malloc_allocator
+	{
+		//**********************************
+		// Allocation method
+		//**********************************
+		inline void* allocate(size_t bytes) noexcept { return malloc(bytes); }
+
+		//**********************************
+		// Reallocation method
+		//**********************************
+		inline void* reallocate(void* block, size_t, size_t newBytes) noexcept { return realloc(block, newBytes); }
+
+		//**********************************
+		// In place expansion method
+		//
+		// The C heap has no portable way of
+		// growing a block without moving it
+		//**********************************
+		inline bool expand(void*, size_t, size_t) noexcept { return false; }
+
+		//**********************************
+		// Deallocation method
+		//**********************************
+		inline void deallocate(void* block, size_t) noexcept { free(block); }
+
+		inline bool operator==(const malloc_allocator&) const noexcept { return true; }
+		inline bool operator!=(const malloc_allocator&) const noexcept { return false; }
+	};
+
+	// block size at which mremap_allocator switches to mapped storage
+	const size_t MREMAP_THRESHOLD = 1024 * 1024;
+
+	//**************************************
+	// Mremap allocator
+	//
+	// Stateless allocator that behaves
+	// like malloc_allocator for blocks
+	// under Threshold bytes, and maps
+	// larger ones straight from the OS
+	// (Linux only)
+	//
+	// Mapped blocks grow with
+	// mremap(MREMAP_MAYMOVE), which moves
+	// page table entries instead of
+	// copying bytes, so a resize costs
+	// about the same no matter how big
+	// the block is
+	//**************************************
+	template<size_t Threshold = MREMAP_THRESHOLD>
+	struct mremap_allocator
+	{
+		static const size_t THRESHOLD = Threshold;
+
+		//**********************************
+		// Allocation method
+		//**********************************
+		inline void* allocate(size_t bytes) noexcept
+		{
+#ifdef __linux__
+			if (is_mapped(bytes))
+			{
+				void* block = mmap(nullptr, page_round(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				return block == MAP_FAILED ? nullptr : block;
+			}
+#endif
+			return malloc(bytes);
+		}
+
+		//**********************************
+		// Reallocation method
+		//
+		// Blocks crossing the threshold
+		// are copied once into the other
+		// kind of storage
+		//**********************************
+		inline void* reallocate(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+			if (block == nullptr)
+				return allocate(newBytes);
+			if (!is_mapped(oldBytes) && !is_mapped(newBytes))
+				return realloc(block, newBytes);
+#ifdef __linux__
+			if (is_mapped(oldBytes) && is_mapped(newBytes))
+			{
+				void* newBlock = mremap(block, page_round(oldBytes), page_round(newBytes), MREMAP_MAYMOVE);
+				return newBlock == MAP_FAILED ? nullptr : newBlock;
+			}
+#endif
+			void* newBlock = allocate(newBytes);
+			if (newBlock == nullptr)
+				return nullptr;
+
+			memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+			deallocate(block, oldBytes);
+			return newBlock;
+		}
+
+		//**********************************
+		// In place expansion method
+		//
+		// Only mapped blocks can grow
+		// without moving
+		//**********************************
+		inline bool expand(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+#ifdef __linux__
+			if (block == nullptr || !is_mapped(oldBytes) || !is_mapped(newBytes))
+				return false;
+			return mremap(block, page_round(oldBytes), page_round(newBytes), 0) != MAP_FAILED;
+#else
+			(void)block;
+			(void)oldBytes;
+			(void)newBytes;
+			return false;
+#endif
+		}
+
+		//**********************************
+		// Deallocation method
+		//**********************************
+		inline void deallocate(void* block, size_t bytes) noexcept
+		{
+#ifdef __linux__
+			if (block != nullptr && is_mapped(bytes))
+			{
+				munmap(block, page_round(bytes));
+				return;
+			}
+#endif
+			(void)bytes;
+			free(block);
+		}
+
+		inline bool operator==(const mremap_allocator&) const noexcept { return true; }
+		inline bool operator!=(const mremap_allocator&) const noexcept { return false; }
+
+	private:
+		//**********************************
+		// Mapped block check
+		//**********************************
+		static inline bool is_mapped(size_t bytes) noexcept
+		{
+#ifdef __linux__
+			return bytes >= Threshold;
+#else
+			(void)bytes;
+			return false;
+#endif
+		}
+
+#ifdef __linux__
+		//**********************************
+		// Page rounding method
+		//**********************************
+		static inline size_t page_round(size_t bytes) noexcept
+		{
+			static const size_t PAGE = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			return (bytes + PAGE - 1) & ~(PAGE - 1);
+		}
+#endif
+	};
+
+	//**************************************
+	// Default allocator
+	//
+	// What the nids containers use unless
+	// told otherwise: the C heap, plus
+	// mremap growth for very large blocks
+	// on Linux
+	//**************************************
+#ifdef __linux__
+	using default_allocator = mremap_allocator<>;
+#else
+	using default_allocator = malloc_allocator;
+#endif
+}
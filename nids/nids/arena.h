@@ -0,0 +1,275 @@
+//**************************************
+// arena.h
+//
+// Holds the bump pointer arena and the
+// allocator that lets nids containers
+// draw their storage from it.
+//
+// Allocations are carved off the end
+// of a block, so freeing only gives the
+// memory back if it was the most recent
+// allocation. Everything is released at
+// once with reset() or destruction,
+// which makes it a good fit for scratch
+// containers that live for one request
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace nids
+{
+	class arena final
+	{
+	public:
+		// default number of bytes requested from the heap per block
+		static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+		// every allocation is aligned to this
+		static const size_t ALIGNMENT = alignof(max_align_t);
+
+		//************************************
+		// Constructor
+		//
+		// Blocks are allocated lazily, so
+		// an unused arena costs nothing
+		//************************************
+		inline arena(size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept
+			: m_head(nullptr), m_cursor(nullptr), m_end(nullptr), m_blockSize(blockSize)
+		{
+			assert(m_blockSize > 0);
+		}
+
+		arena(const arena&) = delete;
+		arena& operator=(const arena&) = delete;
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~arena() noexcept
+		{
+			release(nullptr);
+		}
+
+		//************************************
+		// Allocation method
+		//
+		// Returns nullptr if the heap is out
+		// of memory
+		//************************************
+		void* allocate(size_t bytes) noexcept;
+
+		//************************************
+		// In place expansion method
+		//
+		// Grows or shrinks block without
+		// moving it, which only works for
+		// the most recent allocation
+		//************************************
+		bool expand(void* block, size_t oldBytes, size_t newBytes) noexcept;
+
+		//************************************
+		// Deallocation method
+		//
+		// Only the most recent allocation is
+		// actually reclaimed
+		//************************************
+		inline void deallocate(void* block, size_t bytes) noexcept
+		{
+			if (block != nullptr && static_cast<char*>(block) + align(bytes) == m_cursor)
+				m_cursor = static_cast<char*>(block);
+		}
+
+		//************************************
+		// Reset method
+		//
+		// Frees every allocation at once,
+		// keeping the newest block around to
+		// serve the next round
+		//
+		// WARNING: containers that still use
+		// this arena must not be touched
+		// after a reset
+		//************************************
+		inline void reset() noexcept
+		{
+			if (m_head == nullptr)
+				return;
+
+			release(m_head);
+			m_head->next = nullptr;
+			m_cursor = first_byte(m_head);
+		}
+
+		//************************************
+		// Used bytes getter
+		//
+		// Bytes handed out from the current
+		// block
+		//************************************
+		inline size_t bytes_used() const noexcept { return m_head ? static_cast<size_t>(m_cursor - first_byte(m_head)) : 0; }
+	private:
+		struct block_header
+		{
+			block_header* next;
+			size_t size;
+		};
+
+		//************************************
+		// Alignment helper
+		//************************************
+		static inline size_t align(size_t bytes) noexcept { return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+		//************************************
+		// First usable byte of a block
+		//************************************
+		static inline char* first_byte(block_header* block) noexcept
+		{
+			return reinterpret_cast<char*>(block) + align(sizeof(block_header));
+		}
+
+		//************************************
+		// Block adding method
+		//
+		// Starts a new block big enough to
+		// hold at least bytes
+		//************************************
+		bool add_block(size_t bytes) noexcept;
+
+		//************************************
+		// Block releasing method
+		//
+		// Frees every block except keep
+		//************************************
+		inline void release(block_header* keep) noexcept
+		{
+			block_header* block = m_head;
+			while (block != nullptr)
+			{
+				block_header* next = block->next;
+				if (block != keep)
+					free(block);
+				block = next;
+			}
+			if (keep == nullptr)
+			{
+				m_head = nullptr;
+				m_cursor = m_end = nullptr;
+			}
+		}
+
+		block_header* m_head;
+		char* m_cursor;
+		char* m_end;
+		size_t m_blockSize;
+	};
+
+	//**************************************
+	// Allocation method
+	//**************************************
+	inline void* arena::allocate(size_t bytes) noexcept
+	{
+		bytes = align(bytes);
+		if (m_head == nullptr || static_cast<size_t>(m_end - m_cursor) < bytes)
+			if (!add_block(bytes))
+				return nullptr;
+
+		void* block = m_cursor;
+		m_cursor += bytes;
+		return block;
+	}
+
+	//**************************************
+	// In place expansion method
+	//**************************************
+	inline bool arena::expand(void* block, size_t oldBytes, size_t newBytes) noexcept
+	{
+		char* start = static_cast<char*>(block);
+		if (start == nullptr || start + align(oldBytes) != m_cursor)
+			return false;
+
+		if (static_cast<size_t>(m_end - start) < align(newBytes))
+			return false;
+
+		m_cursor = start + align(newBytes);
+		return true;
+	}
+
+	//**************************************
+	// Block adding method
+	//**************************************
+	inline bool arena::add_block(size_t bytes) noexcept
+	{
+		size_t usable = bytes > m_blockSize ? bytes : m_blockSize;
+		block_header* block = static_cast<block_header*>(malloc(align(sizeof(block_header)) + usable));
+		if (block == nullptr)
+			return false;
+
+		block->next = m_head;
+		block->size = usable;
+		m_head = block;
+		m_cursor = first_byte(block);
+		m_end = m_cursor + usable;
+		return true;
+	}
+
+	//**************************************
+	// Arena allocator
+	//
+	// Allocator that hands out memory from
+	// an arena owned by someone else
+	//**************************************
+	struct arena_allocator
+	{
+		inline arena_allocator(arena& source) noexcept : m_arena(&source) {}
+
+		//**********************************
+		// Allocation method
+		//**********************************
+		inline void* allocate(size_t bytes) noexcept { return m_arena->allocate(bytes); }
+
+		//**********************************
+		// Reallocation method
+		//
+		// Grows in place when the block is
+		// the newest one in the arena
+		//**********************************
+		inline void* reallocate(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+			if (m_arena->expand(block, oldBytes, newBytes))
+				return block;
+
+			void* newBlock = m_arena->allocate(newBytes);
+			if (newBlock == nullptr)
+				return nullptr;
+
+			if (block != nullptr)
+			{
+				memcpy(newBlock, block, oldBytes < newBytes ? oldBytes : newBytes);
+				m_arena->deallocate(block, oldBytes);
+			}
+			return newBlock;
+		}
+
+		//**********************************
+		// In place expansion method
+		//**********************************
+		inline bool expand(void* block, size_t oldBytes, size_t newBytes) noexcept { return m_arena->expand(block, oldBytes, newBytes); }
+
+		//**********************************
+		// Deallocation method
+		//**********************************
+		inline void deallocate(void* block, size_t bytes) noexcept { m_arena->deallocate(block, bytes); }
+
+		inline bool operator==(const arena_allocator& rhs) const noexcept { return m_arena == rhs.m_arena; }
+		inline bool operator!=(const arena_allocator& rhs) const noexcept { return m_arena != rhs.m_arena; }
+	private:
+		arena* m_arena;
+	};
+}
@@ -0,0 +1,540 @@
+//**************************************
+// bit_vector.h
+//
+// Holds nids::bit_vector, a vector of
+// bits packed into 64 bit words, and
+// nids::rank_select, the index that
+// answers rank and select over one.
+//
+// A bit_vector takes an eighth of the
+// memory of a vector of bool or char,
+// so a visited set over tens of
+// millions of nodes still fits in
+// cache. Bulk AND / OR / XOR and
+// popcount run a register of words at
+// a time through the SIMD kernels in
+// algorithm.h
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "algorithm.h"
+#include "vector.h"
+
+namespace nids
+{
+	template<typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class bit_vector final
+	{
+	public:
+		using value_type = bool;
+		using word_type = uint64_t;
+		using growth_policy = GrowthPolicy;
+		using allocator_type = Allocator;
+
+		// bits in each word
+		static const size_t WORD_BITS = 64;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline bit_vector() noexcept : m_words(), m_size(0) {}
+
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit bit_vector(const Allocator& allocator) noexcept : m_words(allocator), m_size(0) {}
+
+		//************************************
+		// Size constructor
+		//
+		// Makes size bits, all set to value
+		//************************************
+		inline explicit bit_vector(size_t size, bool value = false) noexcept : m_words(), m_size(0) { assign(size, value); }
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//
+		// Returns the number of bits
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Capacity accessor
+		//
+		// Returns the number of bits that
+		// fit without growing
+		//************************************
+		inline size_t capacity() const noexcept { return m_words.capacity() * WORD_BITS; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Word count accessor
+		//************************************
+		inline size_t word_count() const noexcept { return m_words.size(); }
+
+		//************************************
+		// Word array getter (const correct)
+		//
+		// Bit i is bit i % 64 of word i / 64,
+		// and the bits past size() in the
+		// last word are always zero
+		//************************************
+		inline const word_type* words() const noexcept { return m_words.data(); }
+
+		//************************************
+		// Word array getter
+		//
+		// Writers must keep the bits past
+		// size() zero
+		//************************************
+		inline word_type* words() noexcept { return m_words.data(); }
+
+		//************************************
+		// Bit test method
+		//************************************
+		inline bool test(size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return (m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+		}
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline bool operator[](size_t index) const noexcept { return test(index); }
+
+		//************************************
+		// Population count method
+		//
+		// Returns the number of set bits
+		//************************************
+		inline size_t count() const noexcept { return popcount(m_words.data(), m_words.size()); }
+
+		//************************************
+		// Any set status getter
+		//************************************
+		inline bool any() const noexcept
+		{
+			for (size_t word{ 0 }; word < m_words.size(); ++word)
+				if (m_words[word] != 0)
+					return true;
+			return false;
+		}
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Bit set method
+		//************************************
+		inline void set(size_t index) noexcept
+		{
+			assert(index < m_size);
+			m_words[index / WORD_BITS] |= bit(index);
+		}
+
+		//************************************
+		// Bit set method (value)
+		//************************************
+		inline void set(size_t index, bool value) noexcept
+		{
+			if (value)
+				set(index);
+			else
+				reset(index);
+		}
+
+		//************************************
+		// Bit reset method
+		//************************************
+		inline void reset(size_t index) noexcept
+		{
+			assert(index < m_size);
+			m_words[index / WORD_BITS] &= ~bit(index);
+		}
+
+		//************************************
+		// Bit flip method
+		//************************************
+		inline void flip(size_t index) noexcept
+		{
+			assert(index < m_size);
+			m_words[index / WORD_BITS] ^= bit(index);
+		}
+
+		//************************************
+		// Test and set method
+		//
+		// Sets the bit and returns what it
+		// was before, e.g. to mark a node
+		// visited and learn if it already was
+		//************************************
+		inline bool test_and_set(size_t index) noexcept
+		{
+			assert(index < m_size);
+			word_type& word = m_words[index / WORD_BITS];
+			bool was = (word & bit(index)) != 0;
+			word |= bit(index);
+			return was;
+		}
+
+		//************************************
+		// Push back method
+		//************************************
+		inline void push_back(bool value) noexcept
+		{
+			if (m_size % WORD_BITS == 0)
+				m_words.push_back(0);
+			if (value)
+				m_words[m_size / WORD_BITS] |= bit(m_size);
+			++m_size;
+		}
+
+		//************************************
+		// Pop back method
+		//************************************
+		inline void pop_back() noexcept
+		{
+			assert(m_size > 0);
+			--m_size;
+			m_words[m_size / WORD_BITS] &= ~bit(m_size);
+			if (m_size % WORD_BITS == 0)
+				m_words.resize_default_init(m_words.size() - 1);
+		}
+
+		//************************************
+		// Assign method
+		//
+		// Sets the size to size bits, all
+		// set to value
+		//************************************
+		void assign(size_t size, bool value) noexcept;
+
+		//************************************
+		// Reserve method
+		//
+		// Grows the capacity to at least
+		// size bits, never shrinks it
+		//
+		// Returns the new capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			m_words.reserve(words_for(size));
+			return capacity();
+		}
+
+		//************************************
+		// Clear method
+		//************************************
+		inline void clear() noexcept
+		{
+			m_words.resize_default_init(0);
+			m_size = 0;
+		}
+
+		//************************************
+		// Set all method
+		//************************************
+		inline void set_all() noexcept
+		{
+			if (!m_words.empty())
+				memset(m_words.data(), 0xFF, sizeof(word_type) * m_words.size());
+			clear_tail();
+		}
+
+		//************************************
+		// Reset all method
+		//************************************
+		inline void reset_all() noexcept
+		{
+			if (!m_words.empty())
+				memset(m_words.data(), 0, sizeof(word_type) * m_words.size());
+		}
+
+		//************************************
+		// Bitwise and operator
+		//
+		// rhs must be the same size
+		//************************************
+		inline bit_vector& operator&=(const bit_vector& rhs) noexcept
+		{
+			assert(m_size == rhs.m_size);
+			bitwise_and(m_words.data(), rhs.m_words.data(), m_words.size());
+			return *this;
+		}
+
+		//************************************
+		// Bitwise or operator
+		//
+		// rhs must be the same size
+		//************************************
+		inline bit_vector& operator|=(const bit_vector& rhs) noexcept
+		{
+			assert(m_size == rhs.m_size);
+			bitwise_or(m_words.data(), rhs.m_words.data(), m_words.size());
+			return *this;
+		}
+
+		//************************************
+		// Bitwise xor operator
+		//
+		// rhs must be the same size
+		//************************************
+		inline bit_vector& operator^=(const bit_vector& rhs) noexcept
+		{
+			assert(m_size == rhs.m_size);
+			bitwise_xor(m_words.data(), rhs.m_words.data(), m_words.size());
+			return *this;
+		}
+	private:
+		//************************************
+		// Word count helper
+		//************************************
+		static inline size_t words_for(size_t bits) noexcept { return (bits + WORD_BITS - 1) / WORD_BITS; }
+
+		//************************************
+		// Bit mask helper
+		//************************************
+		static inline word_type bit(size_t index) noexcept { return word_type{ 1 } << (index % WORD_BITS); }
+
+		//************************************
+		// Tail clearing method
+		//
+		// Zeroes the bits of the last word
+		// that are past the size
+		//************************************
+		inline void clear_tail() noexcept
+		{
+			if (m_size % WORD_BITS != 0)
+				m_words[m_words.size() - 1] &= bit(m_size) - 1;
+		}
+
+		vector<word_type, GrowthPolicy, Allocator> m_words;
+		size_t m_size;
+	};
+
+	//**********************************
+	// Assign method
+	//**********************************
+	template<typename GrowthPolicy, typename Allocator>
+	void bit_vector<GrowthPolicy, Allocator>::assign(size_t size, bool value) noexcept
+	{
+		size_t words = words_for(size);
+		if (words > m_words.capacity())
+			m_words.reserve(words);
+		m_words.resize_default_init(words);
+		m_size = size;
+		if (value)
+			set_all();
+		else
+			reset_all();
+	}
+
+	//**************************************
+	// Rank and select index
+	//
+	// Built once over a bit_vector (or any
+	// type with words() and size()) that
+	// must not change while it is used.
+	//
+	// Every block of 8 words gets two
+	// counts side by side: the set bits
+	// before the block, and the set bits
+	// before each of its words packed 9
+	// bits apiece. rank(i) reads both and
+	// adds one popcount. select(k) starts
+	// at a block sampled every
+	// SELECT_SAMPLE set bits, so it only
+	// searches a short stretch of blocks
+	//**************************************
+	class rank_select final
+	{
+	public:
+		// words in each block that has its own running count
+		static const size_t BLOCK_WORDS = 8;
+
+		// set bits between select samples
+		static const size_t SELECT_SAMPLE = 512;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//************************************
+		template<typename BitVector>
+		explicit rank_select(const BitVector& bits) noexcept;
+
+		rank_select(const rank_select&) = delete;
+		rank_select& operator=(const rank_select&) = delete;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Set bit count accessor
+		//************************************
+		inline size_t count() const noexcept { return m_ones; }
+
+		//************************************
+		// Rank method
+		//
+		// Returns the number of set bits
+		// in [0, index), index may be size
+		//************************************
+		size_t rank(size_t index) const noexcept;
+
+		//************************************
+		// Select method
+		//
+		// Returns the position of the set
+		// bit with rank which (counting
+		// from 0), which must be below
+		// count()
+		//************************************
+		size_t select(size_t which) const noexcept;
+	private:
+		//************************************
+		// Block count getter
+		//
+		// Set bits before block
+		//************************************
+		inline uint64_t block_rank(size_t block) const noexcept { return m_counts[2 * block]; }
+
+		//************************************
+		// Word count getter
+		//
+		// Set bits before word within its
+		// block
+		//************************************
+		inline uint64_t word_rank(size_t block, size_t word) const noexcept
+		{
+			return word == 0 ? 0 : (m_counts[2 * block + 1] >> (9 * (word - 1))) & 0x1FF;
+		}
+
+		//************************************
+		// Word select helper
+		//
+		// Returns the position of the set
+		// bit with rank which in word. The
+		// running count of each byte picks
+		// the byte, so at most 7 bits are
+		// stepped over by hand
+		//************************************
+		static inline size_t select_in_word(uint64_t word, size_t which) noexcept
+		{
+			uint64_t counts = word - ((word >> 1) & 0x5555555555555555ull);
+			counts = (counts & 0x3333333333333333ull) + ((counts >> 2) & 0x3333333333333333ull);
+			counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+			// byte i of running holds the set bits in bytes 0 through i
+			uint64_t running = counts * 0x0101010101010101ull;
+			size_t shift{ 0 };
+			while (((running >> shift) & 0xFF) <= which)
+				shift += 8;
+			if (shift > 0)
+				which -= (running >> (shift - 8)) & 0xFF;
+
+			uint64_t bits = (word >> shift) & 0xFF;
+			for (; which > 0; --which)
+				bits &= bits - 1;
+			return shift + count_trailing_zeros(bits);
+		}
+
+		const uint64_t* m_words;
+		size_t m_wordCount;
+		size_t m_size;
+		size_t m_ones;
+
+		// two counts per block, plus a last pair holding the total
+		vector<uint64_t> m_counts;
+
+		// block holding every SELECT_SAMPLE-th set bit
+		vector<uint64_t> m_selectSamples;
+	};
+
+	//**********************************
+	// Constructor
+	//**********************************
+	template<typename BitVector>
+	rank_select::rank_select(const BitVector& bits) noexcept
+		: m_words(bits.words()), m_wordCount((bits.size() + 63) / 64), m_size(bits.size()), m_ones(0), m_counts(), m_selectSamples()
+	{
+		size_t blocks = (m_wordCount + BLOCK_WORDS - 1) / BLOCK_WORDS;
+		m_counts.reserve(2 * blocks + 2);
+
+		size_t nextSample{ 0 };
+		for (size_t block{ 0 }; block < blocks; ++block)
+		{
+			uint64_t inBlock{ 0 };
+			uint64_t packed{ 0 };
+			for (size_t word{ 0 }; word < BLOCK_WORDS; ++word)
+			{
+				if (word > 0)
+					packed |= inBlock << (9 * (word - 1));
+				size_t index = block * BLOCK_WORDS + word;
+				if (index < m_wordCount)
+					inBlock += population_count(m_words[index]);
+			}
+			m_counts.push_back(m_ones);
+			m_counts.push_back(packed);
+			m_ones += inBlock;
+
+			// the samples that fall inside this block
+			for (; nextSample < m_ones; nextSample += SELECT_SAMPLE)
+				m_selectSamples.push_back(block);
+		}
+		m_counts.push_back(m_ones);
+		m_counts.push_back(0);
+	}
+
+	//**********************************
+	// Rank method
+	//**********************************
+	inline size_t rank_select::rank(size_t index) const noexcept
+	{
+		assert(index <= m_size);
+		size_t word = index / 64;
+		size_t block = word / BLOCK_WORDS;
+		size_t ones = block_rank(block) + word_rank(block, word % BLOCK_WORDS);
+		if (index % 64 != 0)
+			ones += population_count(m_words[word] & ((uint64_t{ 1 } << (index % 64)) - 1));
+		return ones;
+	}
+
+	//**********************************
+	// Select method
+	//**********************************
+	inline size_t rank_select::select(size_t which) const noexcept
+	{
+		assert(which < m_ones);
+
+		// binary search for the last block starting at or below which, between two samples
+		size_t sample = which / SELECT_SAMPLE;
+		size_t low = m_selectSamples[sample];
+		size_t high = sample + 1 < m_selectSamples.size() ? m_selectSamples[sample + 1] + 1 : m_counts.size() / 2 - 1;
+		while (high - low > 1)
+		{
+			size_t middle = low + (high - low) / 2;
+			if (block_rank(middle) <= which)
+				low = middle;
+			else
+				high = middle;
+		}
+
+		// then the last word of that block starting at or below which
+		size_t remaining = which - block_rank(low);
+		size_t word{ 0 };
+		while (word + 1 < BLOCK_WORDS && low * BLOCK_WORDS + word + 1 < m_wordCount && word_rank(low, word + 1) <= remaining)
+			++word;
+		return (low * BLOCK_WORDS + word) * 64 + select_in_word(m_words[low * BLOCK_WORDS + word], remaining - word_rank(low, word));
+	}
+}
@@ -0,0 +1,411 @@
+//**************************************
+// concurrent_vector.h
+//
+// Holds nids::concurrent_vector, a
+// vector that many threads can append
+// to at once without a lock.
+//
+// push_back claims a slot with one
+// atomic add, so appending threads
+// never wait on each other. Storage is
+// a fixed table of segments that double
+// in size and are never moved, so an
+// element's address is stable from
+// the moment it is claimed
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+#include "aligned_allocator.h"
+#include "segmented_vector.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace nids
+{
+	template<typename Type, size_t FirstSegmentSize = default_segment_size<Type>(), typename Allocator = default_allocator>
+	class concurrent_vector final : private Allocator
+	{
+		static_assert(FirstSegmentSize > 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0, "FirstSegmentSize must be a power of two");
+	public:
+		using value_type = Type;
+		using iterator = segmented_iterator<concurrent_vector>;
+		using const_iterator = segmented_iterator<const concurrent_vector>;
+		using allocator_type = Allocator;
+
+		// elements in segment 0 (and in segment 1, after which they double)
+		static const size_t FIRST_SEGMENT_SIZE = FirstSegmentSize;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline concurrent_vector() noexcept : Allocator(), m_reserved(0), m_published(0)
+		{
+			for (std::atomic<unsigned char*>& segment : m_segments)
+				segment.store(nullptr, std::memory_order_relaxed);
+		}
+
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit concurrent_vector(const Allocator& allocator) noexcept : concurrent_vector()
+		{
+			static_cast<Allocator&>(*this) = allocator;
+		}
+
+		concurrent_vector(const concurrent_vector&) = delete;
+		concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+		//************************************
+		// Destructor
+		//
+		// No thread may still be appending
+		//************************************
+		~concurrent_vector() noexcept;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//
+		// Returns the number of published
+		// elements: every index below it has
+		// been fully constructed, so other
+		// threads can read [0, size())
+		//************************************
+		inline size_t size() const noexcept { return m_published.load(std::memory_order_acquire); }
+
+		//************************************
+		// Reserved size accessor
+		//
+		// Returns the number of claimed
+		// slots, including elements that are
+		// still being constructed
+		//************************************
+		inline size_t reserved_size() const noexcept { return m_reserved.load(std::memory_order_acquire); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return size() == 0; }
+
+		//************************************
+		// Publication status getter
+		//
+		// True once the element at index
+		// has been constructed, even if
+		// earlier ones are still in flight
+		//************************************
+		inline bool is_published(size_t index) const noexcept
+		{
+			if (index >= reserved_size())
+				return false;
+			unsigned char* segment = m_segments[segment_of(index)].load(std::memory_order_acquire);
+			return segment != nullptr && ready_flags(segment, segment_of(index))[offset_of(index)].load(std::memory_order_acquire) != 0;
+		}
+
+		//************************************
+		// Const correct subscript operator
+		//
+		// index must be published (below
+		// size(), or returned by this
+		// thread's push_back)
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept { return *slot(index); }
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline Type& operator[](size_t index) noexcept { return *slot(index); }
+
+		//************************************
+		// Allocator getter
+		//************************************
+		inline const Allocator& get_allocator() const noexcept { return *this; }
+
+		//************************************
+		// Begin iterator getter
+		//
+		// Iterates the elements published
+		// when end() is called
+		//************************************
+		inline iterator begin() noexcept { return iterator(this, 0); }
+		inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+		//************************************
+		// End iterator getter
+		//************************************
+		inline iterator end() noexcept { return iterator(this, size()); }
+		inline const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Push back method
+		//
+		// Safe to call from any number of
+		// threads at once
+		//
+		// Returns the index the element
+		// was stored at
+		//************************************
+		inline size_t push_back(const Type& data) noexcept { return emplace_back(data); }
+
+		//************************************
+		// Push back method (rvalue)
+		//************************************
+		inline size_t push_back(Type&& data) noexcept { return emplace_back(std::move(data)); }
+
+		//************************************
+		// Emplace back method
+		//
+		// Constructs a new element from
+		// args, safe to call from any number
+		// of threads at once
+		//
+		// Returns the index the element
+		// was stored at
+		//************************************
+		template<typename... Args>
+		size_t emplace_back(Args&&... args) noexcept;
+
+		//************************************
+		// Reserve method
+		//
+		// Allocates segments up front so
+		// the first size appends don't have
+		// to, safe to call concurrently
+		//
+		// Returns the capacity of the
+		// allocated segments
+		//************************************
+		size_t reserve(size_t size) noexcept;
+	private:
+		// one table entry per possible segment, enough for any size_t index
+		static const size_t MAX_SEGMENTS = 64;
+
+		//************************************
+		// Segment index helper
+		//
+		// Segment 0 holds the first
+		// FIRST_SEGMENT_SIZE elements, and
+		// segment k holds the next
+		// FIRST_SEGMENT_SIZE << (k - 1)
+		//************************************
+		static inline size_t segment_of(size_t index) noexcept
+		{
+			size_t block = index / FirstSegmentSize;
+			if (block == 0)
+				return 0;
+#ifdef _MSC_VER
+			unsigned long bit;
+			_BitScanReverse64(&bit, block);
+			return bit + 1;
+#else
+			return 64 - __builtin_clzll(block);
+#endif
+		}
+
+		//************************************
+		// Segment start helper
+		//************************************
+		static inline size_t segment_start(size_t segment) noexcept
+		{
+			return segment == 0 ? 0 : FirstSegmentSize << (segment - 1);
+		}
+
+		//************************************
+		// Segment length helper
+		//************************************
+		static inline size_t segment_length(size_t segment) noexcept
+		{
+			return segment == 0 ? FirstSegmentSize : FirstSegmentSize << (segment - 1);
+		}
+
+		//************************************
+		// Segment offset helper
+		//************************************
+		static inline size_t offset_of(size_t index) noexcept { return index - segment_start(segment_of(index)); }
+
+		//************************************
+		// Segment byte size helper
+		//
+		// A segment holds its elements
+		// followed by one ready flag each
+		//************************************
+		static inline size_t segment_bytes(size_t segment) noexcept
+		{
+			return (sizeof(Type) + sizeof(std::atomic<unsigned char>)) * segment_length(segment);
+		}
+
+		//************************************
+		// Ready flag getter
+		//************************************
+		static inline std::atomic<unsigned char>* ready_flags(unsigned char* segment, size_t index) noexcept
+		{
+			return reinterpret_cast<std::atomic<unsigned char>*>(segment + sizeof(Type) * segment_length(index));
+		}
+
+		//************************************
+		// Slot getter
+		//************************************
+		inline Type* slot(size_t index) const noexcept
+		{
+			assert(index < reserved_size());
+			unsigned char* segment = m_segments[segment_of(index)].load(std::memory_order_acquire);
+			assert(segment != nullptr);
+			return reinterpret_cast<Type*>(segment) + offset_of(index);
+		}
+
+		//************************************
+		// Segment getter
+		//
+		// Returns segment, allocating it if
+		// no other thread has yet. Racing
+		// threads each allocate one and the
+		// losers free theirs
+		//************************************
+		unsigned char* acquire_segment(size_t segment) noexcept;
+
+		//************************************
+		// Publish method
+		//
+		// Marks index ready, then moves the
+		// published count past every ready
+		// element, finishing the work of any
+		// thread that published out of order
+		//
+		// In the common in order case this
+		// is a single compare exchange
+		//************************************
+		void publish(size_t index) noexcept;
+
+		std::atomic<unsigned char*> m_segments[MAX_SEGMENTS];
+
+		// kept on their own cache lines, every append writes both
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_reserved;
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_published;
+	};
+
+	//**********************************
+	// Destructor
+	//**********************************
+	template<typename Type, size_t FirstSegmentSize, typename Allocator>
+	concurrent_vector<Type, FirstSegmentSize, Allocator>::~concurrent_vector() noexcept
+	{
+		size_t count = m_reserved.load(std::memory_order_acquire);
+		for (size_t segment{ 0 }; segment < MAX_SEGMENTS; ++segment)
+		{
+			unsigned char* block = m_segments[segment].load(std::memory_order_acquire);
+			if (block == nullptr)
+				continue;
+
+			size_t start = segment_start(segment);
+			if (count > start)
+			{
+				size_t live = count - start;
+				destroy_range(reinterpret_cast<Type*>(block), live < segment_length(segment) ? live : segment_length(segment));
+			}
+			this->deallocate(block, segment_bytes(segment));
+		}
+	}
+
+	//**********************************
+	// Emplace back method
+	//**********************************
+	template<typename Type, size_t FirstSegmentSize, typename Allocator>
+	template<typename... Args>
+	size_t concurrent_vector<Type, FirstSegmentSize, Allocator>::emplace_back(Args&&... args) noexcept
+	{
+		size_t index = m_reserved.fetch_add(1, std::memory_order_acq_rel);
+		unsigned char* segment = acquire_segment(segment_of(index));
+		new (reinterpret_cast<Type*>(segment) + offset_of(index)) Type(std::forward<Args>(args)...);
+		publish(index);
+		return index;
+	}
+
+	//**********************************
+	// Reserve method
+	//**********************************
+	template<typename Type, size_t FirstSegmentSize, typename Allocator>
+	size_t concurrent_vector<Type, FirstSegmentSize, Allocator>::reserve(size_t size) noexcept
+	{
+		if (size == 0)
+			return 0;
+		size_t last = segment_of(size - 1);
+		for (size_t segment{ 0 }; segment <= last; ++segment)
+			acquire_segment(segment);
+		return segment_start(last) + segment_length(last);
+	}
+
+	//**********************************
+	// Segment getter
+	//**********************************
+	template<typename Type, size_t FirstSegmentSize, typename Allocator>
+	unsigned char* concurrent_vector<Type, FirstSegmentSize, Allocator>::acquire_segment(size_t segment) noexcept
+	{
+		assert(segment < MAX_SEGMENTS);
+		unsigned char* block = m_segments[segment].load(std::memory_order_acquire);
+		if (block != nullptr)
+			return block;
+
+		unsigned char* fresh = static_cast<unsigned char*>(this->allocate(segment_bytes(segment)));
+		assert(fresh != nullptr);
+		std::atomic<unsigned char>* flags = ready_flags(fresh, segment);
+		for (size_t index{ 0 }; index < segment_length(segment); ++index)
+			new (flags + index) std::atomic<unsigned char>(0);
+
+		if (m_segments[segment].compare_exchange_strong(block, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+			return fresh;
+
+		// another thread got there first, block now holds its segment
+		this->deallocate(fresh, segment_bytes(segment));
+		return block;
+	}
+
+	//**********************************
+	// Publish method
+	//**********************************
+	template<typename Type, size_t FirstSegmentSize, typename Allocator>
+	void concurrent_vector<Type, FirstSegmentSize, Allocator>::publish(size_t index) noexcept
+	{
+		size_t segment = segment_of(index);
+		ready_flags(m_segments[segment].load(std::memory_order_acquire), segment)[offset_of(index)].store(1, std::memory_order_release);
+
+		// Two neighbours publishing at once each store their own flag and
+		// then read the other's (through m_published or the flag itself).
+		// Release and acquire don't order a store before a later load, so
+		// both could miss and leave the count stuck below ready elements.
+		// The full fences here and before each re-read stop that
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// guess that every earlier element is already published
+		size_t published = index;
+		for (;;)
+		{
+			// stop at the first element that isn't ready, its owner will carry on
+			if (published != index)
+			{
+				if (published >= m_reserved.load(std::memory_order_acquire))
+					break;
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				segment = segment_of(published);
+				unsigned char* block = m_segments[segment].load(std::memory_order_acquire);
+				if (block == nullptr || ready_flags(block, segment)[offset_of(published)].load(std::memory_order_acquire) == 0)
+					break;
+			}
+
+			if (m_published.compare_exchange_weak(published, published + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+				++published;
+		}
+	}
+}
@@ -0,0 +1,618 @@
+//**************************************
+// cow_vector.h
+//
+// Holds nids::cow_vector, a copy on
+// write vector, and nids::cow_snapshot,
+// a read only handle to its contents.
+//
+// The elements live in one refcounted
+// block that copies of the vector share,
+// so copying is O(1). A write clones the
+// block first if anything else still
+// refers to it, so shared blocks are
+// never changed. That also means a
+// snapshot can be read from any thread
+// without a lock, while the vector it
+// came from carries on being written
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <utility>
+#include "span.h"
+#include "vector.h"
+
+namespace nids
+{
+	//**************************************
+	// Shared block header
+	//
+	// Sits at the front of every block,
+	// with the elements right after it
+	//**************************************
+	struct cow_header
+	{
+		// vectors and snapshots holding the block
+		std::atomic<size_t> refs;
+		size_t size;
+		size_t capacity;
+	};
+
+	//**************************************
+	// Header size helper
+	//
+	// The header rounded up so the
+	// elements after it are aligned
+	//**************************************
+	template<typename Type>
+	constexpr size_t cow_header_bytes() noexcept
+	{
+		return (sizeof(cow_header) + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+	}
+
+	//**************************************
+	// Block element getter
+	//**************************************
+	template<typename Type>
+	inline Type* cow_elements(cow_header* block) noexcept
+	{
+		return reinterpret_cast<Type*>(reinterpret_cast<unsigned char*>(block) + cow_header_bytes<Type>());
+	}
+
+	//**************************************
+	// Block release method
+	//
+	// Drops one reference to block, and
+	// destroys and frees it if that was
+	// the last one
+	//**************************************
+	template<typename Type, typename Allocator>
+	inline void cow_release(Allocator& allocator, cow_header* block) noexcept
+	{
+		if (block == nullptr || block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+		destroy_range(cow_elements<Type>(block), block->size);
+		size_t bytes = cow_header_bytes<Type>() + sizeof(Type) * block->capacity;
+		block->~cow_header();
+		allocator.deallocate(block, bytes);
+	}
+
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	class cow_vector;
+
+	//**************************************
+	// Snapshot
+	//
+	// Keeps the contents of a cow_vector
+	// as they were when it was taken. The
+	// block can't change while this holds
+	// it, so any number of threads can
+	// read it at once
+	//**************************************
+	template<typename Type, typename Allocator = default_allocator>
+	class cow_snapshot final : private Allocator
+	{
+	public:
+		using value_type = Type;
+		using const_iterator = const Type*;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline cow_snapshot() noexcept : Allocator(), m_block(nullptr) {}
+
+		//************************************
+		// Copy constructor
+		//************************************
+		inline cow_snapshot(const cow_snapshot& rhs) noexcept : Allocator(rhs), m_block(rhs.m_block)
+		{
+			if (m_block != nullptr)
+				m_block->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		//************************************
+		// Move constructor
+		//************************************
+		inline cow_snapshot(cow_snapshot&& rhs) noexcept : Allocator(rhs), m_block(rhs.m_block) { rhs.m_block = nullptr; }
+
+		//************************************
+		// Copy assignment operator
+		//************************************
+		inline cow_snapshot& operator=(const cow_snapshot& rhs) noexcept
+		{
+			// the copy lets go of our old block, with the allocator it came from
+			cow_snapshot copy(rhs);
+			std::swap(m_block, copy.m_block);
+			std::swap(static_cast<Allocator&>(*this), static_cast<Allocator&>(copy));
+			return *this;
+		}
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		inline cow_snapshot& operator=(cow_snapshot&& rhs) noexcept
+		{
+			std::swap(m_block, rhs.m_block);
+			std::swap(static_cast<Allocator&>(*this), static_cast<Allocator&>(rhs));
+			return *this;
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~cow_snapshot() noexcept { cow_release<Type>(static_cast<Allocator&>(*this), m_block); }
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_block != nullptr ? m_block->size : 0; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return size() == 0; }
+
+		//************************************
+		// Reference count getter
+		//
+		// Returns how many vectors and
+		// snapshots share the block
+		//************************************
+		inline size_t use_count() const noexcept { return m_block != nullptr ? m_block->refs.load(std::memory_order_relaxed) : 0; }
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept
+		{
+			assert(index < size());
+			return data()[index];
+		}
+
+		//************************************
+		// Array getter
+		//************************************
+		inline const Type* data() const noexcept { return m_block != nullptr ? cow_elements<Type>(m_block) : nullptr; }
+
+		//************************************
+		// Span getter
+		//************************************
+		inline span<const Type> view() const noexcept { return span<const Type>(data(), size()); }
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		inline const_iterator begin() const noexcept { return data(); }
+
+		//************************************
+		// End iterator getter
+		//************************************
+		inline const_iterator end() const noexcept { return data() + size(); }
+	private:
+		template<typename, typename, typename>
+		friend class cow_vector;
+
+		//************************************
+		// Sharing constructor
+		//
+		// Takes a new reference to block
+		//************************************
+		inline cow_snapshot(const Allocator& allocator, cow_header* block) noexcept : Allocator(allocator), m_block(block)
+		{
+			if (m_block != nullptr)
+				m_block->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		cow_header* m_block;
+	};
+
+	template<typename Type, typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class cow_vector final : private Allocator
+	{
+		static_assert(alignof(Type) <= alignof(max_align_t), "cow_vector blocks are only aligned like malloc's");
+	public:
+		using value_type = Type;
+		using iterator = Type*;
+		using const_iterator = const Type*;
+		using growth_policy = GrowthPolicy;
+		using allocator_type = Allocator;
+		using snapshot_type = cow_snapshot<Type, Allocator>;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline cow_vector() noexcept : Allocator(), m_block(nullptr) {}
+
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit cow_vector(const Allocator& allocator) noexcept : Allocator(allocator), m_block(nullptr) {}
+
+		//************************************
+		// Snapshot constructor
+		//
+		// Shares the snapshot's block, O(1)
+		//************************************
+		inline explicit cow_vector(const snapshot_type& snapshot) noexcept
+			: Allocator(static_cast<const Allocator&>(snapshot)), m_block(snapshot.m_block)
+		{
+			retain();
+		}
+
+		//************************************
+		// Copy constructor
+		//
+		// Shares rhs's block, O(1)
+		//************************************
+		inline cow_vector(const cow_vector& rhs) noexcept : Allocator(rhs), m_block(rhs.m_block) { retain(); }
+
+		//************************************
+		// Move constructor
+		//************************************
+		inline cow_vector(cow_vector&& rhs) noexcept : Allocator(rhs), m_block(rhs.m_block) { rhs.m_block = nullptr; }
+
+		//************************************
+		// Copy assignment operator
+		//************************************
+		inline cow_vector& operator=(const cow_vector& rhs) noexcept
+		{
+			cow_vector copy(rhs);
+			swap(copy);
+			return *this;
+		}
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		inline cow_vector& operator=(cow_vector&& rhs) noexcept
+		{
+			swap(rhs);
+			return *this;
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~cow_vector() noexcept { cow_release<Type>(static_cast<Allocator&>(*this), m_block); }
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_block != nullptr ? m_block->size : 0; }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_block != nullptr ? m_block->capacity : 0; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return size() == 0; }
+
+		//************************************
+		// Reference count getter
+		//
+		// Returns how many vectors and
+		// snapshots share the block
+		//************************************
+		inline size_t use_count() const noexcept { return m_block != nullptr ? m_block->refs.load(std::memory_order_relaxed) : 0; }
+
+		//************************************
+		// Shared status getter
+		//
+		// True if the next write will have
+		// to clone the block
+		//************************************
+		inline bool is_shared() const noexcept
+		{
+			// acquire, so readers that let go are done before we write
+			return m_block != nullptr && m_block->refs.load(std::memory_order_acquire) > 1;
+		}
+
+		//************************************
+		// Allocator getter
+		//************************************
+		inline const Allocator& get_allocator() const noexcept { return *this; }
+
+		//************************************
+		// Const correct subscript operator
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept
+		{
+			assert(index < size());
+			return cdata()[index];
+		}
+
+		//************************************
+		// Subscript operator
+		//
+		// Clones the block if it is shared,
+		// use the const version (or cdata)
+		// to read without that
+		//************************************
+		inline Type& operator[](size_t index) noexcept
+		{
+			assert(index < size());
+			return data()[index];
+		}
+
+		//************************************
+		// Array getter (const correct)
+		//************************************
+		inline const Type* data() const noexcept { return cdata(); }
+
+		//************************************
+		// Read only array getter
+		//
+		// Never clones, even on a non const
+		// vector
+		//************************************
+		inline const Type* cdata() const noexcept { return m_block != nullptr ? cow_elements<Type>(m_block) : nullptr; }
+
+		//************************************
+		// Array getter
+		//
+		// Clones the block if it is shared
+		//************************************
+		inline Type* data() noexcept
+		{
+			if (is_shared())
+				clone(m_block->capacity);
+			return m_block != nullptr ? cow_elements<Type>(m_block) : nullptr;
+		}
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		inline const_iterator begin() const noexcept { return cdata(); }
+		inline iterator begin() noexcept { return data(); }
+
+		//************************************
+		// End iterator getter
+		//************************************
+		inline const_iterator end() const noexcept { return cdata() + size(); }
+		inline iterator end() noexcept { return data() + size(); }
+
+		//************************************
+		// Snapshot method
+		//
+		// Returns a read only handle to the
+		// current contents, O(1). Later
+		// writes to this vector clone the
+		// block instead of changing it
+		//************************************
+		inline snapshot_type snapshot() const noexcept { return snapshot_type(*this, m_block); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Push back method
+		//************************************
+		inline void push_back(const Type& data) noexcept { emplace_back(data); }
+
+		//************************************
+		// Push back method (rvalue)
+		//************************************
+		inline void push_back(Type&& data) noexcept { emplace_back(std::move(data)); }
+
+		//************************************
+		// Emplace back method
+		//
+		// Constructs a new element at the
+		// end of the vector from args. Args
+		// may come from the vector itself
+		//************************************
+		template<typename... Args>
+		Type& emplace_back(Args&&... args) noexcept;
+
+		//************************************
+		// Pop back method
+		//************************************
+		void pop_back() noexcept;
+
+		//************************************
+		// Clear method
+		//
+		// A shared block is just let go of
+		// rather than cloned
+		//************************************
+		void clear() noexcept;
+
+		//************************************
+		// Reserve method
+		//
+		// Grows the capacity to at least
+		// size, never shrinks it
+		//
+		// Returns the new capacity
+		//************************************
+		size_t reserve(size_t size) noexcept;
+
+		//************************************
+		// Swap method
+		//************************************
+		inline void swap(cow_vector& rhs) noexcept
+		{
+			std::swap(m_block, rhs.m_block);
+			std::swap(static_cast<Allocator&>(*this), static_cast<Allocator&>(rhs));
+		}
+	private:
+		//************************************
+		// Retain method
+		//************************************
+		inline void retain() noexcept
+		{
+			if (m_block != nullptr)
+				m_block->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		//************************************
+		// Block size helper
+		//************************************
+		static inline size_t block_bytes(size_t capacity) noexcept { return cow_header_bytes<Type>() + sizeof(Type) * capacity; }
+
+		//************************************
+		// Clone method
+		//
+		// Copies the elements into a block
+		// of its own with room for capacity
+		// of them and lets go of the shared
+		// one
+		//************************************
+		void clone(size_t capacity) noexcept;
+
+		//************************************
+		// Grow method
+		//
+		// Grows a block nothing else shares
+		// to capacity elements
+		//************************************
+		void grow(size_t capacity) noexcept;
+
+		cow_header* m_block;
+	};
+
+	//**********************************
+	// Emplace back method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	template<typename... Args>
+	Type& cow_vector<Type, GrowthPolicy, Allocator>::emplace_back(Args&&... args) noexcept
+	{
+		size_t count = size();
+		if (count < capacity() && !is_shared())
+		{
+			Type* element = new (cow_elements<Type>(m_block) + count) Type(std::forward<Args>(args)...);
+			++m_block->size;
+			return *element;
+		}
+
+		// args may point into the block that is about to move, so build the element first
+		Type value(std::forward<Args>(args)...);
+		size_t grown = count == capacity() ? GrowthPolicy::next_capacity(capacity(), sizeof(Type)) : capacity();
+		if (is_shared())
+			clone(grown);
+		else
+			grow(grown);
+
+		Type* element = new (cow_elements<Type>(m_block) + count) Type(std::move(value));
+		++m_block->size;
+		return *element;
+	}
+
+	//**********************************
+	// Pop back method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	void cow_vector<Type, GrowthPolicy, Allocator>::pop_back() noexcept
+	{
+		assert(size() > 0);
+		if (is_shared())
+			clone(m_block->capacity);
+		--m_block->size;
+		cow_elements<Type>(m_block)[m_block->size].~Type();
+	}
+
+	//**********************************
+	// Clear method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	void cow_vector<Type, GrowthPolicy, Allocator>::clear() noexcept
+	{
+		if (m_block == nullptr)
+			return;
+		if (is_shared())
+		{
+			cow_release<Type>(static_cast<Allocator&>(*this), m_block);
+			m_block = nullptr;
+			return;
+		}
+		destroy_range(cow_elements<Type>(m_block), m_block->size);
+		m_block->size = 0;
+	}
+
+	//**********************************
+	// Reserve method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	size_t cow_vector<Type, GrowthPolicy, Allocator>::reserve(size_t size) noexcept
+	{
+		if (size <= capacity())
+			return capacity();
+		if (is_shared())
+			clone(size);
+		else
+			grow(size);
+		return capacity();
+	}
+
+	//**********************************
+	// Clone method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	void cow_vector<Type, GrowthPolicy, Allocator>::clone(size_t capacity) noexcept
+	{
+		size_t count = size();
+		assert(capacity >= count && capacity > 0);
+
+		cow_header* fresh = static_cast<cow_header*>(this->allocate(block_bytes(capacity)));
+		assert(fresh != nullptr);
+		new (fresh) cow_header{ { 1 }, count, capacity };
+		copy_range(cow_elements<Type>(fresh), cdata(), count);
+
+		cow_release<Type>(static_cast<Allocator&>(*this), m_block);
+		m_block = fresh;
+	}
+
+	//**********************************
+	// Grow method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	void cow_vector<Type, GrowthPolicy, Allocator>::grow(size_t capacity) noexcept
+	{
+		assert(capacity > 0);
+		if (m_block == nullptr)
+		{
+			m_block = static_cast<cow_header*>(this->allocate(block_bytes(capacity)));
+			assert(m_block != nullptr);
+			new (m_block) cow_header{ { 1 }, 0, capacity };
+			return;
+		}
+
+		// nothing else can see the block, so the header can move bitwise with the elements
+		size_t oldBytes = block_bytes(m_block->capacity);
+		if constexpr (is_trivially_relocatable_v<Type>)
+		{
+			cow_header* grown = static_cast<cow_header*>(this->reallocate(m_block, oldBytes, block_bytes(capacity)));
+			assert(grown != nullptr);
+			m_block = grown;
+			m_block->capacity = capacity;
+		}
+		else
+		{
+			if (this->expand(m_block, oldBytes, block_bytes(capacity)))
+			{
+				m_block->capacity = capacity;
+				return;
+			}
+
+			cow_header* fresh = static_cast<cow_header*>(this->allocate(block_bytes(capacity)));
+			assert(fresh != nullptr);
+			new (fresh) cow_header{ { 1 }, m_block->size, capacity };
+			relocate_range(cow_elements<Type>(fresh), cow_elements<Type>(m_block), m_block->size);
+			m_block->~cow_header();
+			this->deallocate(m_block, oldBytes);
+			m_block = fresh;
+		}
+	}
+}
@@ -0,0 +1,1173 @@
+//**************************************
+// flat_hash_map.h
+//
+// Holds nids::flat_hash_set and
+// nids::flat_hash_map, open addressing
+// hash containers in the Swiss table
+// style.
+//
+// Every slot has a control byte saying
+// whether it is empty, erased, or full,
+// and for full slots 7 bits of the
+// key's hash. A lookup loads 16 control
+// bytes at once and compares them all
+// against those bits with SSE2, so it
+// only touches the slots whose bits
+// match, usually just the one it wants.
+// The control bytes and the slots share
+// a single allocation from the
+// library's allocators, so there is no
+// allocation per element
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "allocator.h"
+#include "relocation.h"
+#include "simd.h"
+
+// SSE2 is part of x86-64, and 32 bit builds only have it when asked for
+#if defined(NIDS_SIMD_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define NIDS_HASH_SSE2 1
+#endif
+
+namespace nids
+{
+	//**************************************
+	// Hash mixing method
+	//
+	// Scatters the bits of value across
+	// the whole word. std::hash is the
+	// identity for integers on the common
+	// standard libraries, which would put
+	// sequential keys in the same control
+	// bits and the same probe groups
+	//**************************************
+	inline uint64_t hash_mix(uint64_t value) noexcept
+	{
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		value *= 0xc4ceb9fe1a85ec53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+	//**************************************
+	// Hash
+	//
+	// The default hasher for the hash
+	// containers, std::hash run through
+	// hash_mix
+	//**************************************
+	template<typename Key>
+	struct hash
+	{
+		inline size_t operator()(const Key& key) const noexcept
+		{
+			return static_cast<size_t>(hash_mix(static_cast<uint64_t>(std::hash<Key>()(key))));
+		}
+	};
+
+	//**************************************
+	// Hash control bytes
+	//
+	// Full slots hold 0 to 127, the low 7
+	// bits of their hash, so the sign bit
+	// alone tells full from not full
+	//**************************************
+	enum HashControl : int8_t
+	{
+		HASH_EMPTY = -128,
+		HASH_DELETED = -2
+	};
+
+	//**************************************
+	// Hash group
+	//
+	// 16 control bytes loaded together.
+	// Each match method returns a bit mask
+	// with bit i set when byte i matches
+	//**************************************
+	class hash_group final
+	{
+	public:
+		// control bytes probed at once
+		static constexpr size_t WIDTH = 16;
+
+		//******************************
+		// Constructor
+		//
+		// Loads WIDTH bytes from
+		// control, which need not be
+		// aligned
+		//******************************
+		inline explicit hash_group(const int8_t* control) noexcept
+		{
+#ifdef NIDS_HASH_SSE2
+			m_control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(control));
+#else
+			memcpy(m_control, control, WIDTH);
+#endif
+		}
+
+		//******************************
+		// Hash bits match method
+		//******************************
+		inline uint32_t match(int8_t bits) const noexcept
+		{
+#ifdef NIDS_HASH_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(bits), m_control)));
+#else
+			uint32_t mask{ 0 };
+			for (size_t index{ 0 }; index < WIDTH; ++index)
+				mask |= static_cast<uint32_t>(m_control[index] == bits) << index;
+			return mask;
+#endif
+		}
+
+		//******************************
+		// Empty match method
+		//******************************
+		inline uint32_t match_empty() const noexcept { return match(HASH_EMPTY); }
+
+		//******************************
+		// Not full match method
+		//
+		// Matches empty and deleted
+		// bytes, the ones with the
+		// sign bit set
+		//******************************
+		inline uint32_t match_not_full() const noexcept
+		{
+#ifdef NIDS_HASH_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(m_control));
+#else
+			uint32_t mask{ 0 };
+			for (size_t index{ 0 }; index < WIDTH; ++index)
+				mask |= static_cast<uint32_t>(m_control[index] < 0) << index;
+			return mask;
+#endif
+		}
+
+		//******************************
+		// Full match method
+		//******************************
+		inline uint32_t match_full() const noexcept { return ~match_not_full() & 0xFFFF; }
+	private:
+#ifdef NIDS_HASH_SSE2
+		__m128i m_control;
+#else
+		int8_t m_control[WIDTH];
+#endif
+	};
+
+	//**************************************
+	// Hash table
+	//
+	// The open addressing table under
+	// flat_hash_set and flat_hash_map,
+	// working in slot indexes. Policy
+	// gives the slot type and how to get
+	// a key out of a slot
+	//
+	// The capacity is a power of two, at
+	// least hash_group::WIDTH. The control
+	// bytes are followed by a copy of
+	// their first WIDTH bytes, so a group
+	// can be loaded at any slot without
+	// wrapping. Lookups probe groups in
+	// triangular steps from the hash's
+	// home slot, and stop at the first
+	// group holding an empty byte
+	//
+	// At most 7/8 of the slots are used
+	// before the table grows, so every
+	// lookup ends at an empty byte
+	//**************************************
+	template<typename Policy, typename Hash, typename Equal, typename Allocator>
+	class hash_table final : private Allocator
+	{
+	public:
+		using key_type = typename Policy::key_type;
+		using slot_type = typename Policy::slot_type;
+
+		static_assert(alignof(slot_type) <= alignof(max_align_t));
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//************************************
+		inline explicit hash_table(const Hash& hash = Hash(), const Equal& equal = Equal(), const Allocator& allocator = Allocator()) noexcept
+			: Allocator(allocator), m_hash(hash), m_equal(equal), m_control(nullptr), m_slots(nullptr), m_size(0), m_capacity(0), m_growthLeft(0) {}
+
+		//************************************
+		// Copy constructor
+		//
+		// Keeps rhs's layout, so nothing
+		// is rehashed
+		//************************************
+		inline hash_table(const hash_table& rhs) noexcept
+			: Allocator(rhs), m_hash(rhs.m_hash), m_equal(rhs.m_equal), m_control(nullptr), m_slots(nullptr), m_size(0), m_capacity(0), m_growthLeft(0)
+		{
+			copy_from(rhs);
+		}
+
+		//************************************
+		// Move constructor
+		//************************************
+		inline hash_table(hash_table&& rhs) noexcept
+			: Allocator(std::move(rhs)), m_hash(std::move(rhs.m_hash)), m_equal(std::move(rhs.m_equal)),
+			m_control(rhs.m_control), m_slots(rhs.m_slots), m_size(rhs.m_size), m_capacity(rhs.m_capacity), m_growthLeft(rhs.m_growthLeft)
+		{
+			rhs.forget();
+		}
+
+		//************************************
+		// Copy assignment operator
+		//************************************
+		inline hash_table& operator=(const hash_table& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				static_cast<Allocator&>(*this) = static_cast<const Allocator&>(rhs);
+				m_hash = rhs.m_hash;
+				m_equal = rhs.m_equal;
+				copy_from(rhs);
+			}
+			return *this;
+		}
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		inline hash_table& operator=(hash_table&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(rhs));
+				m_hash = std::move(rhs.m_hash);
+				m_equal = std::move(rhs.m_equal);
+				m_control = rhs.m_control;
+				m_slots = rhs.m_slots;
+				m_size = rhs.m_size;
+				m_capacity = rhs.m_capacity;
+				m_growthLeft = rhs.m_growthLeft;
+				rhs.forget();
+			}
+			return *this;
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~hash_table() noexcept { release(); }
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Capacity accessor
+		//
+		// Slot count, also the index find
+		// returns for a missing key
+		//************************************
+		inline size_t capacity() const noexcept { return m_capacity; }
+
+		//************************************
+		// Hasher getter
+		//************************************
+		inline const Hash& hash_function() const noexcept { return m_hash; }
+
+		//************************************
+		// Equality getter
+		//************************************
+		inline const Equal& key_eq() const noexcept { return m_equal; }
+
+		//************************************
+		// Slot getters
+		//************************************
+		inline slot_type& slot(size_t index) noexcept
+		{
+			assert(index < m_capacity && m_control[index] >= 0);
+			return m_slots[index];
+		}
+		inline const slot_type& slot(size_t index) const noexcept
+		{
+			assert(index < m_capacity && m_control[index] >= 0);
+			return m_slots[index];
+		}
+
+		//************************************
+		// Next full slot method
+		//
+		// Returns the first full slot at
+		// or after index, or capacity()
+		//************************************
+		inline size_t next_full(size_t index) const noexcept
+		{
+			for (; index < m_capacity; index += hash_group::WIDTH)
+			{
+				uint32_t full = hash_group(m_control + index).match_full();
+				// the bytes past the end are copies of the first ones
+				if (m_capacity - index < hash_group::WIDTH)
+					full &= (1u << (m_capacity - index)) - 1;
+				if (full != 0)
+					return index + count_trailing_zeros(full);
+			}
+			return m_capacity;
+		}
+
+		//************************************
+		// Find method
+		//
+		// Returns the slot holding key,
+		// or capacity() if there is none
+		//************************************
+		inline size_t find(const key_type& key) const noexcept
+		{
+			if (m_size == 0)
+				return m_capacity;
+			return find(key, m_hash(key));
+		}
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Emplace method
+		//
+		// Returns key's slot and true if
+		// it was missing and a slot was
+		// built from arguments, or false
+		// if it was already there
+		//
+		// Growing moves the slots, so
+		// arguments must not refer into
+		// the table
+		//************************************
+		template<typename... Arguments>
+		inline std::pair<size_t, bool> emplace(const key_type& key, Arguments&&... arguments) noexcept
+		{
+			size_t hash = m_hash(key);
+			if (m_size > 0)
+			{
+				size_t found = find(key, hash);
+				if (found != m_capacity)
+					return { found, false };
+			}
+
+			// reuse an erased slot on the way, but grow instead of using up the last empty ones
+			size_t index = m_capacity > 0 ? find_not_full(hash) : 0;
+			if (m_capacity == 0 || (m_growthLeft == 0 && m_control[index] == HASH_EMPTY))
+			{
+				grow();
+				index = find_not_full(hash);
+			}
+			if (m_control[index] == HASH_EMPTY)
+				--m_growthLeft;
+			set_control(index, static_cast<int8_t>(hash & 0x7F));
+			new (m_slots + index) slot_type(std::forward<Arguments>(arguments)...);
+			++m_size;
+			return { index, true };
+		}
+
+		//************************************
+		// Erase method
+		//
+		// Destroys the full slot at index
+		//
+		// The slot goes back to empty when
+		// every group that covers it still
+		// had an empty byte, since then no
+		// probe ever went past it. Only
+		// otherwise does it become a
+		// tombstone that lookups step over
+		//************************************
+		inline void erase(size_t index) noexcept
+		{
+			assert(index < m_capacity && m_control[index] >= 0);
+			m_slots[index].~slot_type();
+			--m_size;
+
+			// the empty bytes nearest index on either side
+			uint32_t emptyBefore = hash_group(m_control + ((index - hash_group::WIDTH) & (m_capacity - 1))).match_empty();
+			uint32_t emptyAfter = hash_group(m_control + index).match_empty();
+			bool neverFull = emptyBefore != 0 && emptyAfter != 0
+				&& count_trailing_zeros(emptyAfter) + (count_leading_zeros(emptyBefore) - 48) < hash_group::WIDTH;
+
+			set_control(index, neverFull ? HASH_EMPTY : HASH_DELETED);
+			if (neverFull)
+				++m_growthLeft;
+		}
+
+		//************************************
+		// Reserve method
+		//
+		// Makes room for size elements
+		// without growing again
+		//
+		// Returns the capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			if (size > m_size + m_growthLeft)
+				rehash(capacity_for(size));
+			return m_capacity;
+		}
+
+		//************************************
+		// Clear method
+		//
+		// Destroys every element, keeping
+		// the slots for reuse
+		//************************************
+		inline void clear() noexcept
+		{
+			if (m_capacity == 0)
+				return;
+			destroy_slots();
+			memset(m_control, HASH_EMPTY, m_capacity + hash_group::WIDTH);
+			m_size = 0;
+			m_growthLeft = max_load(m_capacity);
+		}
+	private:
+		//************************************
+		// Hashed find method
+		//************************************
+		inline size_t find(const key_type& key, size_t hash) const noexcept
+		{
+			const int8_t bits = static_cast<int8_t>(hash & 0x7F);
+			const size_t mask = m_capacity - 1;
+			size_t position = (hash >> 7) & mask;
+			for (size_t step{ hash_group::WIDTH };; step += hash_group::WIDTH)
+			{
+				hash_group group(m_control + position);
+				for (uint32_t match = group.match(bits); match != 0; match &= match - 1)
+				{
+					size_t index = (position + count_trailing_zeros(match)) & mask;
+					if (m_equal(Policy::key(m_slots[index]), key))
+						return index;
+				}
+				if (group.match_empty() != 0)
+					return m_capacity;
+				assert(step <= m_capacity);
+				position = (position + step) & mask;
+			}
+		}
+
+		//************************************
+		// Not full find method
+		//
+		// Returns the first empty or
+		// erased slot along hash's probe
+		// sequence
+		//************************************
+		inline size_t find_not_full(size_t hash) const noexcept
+		{
+			const size_t mask = m_capacity - 1;
+			size_t position = (hash >> 7) & mask;
+			for (size_t step{ hash_group::WIDTH };; step += hash_group::WIDTH)
+			{
+				uint32_t notFull = hash_group(m_control + position).match_not_full();
+				if (notFull != 0)
+					return (position + count_trailing_zeros(notFull)) & mask;
+				assert(step <= m_capacity);
+				position = (position + step) & mask;
+			}
+		}
+
+		//************************************
+		// Control setter method
+		//
+		// Keeps the copy of the first
+		// bytes in step
+		//************************************
+		inline void set_control(size_t index, int8_t control) noexcept
+		{
+			m_control[index] = control;
+			if (index < hash_group::WIDTH)
+				m_control[m_capacity + index] = control;
+		}
+
+		//************************************
+		// Maximum load method
+		//
+		// Full slots allowed at capacity
+		//************************************
+		static inline size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+		//************************************
+		// Capacity for size method
+		//************************************
+		static inline size_t capacity_for(size_t size) noexcept
+		{
+			size_t capacity{ hash_group::WIDTH };
+			while (max_load(capacity) < size)
+				capacity *= 2;
+			return capacity;
+		}
+
+		//************************************
+		// Slot offset method
+		//
+		// Where the slots start in the
+		// allocation, after the control
+		// bytes
+		//************************************
+		static inline size_t slot_offset(size_t capacity) noexcept
+		{
+			size_t offset = capacity + hash_group::WIDTH;
+			return (offset + alignof(slot_type) - 1) / alignof(slot_type) * alignof(slot_type);
+		}
+
+		//************************************
+		// Allocation size method
+		//************************************
+		static inline size_t allocation_bytes(size_t capacity) noexcept { return slot_offset(capacity) + sizeof(slot_type) * capacity; }
+
+		//************************************
+		// Growth method
+		//
+		// Out of empty slots. When at
+		// least 3/32 of the slots are
+		// tombstones the table is rebuilt
+		// at the same size to sweep them,
+		// which takes that many inserts to
+		// happen again, otherwise it
+		// doubles
+		//************************************
+		inline void grow() noexcept
+		{
+			if (m_capacity == 0)
+				rehash(hash_group::WIDTH);
+			else
+				rehash(m_size <= m_capacity / 32 * 25 ? m_capacity : m_capacity * 2);
+		}
+
+		//************************************
+		// Rehash method
+		//
+		// Moves every element into a new
+		// table of capacity slots
+		//************************************
+		inline void rehash(size_t capacity) noexcept
+		{
+			assert(capacity >= hash_group::WIDTH && (capacity & (capacity - 1)) == 0 && max_load(capacity) >= m_size);
+			int8_t* oldControl = m_control;
+			slot_type* oldSlots = m_slots;
+			size_t oldCapacity = m_capacity;
+
+			allocate_table(capacity);
+			m_growthLeft = max_load(capacity) - m_size;
+			for (size_t index{ 0 }; index < oldCapacity; ++index)
+				if (oldControl[index] >= 0)
+				{
+					size_t hash = m_hash(Policy::key(oldSlots[index]));
+					size_t target = find_not_full(hash);
+					set_control(target, static_cast<int8_t>(hash & 0x7F));
+					relocate_range(m_slots + target, oldSlots + index, 1);
+				}
+
+			if (oldCapacity > 0)
+				this->deallocate(oldControl, allocation_bytes(oldCapacity));
+		}
+
+		//************************************
+		// Table allocation method
+		//
+		// Points the table at a new, all
+		// empty allocation of capacity
+		// slots
+		//************************************
+		inline void allocate_table(size_t capacity) noexcept
+		{
+			m_control = static_cast<int8_t*>(this->allocate(allocation_bytes(capacity)));
+			assert(m_control != nullptr);
+			m_slots = reinterpret_cast<slot_type*>(reinterpret_cast<char*>(m_control) + slot_offset(capacity));
+			m_capacity = capacity;
+			memset(m_control, HASH_EMPTY, capacity + hash_group::WIDTH);
+		}
+
+		//************************************
+		// Copy method
+		//
+		// Copies rhs into this empty table
+		//************************************
+		inline void copy_from(const hash_table& rhs) noexcept
+		{
+			if (rhs.m_capacity == 0)
+				return;
+			allocate_table(rhs.m_capacity);
+			memcpy(m_control, rhs.m_control, m_capacity + hash_group::WIDTH);
+			for (size_t index = rhs.next_full(0); index < m_capacity; index = rhs.next_full(index + 1))
+				new (m_slots + index) slot_type(rhs.m_slots[index]);
+			m_size = rhs.m_size;
+			m_growthLeft = rhs.m_growthLeft;
+		}
+
+		//************************************
+		// Slot destruction method
+		//************************************
+		inline void destroy_slots() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<slot_type>)
+				for (size_t index = next_full(0); index < m_capacity; index = next_full(index + 1))
+					m_slots[index].~slot_type();
+		}
+
+		//************************************
+		// Release method
+		//
+		// Destroys everything and frees
+		// the allocation
+		//************************************
+		inline void release() noexcept
+		{
+			if (m_capacity == 0)
+				return;
+			destroy_slots();
+			this->deallocate(m_control, allocation_bytes(m_capacity));
+			forget();
+		}
+
+		//************************************
+		// Forget method
+		//
+		// Empties the table without
+		// touching the allocation
+		//************************************
+		inline void forget() noexcept
+		{
+			m_control = nullptr;
+			m_slots = nullptr;
+			m_size = 0;
+			m_capacity = 0;
+			m_growthLeft = 0;
+		}
+
+		Hash m_hash;
+		Equal m_equal;
+		int8_t* m_control;
+		slot_type* m_slots;
+		size_t m_size;
+		size_t m_capacity;
+		// empty slots that may still be filled before growing
+		size_t m_growthLeft;
+	};
+
+	//**************************************
+	// Hash set policy
+	//**************************************
+	template<typename Key>
+	struct hash_set_policy
+	{
+		using key_type = Key;
+		using slot_type = Key;
+		static inline const Key& key(const slot_type& slot) noexcept { return slot; }
+	};
+
+	//**************************************
+	// Hash map policy
+	//**************************************
+	template<typename Key, typename Value>
+	struct hash_map_policy
+	{
+		using key_type = Key;
+		using slot_type = std::pair<Key, Value>;
+		static inline const Key& key(const slot_type& slot) noexcept { return slot.first; }
+	};
+
+	template<typename Container>
+	class flat_hash_iterator;
+
+	//**************************************
+	// Flat hash set
+	//
+	// Unordered set of unique keys.
+	// Iteration order is the slot order,
+	// which changes when the set grows
+	//
+	// Inserting may move every key, so it
+	// invalidates iterators and
+	// references. Erasing only
+	// invalidates the erased one
+	//**************************************
+	template<typename Key, typename Hash = hash<Key>, typename Equal = std::equal_to<Key>, typename Allocator = default_allocator>
+	class flat_hash_set final
+	{
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using hasher = Hash;
+		using key_equal = Equal;
+		using allocator_type = Allocator;
+		using iterator = flat_hash_iterator<const flat_hash_set>;
+		using const_iterator = iterator;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//************************************
+		inline explicit flat_hash_set(const Hash& hash = Hash(), const Equal& equal = Equal(), const Allocator& allocator = Allocator()) noexcept
+			: m_table(hash, equal, allocator) {}
+
+		//************************************
+		// Range constructor
+		//************************************
+		template<typename Iterator>
+		inline flat_hash_set(Iterator first, Iterator last, const Hash& hash = Hash(), const Equal& equal = Equal(), const Allocator& allocator = Allocator()) noexcept
+			: m_table(hash, equal, allocator)
+		{
+			insert(first, last);
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_table.size(); }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_table.capacity(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_table.size() == 0; }
+
+		//************************************
+		// Hasher getter
+		//************************************
+		inline const Hash& hash_function() const noexcept { return m_table.hash_function(); }
+
+		//************************************
+		// Equality getter
+		//************************************
+		inline const Equal& key_eq() const noexcept { return m_table.key_eq(); }
+
+		//************************************
+		// Begin/end getters
+		//************************************
+		inline iterator begin() const noexcept { return iterator(this, m_table.next_full(0)); }
+		inline iterator end() const noexcept { return iterator(this, m_table.capacity()); }
+
+		//************************************
+		// Find method
+		//************************************
+		inline iterator find(const Key& key) const noexcept { return iterator(this, m_table.find(key)); }
+
+		//************************************
+		// Contains method
+		//************************************
+		inline bool contains(const Key& key) const noexcept { return m_table.find(key) != m_table.capacity(); }
+
+		//************************************
+		// Count method
+		//************************************
+		inline size_t count(const Key& key) const noexcept { return contains(key) ? 1 : 0; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Insert method
+		//
+		// Returns key's position and
+		// whether it was added
+		//************************************
+		inline std::pair<iterator, bool> insert(const Key& key) noexcept
+		{
+			std::pair<size_t, bool> inserted = m_table.emplace(key, key);
+			return { iterator(this, inserted.first), inserted.second };
+		}
+
+		//************************************
+		// Range insert method
+		//************************************
+		template<typename Iterator>
+		inline void insert(Iterator first, Iterator last) noexcept
+		{
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+				m_table.reserve(size() + static_cast<size_t>(std::distance(first, last)));
+			for (; first != last; ++first)
+				m_table.emplace(*first, *first);
+		}
+
+		//************************************
+		// Erase methods
+		//
+		// The iterator version returns the
+		// position after the erased key
+		//************************************
+		inline size_t erase(const Key& key) noexcept
+		{
+			size_t index = m_table.find(key);
+			if (index == m_table.capacity())
+				return 0;
+			m_table.erase(index);
+			return 1;
+		}
+		inline iterator erase(iterator position) noexcept
+		{
+			m_table.erase(position.index());
+			return iterator(this, m_table.next_full(position.index() + 1));
+		}
+
+		//************************************
+		// Reserve method
+		//
+		// Makes room for size keys
+		//
+		// Returns the capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept { return m_table.reserve(size); }
+
+		//************************************
+		// Clear method
+		//
+		// Keeps the slots for reuse
+		//************************************
+		inline void clear() noexcept { m_table.clear(); }
+
+		//*******************[ Iterator Hooks ]
+		//************************************
+		// Entry getter
+		//************************************
+		inline const Key& entry(size_t index) const noexcept { return m_table.slot(index); }
+
+		//************************************
+		// Next entry method
+		//************************************
+		inline size_t next_index(size_t index) const noexcept { return m_table.next_full(index); }
+	private:
+		hash_table<hash_set_policy<Key>, Hash, Equal, Allocator> m_table;
+	};
+
+	//**************************************
+	// Flat hash map
+	//
+	// Unordered map from unique keys to
+	// values, each pair stored in a slot.
+	// Dereferencing an iterator gives a
+	// pair of references, like flat_map
+	//
+	// Inserting may move every entry, so
+	// it invalidates iterators and
+	// references. Erasing only
+	// invalidates the erased one
+	//**************************************
+	template<typename Key, typename Value, typename Hash = hash<Key>, typename Equal = std::equal_to<Key>, typename Allocator = default_allocator>
+	class flat_hash_map final
+	{
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key, Value>;
+		using hasher = Hash;
+		using key_equal = Equal;
+		using allocator_type = Allocator;
+		using reference = std::pair<const Key&, Value&>;
+		using const_reference = std::pair<const Key&, const Value&>;
+		using iterator = flat_hash_iterator<flat_hash_map>;
+		using const_iterator = flat_hash_iterator<const flat_hash_map>;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//************************************
+		inline explicit flat_hash_map(const Hash& hash = Hash(), const Equal& equal = Equal(), const Allocator& allocator = Allocator()) noexcept
+			: m_table(hash, equal, allocator) {}
+
+		//************************************
+		// Range constructor
+		//
+		// Takes anything whose elements have
+		// first and second. The first of
+		// repeated keys wins
+		//************************************
+		template<typename Iterator>
+		inline flat_hash_map(Iterator first, Iterator last, const Hash& hash = Hash(), const Equal& equal = Equal(), const Allocator& allocator = Allocator()) noexcept
+			: m_table(hash, equal, allocator)
+		{
+			insert(first, last);
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_table.size(); }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_table.capacity(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_table.size() == 0; }
+
+		//************************************
+		// Hasher getter
+		//************************************
+		inline const Hash& hash_function() const noexcept { return m_table.hash_function(); }
+
+		//************************************
+		// Equality getter
+		//************************************
+		inline const Equal& key_eq() const noexcept { return m_table.key_eq(); }
+
+		//************************************
+		// Begin/end getters
+		//************************************
+		inline iterator begin() noexcept { return iterator(this, m_table.next_full(0)); }
+		inline iterator end() noexcept { return iterator(this, m_table.capacity()); }
+		inline const_iterator begin() const noexcept { return const_iterator(this, m_table.next_full(0)); }
+		inline const_iterator end() const noexcept { return const_iterator(this, m_table.capacity()); }
+
+		//************************************
+		// Find methods
+		//************************************
+		inline iterator find(const Key& key) noexcept { return iterator(this, m_table.find(key)); }
+		inline const_iterator find(const Key& key) const noexcept { return const_iterator(this, m_table.find(key)); }
+
+		//************************************
+		// Value getters
+		//
+		// Return a pointer to key's value,
+		// or nullptr if key is missing
+		//************************************
+		inline Value* get(const Key& key) noexcept
+		{
+			size_t index = m_table.find(key);
+			return index != m_table.capacity() ? &m_table.slot(index).second : nullptr;
+		}
+		inline const Value* get(const Key& key) const noexcept
+		{
+			size_t index = m_table.find(key);
+			return index != m_table.capacity() ? &m_table.slot(index).second : nullptr;
+		}
+
+		//************************************
+		// Contains method
+		//************************************
+		inline bool contains(const Key& key) const noexcept { return m_table.find(key) != m_table.capacity(); }
+
+		//************************************
+		// Count method
+		//************************************
+		inline size_t count(const Key& key) const noexcept { return contains(key) ? 1 : 0; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Insert method
+		//
+		// Leaves an existing key's value
+		// alone
+		//
+		// Returns key's position and
+		// whether it was added
+		//************************************
+		inline std::pair<iterator, bool> insert(const Key& key, const Value& value) noexcept
+		{
+			std::pair<size_t, bool> inserted = m_table.emplace(key, key, value);
+			return { iterator(this, inserted.first), inserted.second };
+		}
+
+		//************************************
+		// Insert or assign method
+		//
+		// Overwrites an existing key's
+		// value
+		//************************************
+		inline std::pair<iterator, bool> insert_or_assign(const Key& key, const Value& value) noexcept
+		{
+			size_t index = m_table.find(key);
+			if (index != m_table.capacity())
+			{
+				m_table.slot(index).second = value;
+				return { iterator(this, index), false };
+			}
+			return insert(key, value);
+		}
+
+		//************************************
+		// Range insert method
+		//************************************
+		template<typename Iterator>
+		inline void insert(Iterator first, Iterator last) noexcept
+		{
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+				m_table.reserve(size() + static_cast<size_t>(std::distance(first, last)));
+			for (; first != last; ++first)
+				m_table.emplace((*first).first, (*first).first, (*first).second);
+		}
+
+		//************************************
+		// Subscript operator
+		//
+		// Adds a value initialized entry
+		// for a missing key
+		//************************************
+		inline Value& operator[](const Key& key) noexcept
+		{
+			return m_table.slot(m_table.emplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first).second;
+		}
+
+		//************************************
+		// Erase methods
+		//
+		// The iterator version returns the
+		// position after the erased entry
+		//************************************
+		inline size_t erase(const Key& key) noexcept
+		{
+			size_t index = m_table.find(key);
+			if (index == m_table.capacity())
+				return 0;
+			m_table.erase(index);
+			return 1;
+		}
+		inline iterator erase(iterator position) noexcept
+		{
+			m_table.erase(position.index());
+			return iterator(this, m_table.next_full(position.index() + 1));
+		}
+
+		//************************************
+		// Reserve method
+		//
+		// Makes room for size entries
+		//
+		// Returns the capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept { return m_table.reserve(size); }
+
+		//************************************
+		// Clear method
+		//
+		// Keeps the slots for reuse
+		//************************************
+		inline void clear() noexcept { m_table.clear(); }
+
+		//*******************[ Iterator Hooks ]
+		//************************************
+		// Entry getters
+		//************************************
+		inline reference entry(size_t index) noexcept
+		{
+			value_type& slot = m_table.slot(index);
+			return reference(slot.first, slot.second);
+		}
+		inline const_reference entry(size_t index) const noexcept
+		{
+			const value_type& slot = m_table.slot(index);
+			return const_reference(slot.first, slot.second);
+		}
+
+		//************************************
+		// Next entry method
+		//************************************
+		inline size_t next_index(size_t index) const noexcept { return m_table.next_full(index); }
+	private:
+		hash_table<hash_map_policy<Key, Value>, Hash, Equal, Allocator> m_table;
+	};
+
+	//**************************************
+	// Flat hash iterator
+	//
+	// Walks the full slots of a
+	// flat_hash_set or flat_hash_map,
+	// skipping the rest a group at a time.
+	// A map's entries are pairs of
+	// references made by value, so its
+	// iterator is only an input iterator,
+	// a set's is a forward one
+	//
+	// Container is the set or map, or a
+	// const one for read only iteration
+	//**************************************
+	template<typename Container>
+	class flat_hash_iterator final
+	{
+	public:
+		using reference = decltype(std::declval<Container&>().entry(0));
+		using iterator_category = std::conditional_t<std::is_reference_v<reference>, std::forward_iterator_tag, std::input_iterator_tag>;
+		using value_type = typename std::remove_const_t<Container>::value_type;
+		using difference_type = ptrdiff_t;
+
+		//******************************
+		// Arrow proxy
+		//
+		// Holds the entry so
+		// iter->second works on the
+		// pair of references
+		//******************************
+		struct pointer
+		{
+			reference entry;
+			inline auto operator->() const noexcept { return &entry; }
+		};
+
+		//******************************
+		// Constructors
+		//******************************
+		inline flat_hash_iterator() noexcept : m_container(nullptr), m_index(0) {}
+		inline flat_hash_iterator(Container* container, size_t index) noexcept : m_container(container), m_index(index) {}
+
+		//******************************
+		// Const conversion constructor
+		//******************************
+		template<typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Container>>>
+		inline flat_hash_iterator(const flat_hash_iterator<Other>& rhs) noexcept : m_container(rhs.container()), m_index(rhs.index()) {}
+
+		//*******[ Movement Operations ]
+		inline flat_hash_iterator& operator++() noexcept { m_index = m_container->next_index(m_index + 1); return *this; }
+		inline flat_hash_iterator operator++(int) noexcept { flat_hash_iterator old = *this; ++*this; return old; }
+
+		//*****[ Comparison Operations ]
+		inline bool operator==(const flat_hash_iterator& rhs) const noexcept { return m_index == rhs.m_index; }
+		inline bool operator!=(const flat_hash_iterator& rhs) const noexcept { return m_index != rhs.m_index; }
+
+		//*******[ Accessor Operations ]
+		//******************************
+		// Dereference operator
+		//******************************
+		inline reference operator*() const noexcept { return m_container->entry(m_index); }
+
+		//******************************
+		// Member access operator
+		//******************************
+		inline pointer operator->() const noexcept { return pointer{ **this }; }
+
+		//******************************
+		// Slot index getter
+		//******************************
+		inline size_t index() const noexcept { return m_index; }
+
+		//******************************
+		// Container getter
+		//******************************
+		inline Container* container() const noexcept { return m_container; }
+	private:
+		Container* m_container;
+		size_t m_index;
+	};
+}
@@ -0,0 +1,812 @@
+//**************************************
+// flat_map.h
+//
+// Holds nids::flat_set and
+// nids::flat_map, sorted associative
+// containers kept in nids::vectors.
+//
+// Keys sit packed in one sorted array,
+// so a lookup is a branchless binary
+// search over a few cache lines rather
+// than a pointer chase through tree
+// nodes, and iterating is a linear
+// scan. Inserting one key shifts what
+// follows it, so bulk loads and
+// batches go through insert(first,
+// last), which sorts the batch once
+// and merges it in a single pass
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <functional>
+#include <iterator>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+#include "sort.h"
+#include "span.h"
+#include "vector.h"
+
+namespace nids
+{
+	//**************************************
+	// Branchless lower bound method
+	//
+	// Returns the first of count sorted
+	// elements not ordered before key.
+	// Each step halves the range with a
+	// conditional move instead of a
+	// branch, so lookups don't pay for
+	// mispredicted comparisons
+	//**************************************
+	template<typename Type, typename Lookup, typename Compare>
+	inline const Type* branchless_lower_bound(const Type* first, size_t count, const Lookup& key, const Compare& compare) noexcept
+	{
+		if (count == 0)
+			return first;
+		while (count > 1)
+		{
+			size_t half = count / 2;
+			first = compare(first[half], key) ? first + half : first;
+			count -= half;
+		}
+		return first + (compare(*first, key) ? 1 : 0);
+	}
+
+	//**************************************
+	// Branchless upper bound method
+	//
+	// Returns the first of count sorted
+	// elements ordered after key
+	//**************************************
+	template<typename Type, typename Lookup, typename Compare>
+	inline const Type* branchless_upper_bound(const Type* first, size_t count, const Lookup& key, const Compare& compare) noexcept
+	{
+		if (count == 0)
+			return first;
+		while (count > 1)
+		{
+			size_t half = count / 2;
+			first = !compare(key, first[half]) ? first + half : first;
+			count -= half;
+		}
+		return first + (!compare(key, *first) ? 1 : 0);
+	}
+
+	//**************************************
+	// Flat set
+	//
+	// Sorted set of unique keys. Compare
+	// must be a strict weak ordering; a
+	// transparent one (the default
+	// std::less<>) also lets find and the
+	// other lookups take any type it can
+	// compare with Key
+	//
+	// Iterators are pointers into the
+	// sorted keys, invalidated by any
+	// insert or erase
+	//**************************************
+	template<typename Key, typename Compare = std::less<>, typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class flat_set final
+	{
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using key_compare = Compare;
+		using iterator = const Key*;
+		using const_iterator = const Key*;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline flat_set() noexcept : m_compare(), m_keys() {}
+
+		//************************************
+		// Compare constructor
+		//************************************
+		inline explicit flat_set(const Compare& compare) noexcept : m_compare(compare), m_keys() {}
+
+		//************************************
+		// Range constructor
+		//
+		// Sorts [first, last) once and drops
+		// duplicates
+		//************************************
+		template<typename Iterator>
+		inline flat_set(Iterator first, Iterator last, const Compare& compare = Compare()) noexcept : m_compare(compare), m_keys()
+		{
+			insert(first, last);
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_keys.size(); }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_keys.capacity(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_keys.empty(); }
+
+		//************************************
+		// Compare getter
+		//************************************
+		inline const Compare& key_comp() const noexcept { return m_compare; }
+
+		//************************************
+		// Array getter
+		//
+		// The keys in sorted order
+		//************************************
+		inline const Key* data() const noexcept { return m_keys.data(); }
+
+		//************************************
+		// View getter
+		//************************************
+		inline span<const Key> view() const noexcept { return m_keys.view(); }
+
+		//************************************
+		// Subscript operator
+		//
+		// Returns the index'th smallest key
+		//************************************
+		inline const Key& operator[](size_t index) const noexcept { return m_keys[index]; }
+
+		//************************************
+		// Iterator getters
+		//************************************
+		inline iterator begin() const noexcept { return m_keys.data(); }
+		inline iterator end() const noexcept { return m_keys.data() + m_keys.size(); }
+
+		//************************************
+		// Lower bound getter
+		//************************************
+		template<typename Lookup>
+		inline iterator lower_bound(const Lookup& key) const noexcept { return branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_compare); }
+
+		//************************************
+		// Upper bound getter
+		//************************************
+		template<typename Lookup>
+		inline iterator upper_bound(const Lookup& key) const noexcept { return branchless_upper_bound(m_keys.data(), m_keys.size(), key, m_compare); }
+
+		//************************************
+		// Find method
+		//
+		// Returns end() if key isn't there
+		//************************************
+		template<typename Lookup>
+		inline iterator find(const Lookup& key) const noexcept
+		{
+			iterator found = lower_bound(key);
+			return found != end() && !m_compare(key, *found) ? found : end();
+		}
+
+		//************************************
+		// Contains method
+		//************************************
+		template<typename Lookup>
+		inline bool contains(const Lookup& key) const noexcept { return find(key) != end(); }
+
+		//************************************
+		// Count method
+		//************************************
+		template<typename Lookup>
+		inline size_t count(const Lookup& key) const noexcept { return contains(key) ? 1 : 0; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Insert method
+		//
+		// Adds key unless it is already
+		// there, shifting the larger keys up
+		//
+		// Returns where key is and whether
+		// it was added
+		//************************************
+		std::pair<iterator, bool> insert(const Key& key) noexcept;
+
+		//************************************
+		// Batch insert method
+		//
+		// Adds every key of [first, last)
+		// that isn't already there. The batch
+		// is sorted once and merged in from
+		// the back, so each key moves at most
+		// once however many are added
+		//************************************
+		template<typename Iterator>
+		void insert(Iterator first, Iterator last) noexcept;
+
+		//************************************
+		// Erase method
+		//
+		// Returns the number of keys removed
+		//************************************
+		template<typename Lookup>
+		inline size_t erase(const Lookup& key) noexcept
+		{
+			iterator found = find(key);
+			if (found == end())
+				return 0;
+			erase(found);
+			return 1;
+		}
+
+		//************************************
+		// Erase method (iterator)
+		//
+		// Returns the key after the erased
+		// one
+		//************************************
+		inline iterator erase(iterator pos) noexcept
+		{
+			size_t index = static_cast<size_t>(pos - begin());
+			assert(index < size());
+			m_keys.erase(m_keys.begin() + static_cast<ptrdiff_t>(index));
+			return begin() + index;
+		}
+
+		//************************************
+		// Reserve method
+		//************************************
+		inline size_t reserve(size_t size) noexcept { return m_keys.reserve(size); }
+
+		//************************************
+		// Clear method
+		//************************************
+		inline void clear() noexcept { m_keys.resize_default_init(0); }
+	private:
+		Compare m_compare;
+		vector<Key, GrowthPolicy, Allocator> m_keys;
+	};
+
+	//**********************************
+	// Insert method
+	//**********************************
+	template<typename Key, typename Compare, typename GrowthPolicy, typename Allocator>
+	std::pair<typename flat_set<Key, Compare, GrowthPolicy, Allocator>::iterator, bool> flat_set<Key, Compare, GrowthPolicy, Allocator>::insert(const Key& key) noexcept
+	{
+		size_t index = static_cast<size_t>(lower_bound(key) - begin());
+		if (index < size() && !m_compare(key, m_keys[index]))
+			return { begin() + index, false };
+
+		m_keys.insert(m_keys.begin() + static_cast<ptrdiff_t>(index), &key, &key + 1);
+		return { begin() + index, true };
+	}
+
+	//**********************************
+	// Batch insert method
+	//**********************************
+	template<typename Key, typename Compare, typename GrowthPolicy, typename Allocator>
+	template<typename Iterator>
+	void flat_set<Key, Compare, GrowthPolicy, Allocator>::insert(Iterator first, Iterator last) noexcept
+	{
+		if (first == last)
+			return;
+
+		// an empty set is the batch, sorted and deduplicated in place
+		vector<Key, GrowthPolicy, Allocator> batch;
+		vector<Key, GrowthPolicy, Allocator>& sorted = empty() ? m_keys : batch;
+		size_t existing = size();
+		sorted.append(first, last);
+		nids::sort(sorted.begin(), sorted.end(), m_compare);
+
+		// keep the first of each run of equal keys, and only keys the set doesn't have
+		size_t kept{ 0 };
+		for (size_t index{ 0 }; index < sorted.size(); ++index)
+		{
+			const Key& key = sorted[index];
+			if (kept > 0 && !m_compare(sorted[kept - 1], key))
+				continue;
+			if (existing > 0)
+			{
+				const Key* found = branchless_lower_bound(m_keys.data(), existing, key, m_compare);
+				if (found != m_keys.data() + existing && !m_compare(key, *found))
+					continue;
+			}
+			if (kept != index)
+				sorted[kept] = std::move(sorted[index]);
+			++kept;
+		}
+		sorted.resize_default_init(kept);
+		if (existing == 0 || kept == 0)
+			return;
+
+		// merge from the back, into the space past the existing keys
+		m_keys.resize_default_init(existing + kept);
+		Key* keys = m_keys.data();
+		size_t from = existing;
+		size_t added = kept;
+		for (size_t dest = existing + kept; added > 0;)
+		{
+			--dest;
+			if (from > 0 && m_compare(batch[added - 1], keys[from - 1]))
+				keys[dest] = std::move(keys[--from]);
+			else
+				keys[dest] = std::move(batch[--added]);
+		}
+	}
+
+	template<typename Container>
+	class flat_map_iterator;
+
+	//**************************************
+	// Flat map
+	//
+	// Sorted map from unique keys to
+	// values. Keys and values live in two
+	// parallel vectors, so a lookup only
+	// reads keys, however big the values
+	// are
+	//
+	// Dereferencing an iterator gives a
+	// pair of references, so
+	// for (auto [key, value] : map)
+	// writes values through
+	//**************************************
+	template<typename Key, typename Value, typename Compare = std::less<>, typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class flat_map final
+	{
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key, Value>;
+		using key_compare = Compare;
+		using reference = std::pair<const Key&, Value&>;
+		using const_reference = std::pair<const Key&, const Value&>;
+		using iterator = flat_map_iterator<flat_map>;
+		using const_iterator = flat_map_iterator<const flat_map>;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline flat_map() noexcept : m_compare(), m_keys(), m_values() {}
+
+		//************************************
+		// Compare constructor
+		//************************************
+		inline explicit flat_map(const Compare& compare) noexcept : m_compare(compare), m_keys(), m_values() {}
+
+		//************************************
+		// Range constructor
+		//
+		// Takes anything whose elements have
+		// first and second, sorting once
+		//************************************
+		template<typename Iterator>
+		inline flat_map(Iterator first, Iterator last, const Compare& compare = Compare()) noexcept : m_compare(compare), m_keys(), m_values()
+		{
+			insert(first, last);
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_keys.size(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_keys.empty(); }
+
+		//************************************
+		// Compare getter
+		//************************************
+		inline const Compare& key_comp() const noexcept { return m_compare; }
+
+		//************************************
+		// Keys getter
+		//
+		// The keys in sorted order
+		//************************************
+		inline span<const Key> keys() const noexcept { return m_keys.view(); }
+
+		//************************************
+		// Values getters
+		//
+		// values()[i] belongs to keys()[i]
+		//************************************
+		inline span<const Value> values() const noexcept { return m_values.view(); }
+		inline span<Value> values() noexcept { return m_values.view(); }
+
+		//************************************
+		// Entry getters
+		//
+		// Return the index'th smallest key
+		// and its value
+		//************************************
+		inline const_reference entry(size_t index) const noexcept { return const_reference(m_keys[index], m_values[index]); }
+		inline reference entry(size_t index) noexcept { return reference(m_keys[index], m_values[index]); }
+
+		//************************************
+		// Iterator getters
+		//************************************
+		inline iterator begin() noexcept { return iterator(this, 0); }
+		inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		inline iterator end() noexcept { return iterator(this, size()); }
+		inline const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+		//************************************
+		// Lower bound index getter
+		//************************************
+		template<typename Lookup>
+		inline size_t lower_bound_index(const Lookup& key) const noexcept
+		{
+			return static_cast<size_t>(branchless_lower_bound(m_keys.data(), m_keys.size(), key, m_compare) - m_keys.data());
+		}
+
+		//************************************
+		// Find index method
+		//
+		// Returns key's index, or size() if
+		// it isn't there
+		//************************************
+		template<typename Lookup>
+		inline size_t find_index(const Lookup& key) const noexcept
+		{
+			size_t index = lower_bound_index(key);
+			return index < size() && !m_compare(key, m_keys[index]) ? index : size();
+		}
+
+		//************************************
+		// Find methods
+		//************************************
+		template<typename Lookup>
+		inline iterator find(const Lookup& key) noexcept { return iterator(this, find_index(key)); }
+		template<typename Lookup>
+		inline const_iterator find(const Lookup& key) const noexcept { return const_iterator(this, find_index(key)); }
+
+		//************************************
+		// Value getters
+		//
+		// Return key's value, or nullptr if
+		// it isn't there
+		//************************************
+		template<typename Lookup>
+		inline Value* get(const Lookup& key) noexcept
+		{
+			size_t index = find_index(key);
+			return index < size() ? &m_values[index] : nullptr;
+		}
+
+		template<typename Lookup>
+		inline const Value* get(const Lookup& key) const noexcept
+		{
+			size_t index = find_index(key);
+			return index < size() ? &m_values[index] : nullptr;
+		}
+
+		//************************************
+		// Contains method
+		//************************************
+		template<typename Lookup>
+		inline bool contains(const Lookup& key) const noexcept { return find_index(key) < size(); }
+
+		//************************************
+		// Count method
+		//************************************
+		template<typename Lookup>
+		inline size_t count(const Lookup& key) const noexcept { return contains(key) ? 1 : 0; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Insert method
+		//
+		// Adds key and value unless key is
+		// already there, which keeps its old
+		// value
+		//
+		// Returns where key is and whether
+		// it was added
+		//
+		// Like vector::insert, key and value
+		// must not be elements of this map
+		//************************************
+		std::pair<iterator, bool> insert(const Key& key, const Value& value) noexcept;
+
+		//************************************
+		// Insert or assign method
+		//
+		// Same as insert, but an existing
+		// key takes the new value
+		//************************************
+		inline std::pair<iterator, bool> insert_or_assign(const Key& key, const Value& value) noexcept
+		{
+			std::pair<iterator, bool> result = insert(key, value);
+			if (!result.second)
+				m_values[result.first.index()] = value;
+			return result;
+		}
+
+		//************************************
+		// Subscript operator
+		//
+		// Returns key's value, adding a
+		// value initialized one first if
+		// key isn't there
+		//************************************
+		inline Value& operator[](const Key& key) noexcept
+		{
+			size_t index = lower_bound_index(key);
+			if (index == size() || m_compare(key, m_keys[index]))
+				insert_at(index, key, Value());
+			return m_values[index];
+		}
+
+		//************************************
+		// Batch insert method
+		//
+		// Adds every pair of [first, last)
+		// whose key isn't already there. The
+		// batch is sorted once and merged in
+		// from the back, so each entry moves
+		// at most once however many are
+		// added. When the batch holds a key
+		// more than once, which of its
+		// values is kept is unspecified
+		//************************************
+		template<typename Iterator>
+		void insert(Iterator first, Iterator last) noexcept;
+
+		//************************************
+		// Erase method
+		//
+		// Returns the number of entries
+		// removed
+		//************************************
+		template<typename Lookup>
+		inline size_t erase(const Lookup& key) noexcept
+		{
+			size_t index = find_index(key);
+			if (index == size())
+				return 0;
+			erase_at(index);
+			return 1;
+		}
+
+		//************************************
+		// Erase method (iterator)
+		//
+		// Returns the entry after the erased
+		// one
+		//************************************
+		inline iterator erase(iterator pos) noexcept
+		{
+			erase_at(pos.index());
+			return pos;
+		}
+
+		//************************************
+		// Reserve method
+		//************************************
+		inline void reserve(size_t size) noexcept
+		{
+			m_keys.reserve(size);
+			m_values.reserve(size);
+		}
+
+		//************************************
+		// Clear method
+		//************************************
+		inline void clear() noexcept
+		{
+			m_keys.resize_default_init(0);
+			m_values.resize_default_init(0);
+		}
+	private:
+		//************************************
+		// Insert at method
+		//************************************
+		inline void insert_at(size_t index, const Key& key, const Value& value) noexcept
+		{
+			m_keys.insert(m_keys.begin() + static_cast<ptrdiff_t>(index), &key, &key + 1);
+			m_values.insert(m_values.begin() + static_cast<ptrdiff_t>(index), &value, &value + 1);
+		}
+
+		//************************************
+		// Erase at method
+		//************************************
+		inline void erase_at(size_t index) noexcept
+		{
+			assert(index < size());
+			m_keys.erase(m_keys.begin() + static_cast<ptrdiff_t>(index));
+			m_values.erase(m_values.begin() + static_cast<ptrdiff_t>(index));
+		}
+
+		Compare m_compare;
+		vector<Key, GrowthPolicy, Allocator> m_keys;
+		vector<Value, GrowthPolicy, Allocator> m_values;
+	};
+
+	//**********************************
+	// Insert method
+	//**********************************
+	template<typename Key, typename Value, typename Compare, typename GrowthPolicy, typename Allocator>
+	std::pair<typename flat_map<Key, Value, Compare, GrowthPolicy, Allocator>::iterator, bool> flat_map<Key, Value, Compare, GrowthPolicy, Allocator>::insert(const Key& key, const Value& value) noexcept
+	{
+		size_t index = lower_bound_index(key);
+		if (index < size() && !m_compare(key, m_keys[index]))
+			return { iterator(this, index), false };
+
+		insert_at(index, key, value);
+		return { iterator(this, index), true };
+	}
+
+	//**********************************
+	// Batch insert method
+	//**********************************
+	template<typename Key, typename Value, typename Compare, typename GrowthPolicy, typename Allocator>
+	template<typename Iterator>
+	void flat_map<Key, Value, Compare, GrowthPolicy, Allocator>::insert(Iterator first, Iterator last) noexcept
+	{
+		if (first == last)
+			return;
+
+		// the batch is sorted as pairs, then split into the two arrays
+		vector<value_type, GrowthPolicy, Allocator> batch;
+		for (; first != last; ++first)
+			batch.emplace_back((*first).first, (*first).second);
+		const Compare& compare = m_compare;
+		nids::sort(batch.begin(), batch.end(), [&compare](const value_type& lhs, const value_type& rhs) { return compare(lhs.first, rhs.first); });
+
+		// keep the first of each run of equal keys, and only keys the map doesn't have
+		size_t existing = size();
+		size_t kept{ 0 };
+		for (size_t index{ 0 }; index < batch.size(); ++index)
+		{
+			const Key& key = batch[index].first;
+			if (kept > 0 && !m_compare(batch[kept - 1].first, key))
+				continue;
+			if (existing > 0)
+			{
+				const Key* found = branchless_lower_bound(m_keys.data(), existing, key, m_compare);
+				if (found != m_keys.data() + existing && !m_compare(key, *found))
+					continue;
+			}
+			if (kept != index)
+				batch[kept] = std::move(batch[index]);
+			++kept;
+		}
+		if (kept == 0)
+			return;
+
+		// merge from the back, moving each key and its value together
+		m_keys.resize_default_init(existing + kept);
+		m_values.resize_default_init(existing + kept);
+		Key* keys = m_keys.data();
+		Value* values = m_values.data();
+		size_t from = existing;
+		size_t added = kept;
+		for (size_t dest = existing + kept; added > 0;)
+		{
+			--dest;
+			if (from > 0 && m_compare(batch[added - 1].first, keys[from - 1]))
+			{
+				--from;
+				keys[dest] = std::move(keys[from]);
+				values[dest] = std::move(values[from]);
+			}
+			else
+			{
+				--added;
+				keys[dest] = std::move(batch[added].first);
+				values[dest] = std::move(batch[added].second);
+			}
+		}
+	}
+
+	//**************************************
+	// Flat map iterator
+	//
+	// Walks the entries of a flat_map,
+	// dereferencing to a pair of
+	// references to the key and value.
+	// That pair is a value, not a
+	// reference to an entry, so it is
+	// tagged as an input iterator though
+	// it moves like a random access one
+	//
+	// Container is the flat_map, or a
+	// const one for read only iteration
+	//**************************************
+	template<typename Container>
+	class flat_map_iterator final
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = typename std::remove_const_t<Container>::value_type;
+		using difference_type = ptrdiff_t;
+		using reference = decltype(std::declval<Container&>().entry(0));
+
+		//******************************
+		// Arrow proxy
+		//
+		// Holds the pair of references
+		// so iter->second works
+		//******************************
+		struct pointer
+		{
+			reference entry;
+			inline const reference* operator->() const noexcept { return &entry; }
+		};
+
+		//******************************
+		// Constructors
+		//******************************
+		inline flat_map_iterator() noexcept : m_map(nullptr), m_index(0) {}
+		inline flat_map_iterator(Container* map, size_t index) noexcept : m_map(map), m_index(index) {}
+
+		//******************************
+		// Const conversion constructor
+		//******************************
+		template<typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Container>>>
+		inline flat_map_iterator(const flat_map_iterator<Other>& rhs) noexcept : m_map(rhs.map()), m_index(rhs.index()) {}
+
+		//*******[ Movement Operations ]
+		inline flat_map_iterator& operator++() noexcept { ++m_index; return *this; }
+		inline flat_map_iterator operator++(int) noexcept { flat_map_iterator old = *this; ++m_index; return old; }
+		inline flat_map_iterator& operator--() noexcept { --m_index; return *this; }
+		inline flat_map_iterator operator--(int) noexcept { flat_map_iterator old = *this; --m_index; return old; }
+		inline flat_map_iterator& operator+=(difference_type amount) noexcept { m_index += amount; return *this; }
+		inline flat_map_iterator& operator-=(difference_type amount) noexcept { m_index -= amount; return *this; }
+		inline flat_map_iterator operator+(difference_type amount) const noexcept { return flat_map_iterator(m_map, m_index + amount); }
+		inline flat_map_iterator operator-(difference_type amount) const noexcept { return flat_map_iterator(m_map, m_index - amount); }
+		inline difference_type operator-(const flat_map_iterator& rhs) const noexcept { return static_cast<difference_type>(m_index - rhs.m_index); }
+
+		//*****[ Comparison Operations ]
+		inline bool operator==(const flat_map_iterator& rhs) const noexcept { return m_index == rhs.m_index; }
+		inline bool operator!=(const flat_map_iterator& rhs) const noexcept { return m_index != rhs.m_index; }
+		inline bool operator<(const flat_map_iterator& rhs) const noexcept { return m_index < rhs.m_index; }
+		inline bool operator>(const flat_map_iterator& rhs) const noexcept { return m_index > rhs.m_index; }
+		inline bool operator<=(const flat_map_iterator& rhs) const noexcept { return m_index <= rhs.m_index; }
+		inline bool operator>=(const flat_map_iterator& rhs) const noexcept { return m_index >= rhs.m_index; }
+
+		//*******[ Accessor Operations ]
+		//******************************
+		// Dereference operator
+		//******************************
+		inline reference operator*() const noexcept
+		{
+			assert(m_index < m_map->size());
+			return m_map->entry(m_index);
+		}
+
+		//******************************
+		// Member access operator
+		//******************************
+		inline pointer operator->() const noexcept { return pointer{ **this }; }
+
+		//******************************
+		// Offset subscript operator
+		//******************************
+		inline reference operator[](difference_type offset) const noexcept { return m_map->entry(m_index + offset); }
+
+		//******************************
+		// Entry index getter
+		//******************************
+		inline size_t index() const noexcept { return m_index; }
+
+		//******************************
+		// Map getter
+		//******************************
+		inline Container* map() const noexcept { return m_map; }
+	private:
+		Container* m_map;
+		size_t m_index;
+	};
+}
@@ -0,0 +1,105 @@
+//**************************************
+// growth_policy.h
+//
+// Holds the growth policies that decide
+// the new capacity of nids::vector when
+// push_back runs out of space.
+//
+// A growth policy is any type with a
+// static next_capacity(capacity,
+// elementSize) method that returns a
+// capacity strictly larger than the
+// one passed in. Everything is done in
+// integer arithmetic
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+
+namespace nids
+{
+	//**************************************
+	// Geometric growth policy
+	//
+	// Scales the capacity by Numerator /
+	// Denominator, starting at
+	// MinimumCapacity
+	//**************************************
+	template<size_t Numerator, size_t Denominator, size_t MinimumCapacity = 1>
+	struct geometric_growth final
+	{
+		static_assert(Numerator > Denominator, "geometric growth must grow");
+		static_assert(Denominator > 0);
+		static_assert(MinimumCapacity > 0);
+
+		static inline size_t next_capacity(size_t capacity, size_t) noexcept
+		{
+			if (capacity < MinimumCapacity)
+				return MinimumCapacity;
+
+			// split the multiply so large capacities don't overflow
+			const size_t extra = Numerator - Denominator;
+			size_t growth = (capacity / Denominator) * extra + ((capacity % Denominator) * extra) / Denominator;
+			if (growth == 0) growth = 1;
+
+			assert(capacity + growth > capacity);
+			return capacity + growth;
+		}
+	};
+
+	//**************************************
+	// Fixed chunk growth policy
+	//
+	// Adds ChunkSize elements each time
+	//**************************************
+	template<size_t ChunkSize>
+	struct fixed_chunk_growth final
+	{
+		static_assert(ChunkSize > 0);
+
+		static inline size_t next_capacity(size_t capacity, size_t) noexcept
+		{
+			assert(capacity + ChunkSize > capacity);
+			return capacity + ChunkSize;
+		}
+	};
+
+	//**************************************
+	// Page rounded growth policy
+	//
+	// Uses BasePolicy, then rounds the
+	// allocation up to a whole number of
+	// pages once it is at least a page so
+	// the tail of the last page isn't lost
+	//**************************************
+	template<typename BasePolicy, size_t PageSize = 4096>
+	struct page_rounded_growth final
+	{
+		static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0, "page size must be a power of two");
+
+		static inline size_t next_capacity(size_t capacity, size_t elementSize) noexcept
+		{
+			size_t next = BasePolicy::next_capacity(capacity, elementSize);
+			size_t bytes = next * elementSize;
+			if (bytes < PageSize)
+				return next;
+
+			bytes = (bytes + PageSize - 1) & ~(PageSize - 1);
+			return bytes / elementSize;
+		}
+	};
+
+	// common policies
+	using growth_1_5x = geometric_growth<3, 2>;
+	using growth_2x = geometric_growth<2, 1>;
+	using growth_3x = geometric_growth<3, 1, 3>;
+	using growth_golden = geometric_growth<1618, 1000>;
+	using growth_paged = page_rounded_growth<growth_2x>;
+
+	// original nids::vector behavior (3 -> 9 -> 27 ...)
+	using default_growth = growth_3x;
+}
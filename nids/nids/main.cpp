@@ -1,35 +1,19 @@
 //**************************************
 // main.cpp
 //
-// Driver program for testing purposes
+// Driver program for testing purposes.
+// Performance numbers come from the
+// nids_bench project (see
+// nids_bench/Makefile on Linux)
 //
 // Author: Nathan Ikola
 // nathan.ikola@gmail.com
 //**************************************
 
-#define MYVEC
-
-#ifdef MYVEC
-#include "vector.h"
-using nids::vector;
-#else
-#include <vector>
-using std::vector;
-#endif
 #include "vector.h"
 
-const int NUM_ELEMENTS = 1000000000;
-
 int main()
 {
-	/*
-	vector<int> v;
-
-	for (int element{ 0 }; element < NUM_ELEMENTS; ++element)
-	{
-		v.push_back(element);
-	}*/
-
 	nids::vector<int> v;
 	v.push_back(500);
 	auto iter = v.begin();
@@ -39,4 +23,4 @@ int main()
 	++iter;
 
 	return 0;
-}
\ No newline at end of file
+}
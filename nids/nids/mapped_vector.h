@@ -0,0 +1,586 @@
+//**************************************
+// mapped_vector.h
+//
+// Holds nids::mapped_vector, a vector
+// of trivially copyable elements that
+// lives in a memory mapped file.
+//
+// Opening an existing file maps it in
+// place, so loading a table costs page
+// faults as it is read instead of a
+// parse and copy pass. Growing the
+// vector grows the file, and flush
+// makes the contents durable
+//
+// POSIX only (mmap / mremap / msync)
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include "vector.h"
+
+namespace nids
+{
+	// how flush waits for the data to reach the disk
+	enum class FlushMode
+	{
+		FLUSH_ASYNC,
+		FLUSH_SYNC
+	};
+
+	template<typename Type, typename GrowthPolicy = default_growth>
+	class mapped_vector final
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "mapped_vector elements are stored as raw bytes");
+	public:
+		using value_type = Type;
+		using iterator = vector_iterator<Type, mapped_vector>;
+		using growth_policy = GrowthPolicy;
+
+		// identifies a mapped_vector file ("NIDSMVEC")
+		static const uint64_t MAGIC = 0x4345564D5344494Eull;
+
+		// file layout version, bumped on incompatible changes
+		static const uint32_t VERSION = 1;
+
+		// bytes in front of the elements, a whole cache line
+		static const size_t HEADER_SIZE = 64;
+
+		//************************************
+		// End getter method
+		//************************************
+		inline iterator end() const noexcept { return iterator::end(this); }
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//
+		// The vector is closed until open
+		// is called
+		//************************************
+		inline mapped_vector() noexcept
+			: m_file(-1), m_header(nullptr), m_array(nullptr), m_size(0), m_capacity(0) {}
+
+		//************************************
+		// Path constructor
+		//
+		// Opens or creates path, check
+		// is_open for the result
+		//************************************
+		inline explicit mapped_vector(const char* path) noexcept : mapped_vector()
+		{
+			open(path);
+		}
+
+		mapped_vector(const mapped_vector&) = delete;
+		mapped_vector& operator=(const mapped_vector&) = delete;
+
+		//************************************
+		// Move constructor
+		//************************************
+		inline mapped_vector(mapped_vector&& rhs) noexcept
+			: m_file(rhs.m_file), m_header(rhs.m_header), m_array(rhs.m_array), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
+		{
+			rhs.forget();
+		}
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		inline mapped_vector& operator=(mapped_vector&& rhs) noexcept
+		{
+			if (&rhs != this)
+			{
+				close();
+				m_file = rhs.m_file;
+				m_header = rhs.m_header;
+				m_array = rhs.m_array;
+				m_size = rhs.m_size;
+				m_capacity = rhs.m_capacity;
+				rhs.forget();
+			}
+			return *this;
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~mapped_vector() noexcept { close(); }
+
+		//************************************
+		// Open method
+		//
+		// Maps path, creating an empty
+		// vector file if it doesn't exist
+		// and create is set
+		//
+		// Returns false if the file can't
+		// be opened or mapped, or was not
+		// written by a mapped_vector of the
+		// same element size
+		//************************************
+		bool open(const char* path, bool create = true) noexcept;
+
+		//************************************
+		// Close method
+		//
+		// Trims the file down to size() and
+		// unmaps it, the data is handed to
+		// the OS but not flushed
+		//************************************
+		void close() noexcept;
+
+		//************************************
+		// Flush method
+		//
+		// Writes the mapped pages back to
+		// the file, FLUSH_SYNC waits until
+		// they are on disk
+		//
+		// Returns false if msync failed
+		//************************************
+		bool flush(FlushMode mode = FlushMode::FLUSH_SYNC) noexcept;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Open status getter
+		//************************************
+		inline bool is_open() const noexcept { return m_file >= 0; }
+
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_capacity; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Const correct subscript operator
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return m_array[index];
+		}
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline Type& operator[](size_t index) noexcept
+		{
+			assert(index < m_size);
+			return m_array[index];
+		}
+
+		//************************************
+		// Const correct at object accessor
+		//************************************
+		inline const Type& at(size_t index) const noexcept { return operator[](index); }
+
+		//************************************
+		// At object accessor
+		//************************************
+		inline Type& at(size_t index) noexcept { return operator[](index); }
+
+		//************************************
+		// Array getter (const correct)
+		//************************************
+		inline const Type* data() const noexcept { return m_array; }
+
+		//************************************
+		// Array getter
+		//************************************
+		inline Type* data() noexcept { return m_array; }
+
+		//************************************
+		// View getters
+		//
+		// Return a span over every element,
+		// or count elements from offset. A
+		// view is a pointer and a length, so
+		// slicing copies nothing, but like
+		// data() it is invalidated by growth
+		//************************************
+		inline span<Type> view() noexcept { return span<Type>(m_array, m_size); }
+		inline span<const Type> view() const noexcept { return span<const Type>(m_array, m_size); }
+		inline span<Type> view(size_t offset, size_t count) noexcept { return view().subspan(offset, count); }
+		inline span<const Type> view(size_t offset, size_t count) const noexcept { return view().subspan(offset, count); }
+
+		//************************************
+		// Front item getter
+		//************************************
+		inline Type* front() const noexcept { return m_array; }
+
+		//************************************
+		// Back item getter
+		//************************************
+		inline Type* back() const noexcept { return &m_array[m_size - 1]; }
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		inline iterator begin() noexcept { return iterator(this); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Resize method
+		//
+		// Grows or shrinks the file to hold
+		// size elements, without
+		// initializing new ones
+		//
+		// Returns new capacity, or old
+		// capacity if the file couldn't be
+		// resized
+		//************************************
+		size_t resize(size_t size) noexcept;
+
+		//************************************
+		// Resize method
+		//
+		// Resizes the vector and initializes
+		// the new data to the value of val
+		//
+		// Returns new capacity, or old
+		// capacity if unchanged
+		//************************************
+		size_t resize(size_t size, const Type& val) noexcept;
+
+		//************************************
+		// Reserve method
+		//
+		// Grows the capacity to at least
+		// size, never shrinks it
+		//
+		// Returns the new capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			if (size > m_capacity)
+				resize(size);
+			return m_capacity;
+		}
+
+		//************************************
+		// Uninitialized resize method
+		//
+		// Sets the size, growing the
+		// capacity if needed, without
+		// touching the elements, so they
+		// can be filled through data()
+		// (e.g. by read or recv)
+		//
+		// Only for trivial types, anything
+		// else needs resize_default_init
+		//
+		// Returns the new size, or the old
+		// size if the allocation failed
+		//************************************
+		inline size_t resize_uninitialized(size_t size) noexcept
+		{
+			static_assert(std::is_trivial_v<Type>, "resize_uninitialized leaves the elements unconstructed");
+			return resize_default_init(size);
+		}
+
+		//************************************
+		// Default initializing resize method
+		//
+		// Sets the size, default
+		// constructing any new elements,
+		// which leaves trivial types
+		// untouched
+		//
+		// Returns the new size, or the old
+		// size if the allocation failed
+		//************************************
+		inline size_t resize_default_init(size_t size) noexcept
+		{
+			if (size > m_capacity)
+			{
+				size_t capacity = GrowthPolicy::next_capacity(m_capacity, sizeof(Type));
+				resize(capacity < size ? size : capacity);
+				if (m_capacity < size)
+					return m_size;
+			}
+
+			if constexpr (!std::is_trivially_default_constructible_v<Type>)
+				for (size_t index{ m_size }; index < size; ++index)
+					new (m_array + index) Type;
+			set_size(size);
+			return m_size;
+		}
+
+		//************************************
+		// Push back method
+		//
+		// Adds the specified data to the end
+		// of the vector, growing the file if
+		// necessary
+		//
+		// data is copied before the file
+		// grows, so references into the
+		// vector are safe to pass
+		//************************************
+		inline void push_back(const Type& data) noexcept
+		{
+			assert(is_open());
+			Type value = data;
+			if (m_size == m_capacity)
+			{
+				resize(GrowthPolicy::next_capacity(m_capacity, sizeof(Type)));
+				assert(m_size < m_capacity);
+			}
+			m_array[m_size] = value;
+			set_size(m_size + 1);
+		}
+	private:
+		//************************************
+		// File header
+		//
+		// Kept at the start of the file and
+		// updated in place
+		//************************************
+		struct file_header
+		{
+			uint64_t magic;
+			uint32_t version;
+			uint32_t elementSize;
+			uint64_t size;
+			uint64_t capacity;
+			unsigned char reserved[HEADER_SIZE - 32];
+		};
+		static_assert(sizeof(file_header) == HEADER_SIZE);
+
+		//************************************
+		// File size helper
+		//************************************
+		static inline size_t file_bytes(size_t capacity) noexcept { return HEADER_SIZE + sizeof(Type) * capacity; }
+
+		//************************************
+		// Size mutator
+		//
+		// Keeps the header in step, so a
+		// flush always saves a consistent
+		// size
+		//************************************
+		inline void set_size(size_t size) noexcept
+		{
+			m_size = size;
+			m_header->size = size;
+		}
+
+		//************************************
+		// Remapping method
+		//
+		// Moves the mapping from oldBytes to
+		// newBytes of the file
+		//
+		// Returns false if nothing changed
+		//************************************
+		bool remap(size_t oldBytes, size_t newBytes) noexcept;
+
+		//************************************
+		// Forget method
+		//
+		// Drops the file without closing
+		// it, for after a move
+		//************************************
+		inline void forget() noexcept
+		{
+			m_file = -1;
+			m_header = nullptr;
+			m_array = nullptr;
+			m_size = 0;
+			m_capacity = 0;
+		}
+
+		int m_file;
+		file_header* m_header;
+		Type* m_array;
+		size_t m_size;
+		size_t m_capacity;
+	};
+
+	//************************************
+	// Open method
+	//************************************
+	template<typename Type, typename GrowthPolicy>
+	bool mapped_vector<Type, GrowthPolicy>::open(const char* path, bool create) noexcept
+	{
+		close();
+
+		int file = ::open(path, O_RDWR | (create ? O_CREAT : 0), 0644);
+		if (file < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(file, &status) != 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		file_header header{};
+		if (status.st_size == 0)
+		{
+			// new file, give it an empty header
+			header.magic = MAGIC;
+			header.version = VERSION;
+			header.elementSize = sizeof(Type);
+			if (pwrite(file, &header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE))
+			{
+				::close(file);
+				return false;
+			}
+		}
+		else if (static_cast<size_t>(status.st_size) < HEADER_SIZE
+			|| pread(file, &header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE)
+			|| header.magic != MAGIC
+			|| header.version != VERSION
+			|| header.elementSize != sizeof(Type)
+			|| header.size > header.capacity
+			|| file_bytes(header.capacity) > static_cast<size_t>(status.st_size))
+		{
+			::close(file);
+			return false;
+		}
+
+		void* base = mmap(nullptr, file_bytes(header.capacity), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+		if (base == MAP_FAILED)
+		{
+			::close(file);
+			return false;
+		}
+
+		m_file = file;
+		m_header = static_cast<file_header*>(base);
+		m_array = reinterpret_cast<Type*>(static_cast<unsigned char*>(base) + HEADER_SIZE);
+		m_size = header.size;
+		m_capacity = header.capacity;
+		return true;
+	}
+
+	//************************************
+	// Close method
+	//************************************
+	template<typename Type, typename GrowthPolicy>
+	void mapped_vector<Type, GrowthPolicy>::close() noexcept
+	{
+		if (!is_open())
+			return;
+
+		// don't leave unused capacity in the file
+		if (m_capacity != m_size)
+			resize(m_size);
+
+		munmap(m_header, file_bytes(m_capacity));
+		::close(m_file);
+		forget();
+	}
+
+	//************************************
+	// Flush method
+	//************************************
+	template<typename Type, typename GrowthPolicy>
+	bool mapped_vector<Type, GrowthPolicy>::flush(FlushMode mode) noexcept
+	{
+		assert(is_open());
+		return msync(m_header, file_bytes(m_capacity), mode == FlushMode::FLUSH_SYNC ? MS_SYNC : MS_ASYNC) == 0;
+	}
+
+	//************************************
+	// Resize method (no initialization)
+	//************************************
+	template<typename Type, typename GrowthPolicy>
+	size_t mapped_vector<Type, GrowthPolicy>::resize(size_t size) noexcept
+	{
+		assert(is_open());
+		if (size == m_capacity)
+			return m_capacity;
+
+		size_t oldBytes = file_bytes(m_capacity);
+		size_t newBytes = file_bytes(size);
+
+		// the file has to cover the mapping before it is touched, and
+		// the mapping has to shrink before the file does
+		if (size > m_capacity)
+		{
+			if (ftruncate(m_file, static_cast<off_t>(newBytes)) != 0)
+				return m_capacity;
+			if (!remap(oldBytes, newBytes))
+			{
+				if (ftruncate(m_file, static_cast<off_t>(oldBytes)) != 0) {}
+				return m_capacity;
+			}
+		}
+		else
+		{
+			if (size < m_size)
+				set_size(size);
+			if (!remap(oldBytes, newBytes))
+				return m_capacity;
+			if (ftruncate(m_file, static_cast<off_t>(newBytes)) != 0) {}
+		}
+
+		m_capacity = size;
+		m_header->capacity = size;
+		return m_capacity;
+	}
+
+	//************************************
+	// Resize method (initialization)
+	//************************************
+	template<typename Type, typename GrowthPolicy>
+	size_t mapped_vector<Type, GrowthPolicy>::resize(size_t size, const Type& val) noexcept
+	{
+		size_t oldCapacity = m_capacity;
+		if (resize(size) != size)
+			return m_capacity;
+
+		// initialize the new data
+		if (m_capacity > oldCapacity)
+			nids::fill(m_array + oldCapacity, m_array + m_capacity, val);
+
+		return m_capacity;
+	}
+
+	//************************************
+	// Remapping method
+	//************************************
+	template<typename Type, typename GrowthPolicy>
+	bool mapped_vector<Type, GrowthPolicy>::remap(size_t oldBytes, size_t newBytes) noexcept
+	{
+#ifdef __linux__
+		void* base = mremap(m_header, oldBytes, newBytes, MREMAP_MAYMOVE);
+		if (base == MAP_FAILED)
+			return false;
+#else
+		void* base = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+		if (base == MAP_FAILED)
+			return false;
+		munmap(m_header, oldBytes);
+#endif
+		m_header = static_cast<file_header*>(base);
+		m_array = reinterpret_cast<Type*>(static_cast<unsigned char*>(base) + HEADER_SIZE);
+		return true;
+	}
+}
@@ -10,17 +10,24 @@
 #pragma once
 
 #include <assert.h>
-#include <vector>
+#include "small_vector.h"
 
 namespace nids
 {
 	// simple ID data type for convenience
 	using node_id = unsigned long;
 
+	// neighbors kept inline before a node's neighbor list hits the heap
+	const size_t NODE_INLINE_NEIGHBORS = 4;
+
 	template<typename GraphDataType>
 	class Node final
 	{
 	public:
+		// most nodes have a low degree, so keep the first few neighbors inline
+		using neighbor_list = small_vector<Node*, NODE_INLINE_NEIGHBORS>;
+		using neighbor_iterator = typename neighbor_list::iterator;
+
 		// all defaults should be fine for this class
 		inline Node(node_id id, GraphDataType data) noexcept : m_id(id), m_data(data), m_neighbors() {}
 		Node(const Node&) = default;
@@ -48,12 +55,12 @@ namespace nids
 		// Iterator accessor method
 		// Returns:		First neighbor
 		//**********************************
-		inline typename std::vector<Node*>::iterator GetNeighborIterator() noexcept { return m_neighbors.begin(); }
+		inline neighbor_iterator GetNeighborIterator() noexcept { return m_neighbors.begin(); }
 
 		//**********************************
 		// Iterator end method
 		//**********************************
-		inline typename std::vector<Node*>::iterator GetNeigborEnd() noexcept { return m_neighbors.end(); }
+		inline neighbor_iterator GetNeigborEnd() noexcept { return m_neighbors.end(); }
 
 		//**********************************
 		// Neighbor adding method
@@ -77,12 +84,12 @@ namespace nids
 		GraphDataType m_data;
 
 		// list of the neighbors adjacent to this node
-		std::vector<Node*> m_neighbors;
+		neighbor_list m_neighbors;
 	};
 
 	// use this for shorthand to refer to the iterator we get
 	template<typename GraphDataType>
-	using node_iter = typename std::vector<class Node<GraphDataType>*>::iterator;
+	using node_iter = typename Node<GraphDataType>::neighbor_iterator;
 
 	//**************************************
 	// Neighbor adding method
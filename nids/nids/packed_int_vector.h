@@ -0,0 +1,719 @@
+//**************************************
+// packed_int_vector.h
+//
+// Holds nids::packed_int_vector, an
+// append only vector of integers stored
+// compressed in blocks of 128.
+//
+// Each block keeps either the offset of
+// every value from the block minimum
+// (frame of reference) or, for sorted
+// blocks, the gap from the value 4
+// before it (delta), in as few bits as
+// the largest one needs. A sorted list of
+// IDs with 8 byte elements typically
+// shrinks 4 to 8 times, and scanning it
+// reads that much less memory
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "simd.h"
+#include "vector.h"
+
+namespace nids
+{
+	// how a block's values are stored
+	enum class BlockEncoding : uint8_t
+	{
+		BLOCK_FRAME,	// value - base, packed
+		BLOCK_DELTA,	// value - the value 4 before it (the first 4 take base), packed
+		BLOCK_RAW		// values too far apart to pack, two words each
+	};
+
+	//**************************************
+	// Packed block header
+	//
+	// One per full block, so any value can
+	// be found without decoding the blocks
+	// before it
+	//**************************************
+	struct packed_block_header
+	{
+		uint64_t base;
+		uint32_t offset;		// first word of the block
+		uint8_t bits;			// bits per packed value
+		BlockEncoding encoding;
+	};
+
+	//**************************************
+	// Bit packing constants
+	//
+	// A block is stored as 4 interleaved
+	// lanes of 32 bit words, lane l
+	// holding values l, l + 4, l + 8, ...
+	// so one SSE2 register unpacks 4
+	// values at once. A block packed at b
+	// bits takes 4 * b words
+	//**************************************
+	const size_t PACKED_BLOCK_SIZE = 128;
+	const size_t PACKED_LANES = 4;
+	const size_t PACKED_LANE_VALUES = PACKED_BLOCK_SIZE / PACKED_LANES;
+
+	// widest delta block whose gaps always add up within 32 bits
+	const unsigned PACKED_DELTA_SUM_BITS = 24;
+
+	//**************************************
+	// Bit width helper
+	//
+	// Returns the bits needed to hold
+	// value
+	//**************************************
+	inline unsigned bit_width(uint64_t value) noexcept
+	{
+		unsigned bits{ 0 };
+		for (; value != 0; value >>= 1)
+			++bits;
+		return bits;
+	}
+
+	//**************************************
+	// Block packing method
+	//
+	// Packs 128 values of at most bits
+	// bits (32 or fewer) into 4 * bits
+	// zeroed words
+	//**************************************
+	inline void pack_block(const uint32_t* values, unsigned bits, uint32_t* words) noexcept
+	{
+		assert(bits <= 32);
+		if (bits == 0)
+			return;
+		for (size_t step{ 0 }; step < PACKED_LANE_VALUES; ++step)
+		{
+			size_t position = step * bits;
+			size_t word = position / 32;
+			unsigned shift = position % 32;
+			for (size_t lane{ 0 }; lane < PACKED_LANES; ++lane)
+			{
+				uint32_t value = values[step * PACKED_LANES + lane];
+				words[word * PACKED_LANES + lane] |= value << shift;
+				if (shift + bits > 32)
+					words[(word + 1) * PACKED_LANES + lane] |= value >> (32 - shift);
+			}
+		}
+	}
+
+	//**************************************
+	// Packed value extraction method
+	//
+	// Unpacks the single value at index
+	// of a packed block
+	//**************************************
+	inline uint32_t unpack_value(const uint32_t* words, unsigned bits, size_t index) noexcept
+	{
+		if (bits == 0)
+			return 0;
+		size_t position = (index / PACKED_LANES) * bits;
+		size_t lane = index % PACKED_LANES;
+		size_t word = position / 32;
+		unsigned shift = position % 32;
+
+		uint64_t value = words[word * PACKED_LANES + lane] >> shift;
+		if (shift + bits > 32)
+			value |= static_cast<uint64_t>(words[(word + 1) * PACKED_LANES + lane]) << (32 - shift);
+		return static_cast<uint32_t>(value & ((uint64_t{ 1 } << bits) - 1));
+	}
+}
+
+#ifdef NIDS_SIMD_X86
+//**************************************
+// SSE2 unpacking kernels
+//**************************************
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+namespace nids::simd_sse2
+{
+	//**************************************
+	// Unpack step kernel
+	//
+	// Unpacks value Step of all 4 lanes
+	//**************************************
+	template<unsigned Bits, size_t Step>
+	inline void unpack_step(const __m128i* words, __m128i* values, __m128i mask) noexcept
+	{
+		const size_t WORD = Step * Bits / 32;
+		const unsigned SHIFT = Step * Bits % 32;
+
+		__m128i value = _mm_srli_epi32(_mm_loadu_si128(words + WORD), SHIFT);
+		if constexpr (SHIFT + Bits > 32)
+			value = _mm_or_si128(value, _mm_slli_epi32(_mm_loadu_si128(words + WORD + 1), 32 - SHIFT));
+		if constexpr (Bits < 32)
+			value = _mm_and_si128(value, mask);
+		_mm_storeu_si128(values + Step, value);
+	}
+
+	template<unsigned Bits, size_t... Steps>
+	inline void unpack_steps(const uint32_t* words, uint32_t* values, std::index_sequence<Steps...>) noexcept
+	{
+		const __m128i mask = _mm_set1_epi32(static_cast<int>((uint64_t{ 1 } << Bits) - 1));
+		(unpack_step<Bits, Steps>(reinterpret_cast<const __m128i*>(words), reinterpret_cast<__m128i*>(values), mask), ...);
+	}
+
+	//**************************************
+	// Unpack block kernel
+	//
+	// One per bit width, fully unrolled so
+	// every shift is a constant
+	//**************************************
+	template<unsigned Bits>
+	void unpack_block(const uint32_t* words, uint32_t* values) noexcept
+	{
+		if constexpr (Bits == 0)
+			memset(values, 0, sizeof(uint32_t) * PACKED_BLOCK_SIZE);
+		else
+			unpack_steps<Bits>(words, values, std::make_index_sequence<PACKED_LANE_VALUES>());
+	}
+
+	//**************************************
+	// Unpack kernel table
+	//
+	// Indexed by bit width, 0 through 32
+	//**************************************
+	using unpack_kernel = void (*)(const uint32_t*, uint32_t*) noexcept;
+
+	template<size_t... Widths>
+	inline const unpack_kernel* unpack_table(std::index_sequence<Widths...>) noexcept
+	{
+		static const unpack_kernel kernels[] = { &unpack_block<static_cast<unsigned>(Widths)>... };
+		return kernels;
+	}
+
+	inline void unpack_block(const uint32_t* words, unsigned bits, uint32_t* values) noexcept
+	{
+		unpack_table(std::make_index_sequence<33>())[bits](words, values);
+	}
+
+	//**************************************
+	// Decode kernel
+	//
+	// Adds up the gaps of a delta block,
+	// which are 4 values apart so each
+	// lane keeps its own running total,
+	// then adds the base and widens to Type
+	//**************************************
+	template<typename Type>
+	inline void decode_block(const uint32_t* words, unsigned bits, bool delta, uint64_t base, Type* values) noexcept
+	{
+		alignas(16) uint32_t packed[PACKED_BLOCK_SIZE];
+		unpack_block(words, bits, packed);
+
+		const __m128i* source = reinterpret_cast<const __m128i*>(packed);
+		__m128i* dest = reinterpret_cast<__m128i*>(values);
+		__m128i sum = _mm_setzero_si128();
+
+		// frame blocks clear the running total every group
+		const __m128i keep = delta ? _mm_set1_epi32(-1) : _mm_setzero_si128();
+		if constexpr (sizeof(Type) == 4)
+		{
+			const __m128i offset = _mm_set1_epi32(static_cast<int>(base));
+			for (size_t group{ 0 }; group < PACKED_LANE_VALUES; ++group)
+			{
+				sum = _mm_add_epi32(_mm_and_si128(sum, keep), _mm_load_si128(source + group));
+				_mm_storeu_si128(dest + group, _mm_add_epi32(sum, offset));
+			}
+		}
+		else
+		{
+			const __m128i offset = _mm_set1_epi64x(static_cast<int64_t>(base));
+			const __m128i zero = _mm_setzero_si128();
+			for (size_t group{ 0 }; group < PACKED_LANE_VALUES; ++group)
+			{
+				sum = _mm_add_epi32(_mm_and_si128(sum, keep), _mm_load_si128(source + group));
+				_mm_storeu_si128(dest + 2 * group, _mm_add_epi64(_mm_unpacklo_epi32(sum, zero), offset));
+				_mm_storeu_si128(dest + 2 * group + 1, _mm_add_epi64(_mm_unpackhi_epi32(sum, zero), offset));
+			}
+		}
+	}
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
+
+namespace nids
+{
+	//**************************************
+	// Block unpacking method
+	//
+	// Unpacks the 128 values of a block
+	// packed at bits bits (32 or fewer)
+	//**************************************
+	inline void unpack_block(const uint32_t* words, unsigned bits, uint32_t* values) noexcept
+	{
+		assert(bits <= 32);
+#ifdef NIDS_SIMD_X86
+		if (simd_level() >= SimdLevel::SIMD_SSE2)
+		{
+			simd_sse2::unpack_block(words, bits, values);
+			return;
+		}
+#endif
+		for (size_t index{ 0 }; index < PACKED_BLOCK_SIZE; ++index)
+			values[index] = unpack_value(words, bits, index);
+	}
+
+	//**************************************
+	// Block decoding method
+	//
+	// Unpacks the 128 values of a block
+	// and adds base to each. With delta,
+	// each value is first added to every
+	// fourth value before it, in 32 bits,
+	// so delta blocks can be at most
+	// PACKED_DELTA_SUM_BITS wide
+	//**************************************
+	template<typename Type>
+	inline void decode_block(const uint32_t* words, unsigned bits, bool delta, uint64_t base, Type* values) noexcept
+	{
+		assert(bits <= (delta ? PACKED_DELTA_SUM_BITS : 32));
+#ifdef NIDS_SIMD_X86
+		if constexpr (sizeof(Type) == 4 || sizeof(Type) == 8)
+		{
+			if (simd_level() >= SimdLevel::SIMD_SSE2)
+			{
+				simd_sse2::decode_block(words, bits, delta, base, values);
+				return;
+			}
+		}
+#endif
+		using unsigned_type = std::make_unsigned_t<Type>;
+		uint32_t packed[PACKED_BLOCK_SIZE];
+		unpack_block(words, bits, packed);
+		if (delta)
+			for (size_t index{ PACKED_LANES }; index < PACKED_BLOCK_SIZE; ++index)
+				packed[index] += packed[index - PACKED_LANES];
+		for (size_t index{ 0 }; index < PACKED_BLOCK_SIZE; ++index)
+			values[index] = static_cast<Type>(static_cast<unsigned_type>(base) + packed[index]);
+	}
+
+	template<typename Container>
+	class packed_iterator;
+
+	template<typename Type = uint64_t, typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class packed_int_vector final
+	{
+		static_assert(std::is_integral_v<Type> && !std::is_same_v<Type, bool> && sizeof(Type) <= 8, "packed_int_vector holds integers of up to 64 bits");
+	public:
+		using value_type = Type;
+		using unsigned_type = std::make_unsigned_t<Type>;
+		using iterator = packed_iterator<packed_int_vector>;
+		using const_iterator = iterator;
+		using growth_policy = GrowthPolicy;
+		using allocator_type = Allocator;
+
+		// values in each block
+		static const size_t BLOCK_SIZE = PACKED_BLOCK_SIZE;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline packed_int_vector() noexcept : m_headers(), m_words(), m_pending(), m_size(0) {}
+
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit packed_int_vector(const Allocator& allocator) noexcept
+			: m_headers(allocator), m_words(allocator), m_pending(allocator), m_size(0) {}
+
+		//************************************
+		// Range constructor
+		//************************************
+		template<typename Iterator>
+		inline packed_int_vector(Iterator first, Iterator last) noexcept : m_headers(), m_words(), m_pending(), m_size(0)
+		{
+			assign(first, last);
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Block count accessor
+		//
+		// Includes the partly filled last
+		// block
+		//************************************
+		inline size_t block_count() const noexcept { return (m_size + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+		//************************************
+		// Header getter
+		//
+		// Only full blocks have a header
+		//************************************
+		inline const packed_block_header& header(size_t block) const noexcept
+		{
+			assert(block < m_headers.size());
+			return m_headers[block];
+		}
+
+		//************************************
+		// Compressed size accessor
+		//
+		// Returns the bytes the values take,
+		// headers included
+		//************************************
+		inline size_t compressed_bytes() const noexcept
+		{
+			return sizeof(packed_block_header) * m_headers.size() + sizeof(uint32_t) * m_words.size() + sizeof(Type) * m_pending.size();
+		}
+
+		//************************************
+		// Subscript operator
+		//
+		// Returns the value at index. Delta
+		// blocks add up the gaps before it,
+		// up to 32 of them
+		//************************************
+		Type operator[](size_t index) const noexcept;
+
+		//************************************
+		// Back accessor
+		//************************************
+		inline Type back() const noexcept
+		{
+			assert(m_size > 0);
+			return (*this)[m_size - 1];
+		}
+
+		//************************************
+		// Block decoding method
+		//
+		// Writes the values of block to
+		// values, which must hold BLOCK_SIZE
+		//
+		// Returns the number written
+		//************************************
+		size_t decode_block(size_t block, Type* values) const noexcept;
+
+		//************************************
+		// Iterator getters
+		//
+		// The iterator decodes a block at a
+		// time into its own buffer as it
+		// moves forward
+		//************************************
+		inline iterator begin() const noexcept { return iterator(this, 0); }
+		inline iterator end() const noexcept { return iterator(this, m_size); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Push back method
+		//
+		// Values collect unpacked until
+		// there are BLOCK_SIZE of them, then
+		// they are packed as a block
+		//************************************
+		inline void push_back(Type value) noexcept
+		{
+			m_pending.push_back(value);
+			++m_size;
+			if (m_pending.size() == BLOCK_SIZE)
+			{
+				pack(m_pending.data());
+				m_pending.resize_default_init(0);
+			}
+		}
+
+		//************************************
+		// Assign method
+		//
+		// Replaces the contents with
+		// [first, last)
+		//************************************
+		template<typename Iterator>
+		inline void assign(Iterator first, Iterator last) noexcept
+		{
+			clear();
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		//************************************
+		// Clear method
+		//
+		// Keeps the capacity
+		//************************************
+		inline void clear() noexcept
+		{
+			m_headers.resize_default_init(0);
+			m_words.resize_default_init(0);
+			m_pending.resize_default_init(0);
+			m_size = 0;
+		}
+	private:
+		//************************************
+		// Gap origin helper
+		//
+		// Returns what a delta block stores
+		// the value at index relative to
+		//************************************
+		static inline unsigned_type gap_origin(const Type* values, size_t index) noexcept
+		{
+			return static_cast<unsigned_type>(index < PACKED_LANES ? values[0] : values[index - PACKED_LANES]);
+		}
+
+		//************************************
+		// Block packing method
+		//
+		// Encodes BLOCK_SIZE values into a
+		// new block
+		//************************************
+		void pack(const Type* values) noexcept;
+
+		vector<packed_block_header, GrowthPolicy, Allocator> m_headers;
+		vector<uint32_t, GrowthPolicy, Allocator> m_words;
+
+		// values of the last, partly filled block
+		vector<Type, GrowthPolicy, Allocator> m_pending;
+		size_t m_size;
+	};
+
+	//**********************************
+	// Block packing method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	void packed_int_vector<Type, GrowthPolicy, Allocator>::pack(const Type* values) noexcept
+	{
+		// the range and the largest gap pick the encoding
+		unsigned_type low = static_cast<unsigned_type>(values[0]);
+		unsigned_type high = low;
+		unsigned_type largestGap{ 0 };
+		bool sorted{ true };
+		for (size_t index{ 1 }; index < BLOCK_SIZE; ++index)
+		{
+			unsigned_type value = static_cast<unsigned_type>(values[index]);
+			if (values[index] < values[index - 1])
+				sorted = false;
+			else if (value - gap_origin(values, index) > largestGap)
+				largestGap = value - gap_origin(values, index);
+			if (values[index] < static_cast<Type>(low))
+				low = value;
+			if (static_cast<Type>(high) < values[index])
+				high = value;
+		}
+
+		packed_block_header header;
+		header.offset = static_cast<uint32_t>(m_words.size());
+		header.bits = static_cast<uint8_t>(bit_width(high - low));
+		header.encoding = BlockEncoding::BLOCK_FRAME;
+		header.base = low;
+		if (sorted && bit_width(largestGap) < header.bits && bit_width(largestGap) <= PACKED_DELTA_SUM_BITS)
+		{
+			header.bits = static_cast<uint8_t>(bit_width(largestGap));
+			header.encoding = BlockEncoding::BLOCK_DELTA;
+			header.base = static_cast<unsigned_type>(values[0]);
+		}
+		if (header.bits > 32)
+		{
+			header.bits = 64;
+			header.encoding = BlockEncoding::BLOCK_RAW;
+			header.base = 0;
+		}
+		assert(m_words.size() + 2 * BLOCK_SIZE <= UINT32_MAX);
+
+		size_t wordCount = header.encoding == BlockEncoding::BLOCK_RAW ? 2 * BLOCK_SIZE : PACKED_LANES * header.bits;
+		m_words.resize_default_init(m_words.size() + wordCount);
+		uint32_t* words = m_words.data() + header.offset;
+		if (header.encoding == BlockEncoding::BLOCK_RAW)
+		{
+			for (size_t index{ 0 }; index < BLOCK_SIZE; ++index)
+			{
+				uint64_t value = static_cast<unsigned_type>(values[index]);
+				words[2 * index] = static_cast<uint32_t>(value);
+				words[2 * index + 1] = static_cast<uint32_t>(value >> 32);
+			}
+		}
+		else
+		{
+			uint32_t packed[BLOCK_SIZE];
+			for (size_t index{ 0 }; index < BLOCK_SIZE; ++index)
+			{
+				unsigned_type from = header.encoding == BlockEncoding::BLOCK_DELTA ? gap_origin(values, index) : static_cast<unsigned_type>(header.base);
+				packed[index] = static_cast<uint32_t>(static_cast<unsigned_type>(values[index]) - from);
+			}
+			// a constant block has no words, and words may be null
+			if (wordCount > 0)
+				memset(words, 0, sizeof(uint32_t) * wordCount);
+			pack_block(packed, header.bits, words);
+		}
+		m_headers.push_back(header);
+	}
+
+	//**********************************
+	// Subscript operator
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	Type packed_int_vector<Type, GrowthPolicy, Allocator>::operator[](size_t index) const noexcept
+	{
+		assert(index < m_size);
+		size_t block = index / BLOCK_SIZE;
+		size_t offset = index % BLOCK_SIZE;
+		if (block == m_headers.size())
+			return m_pending[offset];
+
+		const packed_block_header& header = m_headers[block];
+		const uint32_t* words = m_words.data() + header.offset;
+		switch (header.encoding)
+		{
+		case BlockEncoding::BLOCK_RAW:
+			return static_cast<Type>(words[2 * offset] | (static_cast<uint64_t>(words[2 * offset + 1]) << 32));
+		case BlockEncoding::BLOCK_FRAME:
+			return static_cast<Type>(static_cast<unsigned_type>(header.base) + unpack_value(words, header.bits, offset));
+		default:
+		{
+			uint32_t packed[BLOCK_SIZE];
+			unpack_block(words, header.bits, packed);
+			uint32_t gaps{ 0 };
+			for (size_t step{ offset % PACKED_LANES }; step <= offset; step += PACKED_LANES)
+				gaps += packed[step];
+			return static_cast<Type>(static_cast<unsigned_type>(header.base) + gaps);
+		}
+		}
+	}
+
+	//**********************************
+	// Block decoding method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	size_t packed_int_vector<Type, GrowthPolicy, Allocator>::decode_block(size_t block, Type* values) const noexcept
+	{
+		assert(block < block_count());
+		if (block == m_headers.size())
+		{
+			memcpy(values, m_pending.data(), sizeof(Type) * m_pending.size());
+			return m_pending.size();
+		}
+
+		const packed_block_header& header = m_headers[block];
+		const uint32_t* words = m_words.data() + header.offset;
+		if (header.encoding == BlockEncoding::BLOCK_RAW)
+		{
+			for (size_t index{ 0 }; index < BLOCK_SIZE; ++index)
+				values[index] = static_cast<Type>(words[2 * index] | (static_cast<uint64_t>(words[2 * index + 1]) << 32));
+			return BLOCK_SIZE;
+		}
+
+		nids::decode_block(words, header.bits, header.encoding == BlockEncoding::BLOCK_DELTA, header.base, values);
+		return BLOCK_SIZE;
+	}
+
+	//**************************************
+	// Packed iterator
+	//
+	// Input iterator over a
+	// packed_int_vector that decodes one
+	// block at a time into a buffer it
+	// carries, so scanning does no per
+	// value work beyond the unpacking.
+	// References point into that buffer
+	// and don't outlive the iterator, so
+	// it isn't a forward iterator
+	//**************************************
+	template<typename Container>
+	class packed_iterator final
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = typename Container::value_type;
+		using difference_type = ptrdiff_t;
+		using reference = const value_type&;
+		using pointer = const value_type*;
+
+		//******************************
+		// Default constructor
+		//******************************
+		inline packed_iterator() noexcept : m_vector(nullptr), m_index(0) {}
+
+		//******************************
+		// Constructor
+		//******************************
+		inline packed_iterator(const Container* vector, size_t index) noexcept : m_vector(vector), m_index(index)
+		{
+			assert(m_vector != nullptr);
+			if (m_index < m_vector->size())
+				load();
+		}
+
+		//*******[ Movement Operations ]
+		//******************************
+		// Increment operator (prefix)
+		//******************************
+		inline packed_iterator& operator++() noexcept
+		{
+			assert(m_index < m_vector->size());
+			++m_index;
+			if (m_index % Container::BLOCK_SIZE == 0 && m_index < m_vector->size())
+				load();
+			return *this;
+		}
+
+		//******************************
+		// Increment operator (postfix)
+		//******************************
+		inline packed_iterator operator++(int) noexcept
+		{
+			packed_iterator _r = *this;
+			++*this;
+			return _r;
+		}
+
+		//*****[ Comparison Operations ]
+		inline bool operator==(const packed_iterator& rhs) const noexcept { return m_index == rhs.m_index; }
+		inline bool operator!=(const packed_iterator& rhs) const noexcept { return m_index != rhs.m_index; }
+
+		//*******[ Accessor Operations ]
+		//******************************
+		// Dereference operator
+		//******************************
+		inline reference operator*() const noexcept { return m_values[m_index % Container::BLOCK_SIZE]; }
+
+		//******************************
+		// Pointer operator
+		//******************************
+		inline pointer operator->() const noexcept { return &m_values[m_index % Container::BLOCK_SIZE]; }
+	private:
+		//******************************
+		// Block loading method
+		//******************************
+		inline void load() noexcept { m_vector->decode_block(m_index / Container::BLOCK_SIZE, m_values); }
+
+		const Container* m_vector;
+		size_t m_index;
+		value_type m_values[Container::BLOCK_SIZE];
+	};
+}
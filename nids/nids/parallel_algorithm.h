@@ -0,0 +1,403 @@
+//**************************************
+// parallel_algorithm.h
+//
+// Holds the parallel algorithms for
+// contiguous ranges (nids::vector
+// iterators, pointers): for_each,
+// transform, reduce, inclusive_scan,
+// copy_if, and sort.
+//
+// A range is cut into a few chunks per
+// thread, with every cut on a cache
+// line boundary so no two threads write
+// the same line, and the chunks are run
+// on a nids::thread_pool. Ranges too
+// small to be worth splitting run
+// sequentially on the calling thread
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+#include "aligned_allocator.h"
+#include "relocation.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+namespace nids
+{
+	// smallest chunk worth handing to another thread
+	const size_t PARALLEL_GRAIN_BYTES = 64 * 1024;
+
+	// chunks per thread, so a thread that finishes early can steal more
+	const size_t PARALLEL_CHUNKS_PER_THREAD = 4;
+
+	//**************************************
+	// Chunk count method
+	//
+	// Returns how many chunks to split
+	// count elements of elementSize bytes
+	// into, 1 meaning run sequentially
+	//**************************************
+	inline size_t parallel_chunk_count(const thread_pool& pool, size_t count, size_t elementSize) noexcept
+	{
+		size_t byGrain = count * elementSize / PARALLEL_GRAIN_BYTES;
+		size_t byThreads = pool.size() * PARALLEL_CHUNKS_PER_THREAD;
+		size_t chunks = byGrain < byThreads ? byGrain : byThreads;
+		return pool.size() > 1 && chunks > 1 ? chunks : 1;
+	}
+
+	//**************************************
+	// Chunk boundary method
+	//
+	// Returns the index chunk starts at
+	// when count elements from first are
+	// cut into chunks pieces. Every inner
+	// boundary is rounded up to the next
+	// cache line
+	//**************************************
+	template<typename Type>
+	inline size_t parallel_chunk_start(const Type* first, size_t count, size_t chunks, size_t chunk) noexcept
+	{
+		if (chunk == 0)
+			return 0;
+		if (chunk >= chunks)
+			return count;
+
+		uintptr_t base = reinterpret_cast<uintptr_t>(first);
+		uintptr_t even = reinterpret_cast<uintptr_t>(first + count / chunks * chunk + count % chunks * chunk / chunks);
+		uintptr_t aligned = (even + CACHE_LINE_SIZE - 1) & ~static_cast<uintptr_t>(CACHE_LINE_SIZE - 1);
+		size_t index = static_cast<size_t>((aligned - base + sizeof(Type) - 1) / sizeof(Type));
+		return index < count ? index : count;
+	}
+
+	//**************************************
+	// Range pointer method
+	//
+	// Returns the address of the first
+	// element of a contiguous range
+	//**************************************
+	template<typename Iterator>
+	inline auto parallel_range_data(Iterator first, size_t count) noexcept -> decltype(&*first)
+	{
+		static_assert(is_contiguous_iterator_v<Iterator>, "parallel algorithms need contiguous iterators");
+		return count > 0 ? &*first : nullptr;
+	}
+
+	//**************************************
+	// For each method
+	//
+	// Calls function on every element of
+	// [first, last), in no particular
+	// order
+	//**************************************
+	template<typename Iterator, typename Function>
+	void parallel_for_each(thread_pool& pool, Iterator first, Iterator last, Function function) noexcept
+	{
+		size_t count = range_length(first, last);
+		auto data = parallel_range_data(first, count);
+		size_t chunks = parallel_chunk_count(pool, count, sizeof(*data));
+		pool.run(chunks, [&](size_t chunk)
+		{
+			size_t end = parallel_chunk_start(data, count, chunks, chunk + 1);
+			for (size_t index = parallel_chunk_start(data, count, chunks, chunk); index < end; ++index)
+				function(data[index]);
+		});
+	}
+
+	template<typename Iterator, typename Function>
+	inline void parallel_for_each(Iterator first, Iterator last, Function function) noexcept
+	{
+		parallel_for_each(default_thread_pool(), first, last, function);
+	}
+
+	//**************************************
+	// Transform method
+	//
+	// Writes operation(element) for every
+	// element of [first, last) to the
+	// range starting at dest, which must
+	// already hold as many elements
+	//
+	// Returns the end of the output
+	//**************************************
+	template<typename Iterator, typename OutIterator, typename Operation>
+	OutIterator parallel_transform(thread_pool& pool, Iterator first, Iterator last, OutIterator dest, Operation operation) noexcept
+	{
+		size_t count = range_length(first, last);
+		auto data = parallel_range_data(first, count);
+		auto out = parallel_range_data(dest, count);
+
+		// cut on the output, the side that is written
+		size_t chunks = parallel_chunk_count(pool, count, sizeof(*out));
+		pool.run(chunks, [&](size_t chunk)
+		{
+			size_t end = parallel_chunk_start(out, count, chunks, chunk + 1);
+			for (size_t index = parallel_chunk_start(out, count, chunks, chunk); index < end; ++index)
+				out[index] = operation(data[index]);
+		});
+		return dest + static_cast<ptrdiff_t>(count);
+	}
+
+	template<typename Iterator, typename OutIterator, typename Operation>
+	inline OutIterator parallel_transform(Iterator first, Iterator last, OutIterator dest, Operation operation) noexcept
+	{
+		return parallel_transform(default_thread_pool(), first, last, dest, operation);
+	}
+
+	//**************************************
+	// Reduce method
+	//
+	// Folds [first, last) into init with
+	// operation, which must be associative
+	// since every chunk is folded on its
+	// own. Chunk results are combined in
+	// order, so the result only depends on
+	// the pool size
+	//**************************************
+	template<typename Iterator, typename Type, typename Operation = std::plus<>>
+	Type parallel_reduce(thread_pool& pool, Iterator first, Iterator last, Type init, Operation operation = Operation()) noexcept
+	{
+		size_t count = range_length(first, last);
+		auto data = parallel_range_data(first, count);
+		size_t chunks = parallel_chunk_count(pool, count, sizeof(*data));
+		if (chunks == 1)
+		{
+			for (size_t index{ 0 }; index < count; ++index)
+				init = operation(init, data[index]);
+			return init;
+		}
+
+		vector<Type> partials;
+		partials.reserve(chunks);
+		for (size_t chunk{ 0 }; chunk < chunks; ++chunk)
+			partials.push_back(init);
+
+		pool.run(chunks, [&](size_t chunk)
+		{
+			size_t start = parallel_chunk_start(data, count, chunks, chunk);
+			size_t end = parallel_chunk_start(data, count, chunks, chunk + 1);
+			assert(start < end);
+			Type partial = data[start];
+			for (size_t index = start + 1; index < end; ++index)
+				partial = operation(partial, data[index]);
+			partials[chunk] = partial;
+		});
+
+		for (size_t chunk{ 0 }; chunk < chunks; ++chunk)
+			init = operation(init, partials[chunk]);
+		return init;
+	}
+
+	template<typename Iterator, typename Type, typename Operation = std::plus<>>
+	inline Type parallel_reduce(Iterator first, Iterator last, Type init, Operation operation = Operation()) noexcept
+	{
+		return parallel_reduce(default_thread_pool(), first, last, init, operation);
+	}
+
+	//**************************************
+	// Inclusive scan method
+	//
+	// Writes the running fold of [first,
+	// last) to the range starting at dest
+	// (which may be first). Two passes:
+	// every chunk is folded, the chunk
+	// totals are scanned, then every chunk
+	// is scanned from its carry in
+	//
+	// Returns the end of the output
+	//**************************************
+	template<typename Iterator, typename OutIterator, typename Operation = std::plus<>>
+	OutIterator parallel_inclusive_scan(thread_pool& pool, Iterator first, Iterator last, OutIterator dest, Operation operation = Operation()) noexcept
+	{
+		size_t count = range_length(first, last);
+		auto data = parallel_range_data(first, count);
+		auto out = parallel_range_data(dest, count);
+		using Type = std::remove_reference_t<decltype(*out)>;
+
+		size_t chunks = parallel_chunk_count(pool, count, sizeof(*out));
+		if (chunks == 1)
+		{
+			if (count > 0)
+			{
+				Type total = data[0];
+				out[0] = total;
+				for (size_t index{ 1 }; index < count; ++index)
+					out[index] = total = operation(total, data[index]);
+			}
+			return dest + static_cast<ptrdiff_t>(count);
+		}
+
+		// each chunk's total, then each chunk's carry in
+		vector<Type> carries;
+		carries.reserve(chunks);
+		for (size_t chunk{ 0 }; chunk < chunks; ++chunk)
+			carries.push_back(data[0]);
+
+		// the first chunk needs no carry, so it is scanned straight away
+		pool.run(chunks, [&](size_t chunk)
+		{
+			size_t start = parallel_chunk_start(out, count, chunks, chunk);
+			size_t end = parallel_chunk_start(out, count, chunks, chunk + 1);
+			assert(start < end);
+			Type total = data[start];
+			if (chunk == 0)
+				out[start] = total;
+			for (size_t index = start + 1; index < end; ++index)
+			{
+				total = operation(total, data[index]);
+				if (chunk == 0)
+					out[index] = total;
+			}
+			carries[chunk] = total;
+		});
+
+		Type running = carries[0];
+		for (size_t chunk{ 1 }; chunk < chunks; ++chunk)
+		{
+			Type total = carries[chunk];
+			carries[chunk] = running;
+			running = operation(running, total);
+		}
+
+		pool.run(chunks - 1, [&](size_t chunk)
+		{
+			++chunk;
+			size_t start = parallel_chunk_start(out, count, chunks, chunk);
+			size_t end = parallel_chunk_start(out, count, chunks, chunk + 1);
+			Type total = carries[chunk];
+			for (size_t index = start; index < end; ++index)
+				out[index] = total = operation(total, data[index]);
+		});
+		return dest + static_cast<ptrdiff_t>(count);
+	}
+
+	template<typename Iterator, typename OutIterator, typename Operation = std::plus<>>
+	inline OutIterator parallel_inclusive_scan(Iterator first, Iterator last, OutIterator dest, Operation operation = Operation()) noexcept
+	{
+		return parallel_inclusive_scan(default_thread_pool(), first, last, dest, operation);
+	}
+
+	//**************************************
+	// Copy if method
+	//
+	// Copies the elements of [first, last)
+	// that satisfy predicate to the range
+	// starting at dest, keeping their
+	// order. dest must already hold enough
+	// elements. Two passes: every chunk
+	// counts its matches, then copies them
+	// to its offset, so predicate is
+	// called twice per element
+	//
+	// Returns the end of the output
+	//**************************************
+	template<typename Iterator, typename OutIterator, typename Predicate>
+	OutIterator parallel_copy_if(thread_pool& pool, Iterator first, Iterator last, OutIterator dest, Predicate predicate) noexcept
+	{
+		size_t count = range_length(first, last);
+		auto data = parallel_range_data(first, count);
+		size_t chunks = parallel_chunk_count(pool, count, sizeof(*data));
+		if (chunks == 1)
+		{
+			size_t copied{ 0 };
+			for (size_t index{ 0 }; index < count; ++index)
+				if (predicate(data[index]))
+					dest[static_cast<ptrdiff_t>(copied++)] = data[index];
+			return dest + static_cast<ptrdiff_t>(copied);
+		}
+
+		vector<size_t> offsets;
+		offsets.resize_default_init(chunks);
+
+		pool.run(chunks, [&](size_t chunk)
+		{
+			size_t end = parallel_chunk_start(data, count, chunks, chunk + 1);
+			size_t matches{ 0 };
+			for (size_t index = parallel_chunk_start(data, count, chunks, chunk); index < end; ++index)
+				matches += predicate(data[index]) ? 1 : 0;
+			offsets[chunk] = matches;
+		});
+
+		size_t total{ 0 };
+		for (size_t chunk{ 0 }; chunk < chunks; ++chunk)
+		{
+			size_t matches = offsets[chunk];
+			offsets[chunk] = total;
+			total += matches;
+		}
+		if (total == 0)
+			return dest;
+
+		auto out = parallel_range_data(dest, total);
+		pool.run(chunks, [&](size_t chunk)
+		{
+			size_t end = parallel_chunk_start(data, count, chunks, chunk + 1);
+			size_t copied = offsets[chunk];
+			for (size_t index = parallel_chunk_start(data, count, chunks, chunk); index < end; ++index)
+				if (predicate(data[index]))
+					out[copied++] = data[index];
+		});
+		return dest + static_cast<ptrdiff_t>(total);
+	}
+
+	template<typename Iterator, typename OutIterator, typename Predicate>
+	inline OutIterator parallel_copy_if(Iterator first, Iterator last, OutIterator dest, Predicate predicate) noexcept
+	{
+		return parallel_copy_if(default_thread_pool(), first, last, dest, predicate);
+	}
+
+	//**************************************
+	// Sort method
+	//
+	// Sorts [first, last) by compare (not
+	// stably). Every chunk is sorted on
+	// its own, then neighbouring runs are
+	// merged in pairs, doubling in length
+	// each round
+	//**************************************
+	template<typename Iterator, typename Compare = std::less<>>
+	void parallel_sort(thread_pool& pool, Iterator first, Iterator last, Compare compare = Compare()) noexcept
+	{
+		size_t count = range_length(first, last);
+		auto data = parallel_range_data(first, count);
+		size_t chunks = parallel_chunk_count(pool, count, sizeof(*data));
+		if (chunks == 1)
+		{
+			std::sort(data, data + count, compare);
+			return;
+		}
+
+		pool.run(chunks, [&](size_t chunk)
+		{
+			std::sort(data + parallel_chunk_start(data, count, chunks, chunk), data + parallel_chunk_start(data, count, chunks, chunk + 1), compare);
+		});
+
+		for (size_t width{ 1 }; width < chunks; width *= 2)
+		{
+			size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+			pool.run(pairs, [&](size_t pair)
+			{
+				size_t low = pair * 2 * width;
+				size_t middle = low + width;
+				size_t high = low + 2 * width;
+				if (middle >= chunks)
+					return;
+				std::inplace_merge(data + parallel_chunk_start(data, count, chunks, low), data + parallel_chunk_start(data, count, chunks, middle),
+					data + parallel_chunk_start(data, count, chunks, high < chunks ? high : chunks), compare);
+			});
+		}
+	}
+
+	template<typename Iterator, typename Compare = std::less<>>
+	inline void parallel_sort(Iterator first, Iterator last, Compare compare = Compare()) noexcept
+	{
+		parallel_sort(default_thread_pool(), first, last, compare);
+	}
+}
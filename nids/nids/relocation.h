@@ -0,0 +1,442 @@
+//**************************************
+// relocation.h
+//
+// Holds the compile time dispatched
+// element management helpers used by
+// the nids containers.
+//
+// Trivially relocatable types are
+// moved around with realloc / memcpy,
+// everything else is placement-new
+// move constructed and destroyed.
+//
+// The contiguous vectors share their
+// push, emplace, erase, append, and
+// insert logic through the array
+// helpers at the bottom, so vector and
+// small_vector only differ in how they
+// grow
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <new>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+namespace nids
+{
+	//**************************************
+	// Trivial relocation trait
+	//
+	// Defaults to trivially copyable, but
+	// can be specialized for types which
+	// are safe to move with memcpy (such
+	// as handles that only own a pointer)
+	//**************************************
+	template<typename Type>
+	struct is_trivially_relocatable : std::is_trivially_copyable<Type> {};
+
+	template<typename Type>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<Type>::value;
+
+	//**************************************
+	// Contiguous iterator trait
+	//
+	// Iterators whose elements sit next to
+	// each other in memory, so a range of
+	// them can be copied in one go
+	//**************************************
+	template<typename Iterator>
+	struct is_contiguous_iterator : std::is_pointer<Iterator> {};
+
+	template<typename Iterator>
+	inline constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<Iterator>::value;
+
+	//**************************************
+	// Range length method
+	//**************************************
+	template<typename Iterator>
+	inline size_t range_length(Iterator first, Iterator last) noexcept
+	{
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+			return static_cast<size_t>(last - first);
+		else
+			return static_cast<size_t>(std::distance(first, last));
+	}
+
+	//**************************************
+	// Range destruction method
+	//
+	// Destroys count objects starting at
+	// first
+	//**************************************
+	template<typename Type>
+	inline void destroy_range(Type* first, size_t count) noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<Type>)
+			for (size_t index{ 0 }; index < count; ++index)
+				first[index].~Type();
+	}
+
+	//**************************************
+	// Range copy method
+	//
+	// Copy constructs count objects from
+	// source into the raw memory at dest
+	//**************************************
+	template<typename Type>
+	inline void copy_range(Type* dest, const Type* source, size_t count) noexcept
+	{
+		if constexpr (std::is_trivially_copyable_v<Type>)
+		{
+			if (count > 0)
+				memcpy(static_cast<void*>(dest), static_cast<const void*>(source), sizeof(Type) * count);
+		}
+		else
+		{
+			for (size_t index{ 0 }; index < count; ++index)
+				new (dest + index) Type(source[index]);
+		}
+	}
+
+	//**************************************
+	// Iterator range copy method
+	//
+	// Copy constructs count objects read
+	// from first into the raw memory at
+	// dest, contiguous ranges are copied
+	// with copy_range
+	//**************************************
+	template<typename Type, typename Iterator>
+	inline void copy_range_from(Type* dest, Iterator first, size_t count) noexcept
+	{
+		if (count == 0)
+			return;
+
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+			copy_range(dest, &*first, count);
+		else
+			for (size_t index{ 0 }; index < count; ++index, ++first)
+				new (dest + index) Type(*first);
+	}
+
+	//**************************************
+	// Range relocation method
+	//
+	// Moves count objects from source into
+	// the raw memory at dest and ends the
+	// lifetime of the source objects
+	//
+	// The ranges must not overlap
+	//**************************************
+	template<typename Type>
+	inline void relocate_range(Type* dest, Type* source, size_t count) noexcept
+	{
+		if constexpr (is_trivially_relocatable_v<Type>)
+		{
+			if (count > 0)
+				memcpy(static_cast<void*>(dest), static_cast<const void*>(source), sizeof(Type) * count);
+		}
+		else
+		{
+			for (size_t index{ 0 }; index < count; ++index)
+			{
+				new (dest + index) Type(std::move(source[index]));
+				source[index].~Type();
+			}
+		}
+	}
+
+	//**************************************
+	// Gap opening method
+	//
+	// Relocates the count live objects at
+	// position up by gap spots, leaving
+	// [position, position + gap) as raw
+	// memory. The space past the objects
+	// must already be allocated
+	//**************************************
+	template<typename Type>
+	inline void open_gap(Type* position, size_t count, size_t gap) noexcept
+	{
+		if constexpr (is_trivially_relocatable_v<Type>)
+			memmove(static_cast<void*>(position + gap), static_cast<const void*>(position), sizeof(Type) * count);
+		else
+		{
+			// go backwards so nothing is overwritten before it moves
+			for (size_t index{ count }; index > 0; --index)
+			{
+				new (position + index - 1 + gap) Type(std::move(position[index - 1]));
+				position[index - 1].~Type();
+			}
+		}
+	}
+
+	//**************************************
+	// Erase shift method
+	//
+	// Removes first[0] from a run of count
+	// live objects by shifting the rest
+	// down one spot and destroying the
+	// last one
+	//**************************************
+	template<typename Type>
+	inline void erase_shift(Type* first, size_t count) noexcept
+	{
+		assert(count > 0);
+		if constexpr (std::is_trivially_copyable_v<Type>)
+			memmove(static_cast<void*>(first), static_cast<const void*>(first + 1), sizeof(Type) * (count - 1));
+		else
+		{
+			for (size_t index{ 1 }; index < count; ++index)
+				first[index - 1] = std::move(first[index]);
+			first[count - 1].~Type();
+		}
+	}
+
+	//**************************************
+	// Array reallocation method
+	//
+	// Grows or shrinks array from
+	// oldCapacity to capacity objects
+	// using allocator, keeping the first
+	// count live objects
+	//
+	// Trivially relocatable types go
+	// through the allocator's realloc
+	// style hook, other types try to grow
+	// in place before falling back to
+	// relocating into a new block
+	//
+	// Returns the new array, or nullptr if
+	// the allocation failed (in which case
+	// array is left untouched)
+	//**************************************
+	template<typename Type, typename Allocator>
+	Type* reallocate_array(Allocator& allocator, Type* array, size_t count, size_t oldCapacity, size_t capacity) noexcept
+	{
+		assert(count <= capacity);
+		assert(count <= oldCapacity);
+		assert(capacity > 0);
+
+		if constexpr (is_trivially_relocatable_v<Type>)
+		{
+			void* newRegion = allocator.reallocate(static_cast<void*>(array), sizeof(Type) * oldCapacity, sizeof(Type) * capacity);
+			if (newRegion != nullptr)
+				return static_cast<Type*>(newRegion);
+		}
+		else
+		{
+			if (array != nullptr && allocator.expand(static_cast<void*>(array), sizeof(Type) * oldCapacity, sizeof(Type) * capacity))
+				return array;
+		}
+
+		// either the hooks failed or we can't move the objects bitwise
+		Type* newRegion = static_cast<Type*>(allocator.allocate(sizeof(Type) * capacity));
+		if (newRegion == nullptr)
+			return nullptr;
+
+		relocate_range(newRegion, array, count);
+		allocator.deallocate(static_cast<void*>(array), sizeof(Type) * oldCapacity);
+		return newRegion;
+	}
+
+	//**************************************
+	// Growth target method
+	//
+	// Returns the capacity to grow to so
+	// needed elements fit, keeping to the
+	// growth policy's next capacity when
+	// that is enough
+	//**************************************
+	inline size_t growth_target(size_t next, size_t needed) noexcept { return next < needed ? needed : next; }
+
+	//**************************************
+	// Alias index method
+	//
+	// Returns the index of element if it
+	// is one of the capacity slots of
+	// array, or capacity if it lives
+	// somewhere else
+	//**************************************
+	template<typename Type>
+	inline size_t alias_index(const Type* array, size_t capacity, const Type* element) noexcept
+	{
+		if (element >= array && element < array + capacity)
+			return static_cast<size_t>(element - array);
+		return capacity;
+	}
+
+	//**************************************
+	// Array push back method
+	// (internal safe)
+	//
+	// Constructs an element at the end of
+	// array from data, which may be one of
+	// array's own elements. grow() must
+	// enlarge array and capacity, data is
+	// found again by index afterwards
+	//
+	// Returns true if data had to be found
+	// again
+	//**************************************
+	template<typename Type, typename Value, typename Grow>
+	inline bool array_push_back_i(Type*& array, size_t& size, size_t& capacity, Value&& data, Grow grow) noexcept
+	{
+		if (size < capacity)
+		{
+			new (array + size++) Type(std::forward<Value>(data));
+			return false;
+		}
+
+		size_t oldCapacity = capacity;
+		size_t index = alias_index<Type>(array, oldCapacity, &data);
+		grow();
+		if (index == oldCapacity)
+		{
+			new (array + size++) Type(std::forward<Value>(data));
+			return false;
+		}
+		new (array + size++) Type(std::forward<Value>(array[index]));
+		return true;
+	}
+
+	//**************************************
+	// Array emplace back method
+	//
+	// Constructs an element at the end of
+	// array from args, calling grow() to
+	// make room first when it is full
+	//**************************************
+	template<typename Type, typename Grow, typename... Args>
+	inline Type& array_emplace_back(Type*& array, size_t& size, size_t& capacity, Grow grow, Args&&... args) noexcept
+	{
+		if (size == capacity)
+			grow();
+		Type* element = new (array + size) Type(std::forward<Args>(args)...);
+		++size;
+		return *element;
+	}
+
+	//**************************************
+	// Array default initializing resize
+	// method
+	//
+	// Sets size to newSize, default
+	// constructing new elements. growTo
+	// is called with the capacity needed
+	// and may fail, leaving the size alone
+	//
+	// Returns the new size, or the old
+	// size if growing failed
+	//**************************************
+	template<typename Type, typename GrowTo>
+	inline size_t array_resize_default_init(Type*& array, size_t& size, size_t& capacity, size_t newSize, GrowTo growTo) noexcept
+	{
+		if (newSize > capacity)
+		{
+			growTo(newSize);
+			if (capacity < newSize)
+				return size;
+		}
+
+		if constexpr (!std::is_trivially_default_constructible_v<Type>)
+			for (size_t index{ size }; index < newSize; ++index)
+				new (array + index) Type;
+		if (newSize < size)
+			destroy_range(array + newSize, size - newSize);
+		size = newSize;
+		return size;
+	}
+
+	//**************************************
+	// Array erase method
+	//
+	// Removes the element at index,
+	// shifting the rest down one spot
+	//**************************************
+	template<typename Type>
+	inline void array_erase(Type* array, size_t& size, size_t index) noexcept
+	{
+		assert(index < size);
+		erase_shift(array + index, size - index);
+		--size;
+	}
+
+	//**************************************
+	// Array append method
+	//
+	// Copies [first, last) onto the end of
+	// array, calling growTo with the
+	// capacity needed at most once. A
+	// contiguous range out of array itself
+	// is found again after growing
+	//**************************************
+	template<typename Type, typename Iterator, typename GrowTo>
+	void array_append(Type*& array, size_t& size, size_t& capacity, Iterator first, Iterator last, GrowTo growTo) noexcept
+	{
+		size_t count = range_length(first, last);
+		if (count == 0)
+			return;
+
+		if (size + count > capacity)
+		{
+			// a range out of this array has to be found again after the move
+			if constexpr (is_contiguous_iterator_v<Iterator>)
+			{
+				size_t index = alias_index<Type>(array, size, &*first);
+				if (index < size)
+				{
+					growTo(size + count);
+					assert(capacity >= size + count);
+					copy_range(array + size, array + index, count);
+					size += count;
+					return;
+				}
+			}
+			growTo(size + count);
+			assert(capacity >= size + count);
+		}
+
+		copy_range_from(array + size, first, count);
+		size += count;
+	}
+
+	//**************************************
+	// Array insert method
+	//
+	// Copies [first, last) in before
+	// index, calling growTo with the
+	// capacity needed at most once. The
+	// range must not come from array
+	//**************************************
+	template<typename Type, typename Iterator, typename GrowTo>
+	void array_insert(Type*& array, size_t& size, size_t& capacity, size_t index, Iterator first, Iterator last, GrowTo growTo) noexcept
+	{
+		assert(index <= size);
+		size_t count = range_length(first, last);
+		if (count == 0)
+			return;
+
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+			assert(alias_index<Type>(array, capacity, &*first) == capacity);
+
+		if (size + count > capacity)
+		{
+			growTo(size + count);
+			assert(capacity >= size + count);
+		}
+
+		open_gap(array + index, size - index, count);
+		copy_range_from(array + index, first, count);
+		size += count;
+	}
+}
@@ -0,0 +1,691 @@
+//**************************************
+// ring_buffer.h
+//
+// Holds nids::ring_buffer, a FIFO queue
+// in one circular array, and
+// nids::spsc_ring_buffer, a fixed size
+// one that a producer thread and a
+// consumer thread can share without a
+// lock.
+//
+// Capacities are powers of two, so
+// wrapping an index around is a mask
+// rather than a division. Bulk pushes
+// and pops copy at most two contiguous
+// pieces, one up to the end of the
+// array and one from its start
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+#include "aligned_allocator.h"
+#include "allocator.h"
+#include "relocation.h"
+#include "span.h"
+
+namespace nids
+{
+	//**************************************
+	// Ring capacity method
+	//
+	// Rounds capacity up to a power of two
+	//**************************************
+	inline size_t ring_capacity(size_t capacity) noexcept
+	{
+		size_t rounded{ 1 };
+		while (rounded < capacity)
+			rounded *= 2;
+		return rounded;
+	}
+
+	//**************************************
+	// Ring buffer
+	//
+	// FIFO queue that pushes at the back
+	// and pops at the front without ever
+	// shifting elements, e.g. a BFS
+	// frontier or a stage of a pipeline
+	//
+	// A Growable buffer doubles when a
+	// push finds it full. A fixed one
+	// keeps the capacity it was built
+	// with, and pushes onto a full one
+	// return false or push fewer
+	//**************************************
+	template<typename Type, bool Growable = true, typename Allocator = default_allocator>
+	class ring_buffer final : private Allocator
+	{
+	public:
+		using value_type = Type;
+		using allocator_type = Allocator;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline ring_buffer() noexcept : Allocator(), m_array(nullptr), m_head(0), m_size(0), m_capacity(0) {}
+
+		//************************************
+		// Capacity constructor
+		//
+		// Rounds capacity up to a power of
+		// two
+		//************************************
+		inline explicit ring_buffer(size_t capacity, const Allocator& allocator = Allocator()) noexcept
+			: Allocator(allocator), m_array(nullptr), m_head(0), m_size(0), m_capacity(0)
+		{
+			if (capacity > 0)
+				grow(ring_capacity(capacity));
+		}
+
+		//************************************
+		// Copy constructor
+		//
+		// The copy starts at the front of
+		// its array
+		//************************************
+		inline ring_buffer(const ring_buffer& rhs) noexcept
+			: Allocator(rhs), m_array(nullptr), m_head(0), m_size(0), m_capacity(0)
+		{
+			copy_from(rhs);
+		}
+
+		//************************************
+		// Move constructor
+		//************************************
+		inline ring_buffer(ring_buffer&& rhs) noexcept
+			: Allocator(std::move(rhs)), m_array(rhs.m_array), m_head(rhs.m_head), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
+		{
+			rhs.m_array = nullptr;
+			rhs.m_head = 0;
+			rhs.m_size = 0;
+			rhs.m_capacity = 0;
+		}
+
+		//************************************
+		// Copy assignment operator
+		//************************************
+		inline ring_buffer& operator=(const ring_buffer& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				static_cast<Allocator&>(*this) = static_cast<const Allocator&>(rhs);
+				copy_from(rhs);
+			}
+			return *this;
+		}
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		inline ring_buffer& operator=(ring_buffer&& rhs) noexcept
+		{
+			if (this != &rhs)
+			{
+				release();
+				static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(rhs));
+				m_array = rhs.m_array;
+				m_head = rhs.m_head;
+				m_size = rhs.m_size;
+				m_capacity = rhs.m_capacity;
+				rhs.m_array = nullptr;
+				rhs.m_head = 0;
+				rhs.m_size = 0;
+				rhs.m_capacity = 0;
+			}
+			return *this;
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~ring_buffer() noexcept { release(); }
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_capacity; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Full status getter
+		//
+		// A full Growable buffer still
+		// takes pushes, it grows first
+		//************************************
+		inline bool full() const noexcept { return m_size == m_capacity; }
+
+		//************************************
+		// Subscript operators
+		//
+		// Index 0 is the front
+		//************************************
+		inline Type& operator[](size_t index) noexcept
+		{
+			assert(index < m_size);
+			return m_array[(m_head + index) & (m_capacity - 1)];
+		}
+		inline const Type& operator[](size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return m_array[(m_head + index) & (m_capacity - 1)];
+		}
+
+		//************************************
+		// Front getters
+		//************************************
+		inline Type& front() noexcept { return (*this)[0]; }
+		inline const Type& front() const noexcept { return (*this)[0]; }
+
+		//************************************
+		// Back getters
+		//************************************
+		inline Type& back() noexcept { return (*this)[m_size - 1]; }
+		inline const Type& back() const noexcept { return (*this)[m_size - 1]; }
+
+		//************************************
+		// Spans getters
+		//
+		// Return the elements front to
+		// back as two contiguous pieces,
+		// the second empty unless they
+		// wrap around the end of the array
+		//************************************
+		inline std::pair<span<Type>, span<Type>> spans() noexcept
+		{
+			size_t first = m_capacity - m_head < m_size ? m_capacity - m_head : m_size;
+			return { span<Type>(m_array + m_head, first), span<Type>(m_array, m_size - first) };
+		}
+		inline std::pair<span<const Type>, span<const Type>> spans() const noexcept
+		{
+			size_t first = m_capacity - m_head < m_size ? m_capacity - m_head : m_size;
+			return { span<const Type>(m_array + m_head, first), span<const Type>(m_array, m_size - first) };
+		}
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Emplace back method
+		//
+		// Returns false if a fixed buffer
+		// is full
+		//************************************
+		template<typename... Arguments>
+		inline bool emplace_back(Arguments&&... arguments) noexcept
+		{
+			if (m_size == m_capacity)
+			{
+				if constexpr (!Growable)
+					return false;
+				// arguments may refer into the buffer, so build it before growing
+				Type value(std::forward<Arguments>(arguments)...);
+				make_room(1);
+				new (m_array + ((m_head + m_size) & (m_capacity - 1))) Type(std::move(value));
+				++m_size;
+				return true;
+			}
+			new (m_array + ((m_head + m_size) & (m_capacity - 1))) Type(std::forward<Arguments>(arguments)...);
+			++m_size;
+			return true;
+		}
+
+		//************************************
+		// Push back methods
+		//
+		// Return false if a fixed buffer
+		// is full
+		//************************************
+		inline bool push_back(const Type& value) noexcept { return emplace_back(value); }
+		inline bool push_back(Type&& value) noexcept { return emplace_back(std::move(value)); }
+
+		//************************************
+		// Bulk push back method
+		//
+		// Copies elements in behind the
+		// back, growing once for all of
+		// them. A fixed buffer takes as
+		// many as fit
+		//
+		// Returns the number pushed
+		//************************************
+		inline size_t push_back(span<const Type> elements) noexcept
+		{
+			size_t count = elements.size();
+			if (m_capacity - m_size < count && !make_room(count))
+				count = m_capacity - m_size;
+			if (count == 0)
+				return 0;
+
+			// elements must not come from this buffer, a grow would have moved them
+			assert(elements.data() + elements.size() <= m_array || elements.data() >= m_array + m_capacity);
+			size_t tail = (m_head + m_size) & (m_capacity - 1);
+			size_t first = m_capacity - tail < count ? m_capacity - tail : count;
+			copy_range(m_array + tail, elements.data(), first);
+			copy_range(m_array, elements.data() + first, count - first);
+			m_size += count;
+			return count;
+		}
+
+		//************************************
+		// Pop front method
+		//************************************
+		inline void pop_front() noexcept
+		{
+			assert(m_size > 0);
+			m_array[m_head].~Type();
+			m_head = (m_head + 1) & (m_capacity - 1);
+			--m_size;
+		}
+
+		//************************************
+		// Bulk pop front method
+		//
+		// Moves up to output.size()
+		// elements from the front into
+		// output, oldest first
+		//
+		// Returns the number popped
+		//************************************
+		inline size_t pop_front(span<Type> output) noexcept
+		{
+			size_t count = output.size() < m_size ? output.size() : m_size;
+			size_t first = m_capacity - m_head < count ? m_capacity - m_head : count;
+			move_out(output.data(), m_array + m_head, first);
+			move_out(output.data() + first, m_array, count - first);
+			m_head = (m_head + count) & (m_capacity - 1);
+			m_size -= count;
+			return count;
+		}
+
+		//************************************
+		// Pop back method
+		//************************************
+		inline void pop_back() noexcept
+		{
+			assert(m_size > 0);
+			back().~Type();
+			--m_size;
+		}
+
+		//************************************
+		// Reserve method
+		//
+		// Grows a Growable buffer to hold
+		// at least size elements
+		//
+		// Returns the capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			static_assert(Growable, "a fixed ring_buffer keeps its capacity");
+			if (size > m_capacity)
+				grow(ring_capacity(size));
+			return m_capacity;
+		}
+
+		//************************************
+		// Clear method
+		//
+		// Keeps the array for reuse
+		//************************************
+		inline void clear() noexcept
+		{
+			std::pair<span<Type>, span<Type>> pieces = spans();
+			destroy_range(pieces.first.data(), pieces.first.size());
+			destroy_range(pieces.second.data(), pieces.second.size());
+			m_head = 0;
+			m_size = 0;
+		}
+	private:
+		//************************************
+		// Room making method
+		//
+		// Grows to fit count more elements
+		//
+		// Returns false if the buffer is
+		// fixed
+		//************************************
+		inline bool make_room(size_t count) noexcept
+		{
+			if constexpr (Growable)
+			{
+				size_t capacity = m_capacity > 0 ? m_capacity : 1;
+				while (capacity - m_size < count)
+					capacity *= 2;
+				grow(capacity);
+				return true;
+			}
+			else
+			{
+				(void)count;
+				return false;
+			}
+		}
+
+		//************************************
+		// Growth method
+		//
+		// Moves to an array of capacity
+		// elements. Bitwise movable types
+		// go through the allocator's
+		// reallocate, after which the part
+		// that wrapped around moves to just
+		// past the old end
+		//************************************
+		inline void grow(size_t capacity) noexcept
+		{
+			assert(capacity > m_capacity && (capacity & (capacity - 1)) == 0);
+			size_t wrapped = m_head + m_size > m_capacity ? m_head + m_size - m_capacity : 0;
+			if constexpr (is_trivially_relocatable_v<Type>)
+			{
+				m_array = reallocate_array(static_cast<Allocator&>(*this), m_array, m_capacity, m_capacity, capacity);
+				assert(m_array != nullptr);
+				// the new capacity is at least double, so the wrapped part fits
+				relocate_range(m_array + m_capacity, m_array, wrapped);
+			}
+			else
+			{
+				Type* array = static_cast<Type*>(this->allocate(sizeof(Type) * capacity));
+				assert(array != nullptr);
+				relocate_range(array, m_array + m_head, m_size - wrapped);
+				relocate_range(array + m_size - wrapped, m_array, wrapped);
+				this->deallocate(m_array, sizeof(Type) * m_capacity);
+				m_array = array;
+				m_head = 0;
+			}
+			m_capacity = capacity;
+		}
+
+		//************************************
+		// Move out method
+		//
+		// Move assigns count elements into
+		// dest and destroys the sources
+		//************************************
+		static inline void move_out(Type* dest, Type* source, size_t count) noexcept
+		{
+			for (size_t index{ 0 }; index < count; ++index)
+				dest[index] = std::move(source[index]);
+			destroy_range(source, count);
+		}
+
+		//************************************
+		// Copy method
+		//
+		// Copies rhs into this empty buffer
+		//************************************
+		inline void copy_from(const ring_buffer& rhs) noexcept
+		{
+			if (rhs.m_capacity == 0)
+				return;
+			m_array = static_cast<Type*>(this->allocate(sizeof(Type) * rhs.m_capacity));
+			assert(m_array != nullptr);
+			m_capacity = rhs.m_capacity;
+			std::pair<span<const Type>, span<const Type>> pieces = rhs.spans();
+			copy_range(m_array, pieces.first.data(), pieces.first.size());
+			copy_range(m_array + pieces.first.size(), pieces.second.data(), pieces.second.size());
+			m_size = rhs.m_size;
+		}
+
+		//************************************
+		// Release method
+		//
+		// Destroys everything and frees
+		// the array
+		//************************************
+		inline void release() noexcept
+		{
+			clear();
+			this->deallocate(m_array, sizeof(Type) * m_capacity);
+			m_array = nullptr;
+			m_capacity = 0;
+		}
+
+		Type* m_array;
+		// array index of the front
+		size_t m_head;
+		size_t m_size;
+		size_t m_capacity;
+	};
+
+	//**************************************
+	// Fixed ring buffer
+	//
+	// A ring_buffer that never grows
+	//**************************************
+	template<typename Type, typename Allocator = default_allocator>
+	using fixed_ring_buffer = ring_buffer<Type, false, Allocator>;
+
+	//**************************************
+	// SPSC ring buffer
+	//
+	// Fixed capacity queue for exactly
+	// one producer thread and one
+	// consumer thread. Only the producer
+	// calls push, only the consumer calls
+	// pop, and neither ever waits: a push
+	// onto a full buffer or a pop from an
+	// empty one just does less
+	//
+	// head and tail count every pop and
+	// push ever made, masked only to find
+	// a slot. Each is written by one side
+	// and kept on its own cache line next
+	// to that side's cached copy of the
+	// other index, so the sides only read
+	// each other's line when the cached
+	// copy says the buffer looks full or
+	// empty. The class is cache line
+	// aligned, so nothing placed after it
+	// shares the producer's line either
+	//**************************************
+	template<typename Type, typename Allocator = default_allocator>
+	class spsc_ring_buffer final : private Allocator
+	{
+	public:
+		using value_type = Type;
+		using allocator_type = Allocator;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//
+		// Rounds capacity up to a power of
+		// two
+		//************************************
+		inline explicit spsc_ring_buffer(size_t capacity, const Allocator& allocator = Allocator()) noexcept
+			: Allocator(allocator), m_array(nullptr), m_capacity(ring_capacity(capacity)),
+			m_head(0), m_cachedTail(0), m_tail(0), m_cachedHead(0)
+		{
+			m_array = static_cast<Type*>(this->allocate(sizeof(Type) * m_capacity));
+			assert(m_array != nullptr);
+		}
+
+		spsc_ring_buffer(const spsc_ring_buffer&) = delete;
+		spsc_ring_buffer& operator=(const spsc_ring_buffer&) = delete;
+
+		//************************************
+		// Destructor
+		//
+		// Neither side may still be using
+		// the buffer
+		//************************************
+		inline ~spsc_ring_buffer() noexcept
+		{
+			for (size_t index = m_head.load(std::memory_order_acquire); index != m_tail.load(std::memory_order_acquire); ++index)
+				m_array[index & (m_capacity - 1)].~Type();
+			this->deallocate(m_array, sizeof(Type) * m_capacity);
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_capacity; }
+
+		//************************************
+		// Size accessor
+		//
+		// Only a snapshot while the other
+		// side is running
+		//************************************
+		inline size_t size() const noexcept
+		{
+			size_t head = m_head.load(std::memory_order_acquire);
+			return m_tail.load(std::memory_order_acquire) - head;
+		}
+
+		//************************************
+		// Empty status getter
+		//
+		// Only a snapshot while the other
+		// side is running
+		//************************************
+		inline bool empty() const noexcept { return size() == 0; }
+
+		//*****************[ Producer Methods ]
+		//************************************
+		// Emplace method
+		//
+		// Returns false if the buffer is
+		// full
+		//************************************
+		template<typename... Arguments>
+		inline bool try_emplace(Arguments&&... arguments) noexcept
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (tail - m_cachedHead == m_capacity)
+			{
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+				if (tail - m_cachedHead == m_capacity)
+					return false;
+			}
+			new (m_array + (tail & (m_capacity - 1))) Type(std::forward<Arguments>(arguments)...);
+			m_tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		//************************************
+		// Push methods
+		//
+		// Return false if the buffer is
+		// full
+		//************************************
+		inline bool try_push(const Type& value) noexcept { return try_emplace(value); }
+		inline bool try_push(Type&& value) noexcept { return try_emplace(std::move(value)); }
+
+		//************************************
+		// Bulk push method
+		//
+		// Copies in as many of elements as
+		// fit, and publishes them all with
+		// one store
+		//
+		// Returns the number pushed
+		//************************************
+		inline size_t try_push(span<const Type> elements) noexcept
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			if (m_capacity - (tail - m_cachedHead) < elements.size())
+				m_cachedHead = m_head.load(std::memory_order_acquire);
+			size_t room = m_capacity - (tail - m_cachedHead);
+			size_t count = elements.size() < room ? elements.size() : room;
+			if (count == 0)
+				return 0;
+
+			size_t slot = tail & (m_capacity - 1);
+			size_t first = m_capacity - slot < count ? m_capacity - slot : count;
+			copy_range(m_array + slot, elements.data(), first);
+			copy_range(m_array, elements.data() + first, count - first);
+			m_tail.store(tail + count, std::memory_order_release);
+			return count;
+		}
+
+		//*****************[ Consumer Methods ]
+		//************************************
+		// Pop method
+		//
+		// Moves the front into output
+		//
+		// Returns false if the buffer is
+		// empty
+		//************************************
+		inline bool try_pop(Type& output) noexcept
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			if (head == m_cachedTail)
+			{
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+				if (head == m_cachedTail)
+					return false;
+			}
+			Type& slot = m_array[head & (m_capacity - 1)];
+			output = std::move(slot);
+			slot.~Type();
+			m_head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		//************************************
+		// Bulk pop method
+		//
+		// Moves up to output.size()
+		// elements into output, oldest
+		// first, and frees their slots
+		// with one store
+		//
+		// Returns the number popped
+		//************************************
+		inline size_t try_pop(span<Type> output) noexcept
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			if (m_cachedTail - head < output.size())
+				m_cachedTail = m_tail.load(std::memory_order_acquire);
+			size_t available = m_cachedTail - head;
+			size_t count = output.size() < available ? output.size() : available;
+			if (count == 0)
+				return 0;
+
+			size_t slot = head & (m_capacity - 1);
+			size_t first = m_capacity - slot < count ? m_capacity - slot : count;
+			for (size_t index{ 0 }; index < first; ++index)
+				output[index] = std::move(m_array[slot + index]);
+			for (size_t index = first; index < count; ++index)
+				output[index] = std::move(m_array[index - first]);
+			destroy_range(m_array + slot, first);
+			destroy_range(m_array, count - first);
+			m_head.store(head + count, std::memory_order_release);
+			return count;
+		}
+	private:
+		// read only once built, shared by both sides
+		Type* m_array;
+		const size_t m_capacity;
+
+		// the consumer's line
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head;
+		size_t m_cachedTail;
+
+		// the producer's line
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail;
+		size_t m_cachedHead;
+	};
+}
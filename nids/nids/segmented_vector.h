@@ -0,0 +1,615 @@
+//**************************************
+// segmented_vector.h
+//
+// Holds nids::segmented_vector, a
+// vector made of fixed size segments
+// that never move once allocated, and
+// its random access iterator.
+//
+// Growing adds one segment instead of
+// reallocating and copying the whole
+// array, so push_back never stalls on
+// a big copy, and pointers and
+// references to elements stay valid
+// for as long as the element exists
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <new>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+#include "span.h"
+#include "vector.h"
+
+namespace nids
+{
+	//**************************************
+	// Default segment size
+	//
+	// The largest power of two number of
+	// elements that fits in 64 KB (at
+	// least one)
+	//**************************************
+	template<typename Type>
+	constexpr size_t default_segment_size() noexcept
+	{
+		size_t elements{ 1 };
+		while (elements * 2 * sizeof(Type) <= 64 * 1024)
+			elements *= 2;
+		return elements;
+	}
+
+	template<typename Container>
+	class segmented_iterator;
+
+	template<typename Type, size_t SegmentSize = default_segment_size<Type>(), typename Allocator = default_allocator>
+	class segmented_vector final : private Allocator
+	{
+		static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be a power of two");
+	public:
+		using value_type = Type;
+		using iterator = segmented_iterator<segmented_vector>;
+		using const_iterator = segmented_iterator<const segmented_vector>;
+		using allocator_type = Allocator;
+
+		// elements per segment
+		static const size_t SEGMENT_SIZE = SegmentSize;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline segmented_vector() noexcept : Allocator(), m_segments(nullptr), m_segmentCount(0), m_directoryCapacity(0), m_size(0) {}
+
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit segmented_vector(const Allocator& allocator) noexcept
+			: Allocator(allocator), m_segments(nullptr), m_segmentCount(0), m_directoryCapacity(0), m_size(0) {}
+
+		//************************************
+		// Copy constructor
+		//************************************
+		segmented_vector(const segmented_vector& rhs) noexcept;
+
+		//************************************
+		// Move constructor
+		//
+		// Hands over the segments, so
+		// references stay valid and now
+		// point into the new vector
+		//************************************
+		inline segmented_vector(segmented_vector&& rhs) noexcept
+			: Allocator(std::move(rhs)), m_segments(rhs.m_segments), m_segmentCount(rhs.m_segmentCount),
+			m_directoryCapacity(rhs.m_directoryCapacity), m_size(rhs.m_size)
+		{
+			rhs.forget();
+		}
+
+		//************************************
+		// Copy assignment operator
+		//************************************
+		inline segmented_vector& operator=(const segmented_vector& rhs) noexcept
+		{
+			if (&rhs != this)
+			{
+				clear();
+				for (size_t index{ 0 }; index < rhs.m_size; ++index)
+					push_back(rhs[index]);
+			}
+			return *this;
+		}
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		inline segmented_vector& operator=(segmented_vector&& rhs) noexcept
+		{
+			if (&rhs != this)
+			{
+				release();
+				static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(rhs));
+				m_segments = rhs.m_segments;
+				m_segmentCount = rhs.m_segmentCount;
+				m_directoryCapacity = rhs.m_directoryCapacity;
+				m_size = rhs.m_size;
+				rhs.forget();
+			}
+			return *this;
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~segmented_vector() noexcept { release(); }
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_segmentCount * SegmentSize; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Const correct subscript operator
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return m_segments[index / SegmentSize][index % SegmentSize];
+		}
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline Type& operator[](size_t index) noexcept
+		{
+			assert(index < m_size);
+			return m_segments[index / SegmentSize][index % SegmentSize];
+		}
+
+		//************************************
+		// Const correct at object accessor
+		//************************************
+		inline const Type& at(size_t index) const noexcept { return operator[](index); }
+
+		//************************************
+		// At object accessor
+		//************************************
+		inline Type& at(size_t index) noexcept { return operator[](index); }
+
+		//************************************
+		// Allocator getter
+		//************************************
+		inline const Allocator& get_allocator() const noexcept { return *this; }
+
+		//************************************
+		// Front item getter
+		//************************************
+		inline Type* front() const noexcept { return m_segments[0]; }
+
+		//************************************
+		// Back item getter
+		//************************************
+		inline Type* back() const noexcept { return &m_segments[(m_size - 1) / SegmentSize][(m_size - 1) % SegmentSize]; }
+
+		//************************************
+		// Segment count getter
+		//************************************
+		inline size_t segment_count() const noexcept { return (m_size + SegmentSize - 1) / SegmentSize; }
+
+		//************************************
+		// Segment getter
+		//
+		// Returns the live elements of one
+		// segment, which are contiguous, so
+		// bulk work can run a segment at a
+		// time
+		//************************************
+		inline span<Type> segment(size_t index) noexcept
+		{
+			assert(index < segment_count());
+			size_t first = index * SegmentSize;
+			return span<Type>(m_segments[index], m_size - first < SegmentSize ? m_size - first : SegmentSize);
+		}
+
+		//************************************
+		// Segment getter (const correct)
+		//************************************
+		inline span<const Type> segment(size_t index) const noexcept
+		{
+			assert(index < segment_count());
+			size_t first = index * SegmentSize;
+			return span<const Type>(m_segments[index], m_size - first < SegmentSize ? m_size - first : SegmentSize);
+		}
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		inline iterator begin() noexcept { return iterator(this, 0); }
+		inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+		//************************************
+		// End iterator getter
+		//************************************
+		inline iterator end() noexcept { return iterator(this, m_size); }
+		inline const_iterator end() const noexcept { return const_iterator(this, m_size); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Push back method
+		//
+		// Adds the specified data to the end
+		// of the vector, adding a segment if
+		// necessary
+		//
+		// Nothing moves when a segment is
+		// added, so references into the
+		// vector are safe to pass
+		//************************************
+		inline void push_back(const Type& data) noexcept { emplace_back(data); }
+
+		//************************************
+		// Push back method (rvalue)
+		//************************************
+		inline void push_back(Type&& data) noexcept { emplace_back(std::move(data)); }
+
+		//************************************
+		// Push back method (internal safe)
+		//
+		// Same as push_back, kept so code
+		// written against nids::vector
+		// compiles unchanged
+		//************************************
+		inline void push_back_i(const Type& data) noexcept { emplace_back(data); }
+
+		//************************************
+		// Push back method
+		// (rvalue, internal safe)
+		//************************************
+		inline void push_back_i(Type&& data) noexcept { emplace_back(std::move(data)); }
+
+		//************************************
+		// Emplace back method
+		//
+		// Constructs a new element at the
+		// end of the vector from args
+		//************************************
+		template<typename... Args>
+		inline Type& emplace_back(Args&&... args) noexcept
+		{
+			if (m_size == capacity())
+				add_segment();
+			Type* element = new (&m_segments[m_size / SegmentSize][m_size % SegmentSize]) Type(std::forward<Args>(args)...);
+			++m_size;
+			return *element;
+		}
+
+		//************************************
+		// Append method
+		//
+		// Copies elements onto the end a
+		// segment at a time. Nothing moves,
+		// so elements of this vector are
+		// safe to append
+		//************************************
+		void append(span<const Type> elements) noexcept;
+
+		//************************************
+		// Pop back method
+		//
+		// Destroys the last element, the
+		// segment is kept for reuse
+		//************************************
+		inline void pop_back() noexcept
+		{
+			assert(m_size > 0);
+			--m_size;
+			m_segments[m_size / SegmentSize][m_size % SegmentSize].~Type();
+		}
+
+		//************************************
+		// Reserve method
+		//
+		// Adds segments until at least size
+		// elements fit, never removes any
+		//
+		// Returns the new capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			while (capacity() < size)
+				add_segment();
+			return capacity();
+		}
+
+		//************************************
+		// Resize method
+		//
+		// Adds or frees segments so the
+		// capacity is the smallest multiple
+		// of SEGMENT_SIZE that holds size,
+		// destroying any elements past size
+		//
+		// Returns the new capacity
+		//************************************
+		size_t resize(size_t size) noexcept;
+
+		//************************************
+		// Default initializing resize method
+		//
+		// Sets the size, default
+		// constructing any new elements
+		//
+		// Returns the new size
+		//************************************
+		inline size_t resize_default_init(size_t size) noexcept
+		{
+			reserve(size);
+			if constexpr (!std::is_trivially_default_constructible_v<Type>)
+				for (size_t index{ m_size }; index < size; ++index)
+					new (&m_segments[index / SegmentSize][index % SegmentSize]) Type;
+			while (m_size > size)
+				pop_back();
+			m_size = size;
+			return m_size;
+		}
+
+		//************************************
+		// Clear method
+		//
+		// Destroys every element but keeps
+		// the segments
+		//************************************
+		inline void clear() noexcept
+		{
+			while (m_size > 0)
+				pop_back();
+		}
+	private:
+		//************************************
+		// Segment allocation method
+		//************************************
+		inline void add_segment() noexcept
+		{
+			if (m_segmentCount == m_directoryCapacity)
+			{
+				size_t capacity = m_directoryCapacity == 0 ? 8 : m_directoryCapacity * 2;
+				Type** directory = reallocate_array(static_cast<Allocator&>(*this), m_segments, m_segmentCount, m_directoryCapacity, capacity);
+				assert(directory != nullptr);
+				m_segments = directory;
+				m_directoryCapacity = capacity;
+			}
+
+			Type* segment = static_cast<Type*>(this->allocate(sizeof(Type) * SegmentSize));
+			assert(segment != nullptr);
+			m_segments[m_segmentCount++] = segment;
+		}
+
+		//************************************
+		// Release method
+		//
+		// Destroys everything and frees the
+		// segments
+		//************************************
+		inline void release() noexcept
+		{
+			clear();
+			for (size_t index{ 0 }; index < m_segmentCount; ++index)
+				this->deallocate(m_segments[index], sizeof(Type) * SegmentSize);
+			if (m_segments != nullptr)
+				this->deallocate(m_segments, sizeof(Type*) * m_directoryCapacity);
+			forget();
+		}
+
+		//************************************
+		// Forget method
+		//
+		// Drops the segments without
+		// freeing them, for after a move
+		//************************************
+		inline void forget() noexcept
+		{
+			m_segments = nullptr;
+			m_segmentCount = 0;
+			m_directoryCapacity = 0;
+			m_size = 0;
+		}
+
+		// segment directory, the only thing that grows by reallocating
+		Type** m_segments;
+		size_t m_segmentCount;
+		size_t m_directoryCapacity;
+		size_t m_size;
+	};
+
+	//**********************************
+	// Copy constructor
+	//**********************************
+	template<typename Type, size_t SegmentSize, typename Allocator>
+	inline segmented_vector<Type, SegmentSize, Allocator>::segmented_vector(const segmented_vector& rhs) noexcept
+		: Allocator(rhs), m_segments(nullptr), m_segmentCount(0), m_directoryCapacity(0), m_size(0)
+	{
+		reserve(rhs.m_size);
+		for (size_t segment{ 0 }; segment < rhs.segment_count(); ++segment)
+		{
+			span<const Type> source = rhs.segment(segment);
+			copy_range(m_segments[segment], source.data(), source.size());
+			m_size += source.size();
+		}
+	}
+
+	//**********************************
+	// Append method
+	//**********************************
+	template<typename Type, size_t SegmentSize, typename Allocator>
+	void segmented_vector<Type, SegmentSize, Allocator>::append(span<const Type> elements) noexcept
+	{
+		reserve(m_size + elements.size());
+		const Type* source = elements.data();
+		size_t remaining = elements.size();
+		while (remaining > 0)
+		{
+			size_t offset = m_size % SegmentSize;
+			size_t count = SegmentSize - offset < remaining ? SegmentSize - offset : remaining;
+			copy_range(m_segments[m_size / SegmentSize] + offset, source, count);
+			m_size += count;
+			source += count;
+			remaining -= count;
+		}
+	}
+
+	//**********************************
+	// Resize method
+	//**********************************
+	template<typename Type, size_t SegmentSize, typename Allocator>
+	size_t segmented_vector<Type, SegmentSize, Allocator>::resize(size_t size) noexcept
+	{
+		while (m_size > size)
+			pop_back();
+
+		size_t segments = (size + SegmentSize - 1) / SegmentSize;
+		while (m_segmentCount > segments)
+			this->deallocate(m_segments[--m_segmentCount], sizeof(Type) * SegmentSize);
+		return reserve(size);
+	}
+
+	//**************************************
+	// Segmented iterator
+	//
+	// Random access iterator over a
+	// segmented_vector, Container is the
+	// vector or a const one
+	//**************************************
+	template<typename Container>
+	class segmented_iterator final
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = typename Container::value_type;
+		using difference_type = ptrdiff_t;
+		using reference = decltype(std::declval<Container&>()[0]);
+		using pointer = std::remove_reference_t<reference>*;
+
+		//******************************
+		// Default constructor
+		//******************************
+		inline segmented_iterator() noexcept : m_vector(nullptr), m_index(0) {}
+
+		//******************************
+		// Constructor
+		//******************************
+		inline segmented_iterator(Container* vector, size_t index) noexcept : m_vector(vector), m_index(index)
+		{
+			assert(m_vector != nullptr);
+		}
+
+		//*******[ Movement Operations ]
+		//******************************
+		// Increment operator (prefix)
+		//******************************
+		inline segmented_iterator& operator++() noexcept
+		{
+			assert(m_index < m_vector->size());
+			++m_index;
+			return *this;
+		}
+
+		//******************************
+		// Increment operator (postfix)
+		//******************************
+		inline segmented_iterator operator++(int) noexcept
+		{
+			segmented_iterator _r = *this;
+			++*this;
+			return _r;
+		}
+
+		//******************************
+		// Decrement operator (prefix)
+		//******************************
+		inline segmented_iterator& operator--() noexcept
+		{
+			assert(m_index > 0);
+			--m_index;
+			return *this;
+		}
+
+		//******************************
+		// Decrement operator (postfix)
+		//******************************
+		inline segmented_iterator operator--(int) noexcept
+		{
+			segmented_iterator _r = *this;
+			--*this;
+			return _r;
+		}
+
+		//******************************
+		// Addition operator
+		//******************************
+		inline segmented_iterator operator+(difference_type amount) const noexcept { return segmented_iterator(m_vector, m_index + amount); }
+
+		//******************************
+		// In-place addition operator
+		//******************************
+		inline segmented_iterator& operator+=(difference_type amount) noexcept
+		{
+			m_index += amount;
+			return *this;
+		}
+
+		//******************************
+		// Subtraction operator
+		//******************************
+		inline segmented_iterator operator-(difference_type amount) const noexcept { return segmented_iterator(m_vector, m_index - amount); }
+
+		//******************************
+		// Subtraction operator (iter)
+		//******************************
+		inline difference_type operator-(const segmented_iterator& rhs) const noexcept
+		{
+			return static_cast<difference_type>(m_index) - static_cast<difference_type>(rhs.m_index);
+		}
+
+		//******************************
+		// In-place subtraction operator
+		//******************************
+		inline segmented_iterator& operator-=(difference_type amount) noexcept
+		{
+			m_index -= amount;
+			return *this;
+		}
+
+		//*****[ Comparison Operations ]
+		inline bool operator==(const segmented_iterator& rhs) const noexcept { return m_index == rhs.m_index; }
+		inline bool operator!=(const segmented_iterator& rhs) const noexcept { return m_index != rhs.m_index; }
+		inline bool operator<(const segmented_iterator& rhs) const noexcept { return m_index < rhs.m_index; }
+		inline bool operator>(const segmented_iterator& rhs) const noexcept { return m_index > rhs.m_index; }
+		inline bool operator<=(const segmented_iterator& rhs) const noexcept { return m_index <= rhs.m_index; }
+		inline bool operator>=(const segmented_iterator& rhs) const noexcept { return m_index >= rhs.m_index; }
+
+		//*******[ Accessor Operations ]
+		//******************************
+		// Dereference operator
+		//******************************
+		inline reference operator*() const noexcept { return (*m_vector)[m_index]; }
+
+		//******************************
+		// Pointer operator
+		//******************************
+		inline pointer operator->() const noexcept { return &(*m_vector)[m_index]; }
+
+		//******************************
+		// Offset subscript operator
+		//******************************
+		inline reference operator[](difference_type offset) const noexcept { return (*m_vector)[m_index + offset]; }
+	private:
+		Container* m_vector;
+		size_t m_index;
+	};
+
+	//******************************
+	// Addition operator overload
+	//******************************
+	template<typename Container>
+	inline segmented_iterator<Container> operator+(ptrdiff_t amount, const segmented_iterator<Container>& iter) noexcept
+	{
+		return iter + amount;
+	}
+}
@@ -0,0 +1,1049 @@
+//**************************************
+// serialize.h
+//
+// Holds the binary format the nids
+// vectors are saved in, and the
+// functions and classes that write and
+// read it.
+//
+// Elements go to and from the file as
+// one block of bytes straight out of
+// data(), so saving or loading a
+// vector costs a few system calls and
+// one checksum pass rather than a call
+// per element. Files too big to buffer
+// can be streamed in chunks, and a
+// saved vector can be viewed in place
+// in a mapped file or buffer
+//
+// POSIX only (writev / mmap)
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <type_traits>
+#include <unistd.h>
+#include "span.h"
+#include "vector.h"
+
+namespace nids
+{
+	// what a serialization call ran into
+	enum class SerialStatus
+	{
+		SERIAL_OK,
+		SERIAL_END,				// a reader has no chunks left
+		SERIAL_IO_ERROR,		// a system call failed or the file ended early
+		SERIAL_BAD_FORMAT,		// not a nids file, or a version this code can't read
+		SERIAL_WRONG_TYPE,		// written with a different element size
+		SERIAL_BYTE_ORDER,		// written on a machine of the other endianness
+		SERIAL_BAD_CHECKSUM,	// the contents were damaged
+		SERIAL_NO_MEMORY		// the vector couldn't grow to hold the contents
+	};
+
+	// how the elements follow the header
+	enum class SerialLayout : uint32_t
+	{
+		LAYOUT_FLAT,	// count elements in one block, can be viewed in place
+		LAYOUT_CHUNKED	// chunks each led by a serial_chunk, ended by an empty one
+	};
+
+	//**************************************
+	// Serial file header
+	//
+	// A whole cache line, so a flat file's
+	// elements start 64 byte aligned in a
+	// mapping. Every field is written in
+	// the writer's byte order, which
+	// byteOrder shows
+	//**************************************
+	struct serial_header
+	{
+		// identifies a nids serial file ("NIDSSERL")
+		static const uint64_t MAGIC = 0x4C52455353444E49ull;
+
+		// format version, bumped on incompatible changes
+		static const uint32_t VERSION = 1;
+
+		// byteOrder as the writer stores it
+		static const uint32_t ORDER_MARK = 0x01020304;
+
+		uint64_t magic;
+		uint32_t version;
+		uint32_t byteOrder;
+		uint32_t elementSize;
+		SerialLayout layout;
+		uint64_t count;			// elements, 0 when chunked
+		uint64_t checksum;		// of the element bytes, 0 when chunked
+		unsigned char reserved[24];
+	};
+	static_assert(sizeof(serial_header) == 64);
+
+	//**************************************
+	// Serial chunk header
+	//
+	// Leads each chunk of a chunked file
+	//**************************************
+	struct serial_chunk
+	{
+		uint64_t count;
+		uint64_t checksum;
+	};
+
+	//**************************************
+	// Byte swapping helpers
+	//
+	// For files written with the other
+	// byte order
+	//**************************************
+	inline uint16_t byte_swap(uint16_t value) noexcept { return static_cast<uint16_t>((value >> 8) | (value << 8)); }
+	inline uint32_t byte_swap(uint32_t value) noexcept { return __builtin_bswap32(value); }
+	inline uint64_t byte_swap(uint64_t value) noexcept { return __builtin_bswap64(value); }
+
+	template<typename Type>
+	inline void byte_swap_elements(Type* elements, size_t count) noexcept
+	{
+		static_assert(sizeof(Type) == 1 || sizeof(Type) == 2 || sizeof(Type) == 4 || sizeof(Type) == 8);
+		if constexpr (sizeof(Type) > 1)
+		{
+			using word_type = std::conditional_t<sizeof(Type) == 2, uint16_t, std::conditional_t<sizeof(Type) == 4, uint32_t, uint64_t>>;
+			for (size_t index{ 0 }; index < count; ++index)
+			{
+				word_type word;
+				memcpy(&word, elements + index, sizeof(word));
+				word = byte_swap(word);
+				memcpy(elements + index, &word, sizeof(word));
+			}
+		}
+	}
+
+	//**************************************
+	// Checksum
+	//
+	// XXH64 (seed 0), fed in pieces of any
+	// size. Four independent lanes take 32
+	// bytes a step, so it keeps up with
+	// memory rather than holding up a
+	// write
+	//**************************************
+	class checksum64 final
+	{
+	public:
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//************************************
+		inline checksum64() noexcept
+			: m_lanes{ PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1 }, m_buffer(), m_buffered(0), m_total(0) {}
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Update method
+		//
+		// Adds bytes to the checksum
+		//************************************
+		void update(const void* data, size_t bytes) noexcept;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Digest getter
+		//
+		// Returns the checksum of every byte
+		// added so far
+		//************************************
+		uint64_t digest() const noexcept;
+
+		//************************************
+		// One shot checksum method
+		//************************************
+		static inline uint64_t of(const void* data, size_t bytes) noexcept
+		{
+			checksum64 sum;
+			sum.update(data, bytes);
+			return sum.digest();
+		}
+	private:
+		static const uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+		static const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+		static const uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+		static const uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ull;
+		static const uint64_t PRIME_5 = 0x27D4EB2F165667C5ull;
+
+		static inline uint64_t rotate(uint64_t value, unsigned bits) noexcept { return (value << bits) | (value >> (64 - bits)); }
+
+		//************************************
+		// Little endian load method
+		//
+		// XXH64 reads its input as little
+		// endian words, swap them on a big
+		// endian host so every host gets the
+		// same digest
+		//************************************
+		template<typename Word>
+		static inline Word load(const unsigned char* bytes) noexcept
+		{
+			Word value;
+			memcpy(&value, bytes, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			value = byte_swap(value);
+#endif
+			return value;
+		}
+
+		static inline uint64_t round(uint64_t lane, uint64_t input) noexcept { return rotate(lane + input * PRIME_2, 31) * PRIME_1; }
+
+		static inline uint64_t merge(uint64_t hash, uint64_t lane) noexcept { return (hash ^ round(0, lane)) * PRIME_1 + PRIME_4; }
+
+		//************************************
+		// Stripe method
+		//
+		// Runs the lanes over every whole 32
+		// byte stripe of bytes
+		//
+		// Returns the bytes consumed
+		//************************************
+		inline size_t stripes(const unsigned char* bytes, size_t count) noexcept
+		{
+			uint64_t a = m_lanes[0], b = m_lanes[1], c = m_lanes[2], d = m_lanes[3];
+			size_t offset{ 0 };
+			for (; offset + 32 <= count; offset += 32)
+			{
+				a = round(a, load<uint64_t>(bytes + offset));
+				b = round(b, load<uint64_t>(bytes + offset + 8));
+				c = round(c, load<uint64_t>(bytes + offset + 16));
+				d = round(d, load<uint64_t>(bytes + offset + 24));
+			}
+			m_lanes[0] = a;
+			m_lanes[1] = b;
+			m_lanes[2] = c;
+			m_lanes[3] = d;
+			return offset;
+		}
+
+		uint64_t m_lanes[4];
+		unsigned char m_buffer[32];
+		size_t m_buffered;
+		uint64_t m_total;
+	};
+
+	//**********************************
+	// Update method
+	//**********************************
+	inline void checksum64::update(const void* data, size_t bytes) noexcept
+	{
+		const unsigned char* source = static_cast<const unsigned char*>(data);
+		m_total += bytes;
+
+		// top up a partial stripe first
+		if (m_buffered > 0)
+		{
+			size_t take = 32 - m_buffered < bytes ? 32 - m_buffered : bytes;
+			memcpy(m_buffer + m_buffered, source, take);
+			m_buffered += take;
+			source += take;
+			bytes -= take;
+			if (m_buffered < 32)
+				return;
+			stripes(m_buffer, 32);
+			m_buffered = 0;
+		}
+
+		size_t consumed = stripes(source, bytes);
+		m_buffered = bytes - consumed;
+		if (m_buffered > 0)
+			memcpy(m_buffer, source + consumed, m_buffered);
+	}
+
+	//**********************************
+	// Digest getter
+	//**********************************
+	inline uint64_t checksum64::digest() const noexcept
+	{
+		uint64_t hash;
+		if (m_total >= 32)
+		{
+			hash = rotate(m_lanes[0], 1) + rotate(m_lanes[1], 7) + rotate(m_lanes[2], 12) + rotate(m_lanes[3], 18);
+			for (uint64_t lane : m_lanes)
+				hash = merge(hash, lane);
+		}
+		else
+			hash = PRIME_5;
+		hash += m_total;
+
+		size_t offset{ 0 };
+		for (; offset + 8 <= m_buffered; offset += 8)
+			hash = rotate(hash ^ round(0, load<uint64_t>(m_buffer + offset)), 27) * PRIME_1 + PRIME_4;
+		if (offset + 4 <= m_buffered)
+		{
+			uint64_t word = load<uint32_t>(m_buffer + offset);
+			hash = rotate(hash ^ (word * PRIME_1), 23) * PRIME_2 + PRIME_3;
+			offset += 4;
+		}
+		for (; offset < m_buffered; ++offset)
+			hash = rotate(hash ^ (m_buffer[offset] * PRIME_5), 11) * PRIME_1;
+
+		hash ^= hash >> 33;
+		hash *= PRIME_2;
+		hash ^= hash >> 29;
+		hash *= PRIME_3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	//**************************************
+	// Whole write helper
+	//
+	// Writes every byte of count buffers
+	// with as few writev calls as the OS
+	// allows, picking up after partial
+	// writes. vectors is used up
+	//**************************************
+	inline bool write_fully(int file, iovec* vectors, int count) noexcept
+	{
+		while (count > 0)
+		{
+			ssize_t written = writev(file, vectors, count);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+
+			size_t remaining = static_cast<size_t>(written);
+			while (count > 0 && remaining >= vectors->iov_len)
+			{
+				remaining -= vectors->iov_len;
+				++vectors;
+				--count;
+			}
+			if (count > 0)
+			{
+				vectors->iov_base = static_cast<char*>(vectors->iov_base) + remaining;
+				vectors->iov_len -= remaining;
+			}
+		}
+		return true;
+	}
+
+	//**************************************
+	// Whole read helper
+	//
+	// Reads exactly bytes into dest
+	//
+	// Returns false on an error or if the
+	// file ends first
+	//**************************************
+	inline bool read_fully(int file, void* dest, size_t bytes) noexcept
+	{
+		char* out = static_cast<char*>(dest);
+		while (bytes > 0)
+		{
+			ssize_t got = ::read(file, out, bytes);
+			if (got < 0 && errno == EINTR)
+				continue;
+			if (got <= 0)
+				return false;
+			out += got;
+			bytes -= static_cast<size_t>(got);
+		}
+		return true;
+	}
+
+	//**************************************
+	// Header making helper
+	//**************************************
+	template<typename Type>
+	inline serial_header make_serial_header(SerialLayout layout, uint64_t count, uint64_t checksum) noexcept
+	{
+		serial_header header{};
+		header.magic = serial_header::MAGIC;
+		header.version = serial_header::VERSION;
+		header.byteOrder = serial_header::ORDER_MARK;
+		header.elementSize = sizeof(Type);
+		header.layout = layout;
+		header.count = count;
+		header.checksum = checksum;
+		return header;
+	}
+
+	//**************************************
+	// Header checking helper
+	//
+	// Puts a header from a machine of the
+	// other byte order into this one's,
+	// setting swapped, then checks it
+	// matches Type
+	//**************************************
+	template<typename Type>
+	inline SerialStatus check_serial_header(serial_header& header, bool& swapped) noexcept
+	{
+		swapped = header.byteOrder == byte_swap(serial_header::ORDER_MARK);
+		if (swapped)
+		{
+			header.magic = byte_swap(header.magic);
+			header.version = byte_swap(header.version);
+			header.elementSize = byte_swap(header.elementSize);
+			header.layout = static_cast<SerialLayout>(byte_swap(static_cast<uint32_t>(header.layout)));
+			header.count = byte_swap(header.count);
+			header.checksum = byte_swap(header.checksum);
+		}
+		else if (header.byteOrder != serial_header::ORDER_MARK)
+			return SerialStatus::SERIAL_BAD_FORMAT;
+
+		if (header.magic != serial_header::MAGIC || header.version != serial_header::VERSION
+			|| (header.layout != SerialLayout::LAYOUT_FLAT && header.layout != SerialLayout::LAYOUT_CHUNKED))
+			return SerialStatus::SERIAL_BAD_FORMAT;
+		if (header.elementSize != sizeof(Type))
+			return SerialStatus::SERIAL_WRONG_TYPE;
+
+		// only plain numbers can be put back in order
+		if (swapped && !std::is_arithmetic_v<Type>)
+			return SerialStatus::SERIAL_BYTE_ORDER;
+		return SerialStatus::SERIAL_OK;
+	}
+
+	//**************************************
+	// Element reading helper
+	//
+	// Appends count elements read from
+	// file to vector, checking them
+	// against checksum
+	//**************************************
+	template<typename Vector>
+	inline SerialStatus read_elements(int file, Vector& vector, uint64_t count, uint64_t checksum, bool swapped) noexcept
+	{
+		using Type = typename Vector::value_type;
+		size_t first = vector.size();
+		if (count > (SIZE_MAX - first) / sizeof(Type))
+			return SerialStatus::SERIAL_NO_MEMORY;
+		if (vector.resize_default_init(first + static_cast<size_t>(count)) != first + count)
+			return SerialStatus::SERIAL_NO_MEMORY;
+
+		Type* dest = vector.data() + first;
+		size_t bytes = sizeof(Type) * static_cast<size_t>(count);
+		if (!read_fully(file, dest, bytes))
+		{
+			vector.resize_default_init(first);
+			return SerialStatus::SERIAL_IO_ERROR;
+		}
+		if (checksum64::of(dest, bytes) != checksum)
+		{
+			vector.resize_default_init(first);
+			return SerialStatus::SERIAL_BAD_CHECKSUM;
+		}
+		if (swapped)
+			byte_swap_elements(dest, static_cast<size_t>(count));
+		return SerialStatus::SERIAL_OK;
+	}
+
+	//**************************************
+	// Vector writing method
+	//
+	// Writes the header and every element
+	// of container (anything with data()
+	// and size(), like the nids vectors or
+	// a span) as one flat file, with a
+	// single writev for the common case
+	//**************************************
+	template<typename Container>
+	SerialStatus write_vector(int file, const Container& container) noexcept
+	{
+		using Type = std::remove_cv_t<std::remove_reference_t<decltype(*container.data())>>;
+		static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be written as bytes");
+
+		size_t bytes = sizeof(Type) * container.size();
+		serial_header header = make_serial_header<Type>(SerialLayout::LAYOUT_FLAT, container.size(), checksum64::of(container.data(), bytes));
+		iovec vectors[2] = { { &header, sizeof(header) }, { const_cast<Type*>(container.data()), bytes } };
+		return write_fully(file, vectors, bytes > 0 ? 2 : 1) ? SerialStatus::SERIAL_OK : SerialStatus::SERIAL_IO_ERROR;
+	}
+
+	//**************************************
+	// Vector writing method (path)
+	//
+	// Replaces the file at path
+	//**************************************
+	template<typename Container>
+	SerialStatus write_vector(const char* path, const Container& container) noexcept
+	{
+		int file = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (file < 0)
+			return SerialStatus::SERIAL_IO_ERROR;
+		SerialStatus status = write_vector(file, container);
+		if (::close(file) != 0 && status == SerialStatus::SERIAL_OK)
+			status = SerialStatus::SERIAL_IO_ERROR;
+		return status;
+	}
+
+	//**************************************
+	// Vector reading method
+	//
+	// Replaces the contents of vector
+	// (anything with data(), size(), and
+	// resize_default_init, like
+	// nids::vector) with a vector read
+	// from file. A flat file is read
+	// straight into data() in one call;
+	// a chunked one a chunk at a time
+	//
+	// vector is left empty on failure
+	//**************************************
+	template<typename Vector>
+	SerialStatus read_vector(int file, Vector& vector) noexcept
+	{
+		using Type = typename Vector::value_type;
+		static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be read as bytes");
+
+		vector.resize_default_init(0);
+		serial_header header;
+		if (!read_fully(file, &header, sizeof(header)))
+			return SerialStatus::SERIAL_IO_ERROR;
+		bool swapped;
+		SerialStatus status = check_serial_header<Type>(header, swapped);
+		if (status != SerialStatus::SERIAL_OK)
+			return status;
+
+		if (header.layout == SerialLayout::LAYOUT_FLAT)
+			return read_elements(file, vector, header.count, header.checksum, swapped);
+
+		for (;;)
+		{
+			serial_chunk chunk;
+			if (!read_fully(file, &chunk, sizeof(chunk)))
+				status = SerialStatus::SERIAL_IO_ERROR;
+			else
+			{
+				if (swapped)
+				{
+					chunk.count = byte_swap(chunk.count);
+					chunk.checksum = byte_swap(chunk.checksum);
+				}
+				if (chunk.count == 0)
+					return SerialStatus::SERIAL_OK;
+				status = read_elements(file, vector, chunk.count, chunk.checksum, swapped);
+			}
+			if (status != SerialStatus::SERIAL_OK)
+			{
+				vector.resize_default_init(0);
+				return status;
+			}
+		}
+	}
+
+	//**************************************
+	// Vector reading method (path)
+	//**************************************
+	template<typename Vector>
+	SerialStatus read_vector(const char* path, Vector& vector) noexcept
+	{
+		int file = ::open(path, O_RDONLY);
+		if (file < 0)
+		{
+			vector.resize_default_init(0);
+			return SerialStatus::SERIAL_IO_ERROR;
+		}
+		SerialStatus status = read_vector(file, vector);
+		::close(file);
+		return status;
+	}
+
+	//**************************************
+	// Streaming writer
+	//
+	// Writes a chunked file a piece at a
+	// time, for vectors that don't fit in
+	// memory at once or whose length isn't
+	// known up front. Small writes are
+	// gathered into a buffer of
+	// chunkElements; writes at least that
+	// big go out straight from the
+	// caller's memory. Nothing seeks, so
+	// file can be a pipe or socket
+	//**************************************
+	template<typename Type, typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class serial_writer final
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be written as bytes");
+	public:
+		// elements per chunk unless the constructor says otherwise, 1 MB of them
+		static const size_t DEFAULT_CHUNK_BYTES = 1024 * 1024;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//
+		// Writes the file header to file,
+		// which the writer doesn't own
+		//************************************
+		explicit serial_writer(int file, size_t chunkElements = (DEFAULT_CHUNK_BYTES + sizeof(Type) - 1) / sizeof(Type)) noexcept;
+
+		serial_writer(const serial_writer&) = delete;
+		serial_writer& operator=(const serial_writer&) = delete;
+
+		//************************************
+		// Destructor
+		//
+		// Finishes the file if finish
+		// wasn't called
+		//************************************
+		inline ~serial_writer() noexcept
+		{
+			if (!m_finished)
+				finish();
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Status getter
+		//
+		// Returns the first error, every
+		// call after one does nothing
+		//************************************
+		inline SerialStatus status() const noexcept { return m_status; }
+
+		//************************************
+		// Written count accessor
+		//************************************
+		inline uint64_t count() const noexcept { return m_count; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Write method
+		//************************************
+		SerialStatus write(span<const Type> elements) noexcept;
+
+		//************************************
+		// Write method (single element)
+		//************************************
+		inline SerialStatus write(const Type& element) noexcept { return write(span<const Type>(&element, 1)); }
+
+		//************************************
+		// Finish method
+		//
+		// Writes what is buffered and the
+		// closing empty chunk
+		//************************************
+		SerialStatus finish() noexcept;
+	private:
+		//************************************
+		// Chunk writing method
+		//************************************
+		bool write_chunk(const Type* elements, size_t count) noexcept;
+
+		int m_file;
+		size_t m_chunkElements;
+		vector<Type, GrowthPolicy, Allocator> m_buffer;
+		uint64_t m_count;
+		SerialStatus m_status;
+		bool m_finished;
+	};
+
+	//**********************************
+	// Constructor
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	serial_writer<Type, GrowthPolicy, Allocator>::serial_writer(int file, size_t chunkElements) noexcept
+		: m_file(file), m_chunkElements(chunkElements > 0 ? chunkElements : 1), m_buffer(), m_count(0), m_status(SerialStatus::SERIAL_OK), m_finished(false)
+	{
+		serial_header header = make_serial_header<Type>(SerialLayout::LAYOUT_CHUNKED, 0, 0);
+		iovec vector = { &header, sizeof(header) };
+		if (!write_fully(m_file, &vector, 1))
+			m_status = SerialStatus::SERIAL_IO_ERROR;
+	}
+
+	//**********************************
+	// Write method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	SerialStatus serial_writer<Type, GrowthPolicy, Allocator>::write(span<const Type> elements) noexcept
+	{
+		assert(!m_finished);
+		if (m_status != SerialStatus::SERIAL_OK)
+			return m_status;
+
+		const Type* source = elements.data();
+		size_t remaining = elements.size();
+		m_count += remaining;
+
+		// fill up a started chunk first
+		if (!m_buffer.empty())
+		{
+			size_t take = m_chunkElements - m_buffer.size() < remaining ? m_chunkElements - m_buffer.size() : remaining;
+			m_buffer.append(source, source + take);
+			source += take;
+			remaining -= take;
+			if (m_buffer.size() < m_chunkElements)
+				return m_status;
+			if (!write_chunk(m_buffer.data(), m_buffer.size()))
+				return m_status;
+			m_buffer.resize_default_init(0);
+		}
+
+		// whole chunks skip the buffer
+		for (; remaining >= m_chunkElements; source += m_chunkElements, remaining -= m_chunkElements)
+			if (!write_chunk(source, m_chunkElements))
+				return m_status;
+
+		if (remaining > 0)
+		{
+			if (m_buffer.capacity() < m_chunkElements)
+				m_buffer.reserve(m_chunkElements);
+			m_buffer.append(source, source + remaining);
+		}
+		return m_status;
+	}
+
+	//**********************************
+	// Finish method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	SerialStatus serial_writer<Type, GrowthPolicy, Allocator>::finish() noexcept
+	{
+		assert(!m_finished);
+		m_finished = true;
+		if (m_status == SerialStatus::SERIAL_OK && !m_buffer.empty())
+			write_chunk(m_buffer.data(), m_buffer.size());
+		if (m_status == SerialStatus::SERIAL_OK)
+			write_chunk(nullptr, 0);
+		return m_status;
+	}
+
+	//**********************************
+	// Chunk writing method
+	//**********************************
+	template<typename Type, typename GrowthPolicy, typename Allocator>
+	bool serial_writer<Type, GrowthPolicy, Allocator>::write_chunk(const Type* elements, size_t count) noexcept
+	{
+		size_t bytes = sizeof(Type) * count;
+		serial_chunk chunk = { count, count > 0 ? checksum64::of(elements, bytes) : 0 };
+		iovec vectors[2] = { { &chunk, sizeof(chunk) }, { const_cast<Type*>(elements), bytes } };
+		if (!write_fully(m_file, vectors, count > 0 ? 2 : 1))
+			m_status = SerialStatus::SERIAL_IO_ERROR;
+		return m_status == SerialStatus::SERIAL_OK;
+	}
+
+	//**************************************
+	// Streaming reader
+	//
+	// Reads a file one chunk at a time,
+	// so a reader never holds more than
+	// the writer's chunk size. Flat files
+	// come back as a single chunk
+	//**************************************
+	template<typename Type>
+	class serial_reader final
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be read as bytes");
+	public:
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//
+		// Reads the file header from file,
+		// which the reader doesn't own
+		//************************************
+		explicit serial_reader(int file) noexcept;
+
+		serial_reader(const serial_reader&) = delete;
+		serial_reader& operator=(const serial_reader&) = delete;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Status getter
+		//
+		// SERIAL_END once every chunk has
+		// been read
+		//************************************
+		inline SerialStatus status() const noexcept { return m_status; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Next chunk method
+		//
+		// Replaces the contents of chunk
+		// (a nids::vector of Type, reusing
+		// its capacity) with the next chunk
+		//
+		// Returns SERIAL_OK while there are
+		// chunks, then SERIAL_END
+		//************************************
+		template<typename Vector>
+		SerialStatus next(Vector& chunk) noexcept;
+	private:
+		int m_file;
+		SerialLayout m_layout;
+		uint64_t m_flatCount;		// left to read of a flat file
+		uint64_t m_flatChecksum;
+		bool m_swapped;
+		SerialStatus m_status;
+	};
+
+	//**********************************
+	// Constructor
+	//**********************************
+	template<typename Type>
+	serial_reader<Type>::serial_reader(int file) noexcept
+		: m_file(file), m_layout(SerialLayout::LAYOUT_FLAT), m_flatCount(0), m_flatChecksum(0), m_swapped(false), m_status(SerialStatus::SERIAL_OK)
+	{
+		serial_header header;
+		if (!read_fully(m_file, &header, sizeof(header)))
+		{
+			m_status = SerialStatus::SERIAL_IO_ERROR;
+			return;
+		}
+		m_status = check_serial_header<Type>(header, m_swapped);
+		m_layout = header.layout;
+		m_flatCount = header.count;
+		m_flatChecksum = header.checksum;
+	}
+
+	//**********************************
+	// Next chunk method
+	//**********************************
+	template<typename Type>
+	template<typename Vector>
+	SerialStatus serial_reader<Type>::next(Vector& chunk) noexcept
+	{
+		static_assert(std::is_same_v<typename Vector::value_type, Type>);
+		chunk.resize_default_init(0);
+		if (m_status != SerialStatus::SERIAL_OK)
+			return m_status;
+
+		uint64_t count;
+		uint64_t checksum;
+		if (m_layout == SerialLayout::LAYOUT_FLAT)
+		{
+			// the whole file is the one chunk
+			count = m_flatCount;
+			checksum = m_flatChecksum;
+			m_flatCount = 0;
+			if (count == 0)
+				return m_status = SerialStatus::SERIAL_END;
+		}
+		else
+		{
+			serial_chunk header;
+			if (!read_fully(m_file, &header, sizeof(header)))
+				return m_status = SerialStatus::SERIAL_IO_ERROR;
+			count = m_swapped ? byte_swap(header.count) : header.count;
+			checksum = m_swapped ? byte_swap(header.checksum) : header.checksum;
+			if (count == 0)
+				return m_status = SerialStatus::SERIAL_END;
+		}
+		m_status = read_elements(m_file, chunk, count, checksum, m_swapped);
+		return m_status;
+	}
+
+	//**************************************
+	// Serial view
+	//
+	// Read only view of the elements of a
+	// flat file, either mapped from disk
+	// or sitting in a buffer the caller
+	// owns, without copying them. open
+	// checks the header but not the
+	// checksum, since that touches every
+	// page; call verify for that
+	//**************************************
+	template<typename Type>
+	class serial_view final
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be viewed as bytes");
+	public:
+		using value_type = Type;
+		using iterator = const Type*;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline serial_view() noexcept : m_mapping(nullptr), m_mappedBytes(0), m_header(nullptr), m_elements() {}
+
+		serial_view(const serial_view&) = delete;
+		serial_view& operator=(const serial_view&) = delete;
+
+		//************************************
+		// Move constructor
+		//************************************
+		inline serial_view(serial_view&& rhs) noexcept
+			: m_mapping(rhs.m_mapping), m_mappedBytes(rhs.m_mappedBytes), m_header(rhs.m_header), m_elements(rhs.m_elements)
+		{
+			rhs.forget();
+		}
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~serial_view() noexcept { close(); }
+
+		//************************************
+		// Open method (path)
+		//
+		// Maps the file at path read only
+		//************************************
+		SerialStatus open(const char* path) noexcept;
+
+		//************************************
+		// Open method (buffer)
+		//
+		// Views a file already in memory,
+		// which must outlive the view and be
+		// aligned for Type past the header
+		//************************************
+		SerialStatus open(const void* buffer, size_t bytes) noexcept;
+
+		//************************************
+		// Close method
+		//************************************
+		inline void close() noexcept
+		{
+			if (m_mapping != nullptr)
+				munmap(m_mapping, m_mappedBytes);
+			forget();
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Open status getter
+		//************************************
+		inline bool is_open() const noexcept { return m_header != nullptr; }
+
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_elements.size(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_elements.empty(); }
+
+		//************************************
+		// Array getter
+		//************************************
+		inline const Type* data() const noexcept { return m_elements.data(); }
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept { return m_elements[index]; }
+
+		//************************************
+		// Span getter
+		//************************************
+		inline span<const Type> view() const noexcept { return m_elements; }
+
+		//************************************
+		// Iterator getters
+		//************************************
+		inline iterator begin() const noexcept { return m_elements.begin(); }
+		inline iterator end() const noexcept { return m_elements.end(); }
+
+		//************************************
+		// Verify method
+		//
+		// Checks the elements against the
+		// header's checksum
+		//************************************
+		inline SerialStatus verify() const noexcept
+		{
+			assert(is_open());
+			return checksum64::of(m_elements.data(), m_elements.size_bytes()) == m_header->checksum ? SerialStatus::SERIAL_OK : SerialStatus::SERIAL_BAD_CHECKSUM;
+		}
+	private:
+		//************************************
+		// Forget method
+		//************************************
+		inline void forget() noexcept
+		{
+			m_mapping = nullptr;
+			m_mappedBytes = 0;
+			m_header = nullptr;
+			m_elements = span<const Type>();
+		}
+
+		void* m_mapping;
+		size_t m_mappedBytes;
+		const serial_header* m_header;
+		span<const Type> m_elements;
+	};
+
+	//**********************************
+	// Open method (path)
+	//**********************************
+	template<typename Type>
+	SerialStatus serial_view<Type>::open(const char* path) noexcept
+	{
+		close();
+		int file = ::open(path, O_RDONLY);
+		if (file < 0)
+			return SerialStatus::SERIAL_IO_ERROR;
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(serial_header))
+		{
+			::close(file);
+			return SerialStatus::SERIAL_IO_ERROR;
+		}
+
+		// the mapping stays valid after the file is closed
+		size_t bytes = static_cast<size_t>(status.st_size);
+		void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, file, 0);
+		::close(file);
+		if (mapping == MAP_FAILED)
+			return SerialStatus::SERIAL_IO_ERROR;
+
+		SerialStatus result = open(mapping, bytes);
+		if (result != SerialStatus::SERIAL_OK)
+		{
+			munmap(mapping, bytes);
+			return result;
+		}
+		m_mapping = mapping;
+		m_mappedBytes = bytes;
+		return SerialStatus::SERIAL_OK;
+	}
+
+	//**********************************
+	// Open method (buffer)
+	//**********************************
+	template<typename Type>
+	SerialStatus serial_view<Type>::open(const void* buffer, size_t bytes) noexcept
+	{
+		if (m_mapping != buffer)
+			close();
+		if (bytes < sizeof(serial_header))
+			return SerialStatus::SERIAL_IO_ERROR;
+
+		// the view reads the header in place, so it has to be in this machine's order
+		const serial_header* header = static_cast<const serial_header*>(buffer);
+		serial_header copy = *header;
+		bool swapped;
+		SerialStatus status = check_serial_header<Type>(copy, swapped);
+		if (status == SerialStatus::SERIAL_OK && swapped)
+			status = SerialStatus::SERIAL_BYTE_ORDER;
+		if (status == SerialStatus::SERIAL_OK && copy.layout != SerialLayout::LAYOUT_FLAT)
+			status = SerialStatus::SERIAL_BAD_FORMAT;
+		if (status != SerialStatus::SERIAL_OK)
+			return status;
+		if (copy.count > (bytes - sizeof(serial_header)) / sizeof(Type))
+			return SerialStatus::SERIAL_IO_ERROR;
+
+		const unsigned char* elements = static_cast<const unsigned char*>(buffer) + sizeof(serial_header);
+		assert(reinterpret_cast<uintptr_t>(elements) % alignof(Type) == 0);
+		m_header = header;
+		m_elements = span<const Type>(reinterpret_cast<const Type*>(elements), static_cast<size_t>(copy.count));
+		return SerialStatus::SERIAL_OK;
+	}
+}
@@ -0,0 +1,180 @@
+//**************************************
+// simd.h
+//
+// Holds the runtime detection of the
+// SIMD instruction sets the nids
+// algorithms can use, and the bit
+// helpers their kernels share.
+//
+// The level is detected once, and can
+// be lowered (never raised above what
+// the CPU supports) for testing and
+// benchmarking
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NIDS_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace nids
+{
+	// instruction sets the kernels are written for, in increasing order
+	enum class SimdLevel
+	{
+		SIMD_SCALAR,
+		SIMD_SSE2,
+		SIMD_AVX2,
+		SIMD_AVX512
+	};
+
+	//**************************************
+	// SIMD level detection method
+	//
+	// Returns the best level both the CPU
+	// and the OS support
+	//**************************************
+	inline SimdLevel detect_simd_level() noexcept
+	{
+#if defined(NIDS_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+			return SimdLevel::SIMD_AVX512;
+		if (__builtin_cpu_supports("avx2"))
+			return SimdLevel::SIMD_AVX2;
+		if (__builtin_cpu_supports("sse2"))
+			return SimdLevel::SIMD_SSE2;
+		return SimdLevel::SIMD_SCALAR;
+#elif defined(NIDS_SIMD_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		bool sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+		if (!sse2)
+			return SimdLevel::SIMD_SCALAR;
+		if (!osxsave || !avx)
+			return SimdLevel::SIMD_SSE2;
+
+		// make sure the OS saves the wide registers
+		unsigned long long xcr0 = _xgetbv(0);
+		if ((xcr0 & 0x6) != 0x6)
+			return SimdLevel::SIMD_SSE2;
+
+		__cpuidex(info, 7, 0);
+		bool avx2 = (info[1] & (1 << 5)) != 0;
+		bool avx512 = (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0;
+		if (avx512 && (xcr0 & 0xE6) == 0xE6)
+			return SimdLevel::SIMD_AVX512;
+		return avx2 ? SimdLevel::SIMD_AVX2 : SimdLevel::SIMD_SSE2;
+#else
+		return SimdLevel::SIMD_SCALAR;
+#endif
+	}
+
+	//**************************************
+	// Supported SIMD level getter
+	//**************************************
+	inline SimdLevel supported_simd_level() noexcept
+	{
+		static const SimdLevel level = detect_simd_level();
+		return level;
+	}
+
+	//**************************************
+	// Active SIMD level accessor
+	//**************************************
+	inline SimdLevel& active_simd_level() noexcept
+	{
+		static SimdLevel level = supported_simd_level();
+		return level;
+	}
+
+	//**************************************
+	// SIMD level getter
+	//**************************************
+	inline SimdLevel simd_level() noexcept { return active_simd_level(); }
+
+	//**************************************
+	// SIMD level mutator
+	//
+	// Clamps level to what is supported
+	//
+	// Returns the level now in use
+	//**************************************
+	inline SimdLevel set_simd_level(SimdLevel level) noexcept
+	{
+		if (level > supported_simd_level())
+			level = supported_simd_level();
+		active_simd_level() = level;
+		return level;
+	}
+
+	//**************************************
+	// Trailing zero count method
+	//**************************************
+	inline unsigned count_trailing_zeros(uint64_t value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<unsigned>(index);
+#else
+		unsigned index{ 0 };
+		while ((value & 1) == 0)
+		{
+			value >>= 1;
+			++index;
+		}
+		return index;
+#endif
+	}
+
+	//**************************************
+	// Leading zero count method
+	//**************************************
+	inline unsigned count_leading_zeros(uint64_t value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_clzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return 63 - static_cast<unsigned>(index);
+#else
+		unsigned count{ 0 };
+		while ((value & (1ull << 63)) == 0)
+		{
+			value <<= 1;
+			++count;
+		}
+		return count;
+#endif
+	}
+
+	//**************************************
+	// Population count method
+	//**************************************
+	inline unsigned population_count(uint64_t value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_popcountll(value));
+#else
+		value = value - ((value >> 1) & 0x5555555555555555ull);
+		value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+		value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return static_cast<unsigned>((value * 0x0101010101010101ull) >> 56);
+#endif
+	}
+}
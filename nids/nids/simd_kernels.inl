@@ -0,0 +1,331 @@
+//**************************************
+// simd_kernels.inl
+//
+// Holds the SIMD kernels behind the
+// nids algorithms, written once against
+// an ops type that wraps one
+// instruction set.
+//
+// algorithm.h includes this file once
+// per instruction set, inside a
+// namespace that defines ops and with
+// the matching compiler target turned
+// on, so there is no include guard
+//
+// ops provides:
+//	reg			register type
+//	WIDTH		register width in bytes
+//	BYTE_MASK	true if eq_mask has one
+//				bit per byte instead of one
+//				bit per lane
+//	FULL_BYTE_MASK	eq_mask<uint8_t> of
+//				two equal registers
+//	load, store, set1, eq_mask, min,
+//	max, add, bit_and, bit_or, bit_xor
+//	popcount64	set bits of each 64 bit
+//				lane, in that lane
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+//**************************************
+// Lane index helper
+//
+// Converts a bit position out of
+// eq_mask into a lane index
+//**************************************
+template<typename Type>
+inline size_t lane_of(unsigned bit) noexcept
+{
+	return ops::BYTE_MASK ? bit / sizeof(Type) : bit;
+}
+
+//**************************************
+// Find kernel
+//**************************************
+template<typename Type>
+inline const Type* find(const Type* first, const Type* last, Type value) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	const typename ops::reg needle = ops::template set1<Type>(value);
+
+	for (; static_cast<size_t>(last - first) >= LANES; first += LANES)
+	{
+		uint64_t mask = ops::template eq_mask<Type>(ops::load(first), needle);
+		if (mask != 0)
+			return first + lane_of<Type>(count_trailing_zeros(mask));
+	}
+
+	for (; first != last; ++first)
+		if (*first == value)
+			return first;
+	return last;
+}
+
+//**************************************
+// Count kernel
+//**************************************
+template<typename Type>
+inline size_t count(const Type* first, const Type* last, Type value) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	const typename ops::reg needle = ops::template set1<Type>(value);
+
+	size_t matches{ 0 };
+	for (; static_cast<size_t>(last - first) >= LANES; first += LANES)
+		matches += lane_of<Type>(population_count(ops::template eq_mask<Type>(ops::load(first), needle)));
+
+	for (; first != last; ++first)
+		if (*first == value)
+			++matches;
+	return matches;
+}
+
+//**************************************
+// Fill kernel
+//**************************************
+template<typename Type>
+inline void fill(Type* first, Type* last, Type value) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	const typename ops::reg pattern = ops::template set1<Type>(value);
+
+	for (; static_cast<size_t>(last - first) >= LANES; first += LANES)
+		ops::store(first, pattern);
+
+	for (; first != last; ++first)
+		*first = value;
+}
+
+//**************************************
+// Equality kernel
+//
+// Compares the bytes of the two ranges,
+// so it is only used for integers
+//**************************************
+template<typename Type>
+inline bool equal(const Type* lhs, const Type* rhs, size_t count) noexcept
+{
+	const uint8_t* left = reinterpret_cast<const uint8_t*>(lhs);
+	const uint8_t* right = reinterpret_cast<const uint8_t*>(rhs);
+	size_t bytes = count * sizeof(Type);
+
+	for (; bytes >= ops::WIDTH; bytes -= ops::WIDTH, left += ops::WIDTH, right += ops::WIDTH)
+		if (ops::template eq_mask<uint8_t>(ops::load(left), ops::load(right)) != ops::FULL_BYTE_MASK)
+			return false;
+
+	return bytes == 0 || memcmp(left, right, bytes) == 0;
+}
+
+//**************************************
+// Horizontal reduction helper
+//
+// Folds the lanes of acc together with
+// the scalar version of the operation
+//**************************************
+template<typename Type, typename Operation>
+inline Type reduce_lanes(typename ops::reg acc, Operation operation) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	alignas(64) Type lanes[LANES];
+	ops::store(lanes, acc);
+
+	Type result = lanes[0];
+	for (size_t lane{ 1 }; lane < LANES; ++lane)
+		result = operation(result, lanes[lane]);
+	return result;
+}
+
+//**************************************
+// Ordered lanes helper
+//
+// Returns the eq_mask of value with
+// itself, which is missing the lanes
+// holding NaN, the only value not
+// equal to itself
+//**************************************
+template<typename Type>
+inline uint64_t ordered_lanes(typename ops::reg value) noexcept
+{
+	return ops::template eq_mask<Type>(value, value);
+}
+
+//**************************************
+// All lanes helper
+//
+// The eq_mask of two equal registers
+//**************************************
+template<typename Type>
+inline uint64_t all_lanes() noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	return ops::BYTE_MASK ? ops::FULL_BYTE_MASK : (LANES == 64 ? ~0ull : (1ull << LANES) - 1);
+}
+
+//**************************************
+// Minimum kernel
+//
+// The range must not be empty
+//
+// The float min instructions treat NaN
+// and -0.0 / +0.0 ties differently
+// than the scalar loop, where the first
+// of equal values wins and only a NaN
+// in front sticks. A range holding a
+// NaN, or whose minimum is zero, is
+// done again with the scalar loop so
+// every SIMD level agrees with it
+//**************************************
+template<typename Type>
+inline Type min_value(const Type* first, const Type* last) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	auto scalar = [](Type lhs, Type rhs) { return rhs < lhs ? rhs : lhs; };
+
+	const Type* start = first;
+	Type result = *first;
+	if (static_cast<size_t>(last - first) >= LANES)
+	{
+		typename ops::reg acc = ops::load(first);
+		[[maybe_unused]] uint64_t ordered = all_lanes<Type>();
+		if constexpr (std::is_floating_point_v<Type>)
+			ordered = ordered_lanes<Type>(acc);
+		for (first += LANES; static_cast<size_t>(last - first) >= LANES; first += LANES)
+		{
+			typename ops::reg next = ops::load(first);
+			if constexpr (std::is_floating_point_v<Type>)
+				ordered &= ordered_lanes<Type>(next);
+			acc = ops::template min<Type>(acc, next);
+		}
+		result = reduce_lanes<Type>(acc, scalar);
+
+		if constexpr (std::is_floating_point_v<Type>)
+			if (ordered != all_lanes<Type>() || result == Type(0))
+			{
+				result = *start;
+				first = start;
+			}
+	}
+
+	for (; first != last; ++first)
+		result = scalar(result, *first);
+	return result;
+}
+
+//**************************************
+// Maximum kernel
+//
+// The range must not be empty
+//
+// Falls back to the scalar loop like
+// the minimum kernel does
+//**************************************
+template<typename Type>
+inline Type max_value(const Type* first, const Type* last) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+	auto scalar = [](Type lhs, Type rhs) { return lhs < rhs ? rhs : lhs; };
+
+	const Type* start = first;
+	Type result = *first;
+	if (static_cast<size_t>(last - first) >= LANES)
+	{
+		typename ops::reg acc = ops::load(first);
+		[[maybe_unused]] uint64_t ordered = all_lanes<Type>();
+		if constexpr (std::is_floating_point_v<Type>)
+			ordered = ordered_lanes<Type>(acc);
+		for (first += LANES; static_cast<size_t>(last - first) >= LANES; first += LANES)
+		{
+			typename ops::reg next = ops::load(first);
+			if constexpr (std::is_floating_point_v<Type>)
+				ordered &= ordered_lanes<Type>(next);
+			acc = ops::template max<Type>(acc, next);
+		}
+		result = reduce_lanes<Type>(acc, scalar);
+
+		if constexpr (std::is_floating_point_v<Type>)
+			if (ordered != all_lanes<Type>() || result == Type(0))
+			{
+				result = *start;
+				first = start;
+			}
+	}
+
+	for (; first != last; ++first)
+		result = scalar(result, *first);
+	return result;
+}
+
+//**************************************
+// Sum kernel
+//
+// Floating point sums are added up in
+// a different order than a scalar loop
+// would, so the rounding can differ
+//**************************************
+template<typename Type>
+inline Type sum(const Type* first, const Type* last) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(Type);
+
+	Type result{ 0 };
+	if (static_cast<size_t>(last - first) >= LANES)
+	{
+		typename ops::reg acc = ops::template set1<Type>(Type{ 0 });
+		for (; static_cast<size_t>(last - first) >= LANES; first += LANES)
+			acc = ops::template add<Type>(acc, ops::load(first));
+		result = reduce_lanes<Type>(acc, [](Type lhs, Type rhs) { return lhs + rhs; });
+	}
+
+	for (; first != last; ++first)
+		result += *first;
+	return result;
+}
+
+//**************************************
+// Word combining kernel
+//**************************************
+template<BitOperation Operation>
+inline void combine_words(uint64_t* dest, const uint64_t* source, size_t words) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(uint64_t);
+
+	size_t word{ 0 };
+	for (; words - word >= LANES; word += LANES)
+	{
+		typename ops::reg lhs = ops::load(dest + word);
+		typename ops::reg rhs = ops::load(source + word);
+		if constexpr (Operation == BitOperation::BIT_AND)
+			ops::store(dest + word, ops::bit_and(lhs, rhs));
+		else if constexpr (Operation == BitOperation::BIT_OR)
+			ops::store(dest + word, ops::bit_or(lhs, rhs));
+		else
+			ops::store(dest + word, ops::bit_xor(lhs, rhs));
+	}
+
+	for (; word < words; ++word)
+		dest[word] = apply_bit_operation<Operation>(dest[word], source[word]);
+}
+
+//**************************************
+// Population count kernel
+//**************************************
+inline size_t popcount_words(const uint64_t* words, size_t count) noexcept
+{
+	const size_t LANES = ops::WIDTH / sizeof(uint64_t);
+
+	size_t bits{ 0 };
+	size_t word{ 0 };
+	if (count >= LANES)
+	{
+		typename ops::reg acc = ops::template set1<uint64_t>(0);
+		for (; count - word >= LANES; word += LANES)
+			acc = ops::template add<uint64_t>(acc, ops::popcount64(ops::load(words + word)));
+		bits = reduce_lanes<uint64_t>(acc, [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; });
+	}
+
+	for (; word < count; ++word)
+		bits += population_count(words[word]);
+	return bits;
+}
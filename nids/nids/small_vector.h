@@ -0,0 +1,659 @@
+//**************************************
+// small_vector.h
+//
+// Holds the definition of my small
+// vector class.
+//
+// Same interface as nids::vector, but
+// the first InlineCapacity elements
+// live inside the object itself, and
+// the heap is only touched once the
+// vector grows past that
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <limits>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+#include "vector.h"
+
+namespace nids
+{
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy = default_growth, typename Allocator = default_allocator>
+	class small_vector final : private Allocator
+	{
+	public:
+		using value_type = Type;
+		using iterator = vector_iterator<Type, small_vector>;
+		using growth_policy = GrowthPolicy;
+		using allocator_type = Allocator;
+
+		//************************************
+		// End getter method
+		//************************************
+		inline iterator end() const noexcept { return iterator::end(this); }
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		inline small_vector() noexcept : Allocator(), m_array(inline_data()), m_size(0), m_capacity(InlineCapacity)
+		{
+			static_assert(sizeof(Type) != 0);
+			static_assert(InlineCapacity > 0);
+		}
+
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit small_vector(const Allocator& allocator) noexcept
+			: Allocator(allocator), m_array(inline_data()), m_size(0), m_capacity(InlineCapacity)
+		{
+			static_assert(sizeof(Type) != 0);
+			static_assert(InlineCapacity > 0);
+		}
+
+		//************************************
+		// Copy constructor
+		//************************************
+		small_vector(const small_vector& rhs) noexcept;
+
+		//************************************
+		// Move constructor
+		//************************************
+		small_vector(small_vector&& rhs) noexcept;
+
+		//************************************
+		// Copy assignment operator
+		//************************************
+		small_vector& operator=(const small_vector& rhs) noexcept;
+
+		//************************************
+		// Move assignment operator
+		//************************************
+		small_vector& operator=(small_vector&& rhs) noexcept;
+
+		//************************************
+		// Destructor
+		//************************************
+		inline ~small_vector() noexcept
+		{
+			destroy_range(m_array, m_size);
+			m_size = 0;
+			release();
+		}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return m_capacity; }
+
+		//************************************
+		// Const correct subscript operator
+		//************************************
+		inline const Type& operator[](size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return m_array[index];
+		}
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline Type& operator[](size_t index) noexcept
+		{
+			assert(index < m_size);
+			return m_array[index];
+		}
+
+		//************************************
+		// Const correct at object accessor
+		//************************************
+		inline const Type& at(size_t index) const noexcept { return operator[](index); }
+
+		//************************************
+		// At object accessor
+		//************************************
+		inline Type& at(size_t index) noexcept { return operator[](index); }
+
+		//************************************
+		// Max index getter
+		//************************************
+		inline size_t max_size() const noexcept { return std::numeric_limits<size_t>::max(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Inline storage status getter
+		//
+		// True until the vector spills over
+		// to the heap
+		//************************************
+		inline bool is_inline() const noexcept { return m_array == inline_data(); }
+
+		//************************************
+		// Allocator getter
+		//************************************
+		inline const Allocator& get_allocator() const noexcept { return *this; }
+
+		//************************************
+		// Array getter (const correct)
+		//************************************
+		inline const Type* data() const noexcept { return m_array; }
+
+		//************************************
+		// Array getter
+		//************************************
+		inline Type* data() noexcept { return m_array; }
+
+		//************************************
+		// View getters
+		//
+		// Return a span over every element,
+		// or count elements from offset. A
+		// view is a pointer and a length, so
+		// slicing copies nothing, but like
+		// data() it is invalidated by growth
+		//************************************
+		inline span<Type> view() noexcept { return span<Type>(m_array, m_size); }
+		inline span<const Type> view() const noexcept { return span<const Type>(m_array, m_size); }
+		inline span<Type> view(size_t offset, size_t count) noexcept { return view().subspan(offset, count); }
+		inline span<const Type> view(size_t offset, size_t count) const noexcept { return view().subspan(offset, count); }
+
+		//************************************
+		// Front item getter
+		//************************************
+		inline Type* front() const noexcept { return m_array; }
+
+		//************************************
+		// Back item getter
+		//************************************
+		inline Type* back() const noexcept { return &m_array[m_size - 1]; }
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		inline iterator begin() noexcept { return iterator(this); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Resize method
+		//
+		// Resizes the vector and does not
+		// initialize the new data members
+		//
+		// The capacity never drops below
+		// InlineCapacity, shrinking to that
+		// moves the data back inline
+		//
+		// Returns new capacity, or old
+		// capacity if unchanged
+		//************************************
+		size_t resize(size_t size) noexcept;
+
+		//************************************
+		// Resize method
+		//
+		// Resizes the vector and initializes
+		// the data to the value of val
+		//
+		// Only trivially copyable types get
+		// the new data initialized
+		//
+		// Returns new capacity, or old
+		// capacity if unchanged
+		//************************************
+		size_t resize(size_t size, const Type& val) noexcept;
+
+		//************************************
+		// Push back method
+		//
+		// WARNING: passing in references
+		// to current vector index can
+		// result in undefined behavior if
+		// the vector resizes on push_back
+		//************************************
+		inline void push_back(const Type& data) noexcept;
+
+		//************************************
+		// Push back method (rvalue)
+		//
+		// WARNING: passing in references
+		// to current vector index can
+		// result in undefined behavior if
+		// the vector resizes on push_back
+		//************************************
+		inline void push_back(Type&& data) noexcept;
+
+		//************************************
+		// Push back method (internal safe)
+		//************************************
+		inline void push_back_i(const Type& data) noexcept;
+
+		//************************************
+		// Push back method
+		// (rvalue, internal safe)
+		//************************************
+		inline void push_back_i(Type&& data) noexcept;
+
+		//************************************
+		// Erase method
+		//
+		// Removes the element at pos and
+		// shifts the rest down
+		//
+		// Returns an iterator to the element
+		// that followed the erased one
+		//************************************
+		iterator erase(iterator pos) noexcept;
+
+		//************************************
+		// Reserve method
+		//
+		// Grows the capacity to at least
+		// size, never shrinks it
+		//
+		// Returns the new capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			if (size > m_capacity)
+				resize(size);
+			return m_capacity;
+		}
+
+		//************************************
+		// Uninitialized resize method
+		//
+		// Sets the size, growing the
+		// capacity if needed, without
+		// touching the elements, so they
+		// can be filled through data()
+		// (e.g. by read or recv)
+		//
+		// Only for trivial types, anything
+		// else needs resize_default_init
+		//
+		// Returns the new size, or the old
+		// size if the allocation failed
+		//************************************
+		inline size_t resize_uninitialized(size_t size) noexcept
+		{
+			static_assert(std::is_trivial_v<Type>, "resize_uninitialized leaves the elements unconstructed");
+			return resize_default_init(size);
+		}
+
+		//************************************
+		// Default initializing resize method
+		//
+		// Sets the size, default
+		// constructing any new elements,
+		// which leaves trivial types
+		// untouched
+		//
+		// Returns the new size, or the old
+		// size if the allocation failed
+		//************************************
+		inline size_t resize_default_init(size_t size) noexcept
+		{
+			return array_resize_default_init(m_array, m_size, m_capacity, size, [this](size_t needed) { grow_to(needed); });
+		}
+
+		//************************************
+		// Emplace back method
+		//
+		// Constructs a new element at the
+		// end of the vector from args
+		//
+		// WARNING: args referencing the
+		// vector's own elements have the
+		// same problem as push_back
+		//************************************
+		template<typename... Args>
+		inline Type& emplace_back(Args&&... args) noexcept
+		{
+			return array_emplace_back(m_array, m_size, m_capacity, [this] { resize(next_capacity()); }, std::forward<Args>(args)...);
+		}
+
+		//************************************
+		// Append method
+		//
+		// Copies [first, last) onto the end
+		// of the vector, growing at most once
+		//
+		// Ranges taken from this vector are
+		// safe to append
+		//************************************
+		template<typename Iterator>
+		void append(Iterator first, Iterator last) noexcept;
+
+		//************************************
+		// Insert method
+		//
+		// Copies [first, last) in before pos,
+		// growing at most once
+		//
+		// The range must not come from this
+		// vector
+		//
+		// Returns an iterator to the first
+		// inserted element
+		//************************************
+		template<typename Iterator>
+		iterator insert(iterator pos, Iterator first, Iterator last) noexcept;
+	private:
+		//************************************
+		// Growth method
+		//
+		// Grows the capacity to hold at least
+		// needed elements, keeping to the
+		// growth policy when that is enough
+		//************************************
+		inline void grow_to(size_t needed) noexcept { resize(growth_target(next_capacity(), needed)); }
+
+		//************************************
+		// Inline buffer getters
+		//************************************
+		inline Type* inline_data() noexcept { return reinterpret_cast<Type*>(m_inline); }
+		inline const Type* inline_data() const noexcept { return reinterpret_cast<const Type*>(m_inline); }
+
+		//************************************
+		// Growth capacity getter
+		//************************************
+		inline size_t next_capacity() const noexcept { return GrowthPolicy::next_capacity(m_capacity, sizeof(Type)); }
+
+		//************************************
+		// Heap release method
+		//
+		// Frees the heap block (if any) and
+		// points back at the inline buffer,
+		// the elements must already be gone
+		//************************************
+		inline void release() noexcept
+		{
+			if (!is_inline())
+				this->deallocate(m_array, sizeof(Type) * m_capacity);
+			m_array = inline_data();
+			m_capacity = InlineCapacity;
+		}
+
+		//************************************
+		// Steal method
+		//
+		// Takes the contents of rhs, which
+		// must be empty beforehand
+		//************************************
+		void steal(small_vector& rhs) noexcept;
+
+		Type* m_array;
+		size_t m_size;
+		size_t m_capacity;
+		alignas(Type) unsigned char m_inline[sizeof(Type) * InlineCapacity];
+	};
+
+	//*************************************
+	// Copy constructor
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::small_vector(const small_vector& rhs) noexcept
+		: Allocator(rhs), m_array(inline_data()), m_size(0), m_capacity(InlineCapacity)
+	{
+		if (rhs.m_size > InlineCapacity)
+		{
+			m_array = static_cast<Type*>(this->allocate(sizeof(Type) * rhs.m_capacity));
+			assert(m_array != nullptr);
+			m_capacity = rhs.m_capacity;
+		}
+		copy_range(m_array, rhs.m_array, rhs.m_size);
+		m_size = rhs.m_size;
+	}
+
+	//*************************************
+	// Move constructor
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::small_vector(small_vector&& rhs) noexcept
+		: Allocator(std::move(rhs)), m_array(inline_data()), m_size(0), m_capacity(InlineCapacity)
+	{
+		steal(rhs);
+	}
+
+	//*************************************
+	// Copy assignment operator
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>&
+		small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::operator=(const small_vector& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			// the old contents are getting overwritten anyways
+			destroy_range(m_array, m_size);
+			m_size = 0;
+
+			// avoid allocating space if we can help it
+			if (m_capacity < rhs.m_size)
+			{
+				release();
+				m_array = static_cast<Type*>(this->allocate(sizeof(Type) * rhs.m_capacity));
+				assert(m_array != nullptr);
+				m_capacity = rhs.m_capacity;
+			}
+
+			// deep copy rhs
+			copy_range(m_array, rhs.m_array, rhs.m_size);
+			m_size = rhs.m_size;
+		}
+		return *this;
+	}
+
+	//*************************************
+	// Move assignment operator
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>&
+		small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::operator=(small_vector&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			// purge the left hand side
+			destroy_range(m_array, m_size);
+			m_size = 0;
+			release();
+			// move the right hand side (allocator included)
+			static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(rhs));
+			steal(rhs);
+		}
+		return *this;
+	}
+
+	//*************************************
+	// Steal method
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline void small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::steal(small_vector& rhs) noexcept
+	{
+		assert(m_size == 0 && is_inline());
+
+		// heap blocks can just change hands
+		if (!rhs.is_inline())
+		{
+			m_array = rhs.m_array;
+			m_capacity = rhs.m_capacity;
+			rhs.m_array = rhs.inline_data();
+			rhs.m_capacity = InlineCapacity;
+		}
+		else
+			relocate_range(m_array, rhs.m_array, rhs.m_size);
+
+		m_size = rhs.m_size;
+		rhs.m_size = 0;
+	}
+
+	//*************************************
+	// Resize method (no initialization)
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	size_t small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::resize(size_t size) noexcept
+	{
+		// drop anything that won't fit anymore
+		if (size < m_size)
+		{
+			destroy_range(m_array + size, m_size - size);
+			m_size = size;
+		}
+
+		// see if everything fits inline
+		if (size <= InlineCapacity)
+		{
+			if (!is_inline())
+			{
+				Type* heap = m_array;
+				size_t heapCapacity = m_capacity;
+				relocate_range(inline_data(), heap, m_size);
+				this->deallocate(heap, sizeof(Type) * heapCapacity);
+				m_array = inline_data();
+			}
+			m_capacity = InlineCapacity;
+			return m_capacity;
+		}
+
+		Type* newRegion = nullptr;
+		if (is_inline())
+		{
+			// spill over to the heap
+			newRegion = static_cast<Type*>(this->allocate(sizeof(Type) * size));
+			if (newRegion != nullptr)
+				relocate_range(newRegion, m_array, m_size);
+		}
+		else
+			newRegion = reallocate_array(static_cast<Allocator&>(*this), m_array, m_size, m_capacity, size);
+
+		// if the allocation failed
+		if (newRegion == nullptr)
+			return m_capacity;
+
+		m_array = newRegion;
+		m_capacity = size;
+		return m_capacity;
+	}
+
+	//*************************************
+	// Resize method (initialization)
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	size_t small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::resize(size_t size, const Type& val) noexcept
+	{
+		size_t oldCapacity = m_capacity;
+		resize(size);
+
+		// initialize the new data
+		if constexpr (std::is_trivially_copyable_v<Type>)
+			if (m_capacity > oldCapacity)
+				nids::fill(m_array + oldCapacity, m_array + m_capacity, val);
+
+		return m_capacity;
+	}
+
+	//*************************************
+	// Push back method
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline void small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::push_back(const Type& data) noexcept
+	{
+		// if reallocation is not necessary
+		if (m_size < m_capacity)
+		{
+			new (m_array + m_size++) Type(data);
+			return;
+		}
+
+		resize(next_capacity());
+		new (m_array + m_size++) Type(data);
+	}
+
+	//*************************************
+	// Push back method (rvalue)
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline void small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::push_back(Type&& data) noexcept
+	{
+		// if reallocation is not necessary
+		if (m_size < m_capacity)
+		{
+			new (m_array + m_size++) Type(std::move(data));
+			return;
+		}
+
+		resize(next_capacity());
+		new (m_array + m_size++) Type(std::move(data));
+	}
+
+	//*************************************
+	// Push back method (internal safe)
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline void small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::push_back_i(const Type& data) noexcept
+	{
+		array_push_back_i(m_array, m_size, m_capacity, data, [this] { resize(next_capacity()); });
+	}
+
+	//*************************************
+	// Push back method
+	// (rvalue, internal safe)
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	inline void small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::push_back_i(Type&& data) noexcept
+	{
+		array_push_back_i(m_array, m_size, m_capacity, std::move(data), [this] { resize(next_capacity()); });
+	}
+
+	//*************************************
+	// Erase method
+	//*************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	typename small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::iterator
+		small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::erase(iterator pos) noexcept
+	{
+		size_t index = pos - begin();
+		array_erase(m_array, m_size, index);
+		return begin() + static_cast<ptrdiff_t>(index);
+	}
+
+	//************************************
+	// Append method
+	//************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	template<typename Iterator>
+	void small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::append(Iterator first, Iterator last) noexcept
+	{
+		array_append(m_array, m_size, m_capacity, first, last, [this](size_t needed) { grow_to(needed); });
+	}
+
+	//************************************
+	// Insert method
+	//************************************
+	template<typename Type, size_t InlineCapacity, typename GrowthPolicy, typename Allocator>
+	template<typename Iterator>
+	typename small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::iterator small_vector<Type, InlineCapacity, GrowthPolicy, Allocator>::insert(iterator pos, Iterator first, Iterator last) noexcept
+	{
+		size_t index = pos - begin();
+		array_insert(m_array, m_size, m_capacity, index, first, last, [this](size_t needed) { grow_to(needed); });
+		return begin() + static_cast<ptrdiff_t>(index);
+	}
+}
\ No newline at end of file
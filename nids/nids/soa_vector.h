@@ -0,0 +1,370 @@
+//**************************************
+// soa_vector.h
+//
+// Holds nids::soa_vector, a structure
+// of arrays container for records, and
+// its zip iterator.
+//
+// Every field of the record lives in
+// its own nids::vector column, so a
+// loop over one field only pulls that
+// field into the cache, and columns of
+// arithmetic types can be handed
+// straight to the nids algorithms
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <stddef.h>
+#include <tuple>
+#include <utility>
+#include "span.h"
+#include "vector.h"
+
+namespace nids
+{
+	template<typename Container>
+	class soa_iterator;
+
+	template<typename... Fields>
+	class soa_vector final
+	{
+		static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+	public:
+		using value_type = std::tuple<Fields...>;
+		using reference = std::tuple<Fields&...>;
+		using const_reference = std::tuple<const Fields&...>;
+		using iterator = soa_iterator<soa_vector>;
+		using const_iterator = soa_iterator<const soa_vector>;
+
+		// number of fields (columns) per record
+		static const size_t COLUMNS = sizeof...(Fields);
+
+		// type of the field stored in column Column
+		template<size_t Column>
+		using column_type = std::tuple_element_t<Column, value_type>;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		inline size_t size() const noexcept { return std::get<0>(m_columns).size(); }
+
+		//************************************
+		// Capacity accessor
+		//************************************
+		inline size_t capacity() const noexcept { return std::get<0>(m_columns).capacity(); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		inline bool empty() const noexcept { return size() == 0; }
+
+		//************************************
+		// Const correct subscript operator
+		//
+		// Returns a tuple of references to
+		// the fields of record index
+		//************************************
+		inline const_reference operator[](size_t index) const noexcept
+		{
+			assert(index < size());
+			return record(index, std::index_sequence_for<Fields...>());
+		}
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline reference operator[](size_t index) noexcept
+		{
+			assert(index < size());
+			return record(index, std::index_sequence_for<Fields...>());
+		}
+
+		//************************************
+		// Field getter (const correct)
+		//************************************
+		template<size_t Column>
+		inline const column_type<Column>& get(size_t index) const noexcept { return std::get<Column>(m_columns)[index]; }
+
+		//************************************
+		// Field getter
+		//************************************
+		template<size_t Column>
+		inline column_type<Column>& get(size_t index) noexcept { return std::get<Column>(m_columns)[index]; }
+
+		//************************************
+		// Column getter (const correct)
+		//
+		// Returns a span over one field of
+		// every record
+		//************************************
+		template<size_t Column>
+		inline span<const column_type<Column>> column() const noexcept
+		{
+			return span<const column_type<Column>>(std::get<Column>(m_columns).data(), size());
+		}
+
+		//************************************
+		// Column getter
+		//************************************
+		template<size_t Column>
+		inline span<column_type<Column>> column() noexcept
+		{
+			return span<column_type<Column>>(std::get<Column>(m_columns).data(), size());
+		}
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		inline iterator begin() noexcept { return iterator(this, 0); }
+		inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+		//************************************
+		// End iterator getter
+		//************************************
+		inline iterator end() noexcept { return iterator(this, size()); }
+		inline const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Push back method
+		//
+		// Appends one record, a field at a
+		// time
+		//************************************
+		inline void push_back(const value_type& record) noexcept
+		{
+			push_fields(record, std::index_sequence_for<Fields...>());
+		}
+
+		//************************************
+		// Emplace back method
+		//
+		// Appends one record from its
+		// fields, without building a tuple
+		//************************************
+		inline void emplace_back(const Fields&... fields) noexcept
+		{
+			push_fields(std::forward_as_tuple(fields...), std::index_sequence_for<Fields...>());
+		}
+
+		//************************************
+		// Reserve method
+		//
+		// Grows every column to at least
+		// size, never shrinks them
+		//
+		// Returns the new capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			std::apply([size](auto&... columns) { (columns.reserve(size), ...); }, m_columns);
+			return capacity();
+		}
+
+		//************************************
+		// Resize method
+		//
+		// Resizes every column, see
+		// vector::resize
+		//
+		// Returns new capacity, or old
+		// capacity if unchanged
+		//************************************
+		inline size_t resize(size_t size) noexcept
+		{
+			std::apply([size](auto&... columns) { (columns.resize(size), ...); }, m_columns);
+			return capacity();
+		}
+	private:
+		//************************************
+		// Record builder
+		//************************************
+		template<size_t... Columns>
+		inline reference record(size_t index, std::index_sequence<Columns...>) noexcept
+		{
+			return reference(std::get<Columns>(m_columns)[index]...);
+		}
+
+		template<size_t... Columns>
+		inline const_reference record(size_t index, std::index_sequence<Columns...>) const noexcept
+		{
+			return const_reference(std::get<Columns>(m_columns)[index]...);
+		}
+
+		//************************************
+		// Field appending helper
+		//************************************
+		template<typename Tuple, size_t... Columns>
+		inline void push_fields(const Tuple& record, std::index_sequence<Columns...>) noexcept
+		{
+			(std::get<Columns>(m_columns).push_back(std::get<Columns>(record)), ...);
+		}
+
+		std::tuple<vector<Fields>...> m_columns;
+	};
+
+	//**************************************
+	// Zip iterator
+	//
+	// Walks the records of a soa_vector,
+	// dereferencing to a tuple of
+	// references to the fields. That
+	// tuple is a value, not a reference
+	// to a record, so it is tagged as an
+	// input iterator though it moves
+	// like a random access one
+	//
+	// Container is the soa_vector, or a
+	// const one for read only iteration
+	//**************************************
+	template<typename Container>
+	class soa_iterator final
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = typename Container::value_type;
+		using difference_type = ptrdiff_t;
+		using reference = decltype(std::declval<Container&>()[0]);
+		using pointer = void;
+
+		//******************************
+		// Constructor
+		//******************************
+		inline soa_iterator(Container* soa, size_t index) noexcept : m_soa(soa), m_index(index)
+		{
+			assert(m_soa != nullptr);
+		}
+
+		//*******[ Movement Operations ]
+		//******************************
+		// Increment operator (prefix)
+		//******************************
+		inline soa_iterator& operator++() noexcept
+		{
+			assert(m_index < m_soa->size());
+			++m_index;
+			return *this;
+		}
+
+		//******************************
+		// Increment operator (postfix)
+		//******************************
+		inline soa_iterator operator++(int) noexcept
+		{
+			soa_iterator _r = *this;
+			++*this;
+			return _r;
+		}
+
+		//******************************
+		// Decrement operator (prefix)
+		//******************************
+		inline soa_iterator& operator--() noexcept
+		{
+			assert(m_index > 0);
+			--m_index;
+			return *this;
+		}
+
+		//******************************
+		// Decrement operator (postfix)
+		//******************************
+		inline soa_iterator operator--(int) noexcept
+		{
+			soa_iterator _r = *this;
+			--*this;
+			return _r;
+		}
+
+		//******************************
+		// Next index method
+		//******************************
+		inline soa_iterator next() const noexcept
+		{
+			soa_iterator v{ *this };
+			return ++v;
+		}
+
+		//******************************
+		// Previous index method
+		//******************************
+		inline soa_iterator previous() const noexcept
+		{
+			soa_iterator v{ *this };
+			return --v;
+		}
+
+		//******************************
+		// Addition operator
+		//******************************
+		inline soa_iterator operator+(difference_type amount) const noexcept { return soa_iterator(m_soa, m_index + amount); }
+
+		//******************************
+		// In-place addition operator
+		//******************************
+		inline soa_iterator& operator+=(difference_type amount) noexcept
+		{
+			m_index += amount;
+			return *this;
+		}
+
+		//******************************
+		// Subtraction operator
+		//******************************
+		inline soa_iterator operator-(difference_type amount) const noexcept { return soa_iterator(m_soa, m_index - amount); }
+
+		//******************************
+		// Subtraction operator (iter)
+		//******************************
+		inline difference_type operator-(const soa_iterator& rhs) const noexcept
+		{
+			return static_cast<difference_type>(m_index) - static_cast<difference_type>(rhs.m_index);
+		}
+
+		//******************************
+		// In-place subtraction operator
+		//******************************
+		inline soa_iterator& operator-=(difference_type amount) noexcept
+		{
+			m_index -= amount;
+			return *this;
+		}
+
+		//*****[ Comparison Operations ]
+		inline bool operator==(const soa_iterator& rhs) const noexcept { return m_index == rhs.m_index; }
+		inline bool operator!=(const soa_iterator& rhs) const noexcept { return m_index != rhs.m_index; }
+		inline bool operator<(const soa_iterator& rhs) const noexcept { return m_index < rhs.m_index; }
+		inline bool operator>(const soa_iterator& rhs) const noexcept { return m_index > rhs.m_index; }
+		inline bool operator<=(const soa_iterator& rhs) const noexcept { return m_index <= rhs.m_index; }
+		inline bool operator>=(const soa_iterator& rhs) const noexcept { return m_index >= rhs.m_index; }
+
+		//*******[ Accessor Operations ]
+		//******************************
+		// Dereference operator
+		//
+		// Returns the fields by
+		// reference, so structured
+		// bindings write through
+		//******************************
+		inline reference operator*() const noexcept { return (*m_soa)[m_index]; }
+
+		//******************************
+		// Offset subscript operator
+		//******************************
+		inline reference operator[](difference_type offset) const noexcept { return (*m_soa)[m_index + offset]; }
+
+		//******************************
+		// Record index getter
+		//******************************
+		inline size_t index() const noexcept { return m_index; }
+	private:
+		Container* m_soa;
+		size_t m_index;
+	};
+}
@@ -0,0 +1,514 @@
+//**************************************
+// sort.h
+//
+// Holds nids::sort, which picks the
+// fastest way to sort a range.
+//
+// Contiguous ranges of integers, floats
+// and doubles sorted in ascending order
+// go through an LSD radix sort, which
+// makes a few linear passes instead of
+// n log n comparisons. Everything else
+// (other types, custom comparisons,
+// short ranges) uses a pattern
+// defeating quicksort
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "relocation.h"
+#include "vector.h"
+
+namespace nids
+{
+	// ranges shorter than this are quicker to pdqsort than to radix sort
+	const size_t RADIX_SORT_THRESHOLD = 1024;
+
+	// pdqsort tuning, from the reference implementation
+	const ptrdiff_t PDQ_INSERTION_SORT_THRESHOLD = 24;
+	const ptrdiff_t PDQ_NINTHER_THRESHOLD = 128;
+	const ptrdiff_t PDQ_PARTIAL_INSERTION_LIMIT = 8;
+
+	//**************************************
+	// Radix sortable trait
+	//
+	// Types whose ascending order can be
+	// read straight off their bits
+	//**************************************
+	template<typename Type>
+	inline constexpr bool is_radix_sortable_v = (std::is_integral_v<Type> && !std::is_same_v<Type, bool>)
+		|| std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+	// unsigned integer as wide as Type
+	template<typename Type>
+	using radix_key_t = std::conditional_t<sizeof(Type) == 1, uint8_t,
+		std::conditional_t<sizeof(Type) == 2, uint16_t,
+		std::conditional_t<sizeof(Type) == 4, uint32_t, uint64_t>>>;
+
+	//**************************************
+	// Radix key method
+	//
+	// Maps value to an unsigned key that
+	// sorts in the same order: signed
+	// integers get their sign bit flipped,
+	// negative floats get every bit
+	// flipped and positive ones just the
+	// sign bit
+	//**************************************
+	template<typename Type>
+	inline radix_key_t<Type> radix_key(Type value) noexcept
+	{
+		using Key = radix_key_t<Type>;
+		const Key sign = static_cast<Key>(Key(1) << (sizeof(Type) * 8 - 1));
+
+		Key bits;
+		memcpy(&bits, &value, sizeof(Type));
+		if constexpr (std::is_floating_point_v<Type>)
+			return static_cast<Key>((bits & sign) ? ~bits : bits | sign);
+		else if constexpr (std::is_signed_v<Type>)
+			return static_cast<Key>(bits ^ sign);
+		else
+			return bits;
+	}
+
+	//**************************************
+	// Radix sort method
+	//
+	// Sorts count values at data in
+	// ascending order, a digit per pass,
+	// using scratch (count values long) as
+	// the other half of the ping pong.
+	// Every digit is counted in one read
+	// up front, and passes where every key
+	// has the same digit are skipped
+	//**************************************
+	template<typename Type>
+	void radix_sort(Type* data, size_t count, Type* scratch) noexcept
+	{
+		static_assert(is_radix_sortable_v<Type>, "radix_sort needs integer or floating point values");
+		// 64 bit keys take 6 passes of 11 bits rather than 8 of 8
+		const size_t DIGIT_BITS = sizeof(Type) == 8 ? 11 : 8;
+		const size_t PASSES = (sizeof(Type) * 8 + DIGIT_BITS - 1) / DIGIT_BITS;
+		const size_t BUCKETS = size_t(1) << DIGIT_BITS;
+		const size_t MASK = BUCKETS - 1;
+
+		size_t histogram[PASSES][BUCKETS] = {};
+		for (size_t index{ 0 }; index < count; ++index)
+		{
+			radix_key_t<Type> key = radix_key(data[index]);
+			for (size_t pass{ 0 }; pass < PASSES; ++pass)
+				++histogram[pass][(key >> (pass * DIGIT_BITS)) & MASK];
+		}
+
+		Type* from = data;
+		Type* to = scratch;
+		for (size_t pass{ 0 }; pass < PASSES; ++pass)
+		{
+			size_t* offsets = histogram[pass];
+			size_t shift = pass * DIGIT_BITS;
+			if (offsets[(radix_key(data[0]) >> shift) & MASK] == count)
+				continue;
+
+			size_t total{ 0 };
+			for (size_t bucket{ 0 }; bucket < BUCKETS; ++bucket)
+			{
+				size_t bucketCount = offsets[bucket];
+				offsets[bucket] = total;
+				total += bucketCount;
+			}
+
+			for (size_t index{ 0 }; index < count; ++index)
+				to[offsets[(radix_key(from[index]) >> shift) & MASK]++] = from[index];
+			std::swap(from, to);
+		}
+
+		if (from != data)
+			memcpy(static_cast<void*>(data), static_cast<const void*>(from), count * sizeof(Type));
+	}
+
+	//**************************************
+	// Pattern defeating quicksort
+	//
+	// After Orson Peters' pdqsort:
+	// introsort with median of three (or
+	// ninther) pivots, insertion sort for
+	// short runs, a check for ranges that
+	// are already partitioned, shuffling
+	// after bad pivots, and heapsort once
+	// too many pivots have been bad
+	//**************************************
+
+	//**************************************
+	// Insertion sort method
+	//
+	// Unguarded skips the bounds check,
+	// relying on an element before first
+	// that is no greater than any in the
+	// range
+	//**************************************
+	template<bool Unguarded, typename Iterator, typename Compare>
+	inline void pdq_insertion_sort(Iterator first, Iterator last, Compare& compare) noexcept
+	{
+		using Type = typename std::iterator_traits<Iterator>::value_type;
+		if (first == last)
+			return;
+
+		for (Iterator current = first + 1; current != last; ++current)
+		{
+			Iterator sift = current;
+			Iterator before = current - 1;
+			if (!compare(*sift, *before))
+				continue;
+
+			Type moving = std::move(*sift);
+			do
+			{
+				*sift = std::move(*before);
+				--sift;
+			} while ((Unguarded || sift != first) && compare(moving, *--before));
+			*sift = std::move(moving);
+		}
+	}
+
+	//**************************************
+	// Partial insertion sort method
+	//
+	// Insertion sorts the range unless
+	// that takes more than a few moves
+	//
+	// Returns false if it gave up
+	//**************************************
+	template<typename Iterator, typename Compare>
+	inline bool pdq_partial_insertion_sort(Iterator first, Iterator last, Compare& compare) noexcept
+	{
+		using Type = typename std::iterator_traits<Iterator>::value_type;
+		if (first == last)
+			return true;
+
+		ptrdiff_t moves{ 0 };
+		for (Iterator current = first + 1; current != last; ++current)
+		{
+			Iterator sift = current;
+			Iterator before = current - 1;
+			if (!compare(*sift, *before))
+				continue;
+
+			Type moving = std::move(*sift);
+			do
+			{
+				*sift = std::move(*before);
+				--sift;
+			} while (sift != first && compare(moving, *--before));
+			*sift = std::move(moving);
+
+			moves += current - sift;
+			if (moves > PDQ_PARTIAL_INSERTION_LIMIT)
+				return false;
+		}
+		return true;
+	}
+
+	//**************************************
+	// Sort three method
+	//**************************************
+	template<typename Iterator, typename Compare>
+	inline void pdq_sort3(Iterator a, Iterator b, Iterator c, Compare& compare) noexcept
+	{
+		if (compare(*b, *a)) std::iter_swap(a, b);
+		if (compare(*c, *b)) std::iter_swap(b, c);
+		if (compare(*b, *a)) std::iter_swap(a, b);
+	}
+
+	//**************************************
+	// Right partition method
+	//
+	// Partitions around *first, putting
+	// elements equal to the pivot on the
+	// right
+	//
+	// Returns the pivot's new position,
+	// and whether nothing had to move
+	//**************************************
+	template<typename Iterator, typename Compare>
+	inline std::pair<Iterator, bool> pdq_partition_right(Iterator first, Iterator last, Compare& compare) noexcept
+	{
+		using Type = typename std::iterator_traits<Iterator>::value_type;
+		Type pivot = std::move(*first);
+		Iterator left = first;
+		Iterator right = last;
+
+		// the median of three guards both scans on the first pass
+		while (compare(*++left, pivot));
+		if (left - 1 == first)
+			while (left < right && !compare(*--right, pivot));
+		else
+			while (!compare(*--right, pivot));
+
+		bool partitioned = left >= right;
+		while (left < right)
+		{
+			std::iter_swap(left, right);
+			while (compare(*++left, pivot));
+			while (!compare(*--right, pivot));
+		}
+
+		Iterator pivotPosition = left - 1;
+		*first = std::move(*pivotPosition);
+		*pivotPosition = std::move(pivot);
+		return std::make_pair(pivotPosition, partitioned);
+	}
+
+	//**************************************
+	// Left partition method
+	//
+	// Partitions around *first, putting
+	// elements equal to the pivot on the
+	// left. Used when the pivot equals
+	// the element before the range, so
+	// every equal element is dealt with
+	// in one go
+	//
+	// Returns the pivot's new position
+	//**************************************
+	template<typename Iterator, typename Compare>
+	inline Iterator pdq_partition_left(Iterator first, Iterator last, Compare& compare) noexcept
+	{
+		using Type = typename std::iterator_traits<Iterator>::value_type;
+		Type pivot = std::move(*first);
+		Iterator left = first;
+		Iterator right = last;
+
+		while (compare(pivot, *--right));
+		if (right + 1 == last)
+			while (left < right && !compare(pivot, *++left));
+		else
+			while (!compare(pivot, *++left));
+
+		while (left < right)
+		{
+			std::iter_swap(left, right);
+			while (compare(pivot, *--right));
+			while (!compare(pivot, *++left));
+		}
+
+		*first = std::move(*right);
+		*right = std::move(pivot);
+		return right;
+	}
+
+	//**************************************
+	// pdqsort loop
+	//
+	// Recurses into the left side of each
+	// partition and loops on the right
+	//**************************************
+	template<typename Iterator, typename Compare>
+	void pdq_sort_loop(Iterator first, Iterator last, Compare& compare, int badAllowed, bool leftmost) noexcept
+	{
+		for (;;)
+		{
+			ptrdiff_t size = last - first;
+			if (size < PDQ_INSERTION_SORT_THRESHOLD)
+			{
+				if (leftmost)
+					pdq_insertion_sort<false>(first, last, compare);
+				else
+					pdq_insertion_sort<true>(first, last, compare);
+				return;
+			}
+
+			// pivot goes to first
+			ptrdiff_t half = size / 2;
+			if (size > PDQ_NINTHER_THRESHOLD)
+			{
+				pdq_sort3(first, first + half, last - 1, compare);
+				pdq_sort3(first + 1, first + (half - 1), last - 2, compare);
+				pdq_sort3(first + 2, first + (half + 1), last - 3, compare);
+				pdq_sort3(first + (half - 1), first + half, first + (half + 1), compare);
+				std::iter_swap(first, first + half);
+			}
+			else
+				pdq_sort3(first + half, first, last - 1, compare);
+
+			// a pivot equal to its left neighbour means a run of equal elements
+			if (!leftmost && !compare(*(first - 1), *first))
+			{
+				first = pdq_partition_left(first, last, compare) + 1;
+				continue;
+			}
+
+			std::pair<Iterator, bool> partition = pdq_partition_right(first, last, compare);
+			Iterator pivot = partition.first;
+			ptrdiff_t leftSize = pivot - first;
+			ptrdiff_t rightSize = last - (pivot + 1);
+
+			if (leftSize < size / 8 || rightSize < size / 8)
+			{
+				// bad pivot: give up on quicksort, or shuffle to break the pattern
+				if (--badAllowed == 0)
+				{
+					std::make_heap(first, last, compare);
+					std::sort_heap(first, last, compare);
+					return;
+				}
+
+				if (leftSize >= PDQ_INSERTION_SORT_THRESHOLD)
+				{
+					std::iter_swap(first, first + leftSize / 4);
+					std::iter_swap(pivot - 1, pivot - leftSize / 4);
+					if (leftSize > PDQ_NINTHER_THRESHOLD)
+					{
+						std::iter_swap(first + 1, first + (leftSize / 4 + 1));
+						std::iter_swap(first + 2, first + (leftSize / 4 + 2));
+						std::iter_swap(pivot - 2, pivot - (leftSize / 4 + 1));
+						std::iter_swap(pivot - 3, pivot - (leftSize / 4 + 2));
+					}
+				}
+
+				if (rightSize >= PDQ_INSERTION_SORT_THRESHOLD)
+				{
+					std::iter_swap(pivot + 1, pivot + (1 + rightSize / 4));
+					std::iter_swap(last - 1, last - rightSize / 4);
+					if (rightSize > PDQ_NINTHER_THRESHOLD)
+					{
+						std::iter_swap(pivot + 2, pivot + (2 + rightSize / 4));
+						std::iter_swap(pivot + 3, pivot + (3 + rightSize / 4));
+						std::iter_swap(last - 2, last - (1 + rightSize / 4));
+						std::iter_swap(last - 3, last - (2 + rightSize / 4));
+					}
+				}
+			}
+			else if (partition.second && pdq_partial_insertion_sort(first, pivot, compare) && pdq_partial_insertion_sort(pivot + 1, last, compare))
+				return;
+
+			pdq_sort_loop(first, pivot, compare, badAllowed, leftmost);
+			first = pivot + 1;
+			leftmost = false;
+		}
+	}
+
+	//**************************************
+	// pdqsort method
+	//
+	// Sorts [first, last) by compare, not
+	// stably, in O(n log n) worst case
+	//**************************************
+	template<typename Iterator, typename Compare>
+	inline void pdqsort(Iterator first, Iterator last, Compare compare) noexcept
+	{
+		ptrdiff_t size = last - first;
+		if (size < 2)
+			return;
+
+		int badAllowed{ 0 };
+		while (size >>= 1)
+			++badAllowed;
+		pdq_sort_loop(first, last, compare, badAllowed, true);
+	}
+
+	//**************************************
+	// Default order trait
+	//
+	// Comparisons that sort ascending, the
+	// order radix_sort produces
+	//**************************************
+	template<typename Compare, typename Type>
+	inline constexpr bool is_ascending_compare_v = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Type>>;
+
+	//**************************************
+	// Sort method (scratch)
+	//
+	// Sorts [first, last) ascending, using
+	// scratch as the radix sort buffer so
+	// repeated sorts don't reallocate it
+	//**************************************
+	template<typename Iterator, typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	void sort(Iterator first, Iterator last, vector<Type, GrowthPolicy, Allocator, Stats>& scratch) noexcept
+	{
+		static_assert(is_contiguous_iterator_v<Iterator>, "radix sorting needs a contiguous range");
+		static_assert(std::is_same_v<typename std::iterator_traits<Iterator>::value_type, Type>, "scratch must hold the range's type");
+		size_t count = range_length(first, last);
+		if (count < 2)
+			return;
+
+		Type* data = &*first;
+		if (count < RADIX_SORT_THRESHOLD)
+		{
+			nids::pdqsort(data, data + count, std::less<>());
+			return;
+		}
+
+		if (scratch.size() < count)
+			scratch.resize_uninitialized(count);
+		radix_sort(data, count, scratch.data());
+	}
+
+	//**************************************
+	// Sort method (compare)
+	//
+	// Sorts [first, last) by compare, not
+	// stably. Contiguous ranges of radix
+	// sortable values in ascending order
+	// are radix sorted, everything else is
+	// pdqsorted
+	//**************************************
+	template<typename Iterator, typename Compare>
+	void sort(Iterator first, Iterator last, Compare compare) noexcept
+	{
+		using Type = typename std::iterator_traits<Iterator>::value_type;
+		if constexpr (is_contiguous_iterator_v<Iterator>)
+		{
+			size_t count = range_length(first, last);
+			if (count < 2)
+				return;
+
+			Type* data = &*first;
+			if constexpr (is_radix_sortable_v<Type> && is_ascending_compare_v<Compare, Type>)
+			{
+				if (count >= RADIX_SORT_THRESHOLD)
+				{
+					vector<Type> scratch;
+					nids::sort(data, data + count, scratch);
+					return;
+				}
+			}
+			nids::pdqsort(data, data + count, compare);
+		}
+		else
+			nids::pdqsort(first, last, compare);
+	}
+
+	//**************************************
+	// Sort method
+	//
+	// Sorts [first, last) ascending
+	//**************************************
+	template<typename Iterator>
+	inline void sort(Iterator first, Iterator last) noexcept
+	{
+		nids::sort(first, last, std::less<>());
+	}
+
+	//**************************************
+	// Sort method (container)
+	//
+	// Sorts a container's elements
+	// ascending, also takes temporary
+	// views like span
+	//**************************************
+	template<typename Container>
+	inline void sort(Container&& container) noexcept
+	{
+		nids::sort(container.data(), container.data() + container.size(), std::less<>());
+	}
+}
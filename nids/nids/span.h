@@ -0,0 +1,444 @@
+//**************************************
+// span.h
+//
+// Holds nids::span, a non-owning view
+// of a contiguous run of elements, and
+// nids::strided_span, one of elements
+// a fixed number of bytes apart (e.g.
+// one field of an array of structs).
+//
+// Both are just a pointer and a size
+// (and a stride), so they are cheap to
+// copy, slice, and hand to another
+// thread by value. They never own or
+// free what they point at
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <iterator>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+namespace nids
+{
+	template<typename Type>
+	class span final
+	{
+	public:
+		using value_type = std::remove_cv_t<Type>;
+		using element_type = Type;
+		using iterator = Type*;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		constexpr span() noexcept : m_data(nullptr), m_size(0) {}
+
+		//************************************
+		// Pointer constructor
+		//************************************
+		constexpr span(Type* data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+		//************************************
+		// Range constructor
+		//
+		// Only takes pointers, so a literal 0
+		// size picks the pointer constructor
+		// instead of being ambiguous
+		//************************************
+		template<typename Pointer, typename = std::enable_if_t<std::is_pointer_v<Pointer> && std::is_convertible_v<Pointer, Type*>>>
+		constexpr span(Type* first, Pointer last) noexcept : m_data(first), m_size(static_cast<size_t>(static_cast<Type*>(last) - first)) {}
+
+		//************************************
+		// Const conversion constructor
+		//
+		// Lets a span<T> be passed where a
+		// span<const T> is expected
+		//************************************
+		template<typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Type>>>
+		constexpr span(const span<Other>& rhs) noexcept : m_data(rhs.data()), m_size(rhs.size()) {}
+
+		//************************************
+		// Container constructor
+		//
+		// Views every element of anything
+		// with data() and size(), like the
+		// nids vectors, so they can be passed
+		// where a span is expected. Only
+		// takes lvalues, a span of a
+		// temporary would dangle. The
+		// elements must be Type, give or
+		// take const, so a span of a base
+		// class can't step over derived ones
+		//************************************
+		template<typename Container, typename = std::enable_if_t<!std::is_same_v<std::remove_cv_t<Container>, span>
+			&& std::is_convertible_v<std::remove_pointer_t<decltype(std::declval<Container&>().data())>(*)[], Type(*)[]>>>
+		constexpr span(Container& container) noexcept : m_data(container.data()), m_size(container.size()) {}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		constexpr size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Size in bytes accessor
+		//************************************
+		constexpr size_t size_bytes() const noexcept { return m_size * sizeof(Type); }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		constexpr bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Array getter
+		//************************************
+		constexpr Type* data() const noexcept { return m_data; }
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline Type& operator[](size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+		//************************************
+		// Front item getter
+		//************************************
+		inline Type& front() const noexcept
+		{
+			assert(m_size > 0);
+			return m_data[0];
+		}
+
+		//************************************
+		// Back item getter
+		//************************************
+		inline Type& back() const noexcept
+		{
+			assert(m_size > 0);
+			return m_data[m_size - 1];
+		}
+
+		//************************************
+		// Begin iterator getter
+		//************************************
+		constexpr iterator begin() const noexcept { return m_data; }
+
+		//************************************
+		// End iterator getter
+		//************************************
+		constexpr iterator end() const noexcept { return m_data + m_size; }
+
+		//************************************
+		// Sub span getter
+		//
+		// Returns count elements starting at
+		// offset
+		//************************************
+		inline span subspan(size_t offset, size_t count) const noexcept
+		{
+			assert(offset <= m_size && count <= m_size - offset);
+			return span(m_data + offset, count);
+		}
+
+		//************************************
+		// Sub span getter (to end)
+		//************************************
+		inline span subspan(size_t offset) const noexcept
+		{
+			assert(offset <= m_size);
+			return span(m_data + offset, m_size - offset);
+		}
+
+		//************************************
+		// First elements getter
+		//************************************
+		inline span first(size_t count) const noexcept { return subspan(0, count); }
+
+		//************************************
+		// Last elements getter
+		//************************************
+		inline span last(size_t count) const noexcept
+		{
+			assert(count <= m_size);
+			return span(m_data + m_size - count, count);
+		}
+
+		//************************************
+		// Part getter
+		//
+		// Splits the span into parts pieces
+		// whose sizes differ by at most one
+		// and returns piece index, so workers
+		// can each take theirs without
+		// agreeing on bounds first
+		//************************************
+		inline span part(size_t index, size_t parts) const noexcept
+		{
+			assert(parts > 0 && index < parts);
+			size_t base = m_size / parts;
+			size_t extra = m_size % parts;
+			size_t start = index * base + (index < extra ? index : extra);
+			return span(m_data + start, base + (index < extra ? 1 : 0));
+		}
+	private:
+		Type* m_data;
+		size_t m_size;
+	};
+
+	//**************************************
+	// Strided iterator
+	//
+	// Random access iterator that steps a
+	// fixed number of bytes
+	//**************************************
+	template<typename Type>
+	class strided_iterator final
+	{
+		using byte_type = std::conditional_t<std::is_const_v<Type>, const unsigned char, unsigned char>;
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::remove_cv_t<Type>;
+		using difference_type = ptrdiff_t;
+		using pointer = Type*;
+		using reference = Type&;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructors
+		//************************************
+		constexpr strided_iterator() noexcept : m_element(nullptr), m_stride(0) {}
+		constexpr strided_iterator(Type* element, ptrdiff_t stride) noexcept : m_element(element), m_stride(stride) {}
+
+		//************************************
+		// Step operators
+		//************************************
+		inline strided_iterator& operator++() noexcept { m_element = step(1); return *this; }
+		inline strided_iterator operator++(int) noexcept { strided_iterator old = *this; ++*this; return old; }
+		inline strided_iterator& operator--() noexcept { m_element = step(-1); return *this; }
+		inline strided_iterator operator--(int) noexcept { strided_iterator old = *this; --*this; return old; }
+		inline strided_iterator& operator+=(difference_type amount) noexcept { m_element = step(amount); return *this; }
+		inline strided_iterator& operator-=(difference_type amount) noexcept { m_element = step(-amount); return *this; }
+		inline strided_iterator operator+(difference_type amount) const noexcept { return strided_iterator(step(amount), m_stride); }
+		inline strided_iterator operator-(difference_type amount) const noexcept { return strided_iterator(step(-amount), m_stride); }
+
+		//************************************
+		// Distance operator
+		//************************************
+		inline difference_type operator-(const strided_iterator& rhs) const noexcept
+		{
+			assert(m_stride == rhs.m_stride && m_stride != 0);
+			return (reinterpret_cast<byte_type*>(m_element) - reinterpret_cast<byte_type*>(rhs.m_element)) / m_stride;
+		}
+
+		//************************************
+		// Comparison operators
+		//************************************
+		inline bool operator==(const strided_iterator& rhs) const noexcept { return m_element == rhs.m_element; }
+		inline bool operator!=(const strided_iterator& rhs) const noexcept { return m_element != rhs.m_element; }
+		inline bool operator<(const strided_iterator& rhs) const noexcept { return *this - rhs < 0; }
+		inline bool operator>(const strided_iterator& rhs) const noexcept { return *this - rhs > 0; }
+		inline bool operator<=(const strided_iterator& rhs) const noexcept { return *this - rhs <= 0; }
+		inline bool operator>=(const strided_iterator& rhs) const noexcept { return *this - rhs >= 0; }
+
+		//************************************
+		// Access operators
+		//************************************
+		inline reference operator*() const noexcept { return *m_element; }
+		inline pointer operator->() const noexcept { return m_element; }
+		inline reference operator[](difference_type offset) const noexcept { return *step(offset); }
+	private:
+		inline Type* step(difference_type amount) const noexcept
+		{
+			return reinterpret_cast<Type*>(reinterpret_cast<byte_type*>(m_element) + amount * m_stride);
+		}
+
+		Type* m_element;
+		ptrdiff_t m_stride;
+	};
+
+	//**************************************
+	// Strided span
+	//
+	// Non-owning view of size elements,
+	// stride bytes apart. The stride is in
+	// bytes so one field of a span of
+	// structs can be viewed in place (see
+	// member_span), and may be negative
+	// to walk backwards
+	//**************************************
+	template<typename Type>
+	class strided_span final
+	{
+		using byte_type = std::conditional_t<std::is_const_v<Type>, const unsigned char, unsigned char>;
+	public:
+		using value_type = std::remove_cv_t<Type>;
+		using element_type = Type;
+		using iterator = strided_iterator<Type>;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Default constructor
+		//************************************
+		constexpr strided_span() noexcept : m_first(nullptr), m_size(0), m_stride(sizeof(Type)) {}
+
+		//************************************
+		// Pointer constructor
+		//
+		// first is the first element, each
+		// next one is stride bytes on
+		//************************************
+		constexpr strided_span(Type* first, size_t size, ptrdiff_t stride) noexcept : m_first(first), m_size(size), m_stride(stride) {}
+
+		//************************************
+		// Span constructor
+		//
+		// Views a contiguous span, a stride
+		// of one element
+		//************************************
+		template<typename Other, typename = std::enable_if_t<std::is_same_v<Other, Type> || std::is_same_v<const Other, Type>>>
+		constexpr strided_span(span<Other> elements) noexcept
+			: m_first(elements.data()), m_size(elements.size()), m_stride(sizeof(Type)) {}
+
+		//************************************
+		// Const conversion constructor
+		//************************************
+		template<typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Type>>>
+		constexpr strided_span(const strided_span<Other>& rhs) noexcept
+			: m_first(rhs.begin().operator->()), m_size(rhs.size()), m_stride(rhs.stride()) {}
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//************************************
+		constexpr size_t size() const noexcept { return m_size; }
+
+		//************************************
+		// Empty status getter
+		//************************************
+		constexpr bool empty() const noexcept { return m_size == 0; }
+
+		//************************************
+		// Stride accessor
+		//
+		// Bytes from one element to the next
+		//************************************
+		constexpr ptrdiff_t stride() const noexcept { return m_stride; }
+
+		//************************************
+		// Contiguous status getter
+		//
+		// True when the elements are packed,
+		// so as_span can be used
+		//************************************
+		constexpr bool is_contiguous() const noexcept { return m_stride == static_cast<ptrdiff_t>(sizeof(Type)); }
+
+		//************************************
+		// Contiguous span getter
+		//************************************
+		inline span<Type> as_span() const noexcept
+		{
+			assert(is_contiguous());
+			return span<Type>(m_first, m_size);
+		}
+
+		//************************************
+		// Subscript operator
+		//************************************
+		inline Type& operator[](size_t index) const noexcept
+		{
+			assert(index < m_size);
+			return *element(index);
+		}
+
+		//************************************
+		// Front item getter
+		//************************************
+		inline Type& front() const noexcept
+		{
+			assert(m_size > 0);
+			return *m_first;
+		}
+
+		//************************************
+		// Back item getter
+		//************************************
+		inline Type& back() const noexcept
+		{
+			assert(m_size > 0);
+			return *element(m_size - 1);
+		}
+
+		//************************************
+		// Iterator getters
+		//************************************
+		constexpr iterator begin() const noexcept { return iterator(m_first, m_stride); }
+		inline iterator end() const noexcept { return iterator(element(m_size), m_stride); }
+
+		//************************************
+		// Sub span getter
+		//************************************
+		inline strided_span subspan(size_t offset, size_t count) const noexcept
+		{
+			assert(offset <= m_size && count <= m_size - offset);
+			return strided_span(element(offset), count, m_stride);
+		}
+
+		//************************************
+		// Every nth element getter
+		//
+		// Returns elements 0, step, 2 step...
+		//************************************
+		inline strided_span every(size_t step) const noexcept
+		{
+			assert(step > 0);
+			return strided_span(m_first, (m_size + step - 1) / step, m_stride * static_cast<ptrdiff_t>(step));
+		}
+
+		//************************************
+		// Reversed getter
+		//************************************
+		inline strided_span reversed() const noexcept
+		{
+			return m_size > 0 ? strided_span(element(m_size - 1), m_size, -m_stride) : *this;
+		}
+	private:
+		inline Type* element(size_t index) const noexcept
+		{
+			return reinterpret_cast<Type*>(reinterpret_cast<byte_type*>(m_first) + static_cast<ptrdiff_t>(index) * m_stride);
+		}
+
+		Type* m_first;
+		size_t m_size;
+		ptrdiff_t m_stride;
+	};
+
+	//**************************************
+	// Member span method
+	//
+	// Views one field of every struct in
+	// elements (a span or anything with
+	// data() and size()), e.g.
+	// member_span(points, &Point::x)
+	//**************************************
+	template<typename Container, typename Member, typename Owner>
+	inline auto member_span(Container&& elements, Member Owner::* member) noexcept
+	{
+		using owner_type = std::remove_pointer_t<decltype(elements.data())>;
+		using field_type = std::conditional_t<std::is_const_v<owner_type>, const Member, Member>;
+		static_assert(std::is_same_v<std::remove_cv_t<owner_type>, Owner>, "member must belong to the element type");
+
+		owner_type* first = elements.data();
+		return strided_span<field_type>(elements.size() > 0 ? &(first->*member) : nullptr, elements.size(), static_cast<ptrdiff_t>(sizeof(Owner)));
+	}
+}
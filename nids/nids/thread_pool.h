@@ -0,0 +1,355 @@
+//**************************************
+// thread_pool.h
+//
+// Holds nids::thread_pool, the small
+// work stealing pool the parallel
+// algorithms run on.
+//
+// Every worker owns a deque of tasks.
+// It takes its own work from the back,
+// where the newest (and still cached)
+// tasks are, and steals from the front
+// of the other deques when it runs dry.
+// The thread that calls run() works too
+// rather than sleeping, so run() can be
+// called from inside a task
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <type_traits>
+#include "aligned_allocator.h"
+
+namespace nids
+{
+	class thread_pool final
+	{
+	public:
+		// tasks each worker's deque holds before run() does the rest inline
+		static const size_t QUEUE_CAPACITY = 256;
+
+		//*****************[ Manager Methods ]
+		//************************************
+		// Constructor
+		//
+		// threads counts the thread that
+		// calls run(), so a pool of 1 runs
+		// everything inline. 0 means one per
+		// hardware thread
+		//************************************
+		explicit thread_pool(size_t threads = 0) noexcept;
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		//************************************
+		// Destructor
+		//
+		// Waits for the workers to finish
+		// what is queued and exit
+		//************************************
+		~thread_pool() noexcept;
+
+		//****************[ Accessor Methods ]
+		//************************************
+		// Size accessor
+		//
+		// Returns the number of threads that
+		// run tasks, including the caller
+		//************************************
+		inline size_t size() const noexcept { return m_workerCount + 1; }
+
+		//*****************[ Mutator Methods ]
+		//************************************
+		// Run method
+		//
+		// Calls function(index) for every
+		// index in [0, count) across the
+		// pool and returns once all of the
+		// calls have finished
+		//************************************
+		template<typename Function>
+		void run(size_t count, Function&& function) noexcept;
+	private:
+		struct task
+		{
+			void (*function)(void*, size_t);
+			void* context;
+			size_t index;
+		};
+
+		// one per worker, on its own cache lines so deques don't false share
+		struct alignas(CACHE_LINE_SIZE) worker
+		{
+			std::mutex mutex;
+			task tasks[QUEUE_CAPACITY];
+			size_t head = 0;
+			size_t tail = 0;
+			std::thread thread;
+		};
+
+		// which pool and worker the current thread belongs to, if any
+		struct identity
+		{
+			const thread_pool* pool;
+			size_t index;
+		};
+
+		//************************************
+		// Current thread identity getter
+		//************************************
+		static inline identity& current() noexcept
+		{
+			static thread_local identity self{ nullptr, 0 };
+			return self;
+		}
+
+		//************************************
+		// Push method
+		//
+		// Adds a task to the back of a
+		// worker's deque
+		//
+		// Returns false if it was full
+		//************************************
+		bool push(size_t worker, const task& work) noexcept;
+
+		//************************************
+		// Pop method
+		//
+		// Takes the newest task from the
+		// back of a worker's deque
+		//************************************
+		bool pop(size_t worker, task& work) noexcept;
+
+		//************************************
+		// Steal method
+		//
+		// Takes the oldest task from the
+		// front of a worker's deque
+		//************************************
+		bool steal(size_t worker, task& work) noexcept;
+
+		//************************************
+		// Run one method
+		//
+		// Runs a task from the calling
+		// thread's own deque, or failing
+		// that one stolen from another
+		//
+		// Returns false if there was none
+		//************************************
+		bool run_one() noexcept;
+
+		//************************************
+		// Wake method
+		//
+		// Wakes the sleeping workers after
+		// tasks were queued
+		//************************************
+		void wake() noexcept;
+
+		//************************************
+		// Worker thread body
+		//************************************
+		void work(size_t index) noexcept;
+
+		std::unique_ptr<worker[]> m_workers;
+		size_t m_workerCount;
+		std::atomic<size_t> m_nextWorker;
+		std::atomic<size_t> m_queued;
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeup;
+		bool m_stop;
+	};
+
+	//**************************************
+	// Default thread pool getter
+	//
+	// Returns a pool with one thread per
+	// hardware thread, made the first time
+	// it is needed
+	//**************************************
+	inline thread_pool& default_thread_pool() noexcept
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	//**********************************
+	// Constructor
+	//**********************************
+	inline thread_pool::thread_pool(size_t threads) noexcept : m_workerCount(0), m_nextWorker(0), m_queued(0), m_stop(false)
+	{
+		if (threads == 0)
+			threads = std::thread::hardware_concurrency();
+		if (threads <= 1)
+			return;
+
+		m_workerCount = threads - 1;
+		m_workers.reset(new worker[m_workerCount]);
+		for (size_t index{ 0 }; index < m_workerCount; ++index)
+			m_workers[index].thread = std::thread([this, index] { work(index); });
+	}
+
+	//**********************************
+	// Destructor
+	//**********************************
+	inline thread_pool::~thread_pool() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_stop = true;
+		}
+		m_wakeup.notify_all();
+		for (size_t index{ 0 }; index < m_workerCount; ++index)
+			m_workers[index].thread.join();
+	}
+
+	//**********************************
+	// Run method
+	//**********************************
+	template<typename Function>
+	void thread_pool::run(size_t count, Function&& function) noexcept
+	{
+		if (count == 0)
+			return;
+		if (count == 1 || m_workerCount == 0)
+		{
+			for (size_t index{ 0 }; index < count; ++index)
+				function(index);
+			return;
+		}
+
+		struct job
+		{
+			std::remove_reference_t<Function>* function;
+			std::atomic<size_t> remaining;
+		};
+		job shared{ &function, count };
+		void (*invoke)(void*, size_t) = [](void* context, size_t index)
+		{
+			job* current = static_cast<job*>(context);
+			(*current->function)(index);
+			current->remaining.fetch_sub(1, std::memory_order_acq_rel);
+		};
+
+		// a worker keeps its tasks, anyone else spreads them over the pool
+		identity& self = current();
+		bool inside = self.pool == this;
+		for (size_t index{ 1 }; index < count; ++index)
+		{
+			size_t target = inside ? self.index : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workerCount;
+			if (!push(target, task{ invoke, &shared, index }))
+				invoke(&shared, index);
+		}
+		wake();
+
+		invoke(&shared, 0);
+		while (shared.remaining.load(std::memory_order_acquire) != 0)
+			if (!run_one())
+				std::this_thread::yield();
+	}
+
+	//**********************************
+	// Push method
+	//**********************************
+	inline bool thread_pool::push(size_t index, const task& work) noexcept
+	{
+		worker& target = m_workers[index];
+		std::lock_guard<std::mutex> lock(target.mutex);
+		if (target.tail - target.head == QUEUE_CAPACITY)
+			return false;
+		target.tasks[target.tail++ % QUEUE_CAPACITY] = work;
+		m_queued.fetch_add(1, std::memory_order_release);
+		return true;
+	}
+
+	//**********************************
+	// Pop method
+	//**********************************
+	inline bool thread_pool::pop(size_t index, task& work) noexcept
+	{
+		worker& target = m_workers[index];
+		std::lock_guard<std::mutex> lock(target.mutex);
+		if (target.tail == target.head)
+			return false;
+		work = target.tasks[--target.tail % QUEUE_CAPACITY];
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	//**********************************
+	// Steal method
+	//**********************************
+	inline bool thread_pool::steal(size_t index, task& work) noexcept
+	{
+		worker& target = m_workers[index];
+		std::lock_guard<std::mutex> lock(target.mutex);
+		if (target.tail == target.head)
+			return false;
+		work = target.tasks[target.head++ % QUEUE_CAPACITY];
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	//**********************************
+	// Run one method
+	//**********************************
+	inline bool thread_pool::run_one() noexcept
+	{
+		if (m_queued.load(std::memory_order_acquire) == 0)
+			return false;
+
+		task work;
+		identity& self = current();
+		size_t start = self.pool == this ? self.index : 0;
+		bool found = self.pool == this && pop(start, work);
+		for (size_t offset{ 0 }; !found && offset < m_workerCount; ++offset)
+			found = steal((start + offset) % m_workerCount, work);
+		if (!found)
+			return false;
+
+		work.function(work.context, work.index);
+		return true;
+	}
+
+	//**********************************
+	// Wake method
+	//**********************************
+	inline void thread_pool::wake() noexcept
+	{
+		// taking the lock orders this with a worker deciding to sleep
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+		}
+		m_wakeup.notify_all();
+	}
+
+	//**********************************
+	// Worker thread body
+	//**********************************
+	inline void thread_pool::work(size_t index) noexcept
+	{
+		current() = identity{ this, index };
+		for (;;)
+		{
+			if (run_one())
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_wakeup.wait(lock, [this] { return m_stop || m_queued.load(std::memory_order_acquire) != 0; });
+			if (m_stop && m_queued.load(std::memory_order_acquire) == 0)
+				return;
+		}
+	}
+}
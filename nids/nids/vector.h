@@ -4,9 +4,21 @@
 // Holds the definition of my
 // vector class.
 //
-// The resize strategy is to up the
-// size by 3 each time an allocation
-// is required
+// The resize strategy is picked by the
+// GrowthPolicy template parameter (see
+// growth_policy.h), which defaults to
+// tripling the capacity each time an
+// allocation is required
+//
+// Memory comes from the Allocator
+// template parameter (see allocator.h),
+// which defaults to malloc / realloc /
+// free
+//
+// The Stats template parameter (see
+// vector_stats.h) can count what the
+// vector does with its memory, and by
+// default counts nothing
 //
 // Author: Nathan Ikola
 // nathan.ikola@gmail.com
@@ -15,9 +27,17 @@
 
 #include <assert.h>
 #include <limits>
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 #include <utility>
+#include "algorithm.h"
+#include "aligned_allocator.h"
+#include "allocator.h"
+#include "growth_policy.h"
+#include "relocation.h"
+#include "span.h"
+#include "vector_stats.h"
 
 /*
 TODO:
@@ -26,46 +46,63 @@ TODO:
 	begin, cbegin
 	end, cend
 	rbegin, crbegin
-	reserve
 	shrink_to_fit
 	clear
-	insert
 	emplace
-	erase
-	emplace_back
 	pop_back
 	swap
 */
 
 namespace nids
 {
-	// static expansion size on push_back expansion
-	const float EXPANSION_SIZE = 3;
+	template<typename Type, typename GrowthPolicy = default_growth, typename Allocator = default_allocator, typename Stats = no_stats>
+	class vector;
 
-	template<typename Type>
+	template<typename Type, typename Container = vector<Type>>
 	class vector_iterator;
 
-	template<typename Type>
-	class vector final
+	// vector whose storage starts on an Alignment byte boundary
+	template<typename Type, size_t Alignment = 64, typename GrowthPolicy = default_growth>
+	using aligned_vector = vector<Type, GrowthPolicy, aligned_allocator<Alignment>>;
+
+	// aligned vector whose large buffers are backed by transparent huge pages
+	template<typename Type, size_t Alignment = 64, typename GrowthPolicy = default_growth>
+	using huge_page_vector = vector<Type, GrowthPolicy, huge_page_allocator<Alignment>>;
+
+	// the allocator is a private base so stateless allocators take no space
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	class vector final : private Allocator
 	{
 	public:
-		using iterator = vector_iterator<Type>;
+		using value_type = Type;
+		using iterator = vector_iterator<Type, vector>;
+		using growth_policy = GrowthPolicy;
+		using allocator_type = Allocator;
+		using stats_policy = Stats;
 
 		//************************************
 		// End getter method
 		//************************************
-		inline typename iterator end() const noexcept;
+		inline iterator end() const noexcept;
 
 		//*****************[ Manager Methods ]
 		//************************************
 		// Default constructor
 		//************************************
-		inline vector() noexcept : m_array(nullptr), m_size(0), m_capacity(0)
+		inline vector() noexcept : Allocator(), m_array(nullptr), m_size(0), m_capacity(0)
 		{
 			static_assert(sizeof(Type) != 0);
 			m_array = nullptr;
 		}
 
+		//************************************
+		// Allocator constructor
+		//************************************
+		inline explicit vector(const Allocator& allocator) noexcept : Allocator(allocator), m_array(nullptr), m_size(0), m_capacity(0)
+		{
+			static_assert(sizeof(Type) != 0);
+		}
+
 		//************************************
 		// Parameterized constructor
 		//
@@ -73,13 +110,15 @@ namespace nids
 		// without explicitly using the
 		// template parameters
 		//************************************
-		inline vector(size_t size) noexcept : m_array(nullptr), m_size(0), m_capacity(size)
+		inline vector(size_t size, const Allocator& allocator = Allocator()) noexcept 
+			: Allocator(allocator), m_array(nullptr), m_size(0), m_capacity(size)
 		{
 			static_assert(sizeof(Type) != 0);
 			if (m_capacity > 0)
 			{
-				m_array = static_cast<Type*>(malloc(sizeof(Type) * m_capacity));
+				m_array = static_cast<Type*>(this->allocate(sizeof(Type) * m_capacity));
 				assert(m_array != nullptr);
+				Stats::on_resize(0, sizeof(Type) * m_capacity, 0);
 			}
 			else
 				m_array = nullptr;
@@ -110,9 +149,12 @@ namespace nids
 		//************************************
 		inline ~vector() noexcept 
 		{
+			if (m_capacity > 0)
+				Stats::on_destroy(sizeof(Type) * m_size, sizeof(Type) * m_capacity);
+			destroy_range(m_array, m_size);
 			m_size = 0;
+			this->deallocate(m_array, sizeof(Type) * m_capacity);
 			m_capacity = 0;
-			free(m_array);
 			m_array = nullptr;
 		}
 
@@ -165,10 +207,34 @@ namespace nids
 		//************************************
 		inline bool empty() const noexcept { return m_size == 0; }
 
+		//************************************
+		// Allocator getter
+		//************************************
+		inline const Allocator& get_allocator() const noexcept { return *this; }
+
+		//************************************
+		// Array getter (const correct)
+		//************************************
+		inline const Type* data() const noexcept { return m_array; }
+
 		//************************************
 		// Array getter
 		//************************************
-		const Type* data() const noexcept { return m_array; }
+		inline Type* data() noexcept { return m_array; }
+
+		//************************************
+		// View getters
+		//
+		// Return a span over every element,
+		// or count elements from offset. A
+		// view is a pointer and a length, so
+		// slicing copies nothing, but like
+		// data() it is invalidated by growth
+		//************************************
+		inline span<Type> view() noexcept { return span<Type>(m_array, m_size); }
+		inline span<const Type> view() const noexcept { return span<const Type>(m_array, m_size); }
+		inline span<Type> view(size_t offset, size_t count) noexcept { return view().subspan(offset, count); }
+		inline span<const Type> view(size_t offset, size_t count) const noexcept { return view().subspan(offset, count); }
 
 		//************************************
 		// Front item getter
@@ -183,7 +249,7 @@ namespace nids
 		//************************************
 		// Begin iterator getter
 		//************************************
-		inline typename iterator begin() noexcept;
+		inline iterator begin() noexcept;
 
 		//*****************[ Mutator Methods ]
 		//************************************
@@ -202,6 +268,11 @@ namespace nids
 		//
 		// Resizes the vector and initializes
 		// the data to the value of val
+		//
+		// Only trivially copyable types get
+		// the new data initialized, since
+		// anything else would have to be
+		// constructed outside of the size
 		// 
 		// Returns new capacity, or old
 		// capacity if unchanged
@@ -254,7 +325,135 @@ namespace nids
 		// if necessary
 		//************************************
 		inline void push_back_i(Type&& data) noexcept;
+
+		//************************************
+		// Erase method
+		//
+		// Removes the element at pos and
+		// shifts the rest down
+		//
+		// Returns an iterator to the element
+		// that followed the erased one
+		//************************************
+		iterator erase(iterator pos) noexcept;
+
+		//************************************
+		// Reserve method
+		//
+		// Grows the capacity to at least
+		// size, never shrinks it
+		//
+		// Returns the new capacity
+		//************************************
+		inline size_t reserve(size_t size) noexcept
+		{
+			if (size > m_capacity)
+				resize(size);
+			return m_capacity;
+		}
+
+		//************************************
+		// Uninitialized resize method
+		//
+		// Sets the size, growing the
+		// capacity if needed, without
+		// touching the elements, so they
+		// can be filled through data()
+		// (e.g. by read or recv)
+		//
+		// Only for trivial types, anything
+		// else needs resize_default_init
+		//
+		// Returns the new size, or the old
+		// size if the allocation failed
+		//************************************
+		inline size_t resize_uninitialized(size_t size) noexcept
+		{
+			static_assert(std::is_trivial_v<Type>, "resize_uninitialized leaves the elements unconstructed");
+			return resize_default_init(size);
+		}
+
+		//************************************
+		// Default initializing resize method
+		//
+		// Sets the size, default
+		// constructing any new elements,
+		// which leaves trivial types
+		// untouched
+		//
+		// Returns the new size, or the old
+		// size if the allocation failed
+		//************************************
+		inline size_t resize_default_init(size_t size) noexcept
+		{
+			return array_resize_default_init(m_array, m_size, m_capacity, size, [this](size_t needed) { grow_to(needed); });
+		}
+
+		//************************************
+		// Emplace back method
+		//
+		// Constructs a new element at the
+		// end of the vector from args
+		//
+		// WARNING: args referencing the
+		// vector's own elements have the
+		// same problem as push_back
+		//************************************
+		template<typename... Args>
+		inline Type& emplace_back(Args&&... args) noexcept
+		{
+			return array_emplace_back(m_array, m_size, m_capacity, [this] { resize(next_capacity()); }, std::forward<Args>(args)...);
+		}
+
+		//************************************
+		// Append method
+		//
+		// Copies [first, last) onto the end
+		// of the vector, growing at most once
+		//
+		// Ranges taken from this vector are
+		// safe to append
+		//************************************
+		template<typename Iterator>
+		void append(Iterator first, Iterator last) noexcept;
+
+		//************************************
+		// Append method (span)
+		//************************************
+		inline void append(span<const Type> elements) noexcept { append(elements.begin(), elements.end()); }
+
+		//************************************
+		// Insert method
+		//
+		// Copies [first, last) in before pos,
+		// growing at most once
+		//
+		// The range must not come from this
+		// vector
+		//
+		// Returns an iterator to the first
+		// inserted element
+		//************************************
+		template<typename Iterator>
+		iterator insert(iterator pos, Iterator first, Iterator last) noexcept;
 	private:
+		//************************************
+		// Growth method
+		//
+		// Grows the capacity to hold at least
+		// needed elements, keeping to the
+		// growth policy when that is enough
+		//************************************
+		inline void grow_to(size_t needed) noexcept { resize(growth_target(next_capacity(), needed)); }
+
+		//************************************
+		// Growth capacity getter
+		//
+		// Returns the capacity to grow to
+		// when push_back runs out of space
+		//************************************
+		inline size_t next_capacity() const noexcept { return GrowthPolicy::next_capacity(m_capacity, sizeof(Type)); }
+
 		Type* m_array;
 		size_t m_size;
 		size_t m_capacity;
@@ -263,24 +462,26 @@ namespace nids
 	//*************************************
 	// Copy constructor
 	//*************************************
-	template<typename Type>
-	inline vector<Type>::vector(const vector& rhs) noexcept
-		: m_array(nullptr), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline vector<Type, GrowthPolicy, Allocator, Stats>::vector(const vector& rhs) noexcept
+		: Allocator(rhs), m_array(nullptr), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
 	{
-		assert(rhs.m_capacity > 0);
-		m_array = static_cast<Type*>(malloc(sizeof(Type) * m_capacity));
+		// an empty rhs has nothing to allocate
+		if (m_capacity == 0)
+			return;
+		m_array = static_cast<Type*>(this->allocate(sizeof(Type) * m_capacity));
 		assert(m_array != nullptr);
-		memcpy(m_array, rhs.m_array, sizeof(Type) * m_size);
+		Stats::on_resize(0, sizeof(Type) * m_capacity, 0);
+		copy_range(m_array, rhs.m_array, m_size);
 	}
 
 	//**********************************
 	// Move constructor
 	//**********************************
-	template<typename Type>
-	inline vector<Type>::vector(vector&& rhs) noexcept
-		: m_array(rhs.m_array), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline vector<Type, GrowthPolicy, Allocator, Stats>::vector(vector&& rhs) noexcept
+		: Allocator(std::move(rhs)), m_array(rhs.m_array), m_size(rhs.m_size), m_capacity(rhs.m_capacity)
 	{
-		assert(rhs.m_capacity > 0);
 		rhs.m_array = nullptr;
 		rhs.m_capacity = 0;
 		rhs.m_size = 0;
@@ -289,29 +490,33 @@ namespace nids
 	//**********************************
 	// Copy assignment operator
 	//**********************************
-	template<typename Type>
-	inline vector<Type>& vector<Type>::operator=(const vector& rhs) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline vector<Type, GrowthPolicy, Allocator, Stats>& vector<Type, GrowthPolicy, Allocator, Stats>::operator=(const vector& rhs) noexcept
 	{
-		assert(rhs.m_capacity > 0);
 		if (this != &rhs)
 		{
+			// the old contents are getting overwritten anyways
+			destroy_range(m_array, m_size);
+			m_size = 0;
+
 			// avoid allocating space if we can help it
 			if (m_capacity < rhs.m_capacity)
 			{
-				m_capacity = rhs.m_capacity;
-				Type* newRegion = static_cast<Type*>(realloc(m_array, sizeof(Type) * m_capacity));
+				Type* newRegion = reallocate_array(static_cast<Allocator&>(*this), m_array, 0, m_capacity, rhs.m_capacity);
 				if (newRegion == nullptr)
 				{
-					free(m_array);
-					newRegion = static_cast<Type*>(malloc(sizeof(Type) * m_capacity));
+					this->deallocate(m_array, sizeof(Type) * m_capacity);
+					newRegion = static_cast<Type*>(this->allocate(sizeof(Type) * rhs.m_capacity));
 					assert(newRegion != nullptr);
 				}
+				Stats::on_resize(sizeof(Type) * m_capacity, sizeof(Type) * rhs.m_capacity, 0);
 				m_array = newRegion;
+				m_capacity = rhs.m_capacity;
 			}
 
 			// deep copy rhs
 			m_size = rhs.m_size;
-			memcpy(m_array, rhs.m_array, sizeof(Type) * m_size);
+			copy_range(m_array, rhs.m_array, m_size);
 		}
 		return *this;
 	}
@@ -319,15 +524,18 @@ namespace nids
 	//**********************************
 	// Move assignment operator
 	//**********************************
-	template<typename Type>
-	inline vector<Type>& vector<Type>::operator=(vector&& rhs) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline vector<Type, GrowthPolicy, Allocator, Stats>& vector<Type, GrowthPolicy, Allocator, Stats>::operator=(vector&& rhs) noexcept
 	{
-		assert(rhs.m_capacity > 0);
 		if (this != &rhs)
 		{
 			// purge the left hand side
-			free(m_array);
-			// move the right hand side
+			if (m_capacity > 0)
+				Stats::on_destroy(sizeof(Type) * m_size, sizeof(Type) * m_capacity);
+			destroy_range(m_array, m_size);
+			this->deallocate(m_array, sizeof(Type) * m_capacity);
+			// move the right hand side (allocator included)
+			static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(rhs));
 			m_array = rhs.m_array;
 			m_size = rhs.m_size;
 			m_capacity = rhs.m_capacity;
@@ -341,167 +549,110 @@ namespace nids
 	//**********************************
 	// Resize method (no initialization)
 	//**********************************
-	template<typename Type>
-	size_t vector<Type>::resize(size_t size) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	size_t vector<Type, GrowthPolicy, Allocator, Stats>::resize(size_t size) noexcept
 	{
 		// see if size is equal to zero
 		if (size == 0)
 		{
+			destroy_range(m_array, m_size);
+			m_size = 0;
+			this->deallocate(m_array, sizeof(Type) * m_capacity);
 			m_capacity = 0;
-			free(m_array);
 			m_array = nullptr;
 			return 0;
 		}
 
-		void* newRegion = realloc(m_array, sizeof(Type) * size);
-
-		// if realloc failed
-		if (newRegion == nullptr)
+		// drop anything that won't fit anymore
+		if (size < m_size)
 		{
-			newRegion = malloc(sizeof(Type) * size);
-			if (newRegion == nullptr)
-				return m_capacity;
-			
-			// copy the old data
-			memcpy(newRegion, m_array, sizeof(Type) * m_size);
-			free(m_array);
+			destroy_range(m_array + size, m_size - size);
+			m_size = size;
 		}
 
-		m_array = static_cast<Type*>(newRegion);
+		Type* newRegion = reallocate_array(static_cast<Allocator&>(*this), m_array, m_size, m_capacity, size);
 
+		// if the allocation failed
+		if (newRegion == nullptr)
+			return m_capacity;
+
+		Stats::on_resize(sizeof(Type) * m_capacity, sizeof(Type) * size, newRegion != m_array ? sizeof(Type) * m_size : 0);
+		m_array = newRegion;
 		m_capacity = size;
-		if (m_capacity < m_size)
-			m_size = m_capacity;
 		return m_capacity;
 	}
 
 	//**********************************
 	// Resize method (initialization)
 	//**********************************
-	template<typename Type>
-	size_t vector<Type>::resize(size_t size, const Type& val) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	size_t vector<Type, GrowthPolicy, Allocator, Stats>::resize(size_t size, const Type& val) noexcept
 	{
-		// see if size is equal to zero
-		if (size == 0)
-		{
-			m_capacity = 0;
-			free(m_array);
-			m_array = nullptr;
-			return 0;
-		}
-
-		Type* newRegion = static_cast<Type*>(realloc(m_array, sizeof(Type) * size));
-
-		// if realloc failed
-		if (newRegion == nullptr)
-		{
-			newRegion = static_cast<Type*>(malloc(sizeof(Type) * size));
-			if (newRegion == nullptr)
-				return m_capacity;
-
-			// copy the old data
-			memcpy(newRegion, m_array, sizeof(Type) * m_size);
-			free(m_array);
-		}
-
-		m_array = newRegion;
+		size_t oldCapacity = m_capacity;
+		if (resize(size) != size || size == 0)
+			return m_capacity;
 
 		// initialize the new data
-		for (; m_capacity < size; ++m_capacity)
-			m_array[m_capacity] = val;
+		if constexpr (std::is_trivially_copyable_v<Type>)
+			if (m_capacity > oldCapacity)
+				nids::fill(m_array + oldCapacity, m_array + m_capacity, val);
 
-		// this is still required in case size < m_capacity
-		m_capacity = size;
-		if (m_capacity < m_size)
-			m_size = m_capacity;
 		return m_capacity;
 	}
 
 	//**********************************
 	// Push back method
 	//**********************************
-	template<typename Type>
-	inline void vector<Type>::push_back(const Type& data) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline void vector<Type, GrowthPolicy, Allocator, Stats>::push_back(const Type& data) noexcept
 	{
 		// if reallocation is necessary
 		if (m_size < m_capacity)
 		{
-			m_array[m_size++] = data;
+			new (m_array + m_size++) Type(data);
 			return;
 		}
 
-		if (m_capacity == 0) ++m_capacity;
-		resize(static_cast<size_t>(m_capacity * EXPANSION_SIZE));
-		m_array[m_size++] = data;
+		resize(next_capacity());
+		new (m_array + m_size++) Type(data);
 	}
 
 	//**********************************
 	// Push back method (rvalue)
 	//**********************************
-	template<typename Type>
-	inline void vector<Type>::push_back(Type&& data) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline void vector<Type, GrowthPolicy, Allocator, Stats>::push_back(Type&& data) noexcept
 	{
 		// if reallocation is not necessary
 		if (m_size < m_capacity)
 		{
-			m_array[m_size++] = data;
+			new (m_array + m_size++) Type(std::move(data));
 			return;
 		}
 
-		if (m_capacity == 0) ++m_capacity;
-		resize(static_cast<size_t>(m_capacity * EXPANSION_SIZE));
-		m_array[m_size++] = data;
+		resize(next_capacity());
+		new (m_array + m_size++) Type(std::move(data));
 	}
 
 	//**********************************
 	// Push back method (internal safe)
 	//**********************************
-	template<typename Type>
-	inline void vector<Type>::push_back_i(const Type& data) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline void vector<Type, GrowthPolicy, Allocator, Stats>::push_back_i(const Type& data) noexcept
 	{
-		// if reallocation is not necessary
-		if (m_size < m_capacity)
-		{
-			m_array[m_size++] = data;
-			return;
-		}
-
-		if (m_capacity == 0) ++m_capacity;
-		else if (&data >= m_array && &data <= m_array + m_capacity)
-		{
-			size_t _cached_index = static_cast<size_t>(&data - &m_array[0]);
-			resize(static_cast<size_t>(m_capacity * EXPANSION_SIZE));
-			m_array[m_size++] = m_array[_cached_index];
-			return;
-		}
-		resize(static_cast<size_t>(m_capacity * EXPANSION_SIZE));
-		m_array[m_size++] = data;
+		if (array_push_back_i(m_array, m_size, m_capacity, data, [this] { resize(next_capacity()); }))
+			Stats::on_alias();
 	}
 
 	//**********************************
 	// Push back method 
 	// (rvalue, internal safe)
 	//**********************************
-	template<typename Type>
-	inline void vector<Type>::push_back_i(Type&& data) noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline void vector<Type, GrowthPolicy, Allocator, Stats>::push_back_i(Type&& data) noexcept
 	{
-		// if reallocation is necessary
-		if (m_size < m_capacity)
-		{
-			m_array[m_size++] = data;
-			return;
-		}
-
-		if (m_capacity == 0) ++m_capacity;
-		else if (&data >= m_array && &data <= m_array + m_capacity)
-		{
-			size_t _cached_index = static_cast<size_t>(&data - &m_array[0]);
-			resize(static_cast<size_t>(m_capacity * EXPANSION_SIZE));
-			m_array[m_size++] = std::move(m_array[_cached_index]);
-			return;
-		}
-		resize(static_cast<size_t>(m_capacity * EXPANSION_SIZE));
-		m_array[m_size++] = data;
+		if (array_push_back_i(m_array, m_size, m_capacity, std::move(data), [this] { resize(next_capacity()); }))
+			Stats::on_alias();
 	}
 }
 
@@ -513,19 +664,52 @@ namespace nids
 	//************************************
 	// Begin iterator getter
 	//************************************
-	template<typename Type>
-	inline typename vector<Type>::iterator vector<Type>::begin() noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline typename vector<Type, GrowthPolicy, Allocator, Stats>::iterator vector<Type, GrowthPolicy, Allocator, Stats>::begin() noexcept
 	{
-		if (m_capacity) return vector_iterator(this);
+		if (m_capacity) return iterator(this);
 		return end();
 	}
 
 	//************************************
 	// End getter method
 	//************************************
-	template<typename Type>
-	inline typename vector<Type>::iterator vector<Type>::end() const noexcept
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	inline typename vector<Type, GrowthPolicy, Allocator, Stats>::iterator vector<Type, GrowthPolicy, Allocator, Stats>::end() const noexcept
+	{
+		return iterator::end(this);
+	}
+
+	//************************************
+	// Erase method
+	//************************************
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	typename vector<Type, GrowthPolicy, Allocator, Stats>::iterator vector<Type, GrowthPolicy, Allocator, Stats>::erase(iterator pos) noexcept
+	{
+		size_t index = pos - begin();
+		array_erase(m_array, m_size, index);
+		return begin() + static_cast<ptrdiff_t>(index);
+	}
+
+	//************************************
+	// Append method
+	//************************************
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	template<typename Iterator>
+	void vector<Type, GrowthPolicy, Allocator, Stats>::append(Iterator first, Iterator last) noexcept
+	{
+		array_append(m_array, m_size, m_capacity, first, last, [this](size_t needed) { grow_to(needed); });
+	}
+
+	//************************************
+	// Insert method
+	//************************************
+	template<typename Type, typename GrowthPolicy, typename Allocator, typename Stats>
+	template<typename Iterator>
+	typename vector<Type, GrowthPolicy, Allocator, Stats>::iterator vector<Type, GrowthPolicy, Allocator, Stats>::insert(iterator pos, Iterator first, Iterator last) noexcept
 	{
-		return vector_iterator<Type>::end(this);
+		size_t index = pos - begin();
+		array_insert(m_array, m_size, m_capacity, index, first, last, [this](size_t needed) { grow_to(needed); });
+		return begin() + static_cast<ptrdiff_t>(index);
 	}
 }
\ No newline at end of file
@@ -3,31 +3,44 @@
 //
 // The iterator class for nids::vector
 //
+// Container is the vector type being
+// iterated, so that every flavor of
+// nids::vector shares this iterator
+//
 // Author: Nathan Ikola
 // nathan.ikola@gmail.com
 //**************************************
 #pragma once
 
+#include <iterator>
+#include <stddef.h>
+
 namespace nids
 {
-	template<typename Type>
+	template<typename Type, typename Container>
 	class vector_iterator final
 	{
 	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = Type;
+		using difference_type = ptrdiff_t;
+		using pointer = Type*;
+		using reference = Type&;
+
 		//******************************
 		// Constructor
 		//******************************
-		inline vector_iterator(const vector<Type>* vector) noexcept : m_vector(vector), m_cursor(nullptr) 
+		inline vector_iterator(const Container* vector) noexcept : m_vector(vector), m_cursor(nullptr) 
 		{ 
 			assert(m_vector != nullptr);
 			if(m_vector->capacity() != 0)
-				m_cursor = &(const_cast<nids::vector<Type>*>(vector)->at(0));
+				m_cursor = const_cast<Type*>(m_vector->data());
 		}
 
 		//******************************
 		// Copy constructor
 		//******************************
-		inline vector_iterator(const vector_iterator<Type>& rhs) noexcept : m_vector(rhs.m_vector), m_cursor(rhs.m_cursor) 
+		inline vector_iterator(const vector_iterator<Type, Container>& rhs) noexcept : m_vector(rhs.m_vector), m_cursor(rhs.m_cursor) 
 		{ 
 			assert(m_vector != nullptr);
 		}
@@ -35,7 +48,7 @@ namespace nids
 		//******************************
 		// Move constructor
 		//******************************
-		inline vector_iterator(vector_iterator<Type>&& rhs) noexcept : m_vector(rhs.m_vector), m_cursor(rhs.m_cursor)
+		inline vector_iterator(vector_iterator<Type, Container>&& rhs) noexcept : m_vector(rhs.m_vector), m_cursor(rhs.m_cursor)
 		{
 			rhs.m_cursor = nullptr;
 		}
@@ -43,7 +56,7 @@ namespace nids
 		//******************************
 		// Copy assignment operator
 		//******************************
-		inline vector_iterator<Type>& operator=(const vector_iterator<Type>& rhs) noexcept
+		inline vector_iterator<Type, Container>& operator=(const vector_iterator<Type, Container>& rhs) noexcept
 		{
 			assert(rhs.m_vector != nullptr);
 			if (&rhs != this)
@@ -57,7 +70,7 @@ namespace nids
 		//******************************
 		// Move assignment operator
 		//******************************
-		inline vector_iterator<Type>& operator=(vector_iterator<Type>&& rhs) noexcept
+		inline vector_iterator<Type, Container>& operator=(vector_iterator<Type, Container>&& rhs) noexcept
 		{
 			assert(rhs.m_vector != nullptr);
 			if (&rhs != this)
@@ -83,7 +96,7 @@ namespace nids
 		//******************************
 		// Increment operator (prefix)
 		//******************************
-		inline vector_iterator<Type>& operator++() noexcept 
+		inline vector_iterator<Type, Container>& operator++() noexcept 
 		{
 			assert(m_cursor != m_vector->back() + 1);
 			++m_cursor;
@@ -93,9 +106,9 @@ namespace nids
 		//******************************
 		// Increment operator (postfix)
 		//******************************
-		inline vector_iterator<Type> operator++(int) noexcept 
+		inline vector_iterator<Type, Container> operator++(int) noexcept 
 		{
-			vector_iterator<Type> _r = *this;
+			vector_iterator<Type, Container> _r = *this;
 			assert(m_cursor != m_vector->back() + 1);
 			++m_cursor;
 			return _r;
@@ -104,7 +117,7 @@ namespace nids
 		//******************************
 		// Decrement operator (prefix)
 		//******************************
-		inline vector_iterator<Type>& operator--() noexcept
+		inline vector_iterator<Type, Container>& operator--() noexcept
 		{
 			assert(m_cursor != m_vector->front());
 			--m_cursor;
@@ -114,10 +127,10 @@ namespace nids
 		//******************************
 		// Decrement operator (postfix)
 		//******************************
-		inline vector_iterator<Type> operator--(int) noexcept
+		inline vector_iterator<Type, Container> operator--(int) noexcept
 		{
 			assert(m_cursor != m_vector->front());
-			vector_iterator<Type> _r = *this;
+			vector_iterator<Type, Container> _r = *this;
 			--m_cursor;
 			return _r;
 		}
@@ -125,27 +138,27 @@ namespace nids
 		//******************************
 		// Next index method
 		//******************************
-		inline vector_iterator<Type> next() const noexcept 
+		inline vector_iterator<Type, Container> next() const noexcept 
 		{ 
-			vector_iterator<Type> v{ *this };
+			vector_iterator<Type, Container> v{ *this };
 			return ++v;
 		}
 
 		//******************************
 		// Previous index method
 		//******************************
-		inline vector_iterator<Type> previous()const  noexcept 
+		inline vector_iterator<Type, Container> previous()const  noexcept 
 		{ 
-			vector_iterator<Type> v{ *this };
+			vector_iterator<Type, Container> v{ *this };
 			return --v; 
 		}
 
 		//******************************
 		// Addition operator (int)
 		//******************************
-		inline vector_iterator<Type> operator+(int amount) const noexcept
+		inline vector_iterator<Type, Container> operator+(difference_type amount) const noexcept
 		{
-			vector_iterator<Type> v{ *this };
+			vector_iterator<Type, Container> v{ *this };
 			v.m_cursor += amount;
 			return v;
 		}
@@ -153,7 +166,7 @@ namespace nids
 		//******************************
 		// In-place addition operator
 		//******************************
-		inline vector_iterator<Type>& operator+=(int amount) noexcept
+		inline vector_iterator<Type, Container>& operator+=(difference_type amount) noexcept
 		{
 			m_cursor += amount;
 			return *this;
@@ -162,9 +175,9 @@ namespace nids
 		//******************************
 		// Subtraction operator
 		//******************************
-		inline vector_iterator<Type> operator-(int amount) noexcept
+		inline vector_iterator<Type, Container> operator-(difference_type amount) const noexcept
 		{
-			vector_iterator<Type> v{ *this };
+			vector_iterator<Type, Container> v{ *this };
 			v.m_cursor -= amount;
 			return v;
 		}
@@ -172,7 +185,7 @@ namespace nids
 		//******************************
 		// Subtraction operator (iter)
 		//******************************
-		inline size_t operator-(const vector_iterator<Type>& rhs)
+		inline difference_type operator-(const vector_iterator<Type, Container>& rhs) const noexcept
 		{
 			return m_cursor - rhs.m_cursor;
 		}
@@ -180,7 +193,7 @@ namespace nids
 		//******************************
 		// In-place subtraction operator
 		//******************************
-		inline vector_iterator<Type>& operator-=(int amount) noexcept
+		inline vector_iterator<Type, Container>& operator-=(difference_type amount) noexcept
 		{
 			m_cursor -= amount;
 			return *this;
@@ -190,32 +203,32 @@ namespace nids
 		//******************************
 		// Comparison operator
 		//******************************
-		inline bool operator==(const vector_iterator<Type>& rhs) const noexcept { return m_cursor == rhs.m_cursor; }
+		inline bool operator==(const vector_iterator<Type, Container>& rhs) const noexcept { return m_cursor == rhs.m_cursor; }
 
 		//******************************
 		// Comparison operator (NOT)
 		//******************************
-		inline bool operator!=(const vector_iterator<Type>& rhs) const noexcept { return m_cursor != rhs.m_cursor; }
+		inline bool operator!=(const vector_iterator<Type, Container>& rhs) const noexcept { return m_cursor != rhs.m_cursor; }
 
 		//******************************
 		// LT operator
 		//******************************
-		inline bool operator<(const vector_iterator<Type>& rhs) const noexcept { return m_cursor < rhs.m_cursor; }
+		inline bool operator<(const vector_iterator<Type, Container>& rhs) const noexcept { return m_cursor < rhs.m_cursor; }
 
 		//******************************
 		// GT operator
 		//******************************
-		inline bool operator>(const vector_iterator<Type>& rhs) const noexcept { return m_cursor > rhs.m_cursor; }
+		inline bool operator>(const vector_iterator<Type, Container>& rhs) const noexcept { return m_cursor > rhs.m_cursor; }
 
 		//******************************
 		// LTE operator
 		//******************************
-		inline bool operator<=(const vector_iterator<Type>& rhs) const noexcept { return m_cursor <= rhs.m_cursor; }
+		inline bool operator<=(const vector_iterator<Type, Container>& rhs) const noexcept { return m_cursor <= rhs.m_cursor; }
 
 		//******************************
 		// GTE operator
 		//******************************
-		inline bool operator>=(const vector_iterator<Type>& rhs) const noexcept { return m_cursor >= rhs.m_cursor; }
+		inline bool operator>=(const vector_iterator<Type, Container>& rhs) const noexcept { return m_cursor >= rhs.m_cursor; }
 
 		//*******[ Accessor Operations ]
 		//******************************
@@ -251,36 +264,42 @@ namespace nids
 		//******************************
 		// Offset subscript operator
 		//******************************
-		inline Type& operator[](int offset) noexcept { return m_cursor[offset]; }
+		inline Type& operator[](difference_type offset) noexcept { return m_cursor[offset]; }
 
 		//******************************
 		// Offset subscript operator
 		// (const correct)
 		//******************************
-		inline const Type& operator[](int offset) const noexcept { return m_cursor[offset]; }
+		inline const Type& operator[](difference_type offset) const noexcept { return m_cursor[offset]; }
 
 		//************[ Static Methods ]
 		//******************************
 		// End getter
 		//******************************
-		static inline vector_iterator<Type> end(const vector<Type>* v) noexcept
+		static inline vector_iterator<Type, Container> end(const Container* v) noexcept
 		{
-			vector_iterator<Type> iter{ v };
+			vector_iterator<Type, Container> iter{ v };
 			if(v->capacity() != 0)
 				iter.m_cursor = v->back() + 1;
 			return iter;
 		}
 	private:
-		const vector<Type>* m_vector;
+		const Container* m_vector;
 		Type* m_cursor;
 	};
 
 	//******************************
 	// Addition operator overload
 	//******************************
-	template<typename Type>
-	inline vector_iterator<Type> operator+(int amount, const vector_iterator<Type>& iter) noexcept
+	template<typename Type, typename Container>
+	inline vector_iterator<Type, Container> operator+(ptrdiff_t amount, const vector_iterator<Type, Container>& iter) noexcept
 	{
 		return iter + amount;
 	}
+
+	//******************************
+	// Contiguous iterator trait
+	//******************************
+	template<typename Type, typename Container>
+	struct is_contiguous_iterator<vector_iterator<Type, Container>> : std::true_type {};
 }
\ No newline at end of file
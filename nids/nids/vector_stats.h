@@ -0,0 +1,247 @@
+//**************************************
+// vector_stats.h
+//
+// Holds the stats policies for
+// nids::vector, which count what a
+// vector does with its memory.
+//
+// A stats policy is any type with these
+// static member functions, called by
+// the vector as things happen:
+//
+//	void on_resize(size_t oldBytes,
+//		size_t newBytes, size_t copiedBytes)
+//	void on_destroy(size_t usedBytes,
+//		size_t capacityBytes)
+//	void on_alias()
+//
+// no_stats does nothing, so a vector
+// that uses it compiles to the same
+// code as before. counting_stats<Tag>
+// adds the events to counters shared by
+// every vector with the same Tag, and
+// optional_stats<Tag> is one or the
+// other depending on NIDS_VECTOR_STATS
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdio.h>
+
+// declares a stats tag type named after itself, for use with counting_stats
+#define NIDS_STATS_TAG(tag) struct tag { static constexpr const char* name = #tag; }
+
+namespace nids
+{
+	//**************************************
+	// No stats policy
+	//
+	// The default, every hook is empty
+	//**************************************
+	struct no_stats final
+	{
+		static inline void on_resize(size_t, size_t, size_t) noexcept {}
+		static inline void on_destroy(size_t, size_t) noexcept {}
+		static inline void on_alias() noexcept {}
+	};
+
+	//**************************************
+	// Stats counters
+	//
+	// The totals for one tag. Every tag
+	// that has counted something is kept
+	// in a list for the dump functions
+	//**************************************
+	struct vector_stats_counters final
+	{
+		//**********************************
+		// Constructor
+		//
+		// Adds the counters to the list
+		//**********************************
+		explicit vector_stats_counters(const char* tag) noexcept;
+
+		vector_stats_counters(const vector_stats_counters&) = delete;
+		vector_stats_counters& operator=(const vector_stats_counters&) = delete;
+
+		//**********************************
+		// Reset method
+		//**********************************
+		void reset() noexcept;
+
+		// tag the counters belong to
+		const char* name;
+
+		// first allocations, capacity going from nothing to something
+		std::atomic<size_t> allocations;
+
+		// capacity changes of an existing buffer (the realloc storms)
+		std::atomic<size_t> reallocations;
+
+		// bytes of live elements carried over by reallocations that moved the buffer
+		std::atomic<size_t> copied_bytes;
+
+		// largest buffer any vector with this tag has had
+		std::atomic<size_t> peak_capacity_bytes;
+
+		// unused capacity left in vectors when they were destroyed
+		std::atomic<size_t> wasted_bytes;
+
+		// vectors destroyed while holding a buffer
+		std::atomic<size_t> destroyed;
+
+		// push_back_i calls that had to grow while given one of the vector's own elements
+		std::atomic<size_t> aliasing_hits;
+
+		// next tag in the list
+		vector_stats_counters* next;
+	};
+
+	//**************************************
+	// Counters list accessor
+	//
+	// Returns the head of the list of
+	// every tag's counters
+	//**************************************
+	inline std::atomic<vector_stats_counters*>& vector_stats_list() noexcept
+	{
+		static std::atomic<vector_stats_counters*> head{ nullptr };
+		return head;
+	}
+
+	//**********************************
+	// Constructor
+	//**********************************
+	inline vector_stats_counters::vector_stats_counters(const char* tag) noexcept
+		: name(tag), allocations(0), reallocations(0), copied_bytes(0), peak_capacity_bytes(0),
+		wasted_bytes(0), destroyed(0), aliasing_hits(0), next(nullptr)
+	{
+		std::atomic<vector_stats_counters*>& head = vector_stats_list();
+		next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	//**********************************
+	// Reset method
+	//**********************************
+	inline void vector_stats_counters::reset() noexcept
+	{
+		allocations = 0;
+		reallocations = 0;
+		copied_bytes = 0;
+		peak_capacity_bytes = 0;
+		wasted_bytes = 0;
+		destroyed = 0;
+		aliasing_hits = 0;
+	}
+
+	//**************************************
+	// Counting stats policy
+	//
+	// Counts into the counters for Tag,
+	// which must have a static name
+	// member (see NIDS_STATS_TAG). Using
+	// one tag per call site shows which
+	// vectors are doing the work
+	//**************************************
+	template<typename Tag>
+	struct counting_stats final
+	{
+		//**********************************
+		// Counters accessor
+		//**********************************
+		static inline vector_stats_counters& counters() noexcept
+		{
+			static vector_stats_counters tagCounters(Tag::name);
+			return tagCounters;
+		}
+
+		//**********************************
+		// Resize hook
+		//
+		// Called after the capacity
+		// changed from oldBytes to newBytes,
+		// copiedBytes is what the move to
+		// a new buffer carried over
+		//**********************************
+		static inline void on_resize(size_t oldBytes, size_t newBytes, size_t copiedBytes) noexcept
+		{
+			vector_stats_counters& stats = counters();
+			if (oldBytes == 0)
+				stats.allocations.fetch_add(1, std::memory_order_relaxed);
+			else
+				stats.reallocations.fetch_add(1, std::memory_order_relaxed);
+			stats.copied_bytes.fetch_add(copiedBytes, std::memory_order_relaxed);
+
+			size_t peak = stats.peak_capacity_bytes.load(std::memory_order_relaxed);
+			while (newBytes > peak && !stats.peak_capacity_bytes.compare_exchange_weak(peak, newBytes, std::memory_order_relaxed));
+		}
+
+		//**********************************
+		// Destruction hook
+		//**********************************
+		static inline void on_destroy(size_t usedBytes, size_t capacityBytes) noexcept
+		{
+			vector_stats_counters& stats = counters();
+			stats.destroyed.fetch_add(1, std::memory_order_relaxed);
+			stats.wasted_bytes.fetch_add(capacityBytes - usedBytes, std::memory_order_relaxed);
+		}
+
+		//**********************************
+		// Aliasing hook
+		//**********************************
+		static inline void on_alias() noexcept { counters().aliasing_hits.fetch_add(1, std::memory_order_relaxed); }
+	};
+
+	// counts only when built with NIDS_VECTOR_STATS defined, so tagged vectors cost nothing otherwise
+#ifdef NIDS_VECTOR_STATS
+	template<typename Tag>
+	using optional_stats = counting_stats<Tag>;
+#else
+	template<typename Tag>
+	using optional_stats = no_stats;
+#endif
+
+	//**************************************
+	// Stats visiting method
+	//
+	// Calls visitor with the counters of
+	// every tag that has counted anything
+	//**************************************
+	template<typename Visitor>
+	inline void for_each_vector_stats(Visitor&& visitor) noexcept
+	{
+		for (vector_stats_counters* stats = vector_stats_list().load(std::memory_order_acquire); stats != nullptr; stats = stats->next)
+			visitor(static_cast<const vector_stats_counters&>(*stats));
+	}
+
+	//**************************************
+	// Stats reset method
+	//
+	// Zeroes every tag's counters
+	//**************************************
+	inline void reset_vector_stats() noexcept
+	{
+		for (vector_stats_counters* stats = vector_stats_list().load(std::memory_order_acquire); stats != nullptr; stats = stats->next)
+			stats->reset();
+	}
+
+	//**************************************
+	// Stats dump method
+	//
+	// Prints a line per tag to out
+	//**************************************
+	inline void dump_vector_stats(FILE* out = stdout) noexcept
+	{
+		for_each_vector_stats([out](const vector_stats_counters& stats)
+		{
+			fprintf(out, "%-32s allocations=%zu reallocations=%zu copied_bytes=%zu peak_capacity_bytes=%zu wasted_bytes=%zu destroyed=%zu aliasing_hits=%zu\n",
+				stats.name, stats.allocations.load(), stats.reallocations.load(), stats.copied_bytes.load(), stats.peak_capacity_bytes.load(),
+				stats.wasted_bytes.load(), stats.destroyed.load(), stats.aliasing_hits.load());
+		});
+	}
+}
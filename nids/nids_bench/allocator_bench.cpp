@@ -0,0 +1,71 @@
+//**************************************
+// allocator_bench.cpp
+//
+// Benchmarks per-request scratch vector
+// churn on the malloc allocator versus
+// an arena that is reset per request
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/arena.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	const size_t NUM_REQUESTS = 100000;
+	const size_t VECTORS_PER_REQUEST = 16;
+	const size_t ELEMENTS_PER_VECTOR = 40;
+
+	//**************************************
+	// Simulated request
+	//
+	// Builds a handful of short lived
+	// vectors and sums their contents
+	//**************************************
+	template<typename Vector, typename... Args>
+	inline long long RunRequest(size_t request, Args&... args) noexcept
+	{
+		long long sum{ 0 };
+		for (size_t index{ 0 }; index < VECTORS_PER_REQUEST; ++index)
+		{
+			Vector v{ args... };
+			for (size_t element{ 0 }; element < ELEMENTS_PER_VECTOR + (request + index) % 8; ++element)
+				v.push_back(static_cast<int>(element));
+			for (size_t element{ 0 }; element < v.size(); ++element)
+				sum += v[element];
+		}
+		return sum;
+	}
+}
+
+NIDS_BENCHMARK(allocator, request_churn_malloc)
+{
+	result.Time(NUM_REQUESTS * VECTORS_PER_REQUEST, []
+	{
+		long long total{ 0 };
+		for (size_t request{ 0 }; request < NUM_REQUESTS; ++request)
+			total += RunRequest<nids::vector<int>>(request);
+		nids_bench::DoNotOptimize(total);
+	});
+}
+
+NIDS_BENCHMARK(allocator, request_churn_arena)
+{
+	result.Time(NUM_REQUESTS * VECTORS_PER_REQUEST, []
+	{
+		using arena_vector = nids::vector<int, nids::default_growth, nids::arena_allocator>;
+
+		nids::arena scratch;
+		nids::arena_allocator allocator{ scratch };
+		long long total{ 0 };
+		for (size_t request{ 0 }; request < NUM_REQUESTS; ++request)
+		{
+			total += RunRequest<arena_vector>(request, allocator);
+			scratch.reset();
+		}
+		nids_bench::DoNotOptimize(total);
+	});
+}
@@ -0,0 +1,483 @@
+//**************************************
+// bench.h
+//
+// Holds the minimal benchmark harness
+// used by the nids_bench driver.
+//
+// Benchmarks register themselves with
+// NIDS_BENCHMARK and report the time
+// per operation of their timed region,
+// plus hardware counters per operation
+// when perf_event_open is available
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "../nids/allocator.h"
+#include "../nids/vector_stats.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nids_bench
+{
+	// number of times each timed region is repeated (best run is reported)
+	const int REPEATS = 5;
+
+	//**************************************
+	// Optimization barrier
+	//
+	// Keeps the compiler from discarding
+	// results that are otherwise unused
+	//**************************************
+	template<typename Type>
+	inline void DoNotOptimize(const Type& value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	//**************************************
+	// Peak RSS reset method
+	//
+	// Resets the high water mark reported
+	// by PeakRssKb (Linux only)
+	//**************************************
+	inline void ResetPeakRss() noexcept
+	{
+#ifdef __linux__
+		int fd = open("/proc/self/clear_refs", O_WRONLY);
+		if (fd < 0)
+			return;
+		if (write(fd, "5", 1) < 0) {}
+		close(fd);
+#endif
+	}
+
+	//**************************************
+	// Peak RSS getter
+	//
+	// Returns the resident set high water
+	// mark in KB, or 0 if unavailable
+	//**************************************
+	inline long PeakRssKb() noexcept
+	{
+		long peak = 0;
+#ifdef __linux__
+		FILE* status = fopen("/proc/self/status", "r");
+		if (status == nullptr)
+			return 0;
+
+		char line[256];
+		while (fgets(line, sizeof(line), status) != nullptr)
+			if (strncmp(line, "VmHWM:", 6) == 0)
+			{
+				peak = atol(line + 6);
+				break;
+			}
+		fclose(status);
+#endif
+		return peak;
+	}
+
+	//**************************************
+	// Huge page usage getter
+	//
+	// Returns the KB of anonymous memory
+	// backed by transparent huge pages, or
+	// 0 if unavailable (Linux only)
+	//**************************************
+	inline long AnonHugePagesKb() noexcept
+	{
+		long huge = 0;
+#ifdef __linux__
+		FILE* rollup = fopen("/proc/self/smaps_rollup", "r");
+		if (rollup == nullptr)
+			return 0;
+
+		char line[256];
+		while (fgets(line, sizeof(line), rollup) != nullptr)
+			if (strncmp(line, "AnonHugePages:", 14) == 0)
+			{
+				huge = atol(line + 14);
+				break;
+			}
+		fclose(rollup);
+#endif
+		return huge;
+	}
+
+	//**************************************
+	// Allocation counter getter
+	//
+	// Running total of the bytes asked for
+	// through operator new (replaced in
+	// bench_main.cpp) and CountingAllocator
+	//**************************************
+	inline std::atomic<size_t>& AllocationCounter() noexcept
+	{
+		static std::atomic<size_t> allocated{ 0 };
+		return allocated;
+	}
+
+	//**************************************
+	// Allocated bytes getter
+	//
+	// Benchmarks read it before and after
+	// a run
+	//**************************************
+	inline size_t AllocatedBytes() noexcept { return AllocationCounter().load(std::memory_order_relaxed); }
+
+	//**************************************
+	// Counting allocator
+	//
+	// Wraps a nids allocator and adds the
+	// size of every block it is asked for,
+	// including the new size of a block
+	// grown in place, to the counter
+	//**************************************
+	template<typename Base = nids::default_allocator>
+	struct CountingAllocator : Base
+	{
+		inline void* allocate(size_t bytes) noexcept
+		{
+			AllocationCounter().fetch_add(bytes, std::memory_order_relaxed);
+			return Base::allocate(bytes);
+		}
+
+		inline void* reallocate(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+			AllocationCounter().fetch_add(newBytes, std::memory_order_relaxed);
+			return Base::reallocate(block, oldBytes, newBytes);
+		}
+
+		inline bool expand(void* block, size_t oldBytes, size_t newBytes) noexcept
+		{
+			bool expanded = Base::expand(block, oldBytes, newBytes);
+			if (expanded)
+				AllocationCounter().fetch_add(newBytes, std::memory_order_relaxed);
+			return expanded;
+		}
+	};
+
+	//**************************************
+	// Hardware counters
+	//
+	// Counts cycles, instructions, cache
+	// misses, and branch misses for the
+	// calling thread with perf_event_open.
+	// Events the kernel refuses (no PMU in
+	// a VM, perf_event_paranoid too high,
+	// not Linux) are left out
+	//**************************************
+	class PerfCounters final
+	{
+	public:
+		static const int EVENT_COUNT = 4;
+
+		//**********************************
+		// Constructor
+		//**********************************
+		inline PerfCounters() noexcept
+		{
+#ifdef __linux__
+			const uint64_t configs[EVENT_COUNT] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+			for (int event{ 0 }; event < EVENT_COUNT; ++event)
+			{
+				perf_event_attr attr;
+				memset(&attr, 0, sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = configs[event];
+				attr.disabled = 1;
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+				m_fds[event] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+			}
+#else
+			for (int& fd : m_fds)
+				fd = -1;
+#endif
+		}
+
+		PerfCounters(const PerfCounters&) = delete;
+		PerfCounters& operator=(const PerfCounters&) = delete;
+
+		//**********************************
+		// Destructor
+		//**********************************
+		inline ~PerfCounters() noexcept
+		{
+#ifdef __linux__
+			for (int fd : m_fds)
+				if (fd >= 0)
+					close(fd);
+#endif
+		}
+
+		//**********************************
+		// Availability getter
+		//
+		// True if any event could be opened
+		//**********************************
+		inline bool Available() const noexcept
+		{
+			for (int fd : m_fds)
+				if (fd >= 0)
+					return true;
+			return false;
+		}
+
+		//**********************************
+		// Event availability getter
+		//**********************************
+		inline bool Available(int event) const noexcept { return m_fds[event] >= 0; }
+
+		//**********************************
+		// Event name getter
+		//**********************************
+		static inline const char* Name(int event) noexcept
+		{
+			static const char* const names[EVENT_COUNT] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+			return names[event];
+		}
+
+		//**********************************
+		// Start method
+		//
+		// Zeroes and starts every event
+		//**********************************
+		inline void Start() noexcept
+		{
+#ifdef __linux__
+			for (int fd : m_fds)
+				if (fd >= 0)
+				{
+					ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+					ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+				}
+#endif
+		}
+
+		//**********************************
+		// Stop method
+		//
+		// Stops every event and stores its
+		// count in values, scaled up if the
+		// kernel had to multiplex it
+		//**********************************
+		inline void Stop(double (&values)[EVENT_COUNT]) noexcept
+		{
+			for (int event{ 0 }; event < EVENT_COUNT; ++event)
+			{
+				values[event] = 0.0;
+#ifdef __linux__
+				if (m_fds[event] < 0)
+					continue;
+				ioctl(m_fds[event], PERF_EVENT_IOC_DISABLE, 0);
+
+				// value, time enabled, time running
+				uint64_t read_values[3];
+				if (read(m_fds[event], read_values, sizeof(read_values)) != sizeof(read_values) || read_values[2] == 0)
+					continue;
+				values[event] = static_cast<double>(read_values[0]) * read_values[1] / read_values[2];
+#endif
+			}
+		}
+	private:
+		int m_fds[EVENT_COUNT];
+	};
+
+	//**************************************
+	// Shared hardware counters getter
+	//**************************************
+	inline PerfCounters& HardwareCounters() noexcept
+	{
+		static PerfCounters counters;
+		return counters;
+	}
+
+	class Result final
+	{
+	public:
+		//**********************************
+		// Timing method
+		//
+		// Runs function REPEATS times and
+		// keeps the fastest run, reported
+		// as nanoseconds per operation
+		//**********************************
+		template<typename Function>
+		void Time(size_t operations, Function&& function) noexcept
+		{
+			PerfCounters& hardware = HardwareCounters();
+			for (int repeat{ 0 }; repeat < REPEATS; ++repeat)
+			{
+				double events[PerfCounters::EVENT_COUNT];
+				hardware.Start();
+				auto start = std::chrono::steady_clock::now();
+				function();
+				auto stop = std::chrono::steady_clock::now();
+				hardware.Stop(events);
+
+				double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+				if (repeat == 0 || ns < m_bestNs)
+				{
+					m_bestNs = ns;
+					memcpy(m_events, events, sizeof(events));
+				}
+			}
+			m_operations = operations;
+		}
+
+		//**********************************
+		// Nanoseconds per op accessor
+		//**********************************
+		inline double NsPerOp() const noexcept { return m_operations ? m_bestNs / m_operations : 0.0; }
+
+		//**********************************
+		// Counter method
+		//
+		// Attaches an extra named value to
+		// the reported line
+		//**********************************
+		inline void Counter(const char* name, double value) noexcept { m_counters.push_back(NamedValue{ name, value }); }
+
+		//**********************************
+		// Counter printing method
+		//**********************************
+		inline void PrintCounters() const noexcept
+		{
+			for (const NamedValue& counter : m_counters)
+				printf("  %s=%.0f", counter.name, counter.value);
+		}
+
+		//**********************************
+		// Hardware counter printing method
+		//
+		// Prints each event of the best run
+		// per operation, and instructions
+		// per cycle
+		//**********************************
+		inline void PrintHardwareCounters() const noexcept
+		{
+			const PerfCounters& hardware = HardwareCounters();
+			if (m_operations == 0 || !hardware.Available())
+				return;
+			for (int event{ 0 }; event < PerfCounters::EVENT_COUNT; ++event)
+				if (hardware.Available(event))
+					printf("  %s/op=%.3f", PerfCounters::Name(event), m_events[event] / m_operations);
+			if (m_events[0] > 0.0 && hardware.Available(1))
+				printf("  ipc=%.2f", m_events[1] / m_events[0]);
+		}
+	private:
+		struct NamedValue
+		{
+			const char* name;
+			double value;
+		};
+
+		std::vector<NamedValue> m_counters;
+		double m_events[PerfCounters::EVENT_COUNT] = {};
+		double m_bestNs = 0.0;
+		size_t m_operations = 0;
+	};
+
+	//**************************************
+	// Vector stats counters method
+	//
+	// Attaches one tag's vector stats
+	// (see vector_stats.h) to a result
+	//**************************************
+	inline void VectorStatsCounters(Result& result, const nids::vector_stats_counters& stats) noexcept
+	{
+		result.Counter("allocations", static_cast<double>(stats.allocations.load()));
+		result.Counter("reallocations", static_cast<double>(stats.reallocations.load()));
+		result.Counter("copied_bytes", static_cast<double>(stats.copied_bytes.load()));
+		result.Counter("peak_capacity_bytes", static_cast<double>(stats.peak_capacity_bytes.load()));
+		result.Counter("wasted_bytes", static_cast<double>(stats.wasted_bytes.load()));
+		result.Counter("aliasing_hits", static_cast<double>(stats.aliasing_hits.load()));
+	}
+
+	// signature every benchmark body has
+	using BenchmarkFunction = void(*)(Result&);
+
+	struct Benchmark
+	{
+		const char* name;
+		BenchmarkFunction function;
+	};
+
+	//**************************************
+	// Benchmark registry accessor
+	//**************************************
+	inline std::vector<Benchmark>& Registry() noexcept
+	{
+		static std::vector<Benchmark> registry;
+		return registry;
+	}
+
+	//**************************************
+	// Static registration helper
+	//**************************************
+	struct Registrar final
+	{
+		inline Registrar(const char* name, BenchmarkFunction function) noexcept
+		{
+			Registry().push_back(Benchmark{ name, function });
+		}
+	};
+
+	//**************************************
+	// Benchmark runner
+	//
+	// Runs every benchmark whose name
+	// contains filter (or all of them if
+	// filter is nullptr)
+	//**************************************
+	inline void RunAll(const char* filter) noexcept
+	{
+		if (!HardwareCounters().Available())
+			fprintf(stderr, "hardware counters unavailable, reporting time only\n");
+
+		for (const Benchmark& benchmark : Registry())
+		{
+			if (filter != nullptr && strstr(benchmark.name, filter) == nullptr)
+				continue;
+
+			Result result;
+			benchmark.function(result);
+			printf("%-56s %12.3f ns/op", benchmark.name, result.NsPerOp());
+			result.PrintCounters();
+			result.PrintHardwareCounters();
+			printf("\n");
+			fflush(stdout);
+		}
+	}
+}
+
+// registers a benchmark named "group/name"
+#define NIDS_BENCHMARK(group, name) \
+	static void group##_##name(nids_bench::Result&); \
+	static nids_bench::Registrar group##_##name##_registrar{ #group "/" #name, group##_##name }; \
+	static void group##_##name(nids_bench::Result& result)
@@ -0,0 +1,40 @@
+//**************************************
+// bench_main.cpp
+//
+// Driver program for the benchmarks
+//
+// Usage: nids_bench [filter]
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include <new>
+#include "bench.h"
+
+//**************************************
+// Counting operator new
+//
+// Every heap allocation made through
+// new (std containers included) adds
+// its size to the benchmark counter.
+// The other forms of new and delete
+// forward to these by default
+//**************************************
+void* operator new(size_t bytes)
+{
+	nids_bench::AllocationCounter().fetch_add(bytes, std::memory_order_relaxed);
+	void* block = malloc(bytes == 0 ? 1 : bytes);
+	if (block == nullptr)
+		abort();
+	return block;
+}
+
+void operator delete(void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+
+int main(int argc, char** argv)
+{
+	nids_bench::RunAll(argc > 1 ? argv[1] : nullptr);
+	return 0;
+}
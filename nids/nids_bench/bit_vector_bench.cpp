@@ -0,0 +1,157 @@
+//**************************************
+// bit_vector_bench.cpp
+//
+// Benchmarks nids::bit_vector as a
+// visited set against a vector of char,
+// the bulk word operations at each SIMD
+// level, and rank / select
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/bit_vector.h"
+
+namespace
+{
+	// nodes in the visited set, 32 MB as chars but 4 MB as bits
+	const size_t NUM_NODES = 32 * 1024 * 1024;
+
+	// visits per timed run
+	const size_t NUM_VISITS = 16 * 1024 * 1024;
+
+	//**************************************
+	// Pseudo random node order, the same
+	// for every benchmark
+	//**************************************
+	inline size_t NextNode(uint64_t& state) noexcept
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return static_cast<size_t>(state >> 33) % NUM_NODES;
+	}
+
+	//**************************************
+	// Shared bits, about half set
+	//**************************************
+	const nids::bit_vector<>& Bits() noexcept
+	{
+		static nids::bit_vector<> bits = []
+		{
+			nids::bit_vector<> values(NUM_NODES);
+			uint64_t state{ 1 };
+			for (size_t visit{ 0 }; visit < NUM_NODES / 2; ++visit)
+				values.set(NextNode(state));
+			return values;
+		}();
+		return bits;
+	}
+
+	//**************************************
+	// Times body at level, or skips it if
+	// the CPU doesn't support that level
+	//**************************************
+	template<typename Body>
+	void AtLevel(nids_bench::Result& result, nids::SimdLevel level, Body body) noexcept
+	{
+		if (nids::set_simd_level(level) != level)
+		{
+			result.Counter("unsupported", 1.0);
+			nids::set_simd_level(nids::supported_simd_level());
+			return;
+		}
+		result.Time(NUM_NODES / 64, body);
+		nids::set_simd_level(nids::supported_simd_level());
+	}
+
+	//**************************************
+	// Popcount body, timed per word
+	//**************************************
+	void Count(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		const nids::bit_vector<>& bits = Bits();
+		AtLevel(result, level, [&] { nids_bench::DoNotOptimize(bits.count()); });
+	}
+
+	//**************************************
+	// And body, timed per word
+	//**************************************
+	void And(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		nids::bit_vector<> mask(NUM_NODES, true);
+		AtLevel(result, level, [&]
+		{
+			mask &= Bits();
+			nids_bench::DoNotOptimize(mask.words());
+		});
+	}
+}
+
+NIDS_BENCHMARK(bit_vector, visit_char_vector)
+{
+	nids::vector<char> visited;
+	visited.resize(NUM_NODES, 0);
+	visited.resize_default_init(NUM_NODES);
+	result.Time(NUM_VISITS, [&]
+	{
+		uint64_t state{ 7 };
+		size_t fresh{ 0 };
+		for (size_t visit{ 0 }; visit < NUM_VISITS; ++visit)
+		{
+			char& seen = visited[NextNode(state)];
+			fresh += seen == 0;
+			seen = 1;
+		}
+		nids_bench::DoNotOptimize(fresh);
+	});
+	result.Counter("kb", static_cast<double>(NUM_NODES / 1024));
+}
+
+NIDS_BENCHMARK(bit_vector, visit_bit_vector)
+{
+	nids::bit_vector<> visited(NUM_NODES);
+	result.Time(NUM_VISITS, [&]
+	{
+		uint64_t state{ 7 };
+		size_t fresh{ 0 };
+		for (size_t visit{ 0 }; visit < NUM_VISITS; ++visit)
+			fresh += !visited.test_and_set(NextNode(state));
+		nids_bench::DoNotOptimize(fresh);
+	});
+	result.Counter("kb", static_cast<double>(NUM_NODES / 8 / 1024));
+}
+
+#define NIDS_BIT_BENCHMARKS(kernel) \
+	NIDS_BENCHMARK(bit_vector, kernel##_scalar) { kernel(result, nids::SimdLevel::SIMD_SCALAR); } \
+	NIDS_BENCHMARK(bit_vector, kernel##_sse2) { kernel(result, nids::SimdLevel::SIMD_SSE2); } \
+	NIDS_BENCHMARK(bit_vector, kernel##_avx2) { kernel(result, nids::SimdLevel::SIMD_AVX2); } \
+	NIDS_BENCHMARK(bit_vector, kernel##_avx512) { kernel(result, nids::SimdLevel::SIMD_AVX512); }
+
+NIDS_BIT_BENCHMARKS(Count)
+NIDS_BIT_BENCHMARKS(And)
+
+NIDS_BENCHMARK(bit_vector, rank)
+{
+	nids::rank_select index(Bits());
+	result.Time(NUM_VISITS, [&]
+	{
+		uint64_t state{ 11 };
+		size_t total{ 0 };
+		for (size_t query{ 0 }; query < NUM_VISITS; ++query)
+			total += index.rank(NextNode(state));
+		nids_bench::DoNotOptimize(total);
+	});
+}
+
+NIDS_BENCHMARK(bit_vector, select)
+{
+	nids::rank_select index(Bits());
+	result.Time(NUM_VISITS, [&]
+	{
+		uint64_t state{ 13 };
+		size_t total{ 0 };
+		for (size_t query{ 0 }; query < NUM_VISITS; ++query)
+			total += index.select(NextNode(state) % index.count());
+		nids_bench::DoNotOptimize(total);
+	});
+}
@@ -0,0 +1,83 @@
+//**************************************
+// concurrent_bench.cpp
+//
+// Benchmarks concurrent push_back
+// throughput for concurrent_vector
+// against a nids::vector behind a
+// mutex, from 1 to 64 threads
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../nids/concurrent_vector.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	// total elements appended, split evenly over the threads
+	const size_t NUM_ELEMENTS = 8 * 1024 * 1024;
+
+	//**************************************
+	// Mutex wrapped nids::vector
+	//**************************************
+	class locked_vector final
+	{
+	public:
+		inline size_t push_back(int value) noexcept
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_vector.push_back(value);
+			return m_vector.size() - 1;
+		}
+
+		inline size_t size() const noexcept { return m_vector.size(); }
+	private:
+		std::mutex m_mutex;
+		nids::vector<int> m_vector;
+	};
+
+	//**************************************
+	// Appends NUM_ELEMENTS to a fresh
+	// Vector from Threads threads at once
+	//**************************************
+	template<typename Vector, size_t Threads>
+	void ConcurrentPushBack(nids_bench::Result& result) noexcept
+	{
+		result.Time(NUM_ELEMENTS, []
+		{
+			Vector v;
+			std::vector<std::thread> threads;
+			for (size_t thread{ 0 }; thread < Threads; ++thread)
+				threads.emplace_back([&v]
+				{
+					for (size_t element{ 0 }; element < NUM_ELEMENTS / Threads; ++element)
+						v.push_back(static_cast<int>(element));
+				});
+			for (std::thread& thread : threads)
+				thread.join();
+			nids_bench::DoNotOptimize(v);
+		});
+		result.Counter("threads", static_cast<double>(Threads));
+		result.Counter("hardware_threads", static_cast<double>(std::thread::hardware_concurrency()));
+	}
+}
+
+NIDS_BENCHMARK(concurrent, push_back_locked_1) { ConcurrentPushBack<locked_vector, 1>(result); }
+NIDS_BENCHMARK(concurrent, push_back_locked_2) { ConcurrentPushBack<locked_vector, 2>(result); }
+NIDS_BENCHMARK(concurrent, push_back_locked_4) { ConcurrentPushBack<locked_vector, 4>(result); }
+NIDS_BENCHMARK(concurrent, push_back_locked_8) { ConcurrentPushBack<locked_vector, 8>(result); }
+NIDS_BENCHMARK(concurrent, push_back_locked_16) { ConcurrentPushBack<locked_vector, 16>(result); }
+NIDS_BENCHMARK(concurrent, push_back_locked_32) { ConcurrentPushBack<locked_vector, 32>(result); }
+NIDS_BENCHMARK(concurrent, push_back_locked_64) { ConcurrentPushBack<locked_vector, 64>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_1) { ConcurrentPushBack<nids::concurrent_vector<int>, 1>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_2) { ConcurrentPushBack<nids::concurrent_vector<int>, 2>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_4) { ConcurrentPushBack<nids::concurrent_vector<int>, 4>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_8) { ConcurrentPushBack<nids::concurrent_vector<int>, 8>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_16) { ConcurrentPushBack<nids::concurrent_vector<int>, 16>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_32) { ConcurrentPushBack<nids::concurrent_vector<int>, 32>(result); }
+NIDS_BENCHMARK(concurrent, push_back_concurrent_64) { ConcurrentPushBack<nids::concurrent_vector<int>, 64>(result); }
@@ -0,0 +1,96 @@
+//**************************************
+// cow_bench.cpp
+//
+// Benchmarks handing a large lookup
+// vector to readers: deep copies with
+// nids::vector against shared copies
+// and snapshots with nids::cow_vector,
+// and the cost of the first write
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/cow_vector.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 4 * 1024 * 1024;
+
+	// copies handed out per timed run
+	const size_t NUM_READERS = 64;
+
+	template<typename Vector>
+	Vector MakeTable() noexcept
+	{
+		Vector table;
+		for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+			table.push_back(static_cast<int>(element));
+		return table;
+	}
+}
+
+NIDS_BENCHMARK(cow, copy_vector)
+{
+	nids::vector<int> table = MakeTable<nids::vector<int>>();
+	result.Time(NUM_READERS, [&]
+	{
+		for (size_t reader{ 0 }; reader < NUM_READERS; ++reader)
+		{
+			nids::vector<int> copy(table);
+			nids_bench::DoNotOptimize(copy[0]);
+		}
+	});
+}
+
+NIDS_BENCHMARK(cow, copy_cow_vector)
+{
+	nids::cow_vector<int> table = MakeTable<nids::cow_vector<int>>();
+	result.Time(NUM_READERS, [&]
+	{
+		for (size_t reader{ 0 }; reader < NUM_READERS; ++reader)
+		{
+			nids::cow_vector<int> copy(table);
+			nids_bench::DoNotOptimize(copy.cdata()[0]);
+		}
+	});
+}
+
+NIDS_BENCHMARK(cow, snapshot)
+{
+	nids::cow_vector<int> table = MakeTable<nids::cow_vector<int>>();
+	result.Time(NUM_READERS, [&]
+	{
+		for (size_t reader{ 0 }; reader < NUM_READERS; ++reader)
+		{
+			nids::cow_snapshot<int> view = table.snapshot();
+			nids_bench::DoNotOptimize(view[0]);
+		}
+	});
+}
+
+// the write that clones a shared block pays for the deep copy once
+NIDS_BENCHMARK(cow, first_write_after_snapshot)
+{
+	nids::cow_vector<int> table = MakeTable<nids::cow_vector<int>>();
+	result.Time(1, [&]
+	{
+		nids::cow_snapshot<int> view = table.snapshot();
+		table[0] = 1;
+		nids_bench::DoNotOptimize(view[0]);
+	});
+}
+
+NIDS_BENCHMARK(cow, iterate_snapshot)
+{
+	nids::cow_vector<int> table = MakeTable<nids::cow_vector<int>>();
+	nids::cow_snapshot<int> view = table.snapshot();
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		int sum{ 0 };
+		for (int element : view)
+			sum += element;
+		nids_bench::DoNotOptimize(sum);
+	});
+}
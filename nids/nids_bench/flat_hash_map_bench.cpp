@@ -0,0 +1,146 @@
+//**************************************
+// flat_hash_map_bench.cpp
+//
+// Compares nids::flat_hash_map with
+// std::unordered_map for inserting,
+// looking up keys that are there and
+// keys that are not, and erasing, at a
+// few sizes
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "bench.h"
+#include "../nids/flat_hash_map.h"
+
+namespace
+{
+	// lookups per timed run
+	const size_t NUM_LOOKUPS = 1024 * 1024;
+
+	//**************************************
+	// Pseudo random sequence, the same for
+	// every benchmark
+	//**************************************
+	inline uint64_t Next(uint64_t& state) noexcept
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return state >> 11;
+	}
+
+	//**************************************
+	// Keys helper
+	//
+	// Returns count distinct random keys
+	// with the low bit clear, so keys
+	// with it set are misses
+	//**************************************
+	std::vector<uint64_t> Keys(size_t count) noexcept
+	{
+		std::vector<uint64_t> keys;
+		uint64_t state{ 7 };
+		for (size_t index{ 0 }; index < count; ++index)
+			keys.push_back(Next(state) << 1);
+		std::sort(keys.begin(), keys.end());
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+		for (size_t index = keys.size(); index > 1; --index)
+			std::swap(keys[index - 1], keys[Next(state) % index]);
+		return keys;
+	}
+
+	using FlatMap = nids::flat_hash_map<uint64_t, uint64_t>;
+	using StdMap = std::unordered_map<uint64_t, uint64_t>;
+
+	//**************************************
+	// Insert body
+	//
+	// Builds the map from empty, a key at
+	// a time
+	//**************************************
+	template<typename Map>
+	void Insert(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::vector<uint64_t> keys = Keys(count);
+		result.Time(keys.size(), [&]
+		{
+			Map map;
+			for (uint64_t key : keys)
+				map[key] = key;
+			nids_bench::DoNotOptimize(map.size());
+		});
+	}
+
+	//**************************************
+	// Lookup body
+	//
+	// Looks up NUM_LOOKUPS random keys
+	// that are all there, or all missing
+	//**************************************
+	template<typename Map>
+	void Lookup(nids_bench::Result& result, size_t count, bool hits) noexcept
+	{
+		std::vector<uint64_t> keys = Keys(count);
+		Map map;
+		for (uint64_t key : keys)
+			map[key] = key;
+		result.Time(NUM_LOOKUPS, [&]
+		{
+			uint64_t state{ 11 };
+			size_t found{ 0 };
+			for (size_t lookup{ 0 }; lookup < NUM_LOOKUPS; ++lookup)
+			{
+				uint64_t key = keys[Next(state) % keys.size()] | (hits ? 0 : 1);
+				found += map.find(key) != map.end() ? 1 : 0;
+			}
+			nids_bench::DoNotOptimize(found);
+		});
+	}
+
+	//**************************************
+	// Erase body
+	//
+	// Erases every key of a copy of the
+	// map in random order. Copying is in
+	// the timing too, a memcpy of the
+	// control bytes and the slots for
+	// flat_hash_map but a node at a time
+	// for std::unordered_map
+	//**************************************
+	template<typename Map>
+	void Erase(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::vector<uint64_t> keys = Keys(count);
+		Map base;
+		for (uint64_t key : keys)
+			base[key] = key;
+		std::vector<uint64_t> order = keys;
+		std::reverse(order.begin(), order.end());
+		result.Time(keys.size(), [&]
+		{
+			Map map = base;
+			size_t erased{ 0 };
+			for (uint64_t key : order)
+				erased += map.erase(key);
+			nids_bench::DoNotOptimize(erased);
+		});
+	}
+}
+
+// registers every body at one size
+#define NIDS_FLAT_HASH_MAP_BENCHMARKS(label, count) \
+	NIDS_BENCHMARK(flat_hash_map, insert_flat_hash_map_##label) { Insert<FlatMap>(result, count); } \
+	NIDS_BENCHMARK(flat_hash_map, insert_std_unordered_map_##label) { Insert<StdMap>(result, count); } \
+	NIDS_BENCHMARK(flat_hash_map, lookup_hit_flat_hash_map_##label) { Lookup<FlatMap>(result, count, true); } \
+	NIDS_BENCHMARK(flat_hash_map, lookup_hit_std_unordered_map_##label) { Lookup<StdMap>(result, count, true); } \
+	NIDS_BENCHMARK(flat_hash_map, lookup_miss_flat_hash_map_##label) { Lookup<FlatMap>(result, count, false); } \
+	NIDS_BENCHMARK(flat_hash_map, lookup_miss_std_unordered_map_##label) { Lookup<StdMap>(result, count, false); } \
+	NIDS_BENCHMARK(flat_hash_map, erase_flat_hash_map_##label) { Erase<FlatMap>(result, count); } \
+	NIDS_BENCHMARK(flat_hash_map, erase_std_unordered_map_##label) { Erase<StdMap>(result, count); }
+
+NIDS_FLAT_HASH_MAP_BENCHMARKS(1k, 1024)
+NIDS_FLAT_HASH_MAP_BENCHMARKS(64k, 64 * 1024)
+NIDS_FLAT_HASH_MAP_BENCHMARKS(1m, 1024 * 1024)
@@ -0,0 +1,185 @@
+//**************************************
+// flat_map_bench.cpp
+//
+// Compares nids::flat_set and flat_map
+// with std::set, std::map, and a
+// std::lower_bound over a sorted array
+// for random lookups at a few sizes,
+// and batch inserts against inserting
+// a key at a time
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include "bench.h"
+#include "../nids/flat_map.h"
+
+namespace
+{
+	// lookups per timed run
+	const size_t NUM_LOOKUPS = 1024 * 1024;
+
+	// keys added per timed batch insert
+	const size_t BATCH_SIZE = 64 * 1024;
+
+	// keys added one at a time per timed run, each shifts megabytes
+	const size_t SINGLE_INSERTS = 1024;
+
+	//**************************************
+	// Pseudo random sequence, the same for
+	// every benchmark
+	//**************************************
+	inline uint32_t Next(uint64_t& state) noexcept
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return static_cast<uint32_t>(state >> 33);
+	}
+
+	//**************************************
+	// Keys helper
+	//
+	// Returns count distinct even keys,
+	// shuffled, so odd keys are misses
+	//**************************************
+	std::vector<uint32_t> Keys(size_t count) noexcept
+	{
+		std::vector<uint32_t> keys;
+		for (size_t index{ 0 }; index < count; ++index)
+			keys.push_back(static_cast<uint32_t>(index * 2));
+		uint64_t state{ 7 };
+		for (size_t index = count; index > 1; --index)
+			std::swap(keys[index - 1], keys[Next(state) % index]);
+		return keys;
+	}
+
+	//**************************************
+	// Lookup body
+	//
+	// Looks up NUM_LOOKUPS random keys,
+	// half of them hits
+	//**************************************
+	template<typename Contains>
+	void Lookup(nids_bench::Result& result, size_t count, Contains contains) noexcept
+	{
+		result.Time(NUM_LOOKUPS, [&]
+		{
+			uint64_t state{ 11 };
+			size_t found{ 0 };
+			for (size_t lookup{ 0 }; lookup < NUM_LOOKUPS; ++lookup)
+				found += contains(Next(state) % (2 * count)) ? 1 : 0;
+			nids_bench::DoNotOptimize(found);
+		});
+	}
+
+	void LookupFlatSet(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::vector<uint32_t> keys = Keys(count);
+		nids::flat_set<uint32_t> set(keys.begin(), keys.end());
+		Lookup(result, count, [&set](uint32_t key) { return set.contains(key); });
+	}
+
+	void LookupFlatMap(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::vector<std::pair<uint32_t, uint64_t>> entries;
+		for (uint32_t key : Keys(count))
+			entries.emplace_back(key, key);
+		nids::flat_map<uint32_t, uint64_t> map(entries.begin(), entries.end());
+		Lookup(result, count, [&map](uint32_t key) { return map.get(key) != nullptr; });
+	}
+
+	void LookupStdLowerBound(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::vector<uint32_t> keys = Keys(count);
+		std::sort(keys.begin(), keys.end());
+		Lookup(result, count, [&keys](uint32_t key)
+		{
+			std::vector<uint32_t>::const_iterator found = std::lower_bound(keys.begin(), keys.end(), key);
+			return found != keys.end() && *found == key;
+		});
+	}
+
+	void LookupStdSet(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::vector<uint32_t> keys = Keys(count);
+		std::set<uint32_t> set(keys.begin(), keys.end());
+		Lookup(result, count, [&set](uint32_t key) { return set.find(key) != set.end(); });
+	}
+
+	void LookupStdMap(nids_bench::Result& result, size_t count) noexcept
+	{
+		std::map<uint32_t, uint64_t> map;
+		for (uint32_t key : Keys(count))
+			map.emplace(key, key);
+		Lookup(result, count, [&map](uint32_t key) { return map.find(key) != map.end(); });
+	}
+}
+
+// registers every lookup body at one size
+#define NIDS_FLAT_MAP_BENCHMARKS(label, count) \
+	NIDS_BENCHMARK(flat_map, lookup_flat_set_##label) { LookupFlatSet(result, count); } \
+	NIDS_BENCHMARK(flat_map, lookup_flat_map_##label) { LookupFlatMap(result, count); } \
+	NIDS_BENCHMARK(flat_map, lookup_std_lower_bound_##label) { LookupStdLowerBound(result, count); } \
+	NIDS_BENCHMARK(flat_map, lookup_std_set_##label) { LookupStdSet(result, count); } \
+	NIDS_BENCHMARK(flat_map, lookup_std_map_##label) { LookupStdMap(result, count); }
+
+NIDS_FLAT_MAP_BENCHMARKS(1k, 1024)
+NIDS_FLAT_MAP_BENCHMARKS(64k, 64 * 1024)
+NIDS_FLAT_MAP_BENCHMARKS(1m, 1024 * 1024)
+
+NIDS_BENCHMARK(flat_map, bulk_build_flat_set)
+{
+	std::vector<uint32_t> keys = Keys(1024 * 1024);
+	result.Time(keys.size(), [&]
+	{
+		nids::flat_set<uint32_t> set(keys.begin(), keys.end());
+		nids_bench::DoNotOptimize(set.size());
+	});
+}
+
+NIDS_BENCHMARK(flat_map, bulk_build_std_set)
+{
+	std::vector<uint32_t> keys = Keys(1024 * 1024);
+	result.Time(keys.size(), [&]
+	{
+		std::set<uint32_t> set(keys.begin(), keys.end());
+		nids_bench::DoNotOptimize(set.size());
+	});
+}
+
+NIDS_BENCHMARK(flat_map, batch_insert_flat_set)
+{
+	// a shuffled batch of odd keys merged into a copy of 1M even ones
+	std::vector<uint32_t> keys = Keys(1024 * 1024);
+	const nids::flat_set<uint32_t> base(keys.begin(), keys.end());
+	std::vector<uint32_t> batch(keys.begin(), keys.begin() + BATCH_SIZE);
+	for (uint32_t& key : batch)
+		key += 1;
+	result.Time(BATCH_SIZE, [&]
+	{
+		nids::flat_set<uint32_t> set = base;
+		set.insert(batch.begin(), batch.end());
+		nids_bench::DoNotOptimize(set.size());
+	});
+}
+
+NIDS_BENCHMARK(flat_map, single_insert_flat_set)
+{
+	// the same a key at a time, so every insert shifts half the set
+	std::vector<uint32_t> keys = Keys(1024 * 1024);
+	const nids::flat_set<uint32_t> base(keys.begin(), keys.end());
+	std::vector<uint32_t> batch(keys.begin(), keys.begin() + SINGLE_INSERTS);
+	for (uint32_t& key : batch)
+		key += 1;
+	result.Time(SINGLE_INSERTS, [&]
+	{
+		nids::flat_set<uint32_t> set = base;
+		for (uint32_t key : batch)
+			set.insert(key);
+		nids_bench::DoNotOptimize(set.size());
+	});
+}
@@ -0,0 +1,130 @@
+//**************************************
+// graph_bench.cpp
+//
+// Benchmarks nids::Graph workloads at a
+// few sizes: building it, walking every
+// node's neighbors, looking nodes up by
+// data, and deleting and re-adding nodes
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/graph.h"
+
+namespace
+{
+	// distinct data values, so GetNodes matches one node in DATA_VALUES
+	const int DATA_VALUES = 16;
+
+	//**************************************
+	// Build helper
+	//
+	// Adds count nodes joined in a ring,
+	// plus a chord from every node to the
+	// one a third of the way around, so
+	// each node ends up with 4 neighbors
+	//**************************************
+	void Build(nids::Graph<int>& graph, size_t count) noexcept
+	{
+		for (size_t node{ 0 }; node < count; ++node)
+			graph.AddNode(static_cast<int>(node % DATA_VALUES));
+		for (size_t node{ 0 }; node < count; ++node)
+		{
+			graph.AddNeighbor(node, (node + 1) % count);
+			graph.AddNeighbor(node, (node + count / 3) % count);
+		}
+	}
+
+	//**************************************
+	// Build body
+	//
+	// Also times tearing the graph down.
+	// bytes_allocated is what one build
+	// asked operator new for
+	//**************************************
+	void BuildGraph(nids_bench::Result& result, size_t count) noexcept
+	{
+		size_t allocated{ 0 };
+		result.Time(count, [&]
+		{
+			size_t before = nids_bench::AllocatedBytes();
+			nids::Graph<int> graph;
+			Build(graph, count);
+			nids_bench::DoNotOptimize(graph);
+			allocated = nids_bench::AllocatedBytes() - before;
+		});
+		result.Counter("bytes_allocated", static_cast<double>(allocated));
+	}
+
+	//**************************************
+	// Neighbor walk body
+	//
+	// Timed per neighbor visited
+	//**************************************
+	void WalkNeighbors(nids_bench::Result& result, size_t count) noexcept
+	{
+		nids::Graph<int> graph;
+		Build(graph, count);
+		result.Time(4 * count, [&]
+		{
+			int sum{ 0 };
+			for (size_t node{ 0 }; node < count; ++node)
+			{
+				nids::Node<int>* current = graph.GetNode(node);
+				for (auto neighbor = current->GetNeighborIterator(); neighbor != current->GetNeigborEnd(); ++neighbor)
+					sum += (*neighbor)->GetData();
+			}
+			nids_bench::DoNotOptimize(sum);
+		});
+	}
+
+	//**************************************
+	// Lookup body
+	//
+	// Timed per node scanned
+	//**************************************
+	void FindNodes(nids_bench::Result& result, size_t count) noexcept
+	{
+		nids::Graph<int> graph;
+		Build(graph, count);
+		result.Time(count, [&]
+		{
+			std::vector<nids::node_id> found = graph.GetNodes(DATA_VALUES / 2);
+			nids_bench::DoNotOptimize(found.data());
+		});
+	}
+
+	//**************************************
+	// Churn body
+	//
+	// Deletes every other node and adds
+	// them back through the free list,
+	// timed per node deleted and re-added
+	//**************************************
+	void ChurnNodes(nids_bench::Result& result, size_t count) noexcept
+	{
+		nids::Graph<int> graph;
+		for (size_t node{ 0 }; node < count; ++node)
+			graph.AddNode(static_cast<int>(node % DATA_VALUES));
+		result.Time(count / 2, [&]
+		{
+			for (size_t node{ 0 }; node < count; node += 2)
+				graph.DeleteNode(node);
+			for (size_t node{ 0 }; node < count; node += 2)
+				graph.AddNode(static_cast<int>(node % DATA_VALUES));
+		});
+	}
+}
+
+// registers every workload at one size
+#define NIDS_GRAPH_BENCHMARKS(label, count) \
+	NIDS_BENCHMARK(graph, build_##label) { BuildGraph(result, count); } \
+	NIDS_BENCHMARK(graph, walk_neighbors_##label) { WalkNeighbors(result, count); } \
+	NIDS_BENCHMARK(graph, find_nodes_##label) { FindNodes(result, count); } \
+	NIDS_BENCHMARK(graph, churn_##label) { ChurnNodes(result, count); }
+
+NIDS_GRAPH_BENCHMARKS(1k, 1024)
+NIDS_GRAPH_BENCHMARKS(4k, 4 * 1024)
+NIDS_GRAPH_BENCHMARKS(16k, 16 * 1024)
@@ -0,0 +1,97 @@
+//**************************************
+// growth_bench.cpp
+//
+// Benchmarks push_back throughput and
+// peak memory for each growth policy
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 50000000;
+
+	//**************************************
+	// Shared body for every policy
+	//
+	// Reports the peak RSS of the fill and
+	// the capacity left unused at the end
+	//**************************************
+	template<typename GrowthPolicy>
+	void PushBackWithPolicy(nids_bench::Result& result) noexcept
+	{
+		size_t wasted{ 0 };
+		long peak{ 0 };
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			nids_bench::ResetPeakRss();
+			long before = nids_bench::PeakRssKb();
+
+			nids::vector<int, GrowthPolicy> v;
+			for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+				v.push_back(static_cast<int>(element));
+			nids_bench::DoNotOptimize(v.data());
+
+			peak = nids_bench::PeakRssKb() - before;
+			wasted = (v.capacity() - v.size()) * sizeof(int);
+		});
+		result.Counter("peak_rss_kb", static_cast<double>(peak));
+		result.Counter("wasted_kb", static_cast<double>(wasted / 1024));
+	}
+}
+
+NIDS_BENCHMARK(growth, push_back_1_5x) { PushBackWithPolicy<nids::growth_1_5x>(result); }
+NIDS_BENCHMARK(growth, push_back_golden) { PushBackWithPolicy<nids::growth_golden>(result); }
+NIDS_BENCHMARK(growth, push_back_2x) { PushBackWithPolicy<nids::growth_2x>(result); }
+NIDS_BENCHMARK(growth, push_back_3x) { PushBackWithPolicy<nids::growth_3x>(result); }
+NIDS_BENCHMARK(growth, push_back_paged) { PushBackWithPolicy<nids::growth_paged>(result); }
+NIDS_BENCHMARK(growth, push_back_chunk_64k) { PushBackWithPolicy<nids::fixed_chunk_growth<65536>>(result); }
+
+namespace
+{
+	const size_t NUM_LARGE_ELEMENTS = 64 * 1024 * 1024;
+
+	//**************************************
+	// Times only the push_back calls that
+	// resize, and reports the slowest one
+	// and the last (largest) one
+	//**************************************
+	template<typename Allocator>
+	void ResizeTailLatency(nids_bench::Result& result) noexcept
+	{
+		double worstUs{ 0 };
+		double lastUs{ 0 };
+		result.Time(NUM_LARGE_ELEMENTS, [&]
+		{
+			nids::vector<uint64_t, nids::growth_2x, Allocator> v;
+			double us{ 0 };
+			for (size_t element{ 0 }; element < NUM_LARGE_ELEMENTS; ++element)
+			{
+				if (v.size() != v.capacity())
+				{
+					v.push_back(element);
+					continue;
+				}
+
+				auto start = std::chrono::steady_clock::now();
+				v.push_back(element);
+				auto stop = std::chrono::steady_clock::now();
+				us = std::chrono::duration<double, std::micro>(stop - start).count();
+				if (us > worstUs)
+					worstUs = us;
+			}
+			if (lastUs == 0 || us < lastUs)
+				lastUs = us;
+			nids_bench::DoNotOptimize(v.data());
+		});
+		result.Counter("worst_resize_us", worstUs);
+		result.Counter("last_resize_us", lastUs);
+	}
+}
+
+NIDS_BENCHMARK(growth, resize_latency_malloc) { ResizeTailLatency<nids::malloc_allocator>(result); }
+NIDS_BENCHMARK(growth, resize_latency_mremap) { ResizeTailLatency<nids::mremap_allocator<>>(result); }
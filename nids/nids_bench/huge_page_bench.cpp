@@ -0,0 +1,93 @@
+//**************************************
+// huge_page_bench.cpp
+//
+// Benchmarks sequential and random
+// scans over a large vector backed by
+// malloc, 64 byte aligned blocks, and
+// transparent huge pages
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	// 512 MB of elements, well past what the TLB covers with 4 KB pages
+	const size_t NUM_ELEMENTS = 64 * 1024 * 1024;
+	const size_t NUM_HOPS = 8 * 1024 * 1024;
+
+	//**************************************
+	// Fills v with one random cycle
+	// through every index (Sattolo's
+	// algorithm), so following v[i] visits
+	// the whole vector in random order
+	//**************************************
+	template<typename Vector>
+	void FillCycle(Vector& v) noexcept
+	{
+		v.reserve(NUM_ELEMENTS);
+		for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+			v.push_back(index);
+
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (size_t index{ NUM_ELEMENTS - 1 }; index > 0; --index)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			size_t other = static_cast<size_t>(state % index);
+			uint64_t swap = v[index];
+			v[index] = v[other];
+			v[other] = swap;
+		}
+	}
+
+	//**************************************
+	// Sequential scan body
+	//**************************************
+	template<typename Vector>
+	void SequentialScan(nids_bench::Result& result) noexcept
+	{
+		Vector v;
+		FillCycle(v);
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			uint64_t total{ 0 };
+			for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+				total += v[index];
+			nids_bench::DoNotOptimize(total);
+		});
+		result.Counter("huge_kb", static_cast<double>(nids_bench::AnonHugePagesKb()));
+	}
+
+	//**************************************
+	// Random scan body
+	//
+	// Each load depends on the last one,
+	// so TLB misses can't be overlapped
+	//**************************************
+	template<typename Vector>
+	void RandomScan(nids_bench::Result& result) noexcept
+	{
+		Vector v;
+		FillCycle(v);
+		result.Time(NUM_HOPS, [&]
+		{
+			uint64_t cursor{ 0 };
+			for (size_t hop{ 0 }; hop < NUM_HOPS; ++hop)
+				cursor = v[cursor];
+			nids_bench::DoNotOptimize(cursor);
+		});
+		result.Counter("huge_kb", static_cast<double>(nids_bench::AnonHugePagesKb()));
+	}
+}
+
+NIDS_BENCHMARK(huge_page, sequential_malloc) { SequentialScan<nids::vector<uint64_t>>(result); }
+NIDS_BENCHMARK(huge_page, sequential_aligned_64) { SequentialScan<nids::aligned_vector<uint64_t, 64>>(result); }
+NIDS_BENCHMARK(huge_page, sequential_huge_pages) { SequentialScan<nids::huge_page_vector<uint64_t>>(result); }
+NIDS_BENCHMARK(huge_page, random_malloc) { RandomScan<nids::vector<uint64_t>>(result); }
+NIDS_BENCHMARK(huge_page, random_aligned_64) { RandomScan<nids::aligned_vector<uint64_t, 64>>(result); }
+NIDS_BENCHMARK(huge_page, random_huge_pages) { RandomScan<nids::huge_page_vector<uint64_t>>(result); }
@@ -0,0 +1,103 @@
+//**************************************
+// mapped_bench.cpp
+//
+// Benchmarks loading a table from disk
+// by mapping it with mapped_vector
+// versus reading and copying it into a
+// nids::vector
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+
+#ifdef __linux__
+#include "../nids/mapped_vector.h"
+
+namespace
+{
+	// 256 MB table
+	const size_t NUM_ELEMENTS = 64 * 1024 * 1024;
+	const char* const TABLE_PATH = "/tmp/nids_bench_table.bin";
+
+	//**************************************
+	// Writes the table once per process
+	//**************************************
+	void BuildTable() noexcept
+	{
+		static bool built = false;
+		if (built)
+			return;
+
+		remove(TABLE_PATH);
+		nids::mapped_vector<int> table(TABLE_PATH);
+		table.reserve(NUM_ELEMENTS);
+		for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+			table.push_back(static_cast<int>(index));
+		table.flush();
+		built = true;
+	}
+}
+
+NIDS_BENCHMARK(mapped, open_only)
+{
+	// one op per open, the table isn't touched
+	BuildTable();
+	result.Time(1, []
+	{
+		nids::mapped_vector<int> table(TABLE_PATH);
+		nids_bench::DoNotOptimize(table.size());
+	});
+}
+
+NIDS_BENCHMARK(mapped, open_and_scan)
+{
+	BuildTable();
+	result.Time(NUM_ELEMENTS, []
+	{
+		nids::mapped_vector<int> table(TABLE_PATH);
+		nids_bench::DoNotOptimize(nids::sum(table));
+	});
+}
+
+NIDS_BENCHMARK(mapped, read_and_copy)
+{
+	// what loading the table looked like before mapped_vector
+	BuildTable();
+	result.Time(NUM_ELEMENTS, []
+	{
+		FILE* stream = fopen(TABLE_PATH, "rb");
+		fseek(stream, static_cast<long>(nids::mapped_vector<int>::HEADER_SIZE), SEEK_SET);
+
+		nids::vector<int> table;
+		table.reserve(NUM_ELEMENTS);
+		int chunk[4096];
+		size_t count;
+		while ((count = fread(chunk, sizeof(int), 4096, stream)) > 0)
+			for (size_t index{ 0 }; index < count; ++index)
+				table.push_back(chunk[index]);
+		fclose(stream);
+		nids_bench::DoNotOptimize(nids::sum(table));
+	});
+}
+
+NIDS_BENCHMARK(mapped, read_direct)
+{
+	// one read straight into the vector's storage
+	BuildTable();
+	result.Time(NUM_ELEMENTS, []
+	{
+		FILE* stream = fopen(TABLE_PATH, "rb");
+		fseek(stream, static_cast<long>(nids::mapped_vector<int>::HEADER_SIZE), SEEK_SET);
+
+		nids::vector<int> table;
+		table.resize_uninitialized(NUM_ELEMENTS);
+		size_t count = fread(table.data(), sizeof(int), NUM_ELEMENTS, stream);
+		table.resize_uninitialized(count);
+		fclose(stream);
+		nids_bench::DoNotOptimize(nids::sum(table));
+	});
+	remove(TABLE_PATH);
+}
+#endif
@@ -0,0 +1,168 @@
+//**************************************
+// packed_int_vector_bench.cpp
+//
+// Benchmarks scanning, building, and
+// random access on a sorted ID list
+// held in nids::packed_int_vector
+// against a plain nids::vector
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/packed_int_vector.h"
+
+namespace
+{
+	using PackedIds = nids::packed_int_vector<unsigned long>;
+
+	// IDs in the list, 128 MB as a plain vector
+	const size_t NUM_IDS = 16 * 1024 * 1024;
+
+	// lookups per timed run
+	const size_t NUM_LOOKUPS = 1024 * 1024;
+
+	//**************************************
+	// Pseudo random sequence, the same for
+	// every benchmark
+	//**************************************
+	inline uint64_t Next(uint64_t& state) noexcept
+	{
+		state = state * 6364136223846793005ull + 1442695040888963407ull;
+		return state >> 33;
+	}
+
+	//**************************************
+	// Shared sorted IDs, gaps of 1 to 256
+	//**************************************
+	const nids::vector<unsigned long>& Ids() noexcept
+	{
+		static nids::vector<unsigned long> ids = []
+		{
+			nids::vector<unsigned long> values;
+			uint64_t state{ 1 };
+			unsigned long id{ 1ul << 40 };
+			for (size_t index{ 0 }; index < NUM_IDS; ++index)
+			{
+				id += 1 + Next(state) % 256;
+				values.push_back(id);
+			}
+			return values;
+		}();
+		return ids;
+	}
+
+	//**************************************
+	// Shared packed copy of Ids()
+	//**************************************
+	const PackedIds& Packed() noexcept
+	{
+		static PackedIds packed(Ids().data(), Ids().data() + NUM_IDS);
+		return packed;
+	}
+
+	//**************************************
+	// Size report helper
+	//**************************************
+	inline void ReportKb(nids_bench::Result& result, size_t bytes) noexcept
+	{
+		result.Counter("kb", static_cast<double>(bytes / 1024));
+	}
+
+	//**************************************
+	// Packed scan body
+	//
+	// Sums every ID through the iterator
+	// at level, timed per ID
+	//**************************************
+	void ScanPacked(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		if (nids::set_simd_level(level) != level)
+		{
+			result.Counter("unsupported", 1.0);
+			nids::set_simd_level(nids::supported_simd_level());
+			return;
+		}
+
+		const PackedIds& packed = Packed();
+		result.Time(NUM_IDS, [&]
+		{
+			unsigned long sum{ 0 };
+			for (unsigned long id : packed)
+				sum += id;
+			nids_bench::DoNotOptimize(sum);
+		});
+		ReportKb(result, packed.compressed_bytes());
+		nids::set_simd_level(nids::supported_simd_level());
+	}
+}
+
+NIDS_BENCHMARK(packed_int_vector, scan_vector)
+{
+	const nids::vector<unsigned long>& ids = Ids();
+	result.Time(NUM_IDS, [&]
+	{
+		unsigned long sum{ 0 };
+		for (size_t index{ 0 }; index < NUM_IDS; ++index)
+			sum += ids[index];
+		nids_bench::DoNotOptimize(sum);
+	});
+	ReportKb(result, sizeof(unsigned long) * NUM_IDS);
+}
+
+NIDS_BENCHMARK(packed_int_vector, scan_packed_scalar) { ScanPacked(result, nids::SimdLevel::SIMD_SCALAR); }
+NIDS_BENCHMARK(packed_int_vector, scan_packed_sse2) { ScanPacked(result, nids::SimdLevel::SIMD_SSE2); }
+
+NIDS_BENCHMARK(packed_int_vector, scan_packed_blocks)
+{
+	const PackedIds& packed = Packed();
+	result.Time(NUM_IDS, [&]
+	{
+		unsigned long values[PackedIds::BLOCK_SIZE];
+		unsigned long sum{ 0 };
+		for (size_t block{ 0 }; block < packed.block_count(); ++block)
+		{
+			size_t count = packed.decode_block(block, values);
+			for (size_t index{ 0 }; index < count; ++index)
+				sum += values[index];
+		}
+		nids_bench::DoNotOptimize(sum);
+	});
+}
+
+NIDS_BENCHMARK(packed_int_vector, build_packed)
+{
+	const nids::vector<unsigned long>& ids = Ids();
+	result.Time(NUM_IDS, [&]
+	{
+		PackedIds packed(ids.data(), ids.data() + NUM_IDS);
+		nids_bench::DoNotOptimize(packed.back());
+	});
+}
+
+NIDS_BENCHMARK(packed_int_vector, lookup_vector)
+{
+	const nids::vector<unsigned long>& ids = Ids();
+	result.Time(NUM_LOOKUPS, [&]
+	{
+		uint64_t state{ 3 };
+		unsigned long sum{ 0 };
+		for (size_t lookup{ 0 }; lookup < NUM_LOOKUPS; ++lookup)
+			sum += ids[Next(state) % NUM_IDS];
+		nids_bench::DoNotOptimize(sum);
+	});
+}
+
+NIDS_BENCHMARK(packed_int_vector, lookup_packed)
+{
+	const PackedIds& packed = Packed();
+	result.Time(NUM_LOOKUPS, [&]
+	{
+		uint64_t state{ 3 };
+		unsigned long sum{ 0 };
+		for (size_t lookup{ 0 }; lookup < NUM_LOOKUPS; ++lookup)
+			sum += packed[Next(state) % NUM_IDS];
+		nids_bench::DoNotOptimize(sum);
+	});
+}
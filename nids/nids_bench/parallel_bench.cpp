@@ -0,0 +1,195 @@
+//**************************************
+// parallel_bench.cpp
+//
+// Benchmarks the parallel algorithms
+// on pools of 1 to 16 threads against
+// their sequential std counterparts,
+// giving one scaling curve per
+// algorithm
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <thread>
+#include "../nids/parallel_algorithm.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 16 * 1024 * 1024;
+	const size_t NUM_SORTED = 4 * 1024 * 1024;
+
+	//**************************************
+	// Builds a vector of count random ints
+	//**************************************
+	nids::vector<int> RandomInts(size_t count) noexcept
+	{
+		std::mt19937 random(42);
+		nids::vector<int> v;
+		v.reserve(count);
+		for (size_t index{ 0 }; index < count; ++index)
+			v.push_back(static_cast<int>(random() % 100000));
+		return v;
+	}
+
+	//**************************************
+	// Attaches the thread counts to a
+	// result
+	//**************************************
+	void ThreadCounters(nids_bench::Result& result, size_t threads) noexcept
+	{
+		result.Counter("threads", static_cast<double>(threads));
+		result.Counter("hardware_threads", static_cast<double>(std::thread::hardware_concurrency()));
+	}
+
+	//**************************************
+	// Algorithm bodies, Threads == 0 runs
+	// the std algorithm instead
+	//**************************************
+	template<size_t Threads>
+	void ForEach(nids_bench::Result& result) noexcept
+	{
+		nids::thread_pool pool(Threads);
+		nids::vector<int> v = RandomInts(NUM_ELEMENTS);
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			if constexpr (Threads == 0)
+				std::for_each(v.data(), v.data() + v.size(), [](int& value) { value = value * 3 + 1; });
+			else
+				nids::parallel_for_each(pool, v.begin(), v.end(), [](int& value) { value = value * 3 + 1; });
+			nids_bench::DoNotOptimize(v[0]);
+		});
+		ThreadCounters(result, Threads);
+	}
+
+	template<size_t Threads>
+	void Transform(nids_bench::Result& result) noexcept
+	{
+		nids::thread_pool pool(Threads);
+		nids::vector<int> v = RandomInts(NUM_ELEMENTS);
+		nids::vector<float> out;
+		out.resize_uninitialized(NUM_ELEMENTS);
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			if constexpr (Threads == 0)
+				std::transform(v.data(), v.data() + v.size(), out.data(), [](int value) { return value * 0.5f; });
+			else
+				nids::parallel_transform(pool, v.begin(), v.end(), out.begin(), [](int value) { return value * 0.5f; });
+			nids_bench::DoNotOptimize(out[0]);
+		});
+		ThreadCounters(result, Threads);
+	}
+
+	template<size_t Threads>
+	void Reduce(nids_bench::Result& result) noexcept
+	{
+		nids::thread_pool pool(Threads);
+		nids::vector<int> v = RandomInts(NUM_ELEMENTS);
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			long long total;
+			if constexpr (Threads == 0)
+				total = std::accumulate(v.data(), v.data() + v.size(), 0LL);
+			else
+				total = nids::parallel_reduce(pool, v.begin(), v.end(), 0LL);
+			nids_bench::DoNotOptimize(total);
+		});
+		ThreadCounters(result, Threads);
+	}
+
+	template<size_t Threads>
+	void InclusiveScan(nids_bench::Result& result) noexcept
+	{
+		nids::thread_pool pool(Threads);
+		nids::vector<int> v = RandomInts(NUM_ELEMENTS);
+		nids::vector<int> out;
+		out.resize_uninitialized(NUM_ELEMENTS);
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			if constexpr (Threads == 0)
+				std::partial_sum(v.data(), v.data() + v.size(), out.data());
+			else
+				nids::parallel_inclusive_scan(pool, v.begin(), v.end(), out.begin());
+			nids_bench::DoNotOptimize(out[0]);
+		});
+		ThreadCounters(result, Threads);
+	}
+
+	template<size_t Threads>
+	void CopyIf(nids_bench::Result& result) noexcept
+	{
+		nids::thread_pool pool(Threads);
+		nids::vector<int> v = RandomInts(NUM_ELEMENTS);
+		nids::vector<int> out;
+		out.resize_uninitialized(NUM_ELEMENTS);
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			if constexpr (Threads == 0)
+				std::copy_if(v.data(), v.data() + v.size(), out.data(), [](int value) { return value & 1; });
+			else
+				nids::parallel_copy_if(pool, v.begin(), v.end(), out.begin(), [](int value) { return value & 1; });
+			nids_bench::DoNotOptimize(out[0]);
+		});
+		ThreadCounters(result, Threads);
+	}
+
+	template<size_t Threads>
+	void Sort(nids_bench::Result& result) noexcept
+	{
+		nids::thread_pool pool(Threads);
+		nids::vector<int> source = RandomInts(NUM_SORTED);
+		nids::vector<int> v;
+		v.resize_uninitialized(NUM_SORTED);
+		result.Time(NUM_SORTED, [&]
+		{
+			memcpy(v.data(), source.data(), NUM_SORTED * sizeof(int));
+			if constexpr (Threads == 0)
+				std::sort(v.data(), v.data() + v.size());
+			else
+				nids::parallel_sort(pool, v.begin(), v.end());
+			nids_bench::DoNotOptimize(v[0]);
+		});
+		ThreadCounters(result, Threads);
+	}
+}
+
+NIDS_BENCHMARK(parallel, for_each_std) { ForEach<0>(result); }
+NIDS_BENCHMARK(parallel, for_each_1) { ForEach<1>(result); }
+NIDS_BENCHMARK(parallel, for_each_2) { ForEach<2>(result); }
+NIDS_BENCHMARK(parallel, for_each_4) { ForEach<4>(result); }
+NIDS_BENCHMARK(parallel, for_each_8) { ForEach<8>(result); }
+NIDS_BENCHMARK(parallel, for_each_16) { ForEach<16>(result); }
+NIDS_BENCHMARK(parallel, transform_std) { Transform<0>(result); }
+NIDS_BENCHMARK(parallel, transform_1) { Transform<1>(result); }
+NIDS_BENCHMARK(parallel, transform_2) { Transform<2>(result); }
+NIDS_BENCHMARK(parallel, transform_4) { Transform<4>(result); }
+NIDS_BENCHMARK(parallel, transform_8) { Transform<8>(result); }
+NIDS_BENCHMARK(parallel, transform_16) { Transform<16>(result); }
+NIDS_BENCHMARK(parallel, reduce_std) { Reduce<0>(result); }
+NIDS_BENCHMARK(parallel, reduce_1) { Reduce<1>(result); }
+NIDS_BENCHMARK(parallel, reduce_2) { Reduce<2>(result); }
+NIDS_BENCHMARK(parallel, reduce_4) { Reduce<4>(result); }
+NIDS_BENCHMARK(parallel, reduce_8) { Reduce<8>(result); }
+NIDS_BENCHMARK(parallel, reduce_16) { Reduce<16>(result); }
+NIDS_BENCHMARK(parallel, inclusive_scan_std) { InclusiveScan<0>(result); }
+NIDS_BENCHMARK(parallel, inclusive_scan_1) { InclusiveScan<1>(result); }
+NIDS_BENCHMARK(parallel, inclusive_scan_2) { InclusiveScan<2>(result); }
+NIDS_BENCHMARK(parallel, inclusive_scan_4) { InclusiveScan<4>(result); }
+NIDS_BENCHMARK(parallel, inclusive_scan_8) { InclusiveScan<8>(result); }
+NIDS_BENCHMARK(parallel, inclusive_scan_16) { InclusiveScan<16>(result); }
+NIDS_BENCHMARK(parallel, copy_if_std) { CopyIf<0>(result); }
+NIDS_BENCHMARK(parallel, copy_if_1) { CopyIf<1>(result); }
+NIDS_BENCHMARK(parallel, copy_if_2) { CopyIf<2>(result); }
+NIDS_BENCHMARK(parallel, copy_if_4) { CopyIf<4>(result); }
+NIDS_BENCHMARK(parallel, copy_if_8) { CopyIf<8>(result); }
+NIDS_BENCHMARK(parallel, copy_if_16) { CopyIf<16>(result); }
+NIDS_BENCHMARK(parallel, sort_std) { Sort<0>(result); }
+NIDS_BENCHMARK(parallel, sort_1) { Sort<1>(result); }
+NIDS_BENCHMARK(parallel, sort_2) { Sort<2>(result); }
+NIDS_BENCHMARK(parallel, sort_4) { Sort<4>(result); }
+NIDS_BENCHMARK(parallel, sort_8) { Sort<8>(result); }
+NIDS_BENCHMARK(parallel, sort_16) { Sort<16>(result); }
@@ -0,0 +1,98 @@
+//**************************************
+// relocation_bench.cpp
+//
+// Benchmarks for the trivial (realloc)
+// and non-trivial (move construct)
+// relocation paths of nids::vector
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/vector.h"
+#include <string>
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 10000000;
+	const size_t NUM_STRINGS = 1000000;
+
+	//**************************************
+	// Copy of the push_back path from
+	// before relocation was dispatched on
+	// the element type, kept as a baseline
+	//**************************************
+	struct LegacyIntVector
+	{
+		int* array = nullptr;
+		size_t size = 0;
+		size_t capacity = 0;
+
+		~LegacyIntVector() { free(array); }
+
+		inline void push_back(int data) noexcept
+		{
+			if (size < capacity)
+			{
+				array[size++] = data;
+				return;
+			}
+			if (capacity == 0) ++capacity;
+			capacity = static_cast<size_t>(capacity * 3.0f);
+			array = static_cast<int*>(realloc(array, sizeof(int) * capacity));
+			array[size++] = data;
+		}
+	};
+}
+
+NIDS_BENCHMARK(relocation, push_back_int_legacy)
+{
+	result.Time(NUM_ELEMENTS, []
+	{
+		LegacyIntVector v;
+		for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+			v.push_back(static_cast<int>(element));
+		nids_bench::DoNotOptimize(v.array);
+	});
+}
+
+NIDS_BENCHMARK(relocation, push_back_int)
+{
+	result.Time(NUM_ELEMENTS, []
+	{
+		nids::vector<int> v;
+		for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+			v.push_back(static_cast<int>(element));
+		nids_bench::DoNotOptimize(v.data());
+	});
+}
+
+NIDS_BENCHMARK(relocation, resize_int)
+{
+	size_t resizes{ 0 };
+	for (size_t capacity{ 1 }; capacity < NUM_ELEMENTS; capacity *= 2)
+		++resizes;
+
+	result.Time(resizes, []
+	{
+		nids::vector<int> v(1);
+		for (size_t capacity{ 1 }; capacity < NUM_ELEMENTS; capacity *= 2)
+		{
+			v.push_back(static_cast<int>(capacity));
+			v.resize(capacity * 2);
+		}
+		nids_bench::DoNotOptimize(v.data());
+	});
+}
+
+NIDS_BENCHMARK(relocation, push_back_string)
+{
+	result.Time(NUM_STRINGS, []
+	{
+		nids::vector<std::string> v;
+		for (size_t element{ 0 }; element < NUM_STRINGS; ++element)
+			v.push_back(std::string(24, 'x'));
+		nids_bench::DoNotOptimize(v.data());
+	});
+}
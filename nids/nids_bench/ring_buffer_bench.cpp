@@ -0,0 +1,186 @@
+//**************************************
+// ring_buffer_bench.cpp
+//
+// Compares nids::ring_buffer with
+// std::deque as a FIFO queue, element
+// at a time and in bulk, and hands
+// elements between two threads through
+// spsc_ring_buffer and through a
+// std::deque behind a mutex
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "../nids/ring_buffer.h"
+
+namespace
+{
+	// elements through the queue per timed run
+	const size_t NUM_ELEMENTS = 1024 * 1024;
+
+	// elements queued at once, like a frontier
+	const size_t QUEUE_DEPTH = 1000;
+
+	// elements per bulk push or pop
+	const size_t BATCH_SIZE = 256;
+
+	//**************************************
+	// FIFO body
+	//
+	// Keeps QUEUE_DEPTH elements queued,
+	// popping one for every one pushed
+	//**************************************
+	template<typename Queue>
+	void Fifo(nids_bench::Result& result) noexcept
+	{
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			Queue queue;
+			for (uint64_t index{ 0 }; index < QUEUE_DEPTH; ++index)
+				queue.push_back(index);
+			uint64_t total{ 0 };
+			for (uint64_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+			{
+				total += queue.front();
+				queue.pop_front();
+				queue.push_back(index);
+			}
+			nids_bench::DoNotOptimize(total);
+		});
+	}
+
+	//**************************************
+	// Handoff body
+	//
+	// A producer thread sends
+	// NUM_ELEMENTS numbers to this one,
+	// which sums them. Either side yields
+	// when it can't make progress, so the
+	// numbers stay sane on a single core
+	//**************************************
+	template<typename Push, typename Pop>
+	void Handoff(nids_bench::Result& result, Push push, Pop pop) noexcept
+	{
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			std::thread producer([&]
+			{
+				for (uint64_t next{ 0 }; next < NUM_ELEMENTS;)
+				{
+					size_t pushed = push(next);
+					next += pushed;
+					if (pushed == 0)
+						std::this_thread::yield();
+				}
+			});
+			uint64_t total{ 0 };
+			for (size_t received{ 0 }; received < NUM_ELEMENTS;)
+			{
+				size_t popped = pop(total);
+				received += popped;
+				if (popped == 0)
+					std::this_thread::yield();
+			}
+			producer.join();
+			nids_bench::DoNotOptimize(total);
+		});
+	}
+}
+
+NIDS_BENCHMARK(ring_buffer, fifo_ring_buffer)
+{
+	Fifo<nids::ring_buffer<uint64_t>>(result);
+}
+
+NIDS_BENCHMARK(ring_buffer, fifo_std_deque)
+{
+	Fifo<std::deque<uint64_t>>(result);
+}
+
+NIDS_BENCHMARK(ring_buffer, fifo_bulk_ring_buffer)
+{
+	// the same traffic, BATCH_SIZE elements per call
+	std::vector<uint64_t> batch(BATCH_SIZE);
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		nids::ring_buffer<uint64_t> queue;
+		for (uint64_t index{ 0 }; index < QUEUE_DEPTH; ++index)
+			queue.push_back(index);
+		uint64_t total{ 0 };
+		for (size_t index{ 0 }; index < NUM_ELEMENTS; index += BATCH_SIZE)
+		{
+			queue.pop_front(nids::span<uint64_t>(batch.data(), batch.size()));
+			for (uint64_t value : batch)
+				total += value;
+			queue.push_back(nids::span<const uint64_t>(batch.data(), batch.size()));
+		}
+		nids_bench::DoNotOptimize(total);
+	});
+}
+
+NIDS_BENCHMARK(ring_buffer, handoff_spsc)
+{
+	nids::spsc_ring_buffer<uint64_t> queue(4096);
+	Handoff(result,
+		[&queue](uint64_t next) -> size_t { return queue.try_push(next) ? 1 : 0; },
+		[&queue](uint64_t& total) -> size_t
+		{
+			uint64_t value;
+			if (!queue.try_pop(value))
+				return 0;
+			total += value;
+			return 1;
+		});
+}
+
+NIDS_BENCHMARK(ring_buffer, handoff_spsc_bulk)
+{
+	nids::spsc_ring_buffer<uint64_t> queue(4096);
+	std::vector<uint64_t> input(BATCH_SIZE);
+	std::vector<uint64_t> output(BATCH_SIZE);
+	Handoff(result,
+		[&](uint64_t next) -> size_t
+		{
+			size_t size = NUM_ELEMENTS - next < BATCH_SIZE ? NUM_ELEMENTS - next : BATCH_SIZE;
+			for (size_t index{ 0 }; index < size; ++index)
+				input[index] = next + index;
+			return queue.try_push(nids::span<const uint64_t>(input.data(), size));
+		},
+		[&](uint64_t& total) -> size_t
+		{
+			size_t popped = queue.try_pop(nids::span<uint64_t>(output.data(), output.size()));
+			for (size_t index{ 0 }; index < popped; ++index)
+				total += output[index];
+			return popped;
+		});
+}
+
+NIDS_BENCHMARK(ring_buffer, handoff_mutex_deque)
+{
+	std::mutex lock;
+	std::deque<uint64_t> queue;
+	Handoff(result,
+		[&](uint64_t next) -> size_t
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (queue.size() >= 4096)
+				return 0;
+			queue.push_back(next);
+			return 1;
+		},
+		[&](uint64_t& total) -> size_t
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (queue.empty())
+				return 0;
+			total += queue.front();
+			queue.pop_front();
+			return 1;
+		});
+}
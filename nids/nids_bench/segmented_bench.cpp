@@ -0,0 +1,105 @@
+//**************************************
+// segmented_bench.cpp
+//
+// Benchmarks push_back throughput, the
+// slowest single push_back, and scans
+// for segmented_vector against
+// nids::vector
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/segmented_vector.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 32 * 1024 * 1024;
+
+	//**************************************
+	// Fills a Vector, timing the
+	// push_back calls that have to grow
+	// it (timing all of them only
+	// measures the scheduler)
+	//
+	// Reports the best worst case over
+	// the repeats, and the total time
+	// spent growing
+	//**************************************
+	template<typename Vector>
+	void PushBackLatency(nids_bench::Result& result) noexcept
+	{
+		double bestWorstUs{ 0 };
+		double bestTotalUs{ 0 };
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			double worstUs{ 0 };
+			double totalUs{ 0 };
+			Vector v;
+			for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+			{
+				if (v.size() != v.capacity())
+				{
+					v.push_back(static_cast<int>(element));
+					continue;
+				}
+
+				auto start = std::chrono::steady_clock::now();
+				v.push_back(static_cast<int>(element));
+				auto stop = std::chrono::steady_clock::now();
+				double us = std::chrono::duration<double, std::micro>(stop - start).count();
+				totalUs += us;
+				if (us > worstUs)
+					worstUs = us;
+			}
+			nids_bench::DoNotOptimize(v[0]);
+			if (bestWorstUs == 0 || worstUs < bestWorstUs)
+				bestWorstUs = worstUs;
+			if (bestTotalUs == 0 || totalUs < bestTotalUs)
+				bestTotalUs = totalUs;
+		});
+		result.Counter("worst_grow_us", bestWorstUs);
+		result.Counter("total_grow_us", bestTotalUs);
+	}
+
+	//**************************************
+	// Sums a filled Vector by index
+	//**************************************
+	template<typename Vector>
+	void IndexedScan(nids_bench::Result& result) noexcept
+	{
+		Vector v;
+		for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+			v.push_back(static_cast<int>(element));
+
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			int total{ 0 };
+			for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+				total += v[index];
+			nids_bench::DoNotOptimize(total);
+		});
+	}
+}
+
+NIDS_BENCHMARK(segmented, push_back_latency_vector) { PushBackLatency<nids::vector<int, nids::default_growth, nids::malloc_allocator>>(result); }
+NIDS_BENCHMARK(segmented, push_back_latency_segmented) { PushBackLatency<nids::segmented_vector<int>>(result); }
+NIDS_BENCHMARK(segmented, indexed_scan_vector) { IndexedScan<nids::vector<int>>(result); }
+NIDS_BENCHMARK(segmented, indexed_scan_segmented) { IndexedScan<nids::segmented_vector<int>>(result); }
+
+NIDS_BENCHMARK(segmented, segment_scan_segmented)
+{
+	// one SIMD sum per contiguous segment
+	nids::segmented_vector<int> v;
+	for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+		v.push_back(static_cast<int>(element));
+
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		int total{ 0 };
+		for (size_t segment{ 0 }; segment < v.segment_count(); ++segment)
+			total += nids::sum(v.segment(segment));
+		nids_bench::DoNotOptimize(total);
+	});
+}
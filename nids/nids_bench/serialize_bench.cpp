@@ -0,0 +1,161 @@
+//**************************************
+// serialize_bench.cpp
+//
+// Benchmarks saving and loading a
+// vector with write_vector,
+// read_vector, and serial_view against
+// writing and reading it an element at
+// a time through stdio
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+
+#ifdef __linux__
+#include "../nids/serialize.h"
+
+namespace
+{
+	// 64 MB of elements
+	const size_t NUM_ELEMENTS = 16 * 1024 * 1024;
+	const char* const FLAT_PATH = "/tmp/nids_bench_serial.bin";
+	const char* const STDIO_PATH = "/tmp/nids_bench_serial_stdio.bin";
+
+	//**************************************
+	// Shared elements
+	//**************************************
+	const nids::vector<uint32_t>& Elements() noexcept
+	{
+		static nids::vector<uint32_t> elements = []
+		{
+			nids::vector<uint32_t> values;
+			values.reserve(NUM_ELEMENTS);
+			for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+				values.push_back(static_cast<uint32_t>(index * 2654435761u));
+			return values;
+		}();
+		return elements;
+	}
+
+	//**************************************
+	// Writes both files once per process
+	//**************************************
+	void BuildFiles() noexcept
+	{
+		static bool built = false;
+		if (built)
+			return;
+
+		nids::write_vector(FLAT_PATH, Elements());
+		FILE* stream = fopen(STDIO_PATH, "wb");
+		for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+			fwrite(&Elements()[index], sizeof(uint32_t), 1, stream);
+		fclose(stream);
+		built = true;
+	}
+
+	//**************************************
+	// Throughput report helper
+	//**************************************
+	inline void ReportMbPerSecond(nids_bench::Result& result) noexcept
+	{
+		result.Counter("mb_s", 1000.0 * sizeof(uint32_t) / result.NsPerOp());
+	}
+}
+
+NIDS_BENCHMARK(serialize, write_stdio_loop)
+{
+	const nids::vector<uint32_t>& elements = Elements();
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		FILE* stream = fopen(STDIO_PATH, "wb");
+		for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+			fwrite(&elements[index], sizeof(uint32_t), 1, stream);
+		fclose(stream);
+	});
+	ReportMbPerSecond(result);
+}
+
+NIDS_BENCHMARK(serialize, write_vector)
+{
+	const nids::vector<uint32_t>& elements = Elements();
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		nids_bench::DoNotOptimize(nids::write_vector(FLAT_PATH, elements));
+	});
+	ReportMbPerSecond(result);
+}
+
+NIDS_BENCHMARK(serialize, write_streamed)
+{
+	// 1 MB chunks, fed 4 KB at a time
+	const nids::vector<uint32_t>& elements = Elements();
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		int file = ::open(FLAT_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		nids::serial_writer<uint32_t> writer(file);
+		for (size_t offset{ 0 }; offset < NUM_ELEMENTS; offset += 1024)
+			writer.write(nids::span<const uint32_t>(elements.data() + offset, 1024));
+		nids_bench::DoNotOptimize(writer.finish());
+		::close(file);
+	});
+	ReportMbPerSecond(result);
+	nids::write_vector(FLAT_PATH, elements);
+}
+
+NIDS_BENCHMARK(serialize, read_stdio_loop)
+{
+	BuildFiles();
+	result.Time(NUM_ELEMENTS, []
+	{
+		FILE* stream = fopen(STDIO_PATH, "rb");
+		nids::vector<uint32_t> elements;
+		uint32_t value;
+		while (fread(&value, sizeof(value), 1, stream) == 1)
+			elements.push_back(value);
+		fclose(stream);
+		nids_bench::DoNotOptimize(elements.back());
+	});
+	ReportMbPerSecond(result);
+}
+
+NIDS_BENCHMARK(serialize, read_vector)
+{
+	BuildFiles();
+	result.Time(NUM_ELEMENTS, []
+	{
+		nids::vector<uint32_t> elements;
+		nids::read_vector(FLAT_PATH, elements);
+		nids_bench::DoNotOptimize(elements.back());
+	});
+	ReportMbPerSecond(result);
+}
+
+NIDS_BENCHMARK(serialize, view_and_scan)
+{
+	// open plus one pass over the mapped elements, no checksum
+	BuildFiles();
+	result.Time(NUM_ELEMENTS, []
+	{
+		nids::serial_view<uint32_t> view;
+		view.open(FLAT_PATH);
+		uint32_t sum{ 0 };
+		for (uint32_t value : view)
+			sum += value;
+		nids_bench::DoNotOptimize(sum);
+	});
+	ReportMbPerSecond(result);
+}
+
+NIDS_BENCHMARK(serialize, checksum)
+{
+	const nids::vector<uint32_t>& elements = Elements();
+	result.Time(NUM_ELEMENTS, [&]
+	{
+		nids_bench::DoNotOptimize(nids::checksum64::of(elements.data(), sizeof(uint32_t) * NUM_ELEMENTS));
+	});
+	ReportMbPerSecond(result);
+}
+#endif
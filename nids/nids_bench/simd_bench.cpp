@@ -0,0 +1,108 @@
+//**************************************
+// simd_bench.cpp
+//
+// Benchmarks the nids algorithms at
+// each SIMD level against the scalar
+// fallback
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/algorithm.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 16 * 1024 * 1024;
+
+	//**************************************
+	// Shared input, filled once so every
+	// level scans the same data
+	//**************************************
+	template<typename Type>
+	const nids::vector<Type>& Input() noexcept
+	{
+		static nids::vector<Type> input = []
+		{
+			nids::vector<Type> values;
+			values.reserve(NUM_ELEMENTS);
+			for (size_t index{ 0 }; index < NUM_ELEMENTS; ++index)
+				values.push_back(static_cast<Type>(index % 1000));
+			return values;
+		}();
+		return input;
+	}
+
+	//**************************************
+	// Times body at level, or skips it if
+	// the CPU doesn't support that level
+	//**************************************
+	template<typename Body>
+	void AtLevel(nids_bench::Result& result, nids::SimdLevel level, Body body) noexcept
+	{
+		if (nids::set_simd_level(level) != level)
+		{
+			result.Counter("unsupported", 1.0);
+			nids::set_simd_level(nids::supported_simd_level());
+			return;
+		}
+		result.Time(NUM_ELEMENTS, body);
+		nids::set_simd_level(nids::supported_simd_level());
+	}
+
+	template<typename Type>
+	void Count(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		const nids::vector<Type>& input = Input<Type>();
+		AtLevel(result, level, [&] { nids_bench::DoNotOptimize(nids::count(input, static_cast<Type>(7))); });
+	}
+
+	template<typename Type>
+	void Find(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		// the needle isn't in the input, so the whole range is scanned
+		const nids::vector<Type>& input = Input<Type>();
+		AtLevel(result, level, [&] { nids_bench::DoNotOptimize(nids::find(input, static_cast<Type>(5000))); });
+	}
+
+	template<typename Type>
+	void Sum(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		const nids::vector<Type>& input = Input<Type>();
+		AtLevel(result, level, [&] { nids_bench::DoNotOptimize(nids::sum(input)); });
+	}
+
+	template<typename Type>
+	void Min(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		const nids::vector<Type>& input = Input<Type>();
+		AtLevel(result, level, [&] { nids_bench::DoNotOptimize(nids::min_value(input)); });
+	}
+
+	template<typename Type>
+	void Fill(nids_bench::Result& result, nids::SimdLevel level) noexcept
+	{
+		nids::vector<Type> output = Input<Type>();
+		AtLevel(result, level, [&]
+		{
+			nids::fill(output, static_cast<Type>(3));
+			nids_bench::DoNotOptimize(output.data());
+		});
+	}
+}
+
+#define NIDS_SIMD_BENCHMARKS(kernel, type) \
+	NIDS_BENCHMARK(simd, kernel##_##type##_scalar) { kernel<type>(result, nids::SimdLevel::SIMD_SCALAR); } \
+	NIDS_BENCHMARK(simd, kernel##_##type##_sse2) { kernel<type>(result, nids::SimdLevel::SIMD_SSE2); } \
+	NIDS_BENCHMARK(simd, kernel##_##type##_avx2) { kernel<type>(result, nids::SimdLevel::SIMD_AVX2); } \
+	NIDS_BENCHMARK(simd, kernel##_##type##_avx512) { kernel<type>(result, nids::SimdLevel::SIMD_AVX512); }
+
+NIDS_SIMD_BENCHMARKS(Count, int)
+NIDS_SIMD_BENCHMARKS(Find, int)
+NIDS_SIMD_BENCHMARKS(Sum, int)
+NIDS_SIMD_BENCHMARKS(Sum, float)
+NIDS_SIMD_BENCHMARKS(Min, int)
+NIDS_SIMD_BENCHMARKS(Min, float)
+NIDS_SIMD_BENCHMARKS(Fill, int)
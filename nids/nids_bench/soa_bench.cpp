@@ -0,0 +1,77 @@
+//**************************************
+// soa_bench.cpp
+//
+// Benchmarks scanning one field of a
+// wide record stored as an array of
+// structs (nids::vector) versus a
+// structure of arrays (soa_vector)
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/soa_vector.h"
+
+namespace
+{
+	const size_t NUM_RECORDS = 8 * 1024 * 1024;
+
+	// one cache line per record, the scan only needs weight
+	struct Record
+	{
+		int32_t id;
+		float weight;
+		double position[3];
+		double velocity[3];
+		int64_t flags;
+	};
+
+	using record_soa = nids::soa_vector<int32_t, float, double, double, double, double, double, double, int64_t>;
+}
+
+NIDS_BENCHMARK(soa, sum_field_aos)
+{
+	nids::vector<Record> records;
+	records.reserve(NUM_RECORDS);
+	for (size_t index{ 0 }; index < NUM_RECORDS; ++index)
+		records.push_back(Record{ static_cast<int32_t>(index), 1.0f, {}, {}, 0 });
+
+	result.Time(NUM_RECORDS, [&]
+	{
+		float total{ 0 };
+		for (size_t index{ 0 }; index < NUM_RECORDS; ++index)
+			total += records[index].weight;
+		nids_bench::DoNotOptimize(total);
+	});
+}
+
+NIDS_BENCHMARK(soa, sum_field_soa)
+{
+	record_soa records;
+	records.reserve(NUM_RECORDS);
+	for (size_t index{ 0 }; index < NUM_RECORDS; ++index)
+		records.emplace_back(static_cast<int32_t>(index), 1.0f, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0);
+
+	result.Time(NUM_RECORDS, [&]
+	{
+		nids_bench::DoNotOptimize(nids::sum(records.column<1>()));
+	});
+}
+
+NIDS_BENCHMARK(soa, zip_iterate_soa)
+{
+	// touches two columns through the zip iterator
+	nids::soa_vector<int32_t, float> records;
+	records.reserve(NUM_RECORDS);
+	for (size_t index{ 0 }; index < NUM_RECORDS; ++index)
+		records.emplace_back(static_cast<int32_t>(index), 1.0f);
+
+	result.Time(NUM_RECORDS, [&]
+	{
+		float total{ 0 };
+		for (auto [id, weight] : records)
+			total += weight * static_cast<float>(id & 1);
+		nids_bench::DoNotOptimize(total);
+	});
+}
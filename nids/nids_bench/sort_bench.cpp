@@ -0,0 +1,103 @@
+//**************************************
+// sort_bench.cpp
+//
+// Benchmarks nids::sort (radix and
+// pdqsort) against std::sort on random
+// and patterned data
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include "../nids/sort.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 16 * 1024 * 1024;
+
+	//**************************************
+	// Builds count random values
+	//**************************************
+	template<typename Type>
+	nids::vector<Type> RandomValues(size_t count) noexcept
+	{
+		std::mt19937_64 random(42);
+		nids::vector<Type> v;
+		v.reserve(count);
+		for (size_t index{ 0 }; index < count; ++index)
+		{
+			if constexpr (std::is_floating_point_v<Type>)
+				v.push_back(static_cast<Type>(std::uniform_real_distribution<double>(-1e9, 1e9)(random)));
+			else
+				v.push_back(static_cast<Type>(random()));
+		}
+		return v;
+	}
+
+	//**************************************
+	// Sorts a fresh copy of source on
+	// every repeat, the copy is included
+	// in the time for every contender
+	//**************************************
+	template<typename Type, typename Sorter>
+	void SortCopies(nids_bench::Result& result, const nids::vector<Type>& source, Sorter sorter) noexcept
+	{
+		nids::vector<Type> v;
+		v.resize_uninitialized(source.size());
+		result.Time(source.size(), [&]
+		{
+			memcpy(v.data(), source.data(), source.size() * sizeof(Type));
+			sorter(v.data(), v.data() + v.size());
+			nids_bench::DoNotOptimize(v[0]);
+		});
+	}
+
+	template<typename Type>
+	void StdSort(nids_bench::Result& result) noexcept
+	{
+		SortCopies(result, RandomValues<Type>(NUM_ELEMENTS), [](Type* first, Type* last) { std::sort(first, last); });
+	}
+
+	template<typename Type>
+	void NidsSort(nids_bench::Result& result) noexcept
+	{
+		// scratch kept across repeats, as a caller sorting often would
+		nids::vector<Type> scratch;
+		SortCopies(result, RandomValues<Type>(NUM_ELEMENTS), [&](Type* first, Type* last) { nids::sort(first, last, scratch); });
+	}
+
+	//**************************************
+	// Builds a sorted run with a few
+	// random elements swapped in
+	//**************************************
+	nids::vector<int> NearlySorted(size_t count) noexcept
+	{
+		std::mt19937 random(7);
+		nids::vector<int> v;
+		v.reserve(count);
+		for (size_t index{ 0 }; index < count; ++index)
+			v.push_back(static_cast<int>(index));
+		for (size_t swap{ 0 }; swap < count / 1000; ++swap)
+			std::swap(v[random() % count], v[random() % count]);
+		return v;
+	}
+}
+
+NIDS_BENCHMARK(sort, int32_std) { StdSort<int32_t>(result); }
+NIDS_BENCHMARK(sort, int32_nids) { NidsSort<int32_t>(result); }
+NIDS_BENCHMARK(sort, uint64_std) { StdSort<uint64_t>(result); }
+NIDS_BENCHMARK(sort, uint64_nids) { NidsSort<uint64_t>(result); }
+NIDS_BENCHMARK(sort, float_std) { StdSort<float>(result); }
+NIDS_BENCHMARK(sort, float_nids) { NidsSort<float>(result); }
+NIDS_BENCHMARK(sort, double_std) { StdSort<double>(result); }
+NIDS_BENCHMARK(sort, double_nids) { NidsSort<double>(result); }
+
+// pdqsort, forced with a comparison radix sort can't use or by calling it directly
+NIDS_BENCHMARK(sort, descending_std) { SortCopies(result, RandomValues<int>(NUM_ELEMENTS), [](int* first, int* last) { std::sort(first, last, std::greater<>()); }); }
+NIDS_BENCHMARK(sort, descending_pdq) { SortCopies(result, RandomValues<int>(NUM_ELEMENTS), [](int* first, int* last) { nids::sort(first, last, std::greater<>()); }); }
+NIDS_BENCHMARK(sort, nearly_sorted_std) { SortCopies(result, NearlySorted(NUM_ELEMENTS), [](int* first, int* last) { std::sort(first, last); }); }
+NIDS_BENCHMARK(sort, nearly_sorted_pdq) { SortCopies(result, NearlySorted(NUM_ELEMENTS), [](int* first, int* last) { nids::pdqsort(first, last, std::less<>()); }); }
@@ -0,0 +1,63 @@
+//**************************************
+// stats_bench.cpp
+//
+// Benchmarks the cost of counting
+// vector stats, and uses them to show
+// how much reallocation each growth
+// strategy causes
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "bench.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	const size_t NUM_ELEMENTS = 4 * 1024 * 1024;
+
+	NIDS_STATS_TAG(default_growth_pushes);
+	NIDS_STATS_TAG(doubling_pushes);
+	NIDS_STATS_TAG(chunked_pushes);
+	NIDS_STATS_TAG(reserved_pushes);
+
+	//**************************************
+	// Fills a Vector, reporting its Tag's
+	// stats for one fill
+	//**************************************
+	template<typename Vector, typename Tag>
+	void PushBack(nids_bench::Result& result, bool reserve) noexcept
+	{
+		result.Time(NUM_ELEMENTS, [&]
+		{
+			nids::counting_stats<Tag>::counters().reset();
+			Vector v;
+			if (reserve)
+				v.reserve(NUM_ELEMENTS);
+			for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+				v.push_back(static_cast<int>(element));
+			nids_bench::DoNotOptimize(v[0]);
+		});
+		nids_bench::VectorStatsCounters(result, nids::counting_stats<Tag>::counters());
+	}
+
+	template<typename Tag, typename GrowthPolicy = nids::default_growth>
+	using counted_vector = nids::vector<int, GrowthPolicy, nids::malloc_allocator, nids::counting_stats<Tag>>;
+}
+
+NIDS_BENCHMARK(stats, push_back_no_stats)
+{
+	result.Time(NUM_ELEMENTS, []
+	{
+		nids::vector<int, nids::default_growth, nids::malloc_allocator> v;
+		for (size_t element{ 0 }; element < NUM_ELEMENTS; ++element)
+			v.push_back(static_cast<int>(element));
+		nids_bench::DoNotOptimize(v[0]);
+	});
+}
+
+NIDS_BENCHMARK(stats, push_back_default_growth) { PushBack<counted_vector<default_growth_pushes>, default_growth_pushes>(result, false); }
+NIDS_BENCHMARK(stats, push_back_doubling) { PushBack<counted_vector<doubling_pushes, nids::geometric_growth<2, 1>>, doubling_pushes>(result, false); }
+NIDS_BENCHMARK(stats, push_back_chunked) { PushBack<counted_vector<chunked_pushes, nids::fixed_chunk_growth<65536>>, chunked_pushes>(result, false); }
+NIDS_BENCHMARK(stats, push_back_reserved) { PushBack<counted_vector<reserved_pushes>, reserved_pushes>(result, true); }
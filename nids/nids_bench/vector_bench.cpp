@@ -0,0 +1,202 @@
+//**************************************
+// vector_bench.cpp
+//
+// Compares nids::vector with std::vector
+// for push_back, iteration, copy, move,
+// and resize at a few sizes.
+//
+// bytes_allocated is what one round
+// (one vector of the given size) asked
+// operator new or its allocator for
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include <utility>
+#include <vector>
+#include "bench.h"
+#include "../nids/vector.h"
+
+namespace
+{
+	using NidsVector = nids::vector<int, nids::default_growth, nids_bench::CountingAllocator<>>;
+	using StdVector = std::vector<int>;
+
+	// elements touched per timed run, small sizes repeat until they get here
+	const size_t ELEMENTS_PER_RUN = 16 * 1024 * 1024;
+
+	// moves per timed run
+	const size_t MOVES_PER_RUN = 1024 * 1024;
+
+	//**************************************
+	// Rounds helper
+	//
+	// Returns how many vectors of count
+	// elements make up one timed run
+	//**************************************
+	inline size_t Rounds(size_t count) noexcept { return count < ELEMENTS_PER_RUN ? ELEMENTS_PER_RUN / count : 1; }
+
+	//**************************************
+	// Fill helper
+	//**************************************
+	template<typename Vector>
+	void Fill(Vector& v, size_t count) noexcept
+	{
+		for (size_t element{ 0 }; element < count; ++element)
+			v.push_back(static_cast<int>(element));
+	}
+
+	//**************************************
+	// Grow helpers
+	//
+	// Sets the size to count with every
+	// element zeroed. nids::vector's
+	// resize only sets the capacity, so
+	// it fills the new capacity and then
+	// takes it into the size
+	//**************************************
+	inline void GrowTo(StdVector& v, size_t count) noexcept { v.resize(count); }
+
+	inline void GrowTo(NidsVector& v, size_t count) noexcept
+	{
+		v.resize(count, 0);
+		v.resize_default_init(count);
+	}
+
+	//**************************************
+	// Allocation report helper
+	//**************************************
+	inline void ReportAllocated(nids_bench::Result& result, size_t allocated, size_t rounds) noexcept
+	{
+		result.Counter("bytes_allocated", static_cast<double>(allocated / rounds));
+	}
+
+	//**************************************
+	// Push back body
+	//**************************************
+	template<typename Vector>
+	void PushBack(nids_bench::Result& result, size_t count) noexcept
+	{
+		size_t rounds = Rounds(count);
+		size_t allocated{ 0 };
+		result.Time(rounds * count, [&]
+		{
+			size_t before = nids_bench::AllocatedBytes();
+			for (size_t round{ 0 }; round < rounds; ++round)
+			{
+				Vector v;
+				Fill(v, count);
+				nids_bench::DoNotOptimize(v[0]);
+			}
+			allocated = nids_bench::AllocatedBytes() - before;
+		});
+		ReportAllocated(result, allocated, rounds);
+	}
+
+	//**************************************
+	// Iteration body
+	//**************************************
+	template<typename Vector>
+	void Iterate(nids_bench::Result& result, size_t count) noexcept
+	{
+		size_t rounds = Rounds(count);
+		Vector v;
+		Fill(v, count);
+		result.Time(rounds * count, [&]
+		{
+			for (size_t round{ 0 }; round < rounds; ++round)
+			{
+				int sum{ 0 };
+				for (int element : v)
+					sum += element;
+				nids_bench::DoNotOptimize(sum);
+			}
+		});
+	}
+
+	//**************************************
+	// Copy body
+	//**************************************
+	template<typename Vector>
+	void Copy(nids_bench::Result& result, size_t count) noexcept
+	{
+		size_t rounds = Rounds(count);
+		size_t allocated{ 0 };
+		Vector v;
+		Fill(v, count);
+		result.Time(rounds * count, [&]
+		{
+			size_t before = nids_bench::AllocatedBytes();
+			for (size_t round{ 0 }; round < rounds; ++round)
+			{
+				Vector copy(v);
+				nids_bench::DoNotOptimize(copy[0]);
+			}
+			allocated = nids_bench::AllocatedBytes() - before;
+		});
+		ReportAllocated(result, allocated, rounds);
+	}
+
+	//**************************************
+	// Move body
+	//
+	// Moves the same buffer back and
+	// forth, timed per move
+	//**************************************
+	template<typename Vector>
+	void Move(nids_bench::Result& result, size_t count) noexcept
+	{
+		Vector v;
+		Fill(v, count);
+		result.Time(MOVES_PER_RUN, [&]
+		{
+			for (size_t move{ 0 }; move < MOVES_PER_RUN; move += 2)
+			{
+				Vector moved(std::move(v));
+				nids_bench::DoNotOptimize(moved);
+				v = std::move(moved);
+			}
+			nids_bench::DoNotOptimize(v);
+		});
+	}
+
+	//**************************************
+	// Resize body
+	//**************************************
+	template<typename Vector>
+	void Resize(nids_bench::Result& result, size_t count) noexcept
+	{
+		size_t rounds = Rounds(count);
+		size_t allocated{ 0 };
+		result.Time(rounds * count, [&]
+		{
+			size_t before = nids_bench::AllocatedBytes();
+			for (size_t round{ 0 }; round < rounds; ++round)
+			{
+				Vector v;
+				GrowTo(v, count);
+				nids_bench::DoNotOptimize(v[0]);
+			}
+			allocated = nids_bench::AllocatedBytes() - before;
+		});
+		ReportAllocated(result, allocated, rounds);
+	}
+}
+
+// registers the std and nids versions of every body at one size
+#define NIDS_VECTOR_BENCHMARKS(label, count) \
+	NIDS_BENCHMARK(vector, push_back_std_##label) { PushBack<StdVector>(result, count); } \
+	NIDS_BENCHMARK(vector, push_back_nids_##label) { PushBack<NidsVector>(result, count); } \
+	NIDS_BENCHMARK(vector, iterate_std_##label) { Iterate<StdVector>(result, count); } \
+	NIDS_BENCHMARK(vector, iterate_nids_##label) { Iterate<NidsVector>(result, count); } \
+	NIDS_BENCHMARK(vector, copy_std_##label) { Copy<StdVector>(result, count); } \
+	NIDS_BENCHMARK(vector, copy_nids_##label) { Copy<NidsVector>(result, count); } \
+	NIDS_BENCHMARK(vector, move_std_##label) { Move<StdVector>(result, count); } \
+	NIDS_BENCHMARK(vector, move_nids_##label) { Move<NidsVector>(result, count); } \
+	NIDS_BENCHMARK(vector, resize_std_##label) { Resize<StdVector>(result, count); } \
+	NIDS_BENCHMARK(vector, resize_nids_##label) { Resize<NidsVector>(result, count); }
+
+NIDS_VECTOR_BENCHMARKS(1k, 1024)
+NIDS_VECTOR_BENCHMARKS(64k, 64 * 1024)
+NIDS_VECTOR_BENCHMARKS(16m, 16 * 1024 * 1024)
@@ -0,0 +1,354 @@
+//**************************************
+// algorithm_tests.cpp
+//
+// Holds the unit tests for the SIMD
+// algorithms, run at every level the
+// CPU supports
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+	//**************************************
+	// Runs body once for every SIMD level
+	// the CPU supports, then restores the
+	// detected level
+	//**************************************
+	template<typename Body>
+	void ForEachSimdLevel(Body body)
+	{
+		for (int level{ 0 }; level <= static_cast<int>(nids::supported_simd_level()); ++level)
+		{
+			SCOPED_TRACE(level);
+			nids::set_simd_level(static_cast<nids::SimdLevel>(level));
+			body();
+		}
+		nids::set_simd_level(nids::supported_simd_level());
+	}
+
+	// lengths around every register width, plus a long run
+	const size_t LENGTHS[] = { 0, 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 129, 1000 };
+
+	template<typename Type>
+	std::vector<Type> MakeRange(size_t length)
+	{
+		std::vector<Type> values(length);
+		for (size_t index{ 0 }; index < length; ++index)
+			values[index] = static_cast<Type>((index * 7) % 50);
+		return values;
+	}
+
+	template<typename Type>
+	void CheckFindAndCount()
+	{
+		ForEachSimdLevel([]
+		{
+			for (size_t length : LENGTHS)
+			{
+				std::vector<Type> values = MakeRange<Type>(length);
+				const Type* first = values.data();
+				const Type* last = first + length;
+				for (int needle : { 0, 7, 49, 60 })
+				{
+					Type value = static_cast<Type>(needle);
+					const Type* expected = std::find(first, last, value);
+					EXPECT_EQ(expected, nids::find(first, last, value)) << length;
+					EXPECT_EQ(static_cast<size_t>(std::count(first, last, value)), nids::count(first, last, value)) << length;
+				}
+			}
+		});
+	}
+
+	template<typename Type>
+	void CheckFill()
+	{
+		ForEachSimdLevel([]
+		{
+			for (size_t length : LENGTHS)
+			{
+				// leave a guard element on each side
+				std::vector<Type> values(length + 2, static_cast<Type>(1));
+				nids::fill(values.data() + 1, values.data() + 1 + length, static_cast<Type>(42));
+				EXPECT_EQ(static_cast<Type>(1), values.front());
+				EXPECT_EQ(static_cast<Type>(1), values.back());
+				for (size_t index{ 1 }; index <= length; ++index)
+					EXPECT_EQ(static_cast<Type>(42), values[index]);
+			}
+		});
+	}
+
+	//**************************************
+	// Checks min_value and max_value match
+	// a plain first-wins loop bit for bit
+	// on ranges with NaNs and signed zeros
+	//**************************************
+	template<typename Type>
+	void CheckUnorderedReductions()
+	{
+		const Type nan = std::numeric_limits<Type>::quiet_NaN();
+		auto same = [](Type lhs, Type rhs)
+		{
+			return (std::isnan(lhs) && std::isnan(rhs)) || (lhs == rhs && std::signbit(lhs) == std::signbit(rhs));
+		};
+
+		ForEachSimdLevel([&]
+		{
+			for (size_t length : { 7, 33, 100 })
+				for (int layout{ 0 }; layout < 5; ++layout)
+				{
+					std::vector<Type> values(length, static_cast<Type>(3));
+					if (layout == 0)
+						values[0] = nan;
+					else if (layout == 1)
+						values[length / 2] = nan;
+					else if (layout == 2)
+					{
+						values[1] = static_cast<Type>(0);
+						values[length - 1] = static_cast<Type>(-0.0);
+					}
+					else if (layout == 3)
+					{
+						values[1] = static_cast<Type>(-0.0);
+						values[length - 1] = static_cast<Type>(0);
+						for (Type& value : values)
+							value = -value;
+					}
+					else
+					{
+						values[length - 1] = nan;
+						values[2] = static_cast<Type>(-7);
+					}
+
+					Type lowest = values[0];
+					Type highest = values[0];
+					for (Type value : values)
+					{
+						if (value < lowest)
+							lowest = value;
+						if (highest < value)
+							highest = value;
+					}
+					const Type* first = values.data();
+					EXPECT_TRUE(same(lowest, nids::min_value(first, first + length))) << length << " " << layout;
+					EXPECT_TRUE(same(highest, nids::max_value(first, first + length))) << length << " " << layout;
+				}
+		});
+	}
+
+	template<typename Type>
+	void CheckReductions()
+	{
+		ForEachSimdLevel([]
+		{
+			for (size_t length : LENGTHS)
+			{
+				if (length == 0)
+					continue;
+				std::vector<Type> values = MakeRange<Type>(length);
+				values[length / 2] = static_cast<Type>(-5);
+				values[length - 1] = static_cast<Type>(99);
+				const Type* first = values.data();
+				const Type* last = first + length;
+
+				EXPECT_EQ(*std::min_element(first, last), nids::min_value(first, last)) << length;
+				EXPECT_EQ(*std::max_element(first, last), nids::max_value(first, last)) << length;
+
+				Type expected{};
+				for (Type value : values)
+					expected += value;
+				EXPECT_EQ(expected, nids::sum(first, last)) << length;
+			}
+		});
+	}
+}
+
+//**************************************
+// Find / count tests
+//**************************************
+TEST(AlgorithmFind, Int8) { CheckFindAndCount<int8_t>(); }
+TEST(AlgorithmFind, Int16) { CheckFindAndCount<int16_t>(); }
+TEST(AlgorithmFind, Int32) { CheckFindAndCount<int32_t>(); }
+TEST(AlgorithmFind, Int64) { CheckFindAndCount<int64_t>(); }
+TEST(AlgorithmFind, Float) { CheckFindAndCount<float>(); }
+TEST(AlgorithmFind, Double) { CheckFindAndCount<double>(); }
+
+TEST(AlgorithmFind, FindsFirstOfSeveral)
+{
+	ForEachSimdLevel([]
+	{
+		std::vector<int> values(100, 0);
+		values[40] = 5;
+		values[41] = 5;
+		values[90] = 5;
+		EXPECT_EQ(values.data() + 40, nids::find(values.data(), values.data() + 100, 5));
+	});
+}
+
+TEST(AlgorithmFind, FloatZeroAndNaN)
+{
+	ForEachSimdLevel([]
+	{
+		std::vector<float> values(40, 1.0f);
+		values[20] = -0.0f;
+		values[30] = std::nanf("");
+		EXPECT_EQ(values.data() + 20, nids::find(values.data(), values.data() + 40, 0.0f));
+		EXPECT_EQ(values.data() + 40, nids::find(values.data(), values.data() + 40, std::nanf("")));
+	});
+}
+
+//**************************************
+// Fill tests
+//**************************************
+TEST(AlgorithmFill, Int8) { CheckFill<int8_t>(); }
+TEST(AlgorithmFill, Int16) { CheckFill<int16_t>(); }
+TEST(AlgorithmFill, Int32) { CheckFill<int32_t>(); }
+TEST(AlgorithmFill, Int64) { CheckFill<int64_t>(); }
+TEST(AlgorithmFill, Float) { CheckFill<float>(); }
+TEST(AlgorithmFill, Double) { CheckFill<double>(); }
+
+TEST(AlgorithmFill, ResizeFillsNewCapacity)
+{
+	ForEachSimdLevel([]
+	{
+		nids::vector<int> v;
+		v.resize(3, 1);
+		v.resize(100, 7);
+		EXPECT_EQ(100, v.capacity());
+		for (size_t index{ 0 }; index < 3; ++index)
+			EXPECT_EQ(1, v.data()[index]);
+		for (size_t index{ 3 }; index < 100; ++index)
+			EXPECT_EQ(7, v.data()[index]);
+	});
+}
+
+TEST(AlgorithmFill, ResizeShrinkKeepsData)
+{
+	nids::vector<int> v;
+	v.resize(50, 3);
+	v.resize(10, 9);
+	EXPECT_EQ(10, v.capacity());
+	for (size_t index{ 0 }; index < 10; ++index)
+		EXPECT_EQ(3, v.data()[index]);
+}
+
+//**************************************
+// Equality tests
+//**************************************
+TEST(AlgorithmEqual, DetectsEveryPosition)
+{
+	ForEachSimdLevel([]
+	{
+		for (size_t length : LENGTHS)
+		{
+			std::vector<int16_t> lhs = MakeRange<int16_t>(length);
+			std::vector<int16_t> rhs = lhs;
+			EXPECT_TRUE(nids::equal(lhs.data(), lhs.data() + length, rhs.data()));
+			for (size_t index{ 0 }; index < length; ++index)
+			{
+				rhs[index] = static_cast<int16_t>(rhs[index] + 1);
+				EXPECT_FALSE(nids::equal(lhs.data(), lhs.data() + length, rhs.data())) << length << " " << index;
+				rhs[index] = lhs[index];
+			}
+		}
+	});
+}
+
+TEST(AlgorithmEqual, Containers)
+{
+	nids::vector<int> lhs;
+	nids::vector<int> rhs;
+	for (int index{ 0 }; index < 20; ++index)
+	{
+		lhs.push_back(index);
+		rhs.push_back(index);
+	}
+	EXPECT_TRUE(nids::equal(lhs, rhs));
+	rhs.push_back(20);
+	EXPECT_FALSE(nids::equal(lhs, rhs));
+}
+
+//**************************************
+// Reduction tests
+//**************************************
+TEST(AlgorithmReduce, Int32) { CheckReductions<int32_t>(); }
+TEST(AlgorithmReduce, Float) { CheckReductions<float>(); }
+TEST(AlgorithmReduce, Double) { CheckReductions<double>(); }
+TEST(AlgorithmReduce, Int64Scalar) { CheckReductions<int64_t>(); }
+TEST(AlgorithmReduce, FloatNaNAndSignedZero) { CheckUnorderedReductions<float>(); }
+TEST(AlgorithmReduce, DoubleNaNAndSignedZero) { CheckUnorderedReductions<double>(); }
+
+//**************************************
+// Bit word tests
+//**************************************
+TEST(AlgorithmBits, PopcountMatchesScalar)
+{
+	ForEachSimdLevel([]
+	{
+		for (size_t length : LENGTHS)
+		{
+			std::vector<uint64_t> words(length);
+			size_t expected{ 0 };
+			for (size_t word{ 0 }; word < length; ++word)
+			{
+				words[word] = 0x9E3779B97F4A7C15ull * (word + 1);
+				expected += nids::population_count(words[word]);
+			}
+			EXPECT_EQ(expected, nids::popcount(words.data(), length));
+		}
+	});
+}
+
+TEST(AlgorithmBits, CombineMatchesScalar)
+{
+	ForEachSimdLevel([]
+	{
+		for (size_t length : LENGTHS)
+		{
+			std::vector<uint64_t> lhs(length);
+			std::vector<uint64_t> rhs(length);
+			for (size_t word{ 0 }; word < length; ++word)
+			{
+				lhs[word] = 0x9E3779B97F4A7C15ull * (word + 1);
+				rhs[word] = 0xC2B2AE3D27D4EB4Full * (word + 7);
+			}
+
+			std::vector<uint64_t> anded = lhs;
+			std::vector<uint64_t> ored = lhs;
+			std::vector<uint64_t> xored = lhs;
+			nids::bitwise_and(anded.data(), rhs.data(), length);
+			nids::bitwise_or(ored.data(), rhs.data(), length);
+			nids::bitwise_xor(xored.data(), rhs.data(), length);
+			for (size_t word{ 0 }; word < length; ++word)
+			{
+				EXPECT_EQ(lhs[word] & rhs[word], anded[word]);
+				EXPECT_EQ(lhs[word] | rhs[word], ored[word]);
+				EXPECT_EQ(lhs[word] ^ rhs[word], xored[word]);
+			}
+		}
+	});
+}
+
+//**************************************
+// Container overload tests
+//**************************************
+TEST(AlgorithmContainer, SmallVector)
+{
+	nids::small_vector<int, 8> v;
+	for (int index{ 0 }; index < 30; ++index)
+		v.push_back(index % 10);
+	EXPECT_EQ(3, nids::find(v, 3));
+	EXPECT_EQ(v.size(), nids::find(v, 42));
+	EXPECT_EQ(3, nids::count(v, 4));
+	EXPECT_EQ(135, nids::sum(v));
+	EXPECT_EQ(0, nids::min_value(v));
+	EXPECT_EQ(9, nids::max_value(v));
+	nids::fill(v, 2);
+	EXPECT_EQ(30, nids::count(v, 2));
+}
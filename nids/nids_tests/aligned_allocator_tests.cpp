@@ -0,0 +1,146 @@
+//**************************************
+// aligned_allocator_tests.cpp
+//
+// Holds the unit tests for the aligned
+// and huge page allocators, and for
+// vectors that use them
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <string>
+
+namespace
+{
+	bool IsAligned(const void* block, size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(block) % alignment == 0;
+	}
+}
+
+//**************************************
+// Aligned allocator tests
+//**************************************
+TEST(AlignedAllocator, AllocationsAreAligned)
+{
+	nids::aligned_allocator<128> allocator;
+	for (size_t bytes{ 1 }; bytes < 5000; bytes += 333)
+	{
+		void* block = allocator.allocate(bytes);
+		ASSERT_NE(nullptr, block);
+		EXPECT_TRUE(IsAligned(block, 128));
+		allocator.deallocate(block, bytes);
+	}
+}
+
+TEST(AlignedAllocator, ReallocateKeepsAlignmentAndData)
+{
+	nids::aligned_allocator<64> allocator;
+	size_t bytes{ 16 };
+	unsigned char* block = static_cast<unsigned char*>(allocator.allocate(bytes));
+	for (size_t index{ 0 }; index < bytes; ++index)
+		block[index] = static_cast<unsigned char>(index);
+
+	for (size_t newBytes : { 100, 4096, 100000, 50 })
+	{
+		block = static_cast<unsigned char*>(allocator.reallocate(block, bytes, newBytes));
+		ASSERT_NE(nullptr, block);
+		EXPECT_TRUE(IsAligned(block, 64));
+		for (size_t index{ 0 }; index < 16; ++index)
+			EXPECT_EQ(index, block[index]);
+		bytes = newBytes;
+	}
+	allocator.deallocate(block, bytes);
+}
+
+TEST(AlignedVector, StaysAlignedWhileGrowing)
+{
+	nids::aligned_vector<int, 64> v;
+	for (int index{ 0 }; index < 10000; ++index)
+	{
+		v.push_back(index);
+		ASSERT_TRUE(IsAligned(v.data(), 64));
+	}
+	for (int index{ 0 }; index < 10000; ++index)
+		EXPECT_EQ(index, v[index]);
+	EXPECT_EQ(sizeof(nids::vector<int>), sizeof(v));
+}
+
+TEST(AlignedVector, NonTrivialElements)
+{
+	nids::aligned_vector<std::string, 256> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(std::to_string(index));
+	EXPECT_TRUE(IsAligned(v.data(), 256));
+	for (int index{ 0 }; index < 100; ++index)
+		EXPECT_EQ(std::to_string(index), v[index]);
+}
+
+//**************************************
+// Huge page allocator tests
+//**************************************
+TEST(HugePageAllocator, SmallBlocksAreAligned)
+{
+	nids::huge_page_allocator<64> allocator;
+	void* block = allocator.allocate(100);
+	ASSERT_NE(nullptr, block);
+	EXPECT_TRUE(IsAligned(block, 64));
+	allocator.deallocate(block, 100);
+}
+
+#ifdef __linux__
+TEST(HugePageAllocator, LargeBlocksStartOnHugePage)
+{
+	nids::huge_page_allocator<64> allocator;
+	size_t bytes = 3 * nids::HUGE_PAGE_SIZE + 5;
+	void* block = allocator.allocate(bytes);
+	ASSERT_NE(nullptr, block);
+	EXPECT_TRUE(IsAligned(block, nids::HUGE_PAGE_SIZE));
+	memset(block, 1, bytes);
+	allocator.deallocate(block, bytes);
+}
+
+TEST(HugePageAllocator, ExpandsWithinLastHugePage)
+{
+	nids::huge_page_allocator<64> allocator;
+	size_t bytes = nids::HUGE_PAGE_SIZE + 10;
+	void* block = allocator.allocate(bytes);
+	ASSERT_NE(nullptr, block);
+	EXPECT_TRUE(allocator.expand(block, bytes, 2 * nids::HUGE_PAGE_SIZE));
+	memset(block, 1, 2 * nids::HUGE_PAGE_SIZE);
+	allocator.deallocate(block, 2 * nids::HUGE_PAGE_SIZE);
+}
+#endif
+
+TEST(HugePageVector, CrossesThreshold)
+{
+	nids::huge_page_vector<uint64_t> v;
+	const size_t count = 2 * nids::HUGE_PAGE_SIZE / sizeof(uint64_t) + 17;
+	for (size_t index{ 0 }; index < count; ++index)
+		v.push_back(index);
+	EXPECT_TRUE(IsAligned(v.data(), 64));
+	for (size_t index{ 0 }; index < count; ++index)
+		ASSERT_EQ(index, v[index]);
+
+	// back under the threshold
+	v.resize(10);
+	EXPECT_TRUE(IsAligned(v.data(), 64));
+	for (size_t index{ 0 }; index < 10; ++index)
+		EXPECT_EQ(index, v[index]);
+}
+
+TEST(HugePageVector, CopyAndMove)
+{
+	nids::huge_page_vector<uint32_t> v;
+	const size_t count = nids::HUGE_PAGE_SIZE / sizeof(uint32_t) + 1;
+	for (size_t index{ 0 }; index < count; ++index)
+		v.push_back(static_cast<uint32_t>(index));
+
+	nids::huge_page_vector<uint32_t> copy(v);
+	nids::huge_page_vector<uint32_t> moved(std::move(v));
+	ASSERT_EQ(count, copy.size());
+	ASSERT_EQ(count, moved.size());
+	EXPECT_TRUE(nids::equal(copy, moved));
+}
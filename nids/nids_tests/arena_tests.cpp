@@ -0,0 +1,146 @@
+//**************************************
+// arena_tests.cpp
+//
+// Holds the unit tests for the arena
+// and for vectors that allocate from it
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <string>
+
+// shorthand for a vector that lives in an arena
+template<typename Type>
+using arena_vector = nids::vector<Type, nids::default_growth, nids::arena_allocator>;
+
+//**************************************
+// Arena tests
+//**************************************
+TEST(Arena, AllocationsAreAligned)
+{
+	nids::arena a;
+	for (size_t bytes{ 1 }; bytes < 100; bytes += 7)
+	{
+		void* block = a.allocate(bytes);
+		ASSERT_NE(nullptr, block);
+		EXPECT_EQ(0, reinterpret_cast<uintptr_t>(block) % nids::arena::ALIGNMENT);
+	}
+}
+
+TEST(Arena, AllocationsDoNotOverlap)
+{
+	nids::arena a(256);
+	char* first = static_cast<char*>(a.allocate(100));
+	char* second = static_cast<char*>(a.allocate(100));
+	char* third = static_cast<char*>(a.allocate(100));
+	memset(first, 1, 100);
+	memset(second, 2, 100);
+	memset(third, 3, 100);
+	EXPECT_EQ(1, first[99]);
+	EXPECT_EQ(2, second[99]);
+	EXPECT_EQ(3, third[0]);
+}
+
+TEST(Arena, OversizedAllocation)
+{
+	nids::arena a(64);
+	char* block = static_cast<char*>(a.allocate(4096));
+	ASSERT_NE(nullptr, block);
+	memset(block, 0, 4096);
+}
+
+TEST(Arena, ExpandNewestAllocation)
+{
+	nids::arena a(1024);
+	void* older = a.allocate(32);
+	void* newest = a.allocate(32);
+	EXPECT_TRUE(a.expand(newest, 32, 512));
+	EXPECT_FALSE(a.expand(older, 32, 64));
+	EXPECT_FALSE(a.expand(newest, 512, 4096));
+}
+
+TEST(Arena, DeallocateNewestReclaims)
+{
+	nids::arena a;
+	a.allocate(64);
+	size_t used = a.bytes_used();
+	void* block = a.allocate(64);
+	a.deallocate(block, 64);
+	EXPECT_EQ(used, a.bytes_used());
+}
+
+TEST(Arena, ResetReclaimsEverything)
+{
+	nids::arena a(128);
+	for (int index{ 0 }; index < 20; ++index)
+		a.allocate(100);
+	a.reset();
+	EXPECT_EQ(0, a.bytes_used());
+	EXPECT_NE(nullptr, a.allocate(100));
+}
+
+//**************************************
+// Arena backed vector tests
+//**************************************
+TEST(ArenaVector, PushBackGrowsInPlace)
+{
+	nids::arena a;
+	arena_vector<int> v{ nids::arena_allocator(a) };
+	v.push_back(0);
+	const int* first = v.data();
+	for (int index{ 1 }; index < 100; ++index)
+		v.push_back(index);
+
+	// nothing else allocated from the arena, so the block never moved
+	EXPECT_EQ(first, v.data());
+	for (int index{ 0 }; index < 100; ++index)
+		EXPECT_EQ(index, v[index]);
+}
+
+TEST(ArenaVector, InterleavedVectors)
+{
+	nids::arena a;
+	arena_vector<int> v{ nids::arena_allocator(a) };
+	arena_vector<int> w{ nids::arena_allocator(a) };
+	for (int index{ 0 }; index < 1000; ++index)
+	{
+		v.push_back(index);
+		w.push_back(-index);
+	}
+	for (int index{ 0 }; index < 1000; ++index)
+	{
+		EXPECT_EQ(index, v[index]);
+		EXPECT_EQ(-index, w[index]);
+	}
+}
+
+TEST(ArenaVector, NonTrivialElements)
+{
+	nids::arena a;
+	arena_vector<std::string> v{ nids::arena_allocator(a) };
+	arena_vector<int> w{ nids::arena_allocator(a) };
+	for (int index{ 0 }; index < 50; ++index)
+	{
+		v.push_back(std::string(40, static_cast<char>('a' + index % 26)));
+		w.push_back(index);
+	}
+	for (int index{ 0 }; index < 50; ++index)
+		EXPECT_EQ(std::string(40, static_cast<char>('a' + index % 26)), v[index]);
+}
+
+TEST(ArenaVector, CopySharesArena)
+{
+	nids::arena a;
+	arena_vector<int> v{ nids::arena_allocator(a) };
+	v.push_back(5);
+	arena_vector<int> w{ v };
+	EXPECT_TRUE(v.get_allocator() == w.get_allocator());
+	EXPECT_EQ(5, w[0]);
+}
+
+TEST(ArenaVector, StatelessAllocatorTakesNoSpace)
+{
+	EXPECT_EQ(sizeof(void*) + 2 * sizeof(size_t), sizeof(nids::vector<int>));
+}
@@ -0,0 +1,154 @@
+//**************************************
+// bit_vector_tests.cpp
+//
+// Holds the unit tests for the
+// bit_vector and rank_select classes
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <vector>
+
+//**************************************
+// Bit access tests
+//**************************************
+TEST(BitVectorAccess, PushBackPacksWords)
+{
+	nids::bit_vector<> bits;
+	for (int index{ 0 }; index < 130; ++index)
+		bits.push_back(index % 3 == 0);
+	EXPECT_EQ(130, bits.size());
+	EXPECT_EQ(3, bits.word_count());
+	for (int index{ 0 }; index < 130; ++index)
+		EXPECT_EQ(index % 3 == 0, bits[index]);
+	EXPECT_EQ(44, bits.count());
+}
+
+TEST(BitVectorAccess, SetResetFlip)
+{
+	nids::bit_vector<> bits(100);
+	EXPECT_FALSE(bits.any());
+	bits.set(3);
+	bits.set(64, true);
+	bits.flip(99);
+	bits.flip(3);
+	EXPECT_FALSE(bits.test(3));
+	EXPECT_TRUE(bits.test(64));
+	EXPECT_TRUE(bits.test(99));
+	bits.reset(64);
+	EXPECT_EQ(1, bits.count());
+	EXPECT_FALSE(bits.test_and_set(10));
+	EXPECT_TRUE(bits.test_and_set(10));
+}
+
+TEST(BitVectorAccess, SetAllKeepsTailClear)
+{
+	nids::bit_vector<> bits(70, true);
+	EXPECT_EQ(70, bits.count());
+	EXPECT_EQ(0x3Full, bits.words()[1]);
+	bits.reset_all();
+	EXPECT_EQ(0, bits.count());
+	bits.set_all();
+	EXPECT_EQ(70, bits.count());
+}
+
+TEST(BitVectorAccess, PopBackDropsEmptyWords)
+{
+	nids::bit_vector<> bits(65, true);
+	bits.pop_back();
+	EXPECT_EQ(64, bits.size());
+	EXPECT_EQ(1, bits.word_count());
+	EXPECT_EQ(64, bits.count());
+	bits.push_back(false);
+	EXPECT_FALSE(bits.test(64));
+	bits.clear();
+	EXPECT_TRUE(bits.empty());
+}
+
+TEST(BitVectorAccess, BulkOperators)
+{
+	const size_t BITS = 1000;
+	nids::bit_vector<> evens(BITS);
+	nids::bit_vector<> threes(BITS);
+	for (size_t index{ 0 }; index < BITS; index += 2)
+		evens.set(index);
+	for (size_t index{ 0 }; index < BITS; index += 3)
+		threes.set(index);
+
+	nids::bit_vector<> both = evens;
+	both &= threes;
+	nids::bit_vector<> either = evens;
+	either |= threes;
+	nids::bit_vector<> one = evens;
+	one ^= threes;
+	for (size_t index{ 0 }; index < BITS; ++index)
+	{
+		EXPECT_EQ(index % 6 == 0, both[index]);
+		EXPECT_EQ(index % 2 == 0 || index % 3 == 0, either[index]);
+		EXPECT_EQ((index % 2 == 0) != (index % 3 == 0), one[index]);
+	}
+}
+
+TEST(BitVectorAccess, EmptyCopiesAndMoves)
+{
+	nids::bit_vector<> empty;
+	nids::bit_vector<> copy = empty;
+	EXPECT_EQ(0, copy.size());
+	nids::bit_vector<> moved(std::move(copy));
+	EXPECT_EQ(0, moved.word_count());
+
+	moved.push_back(true);
+	nids::bit_vector<> kept = moved;
+	moved = empty;
+	EXPECT_EQ(0, moved.size());
+	ASSERT_EQ(1, kept.size());
+	EXPECT_TRUE(kept[0]);
+}
+
+//**************************************
+// Rank / select tests
+//**************************************
+TEST(BitVectorRankSelect, MatchesNaiveCounts)
+{
+	// dense and sparse stretches, past several samples and blocks
+	nids::bit_vector<> bits;
+	for (size_t index{ 0 }; index < 100000; ++index)
+		bits.push_back(index < 40000 ? index % 3 != 0 : index % 97 == 0);
+
+	nids::rank_select index(bits);
+	std::vector<size_t> positions;
+	size_t ones{ 0 };
+	for (size_t bit{ 0 }; bit < bits.size(); ++bit)
+	{
+		EXPECT_EQ(ones, index.rank(bit));
+		if (bits[bit])
+		{
+			positions.push_back(bit);
+			++ones;
+		}
+	}
+	EXPECT_EQ(ones, index.rank(bits.size()));
+	EXPECT_EQ(ones, index.count());
+	for (size_t which{ 0 }; which < positions.size(); ++which)
+		ASSERT_EQ(positions[which], index.select(which));
+}
+
+TEST(BitVectorRankSelect, WordAlignedSize)
+{
+	nids::bit_vector<> bits(1024, true);
+	nids::rank_select index(bits);
+	EXPECT_EQ(1024, index.rank(1024));
+	EXPECT_EQ(512, index.rank(512));
+	EXPECT_EQ(1023, index.select(1023));
+}
+
+TEST(BitVectorRankSelect, NoSetBits)
+{
+	// no set bits means no select samples
+	nids::bit_vector<> bits(300, false);
+	nids::rank_select index(bits);
+	EXPECT_EQ(0, index.count());
+	EXPECT_EQ(0, index.rank(300));
+}
@@ -0,0 +1,156 @@
+//**************************************
+// concurrent_vector_tests.cpp
+//
+// Holds the unit tests for the
+// concurrent_vector class
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// small first segment so the tests cross plenty of them
+template<typename Type>
+using small_concurrent_vector = nids::concurrent_vector<Type, 8>;
+
+namespace
+{
+	const int NUM_THREADS = 8;
+	const int PER_THREAD = 20000;
+}
+
+//**************************************
+// Single threaded tests
+//**************************************
+TEST(ConcurrentVectorPush, IndexesAcrossSegments)
+{
+	small_concurrent_vector<int> v;
+	EXPECT_TRUE(v.empty());
+	for (int index{ 0 }; index < 1000; ++index)
+		EXPECT_EQ(static_cast<size_t>(index), v.push_back(index));
+	ASSERT_EQ(1000, v.size());
+	EXPECT_EQ(1000, v.reserved_size());
+	for (int index{ 0 }; index < 1000; ++index)
+		EXPECT_EQ(index, v[index]);
+	EXPECT_TRUE(v.is_published(999));
+	EXPECT_FALSE(v.is_published(1000));
+}
+
+TEST(ConcurrentVectorPush, ReferencesStayValid)
+{
+	small_concurrent_vector<std::string> v;
+	v.push_back("first");
+	std::string* first = &v[0];
+	for (int index{ 0 }; index < 500; ++index)
+		v.emplace_back(3, 'x');
+	EXPECT_EQ(first, &v[0]);
+	EXPECT_EQ("first", v[0]);
+	EXPECT_EQ("xxx", v[500]);
+}
+
+TEST(ConcurrentVectorPush, IteratesPublishedElements)
+{
+	small_concurrent_vector<int> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(index);
+	int expected{ 0 };
+	for (int value : v)
+		EXPECT_EQ(expected++, value);
+	EXPECT_EQ(100, expected);
+	EXPECT_EQ(100, v.end() - v.begin());
+}
+
+TEST(ConcurrentVectorPush, ReserveAllocatesWholeSegments)
+{
+	small_concurrent_vector<int> v;
+	EXPECT_EQ(0, v.reserve(0));
+	EXPECT_EQ(8, v.reserve(1));
+	EXPECT_EQ(16, v.reserve(9));
+	EXPECT_EQ(128, v.reserve(100));
+	EXPECT_TRUE(v.empty());
+}
+
+//**************************************
+// Multi threaded tests
+//**************************************
+TEST(ConcurrentVectorThreads, EveryPushLands)
+{
+	small_concurrent_vector<int> v;
+	std::vector<std::thread> threads;
+	for (int thread{ 0 }; thread < NUM_THREADS; ++thread)
+		threads.emplace_back([&v, thread]
+		{
+			for (int element{ 0 }; element < PER_THREAD; ++element)
+			{
+				size_t index = v.push_back(thread * PER_THREAD + element);
+				EXPECT_EQ(thread * PER_THREAD + element, v[index]);
+			}
+		});
+	for (std::thread& thread : threads)
+		thread.join();
+
+	ASSERT_EQ(NUM_THREADS * PER_THREAD, v.size());
+	std::vector<int> seen(v.begin(), v.end());
+	std::sort(seen.begin(), seen.end());
+	for (int index{ 0 }; index < NUM_THREADS * PER_THREAD; ++index)
+		ASSERT_EQ(index, seen[index]);
+}
+
+TEST(ConcurrentVectorThreads, ReadersSeeConstructedElements)
+{
+	small_concurrent_vector<std::string> v;
+	std::atomic<bool> done{ false };
+	std::atomic<size_t> bad{ 0 };
+
+	std::thread reader([&]
+	{
+		while (!done.load())
+		{
+			size_t size = v.size();
+			for (size_t index{ 0 }; index < size; ++index)
+				if (v[index] != "payload")
+					++bad;
+		}
+	});
+
+	std::vector<std::thread> writers;
+	for (int thread{ 0 }; thread < NUM_THREADS; ++thread)
+		writers.emplace_back([&v]
+		{
+			for (int element{ 0 }; element < PER_THREAD / 10; ++element)
+				v.emplace_back("payload");
+		});
+	for (std::thread& writer : writers)
+		writer.join();
+	done = true;
+	reader.join();
+
+	EXPECT_EQ(0, bad.load());
+	EXPECT_EQ(NUM_THREADS * (PER_THREAD / 10), v.size());
+}
+
+TEST(ConcurrentVectorThreads, DestroysEveryElement)
+{
+	std::shared_ptr<int> tracker = std::make_shared<int>(0);
+	{
+		small_concurrent_vector<std::shared_ptr<int>> v;
+		std::vector<std::thread> threads;
+		for (int thread{ 0 }; thread < NUM_THREADS; ++thread)
+			threads.emplace_back([&v, &tracker]
+			{
+				for (int element{ 0 }; element < 1000; ++element)
+					v.push_back(tracker);
+			});
+		for (std::thread& thread : threads)
+			thread.join();
+		EXPECT_EQ(NUM_THREADS * 1000 + 1, tracker.use_count());
+	}
+	EXPECT_EQ(1, tracker.use_count());
+}
@@ -0,0 +1,189 @@
+//**************************************
+// cow_vector_tests.cpp
+//
+// Holds the unit tests for the
+// cow_vector and cow_snapshot classes
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+//**************************************
+// Sharing tests
+//**************************************
+TEST(CowVectorSharing, StartsEmpty)
+{
+	nids::cow_vector<int> v;
+	EXPECT_TRUE(v.empty());
+	EXPECT_EQ(0, v.capacity());
+	EXPECT_EQ(0, v.use_count());
+	EXPECT_TRUE(v.begin() == v.end());
+}
+
+TEST(CowVectorSharing, CopySharesTheBlock)
+{
+	nids::cow_vector<int> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(index);
+
+	nids::cow_vector<int> copy(v);
+	EXPECT_EQ(2, v.use_count());
+	EXPECT_TRUE(v.is_shared());
+	EXPECT_EQ(v.cdata(), copy.cdata());
+	EXPECT_EQ(100, copy.size());
+}
+
+TEST(CowVectorSharing, WriteClonesOnlyTheWriter)
+{
+	nids::cow_vector<int> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(index);
+	nids::cow_vector<int> copy(v);
+
+	copy[5] = -1;
+	EXPECT_NE(v.cdata(), copy.cdata());
+	EXPECT_EQ(5, v[5]);
+	EXPECT_EQ(-1, copy[5]);
+	EXPECT_EQ(1, v.use_count());
+	EXPECT_EQ(1, copy.use_count());
+
+	// a second write to the now unique copy doesn't clone again
+	const int* before = copy.cdata();
+	copy[6] = -2;
+	EXPECT_EQ(before, copy.cdata());
+}
+
+TEST(CowVectorSharing, PushBackOnSharedBlock)
+{
+	nids::cow_vector<std::string> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(std::to_string(index));
+	nids::cow_vector<std::string> copy = v;
+
+	copy.push_back("tail");
+	copy.pop_back();
+	copy.pop_back();
+	EXPECT_EQ(10, v.size());
+	EXPECT_EQ("9", v[9]);
+	EXPECT_EQ(9, copy.size());
+	EXPECT_EQ("8", copy[8]);
+}
+
+TEST(CowVectorSharing, PushBackOwnElement)
+{
+	nids::cow_vector<std::string> v;
+	v.push_back("first");
+	for (int index{ 0 }; index < 20; ++index)
+		v.push_back(v[0]);
+	for (const std::string& element : static_cast<const nids::cow_vector<std::string>&>(v))
+		EXPECT_EQ("first", element);
+}
+
+TEST(CowVectorSharing, ClearLetsGoOfSharedBlock)
+{
+	nids::cow_vector<int> v;
+	v.push_back(1);
+	nids::cow_vector<int> copy(v);
+
+	copy.clear();
+	EXPECT_TRUE(copy.empty());
+	EXPECT_EQ(1, v.size());
+	EXPECT_EQ(1, v.use_count());
+}
+
+TEST(CowVectorSharing, AssignmentReleasesOldBlock)
+{
+	nids::cow_vector<int> a;
+	nids::cow_vector<int> b;
+	a.push_back(1);
+	b.push_back(2);
+	nids::cow_vector<int> keep(b);
+
+	b = a;
+	EXPECT_EQ(2, a.use_count());
+	EXPECT_EQ(1, keep.use_count());
+	EXPECT_EQ(1, b.cdata()[0]);
+
+	nids::cow_vector<int> moved(std::move(b));
+	EXPECT_EQ(2, moved.use_count());
+	EXPECT_TRUE(b.empty());
+}
+
+TEST(CowVectorSharing, ReserveKeepsElements)
+{
+	nids::cow_vector<std::string> v;
+	v.push_back("a");
+	v.push_back("b");
+	v.reserve(1000);
+	EXPECT_GE(v.capacity(), 1000);
+	EXPECT_EQ("b", v[1]);
+}
+
+//**************************************
+// Snapshot tests
+//**************************************
+TEST(CowVectorSnapshot, KeepsContentsAtTimeTaken)
+{
+	nids::cow_vector<int> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(index);
+
+	nids::cow_snapshot<int> snapshot = v.snapshot();
+	v[0] = 100;
+	v.push_back(10);
+	EXPECT_EQ(10, snapshot.size());
+	EXPECT_EQ(0, snapshot[0]);
+	EXPECT_EQ(100, v[0]);
+
+	int sum{ 0 };
+	for (int element : snapshot)
+		sum += element;
+	EXPECT_EQ(45, sum);
+	EXPECT_EQ(10, snapshot.view().size());
+}
+
+TEST(CowVectorSnapshot, VectorFromSnapshot)
+{
+	nids::cow_vector<int> v;
+	v.push_back(7);
+	nids::cow_snapshot<int> snapshot = v.snapshot();
+	v.clear();
+
+	nids::cow_vector<int> restored(snapshot);
+	EXPECT_EQ(2, snapshot.use_count());
+	EXPECT_EQ(7, restored[0]);
+}
+
+TEST(CowVectorSnapshot, ReadersOnOtherThreads)
+{
+	static const int COUNT = 10000;
+	nids::cow_vector<int> v;
+	for (int index{ 0 }; index < COUNT; ++index)
+		v.push_back(1);
+
+	std::vector<std::thread> readers;
+	for (int thread{ 0 }; thread < 4; ++thread)
+		readers.emplace_back([snapshot = v.snapshot()]
+		{
+			for (int pass{ 0 }; pass < 20; ++pass)
+			{
+				long long sum{ 0 };
+				for (int element : snapshot)
+					sum += element;
+				EXPECT_EQ(COUNT, sum);
+			}
+		});
+
+	// the writer carries on while the readers hold the old block
+	for (int index{ 0 }; index < COUNT; ++index)
+		v[index] = 2;
+	for (std::thread& reader : readers)
+		reader.join();
+	EXPECT_EQ(2, v[COUNT - 1]);
+	EXPECT_EQ(1, v.use_count());
+}
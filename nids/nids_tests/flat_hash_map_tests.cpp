@@ -0,0 +1,221 @@
+//**************************************
+// flat_hash_map_tests.cpp
+//
+// Holds the unit tests for
+// flat_hash_set and flat_hash_map
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	//**************************************
+	// Hash that puts every key in one of
+	// four probe sequences, so groups fill
+	// up and erasing leaves tombstones
+	//**************************************
+	struct CollidingHash
+	{
+		inline size_t operator()(uint32_t key) const noexcept { return (key % 4) << 7 | 5; }
+	};
+}
+
+//**************************************
+// Flat hash set tests
+//**************************************
+TEST(FlatHashSet, InsertFindAndErase)
+{
+	nids::flat_hash_set<int> set;
+	EXPECT_TRUE(set.empty());
+	EXPECT_EQ(0, set.capacity());
+	EXPECT_FALSE(set.contains(3));
+	EXPECT_TRUE(set.begin() == set.end());
+
+	EXPECT_TRUE(set.insert(5).second);
+	EXPECT_TRUE(set.insert(1).second);
+	std::pair<nids::flat_hash_set<int>::iterator, bool> again = set.insert(5);
+	EXPECT_FALSE(again.second);
+	EXPECT_EQ(5, *again.first);
+	EXPECT_EQ(2, set.size());
+	EXPECT_EQ(16, set.capacity());
+	EXPECT_EQ(1, set.count(1));
+	EXPECT_TRUE(set.find(2) == set.end());
+
+	EXPECT_EQ(1, set.erase(5));
+	EXPECT_EQ(0, set.erase(5));
+	EXPECT_EQ(1, set.size());
+	EXPECT_EQ(1, *set.begin());
+
+	set.clear();
+	EXPECT_TRUE(set.empty());
+	EXPECT_EQ(16, set.capacity());
+}
+
+TEST(FlatHashSet, GrowsAndIteratesEveryKey)
+{
+	std::vector<int> keys;
+	for (int index{ 0 }; index < 10000; ++index)
+		keys.push_back(index * 7 - 5000);
+	nids::flat_hash_set<int> set(keys.begin(), keys.end());
+	ASSERT_EQ(keys.size(), set.size());
+	// reserved up front, so no more than 7/8 full
+	EXPECT_EQ(16384, set.capacity());
+
+	std::unordered_set<int> seen;
+	for (int key : set)
+		EXPECT_TRUE(seen.insert(key).second);
+	EXPECT_EQ(keys.size(), seen.size());
+	for (int key : keys)
+		ASSERT_TRUE(set.contains(key)) << key;
+	EXPECT_FALSE(set.contains(1));
+}
+
+TEST(FlatHashSet, MatchesStdUnorderedSetUnderChurn)
+{
+	// the colliding hash keeps the groups full, so erases leave tombstones
+	std::mt19937 random(17);
+	nids::flat_hash_set<uint32_t, CollidingHash> set;
+	std::unordered_set<uint32_t> expected;
+	for (int step{ 0 }; step < 20000; ++step)
+	{
+		uint32_t key = random() % 300;
+		if (random() % 3 == 0)
+			ASSERT_EQ(expected.erase(key), set.erase(key));
+		else
+			ASSERT_EQ(expected.insert(key).second, set.insert(key).second);
+		ASSERT_EQ(expected.size(), set.size());
+	}
+
+	for (uint32_t key{ 0 }; key < 300; ++key)
+		ASSERT_EQ(expected.count(key), set.count(key)) << key;
+	size_t iterated{ 0 };
+	for (uint32_t key : set)
+	{
+		EXPECT_EQ(1, expected.count(key));
+		++iterated;
+	}
+	EXPECT_EQ(expected.size(), iterated);
+}
+
+TEST(FlatHashSet, ChurnDoesNotGrow)
+{
+	// erased slots get reused or swept, so a steady size keeps a steady capacity
+	nids::flat_hash_set<uint32_t> set;
+	for (uint32_t key{ 0 }; key < 100; ++key)
+		set.insert(key);
+	size_t capacity = set.capacity();
+	for (uint32_t key{ 100 }; key < 100000; ++key)
+	{
+		set.insert(key);
+		set.erase(key - 100);
+	}
+	EXPECT_EQ(100, set.size());
+	EXPECT_EQ(capacity, set.capacity());
+	EXPECT_TRUE(set.contains(99999));
+	EXPECT_FALSE(set.contains(99899));
+}
+
+//**************************************
+// Flat hash map tests
+//**************************************
+TEST(FlatHashMap, InsertFindAndErase)
+{
+	nids::flat_hash_map<int, double> map;
+	EXPECT_TRUE(map.insert(10, 1.0).second);
+	EXPECT_TRUE(map.insert(5, 0.5).second);
+	EXPECT_FALSE(map.insert(10, 99.0).second);
+	EXPECT_EQ(1.0, *map.get(10));
+	EXPECT_EQ(nullptr, map.get(7));
+
+	EXPECT_FALSE(map.insert_or_assign(10, 2.0).second);
+	EXPECT_EQ(2.0, map.find(10)->second);
+	map[7] = 0.7;
+	EXPECT_EQ(0.0, map[8]);
+	ASSERT_EQ(4, map.size());
+
+	EXPECT_EQ(1, map.erase(8));
+	map.erase(map.find(5));
+	EXPECT_EQ(2, map.size());
+	EXPECT_TRUE(map.find(5) == map.end());
+	EXPECT_EQ(0.7, *map.get(7));
+}
+
+TEST(FlatHashMap, IterationWritesThrough)
+{
+	std::vector<std::pair<int, int>> entries = { { 3, 30 }, { 1, 10 }, { 2, 20 }, { 3, 99 } };
+	nids::flat_hash_map<int, int> map(entries.begin(), entries.end());
+	ASSERT_EQ(3, map.size());
+	EXPECT_EQ(30, *map.get(3));
+
+	for (auto [key, value] : map)
+		value += key;
+
+	const nids::flat_hash_map<int, int>& constant = map;
+	int total{ 0 };
+	for (nids::flat_hash_map<int, int>::const_iterator iter = constant.begin(); iter != constant.end(); ++iter)
+		total += iter->second;
+	EXPECT_EQ(66, total);
+
+	// a set hands out real references, a map pairs of them made on the fly
+	static_assert(std::is_same_v<std::forward_iterator_tag,
+		std::iterator_traits<nids::flat_hash_set<int>::iterator>::iterator_category>);
+	static_assert(std::is_same_v<std::input_iterator_tag,
+		std::iterator_traits<nids::flat_hash_map<int, int>::iterator>::iterator_category>);
+}
+
+TEST(FlatHashMap, EraseWhileIterating)
+{
+	nids::flat_hash_map<int, int> map;
+	for (int key{ 0 }; key < 1000; ++key)
+		map[key] = key;
+
+	for (nids::flat_hash_map<int, int>::iterator iter = map.begin(); iter != map.end();)
+		iter = iter->first % 3 == 0 ? map.erase(iter) : std::next(iter);
+
+	EXPECT_EQ(666, map.size());
+	for (int key{ 0 }; key < 1000; ++key)
+		ASSERT_EQ(key % 3 != 0, map.contains(key)) << key;
+}
+
+TEST(FlatHashMap, CopiesAndMovesOwnTheirValues)
+{
+	std::mt19937 random(23);
+	nids::flat_hash_map<std::string, std::string> map;
+	std::unordered_map<std::string, std::string> expected;
+	for (int index{ 0 }; index < 2000; ++index)
+	{
+		std::string key = std::to_string(random() % 1500);
+		std::string value = std::string(40, 'a' + index % 26);
+		map.insert_or_assign(key, value);
+		expected[key] = value;
+		if (index % 5 == 0)
+		{
+			std::string gone = std::to_string(random() % 1500);
+			ASSERT_EQ(expected.erase(gone), map.erase(gone));
+		}
+	}
+
+	nids::flat_hash_map<std::string, std::string> copy = map;
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	nids::flat_hash_map<std::string, std::string> moved = std::move(copy);
+	EXPECT_TRUE(copy.empty());
+	copy = moved;
+
+	ASSERT_EQ(expected.size(), moved.size());
+	ASSERT_EQ(expected.size(), copy.size());
+	for (const std::pair<const std::string, std::string>& entry : expected)
+	{
+		ASSERT_NE(nullptr, moved.get(entry.first));
+		EXPECT_EQ(entry.second, *moved.get(entry.first));
+		EXPECT_EQ(entry.second, *copy.get(entry.first));
+	}
+}
@@ -0,0 +1,237 @@
+//**************************************
+// flat_map_tests.cpp
+//
+// Holds the unit tests for flat_set,
+// flat_map, and the branchless binary
+// searches under them
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+//**************************************
+// Search tests
+//**************************************
+TEST(BranchlessSearch, MatchesStdBounds)
+{
+	std::vector<int> values;
+	for (int index{ 0 }; index < 100; ++index)
+		values.push_back(index / 3 * 2);
+
+	std::less<> less;
+	for (size_t count{ 0 }; count <= values.size(); ++count)
+		for (int key{ -1 }; key <= 70; ++key)
+		{
+			const int* first = values.data();
+			ASSERT_EQ(std::lower_bound(first, first + count, key), nids::branchless_lower_bound(first, count, key, less)) << count << " " << key;
+			ASSERT_EQ(std::upper_bound(first, first + count, key), nids::branchless_upper_bound(first, count, key, less)) << count << " " << key;
+		}
+}
+
+//**************************************
+// Flat set tests
+//**************************************
+TEST(FlatSet, InsertKeepsSortedAndUnique)
+{
+	nids::flat_set<int> set;
+	EXPECT_TRUE(set.empty());
+	EXPECT_TRUE(set.find(3) == set.end());
+
+	EXPECT_TRUE(set.insert(5).second);
+	EXPECT_TRUE(set.insert(1).second);
+	EXPECT_TRUE(set.insert(9).second);
+	std::pair<const int*, bool> again = set.insert(5);
+	EXPECT_FALSE(again.second);
+	EXPECT_EQ(5, *again.first);
+
+	ASSERT_EQ(3, set.size());
+	EXPECT_EQ(1, set[0]);
+	EXPECT_EQ(9, set[2]);
+	EXPECT_TRUE(set.contains(9));
+	EXPECT_EQ(0, set.count(4));
+	EXPECT_EQ(9, *set.upper_bound(5));
+	EXPECT_EQ(5, *set.lower_bound(2));
+
+	EXPECT_EQ(1, set.erase(5));
+	EXPECT_EQ(0, set.erase(5));
+	EXPECT_EQ(9, *set.erase(set.begin()));
+	EXPECT_EQ(1, set.size());
+}
+
+TEST(FlatSet, BulkConstructionSortsAndDeduplicates)
+{
+	std::mt19937 random(3);
+	std::vector<uint32_t> keys;
+	for (int index{ 0 }; index < 5000; ++index)
+		keys.push_back(random() % 2000);
+
+	nids::flat_set<uint32_t> set(keys.begin(), keys.end());
+	std::set<uint32_t> expected(keys.begin(), keys.end());
+	ASSERT_EQ(expected.size(), set.size());
+	EXPECT_TRUE(std::equal(expected.begin(), expected.end(), set.begin()));
+}
+
+TEST(FlatSet, BatchInsertMerges)
+{
+	std::mt19937 random(5);
+	nids::flat_set<int> set;
+	std::set<int> expected;
+	for (int round{ 0 }; round < 20; ++round)
+	{
+		std::vector<int> batch;
+		for (int index{ 0 }; index < 300; ++index)
+			batch.push_back(static_cast<int>(random() % 10000) - 5000);
+		set.insert(batch.begin(), batch.end());
+		expected.insert(batch.begin(), batch.end());
+		ASSERT_EQ(expected.size(), set.size());
+		ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin()));
+	}
+
+	// a batch the set already holds changes nothing
+	std::vector<int> same(set.begin(), set.begin() + 10);
+	set.insert(same.begin(), same.end());
+	EXPECT_EQ(expected.size(), set.size());
+}
+
+TEST(FlatSet, CustomCompareAndHeterogeneousLookup)
+{
+	std::vector<std::string> words = { "pear", "apple", "fig", "apple", "kiwi" };
+	nids::flat_set<std::string, std::greater<>> set(words.begin(), words.end());
+	ASSERT_EQ(4, set.size());
+	EXPECT_EQ("pear", set[0]);
+	EXPECT_EQ("apple", set[3]);
+
+	// std::greater<> compares a std::string with a const char* directly
+	EXPECT_TRUE(set.contains("fig"));
+	EXPECT_FALSE(set.contains("plum"));
+
+	std::vector<std::string> more = { "banana", "pear", "zucchini" };
+	set.insert(more.begin(), more.end());
+	ASSERT_EQ(6, set.size());
+	EXPECT_EQ("zucchini", set[0]);
+	EXPECT_EQ("banana", set[4]);
+}
+
+TEST(FlatSet, EmptyCopiesAndMoves)
+{
+	nids::flat_set<int> empty;
+	nids::flat_set<int> moved(std::move(empty));
+	EXPECT_TRUE(moved.empty());
+	nids::flat_set<int> copy = moved;
+	EXPECT_TRUE(copy.empty());
+
+	copy.insert(3);
+	copy = moved;
+	EXPECT_TRUE(copy.empty());
+	copy.insert(4);
+	nids::flat_set<int> kept = copy;
+	ASSERT_EQ(1, kept.size());
+	EXPECT_EQ(4, kept[0]);
+}
+
+//**************************************
+// Flat map tests
+//**************************************
+TEST(FlatMap, InsertFindAndErase)
+{
+	nids::flat_map<int, double> map;
+	EXPECT_TRUE(map.insert(10, 1.0).second);
+	EXPECT_TRUE(map.insert(5, 0.5).second);
+	EXPECT_FALSE(map.insert(10, 99.0).second);
+	EXPECT_EQ(1.0, *map.get(10));
+	EXPECT_EQ(nullptr, map.get(7));
+
+	map.insert_or_assign(10, 2.0);
+	EXPECT_EQ(2.0, map.find(10)->second);
+	map[7] = 0.7;
+	EXPECT_EQ(0.0, map[8]);
+	ASSERT_EQ(4, map.size());
+	EXPECT_EQ(7, map.keys()[1]);
+	EXPECT_EQ(0.7, map.values()[1]);
+
+	EXPECT_EQ(1, map.erase(8));
+	nids::flat_map<int, double>::iterator next = map.erase(map.find(5));
+	EXPECT_EQ(7, (*next).first);
+	EXPECT_EQ(2, map.size());
+	EXPECT_TRUE(map.find(5) == map.end());
+}
+
+TEST(FlatMap, IterationWritesThrough)
+{
+	std::vector<std::pair<int, int>> entries = { { 3, 30 }, { 1, 10 }, { 2, 20 } };
+	nids::flat_map<int, int> map(entries.begin(), entries.end());
+
+	int expectedKey{ 1 };
+	for (auto [key, value] : map)
+	{
+		EXPECT_EQ(expectedKey++, key);
+		value += 1;
+	}
+	EXPECT_EQ(31, *map.get(3));
+
+	const nids::flat_map<int, int>& constant = map;
+	int total{ 0 };
+	for (nids::flat_map<int, int>::const_iterator iter = constant.begin(); iter != constant.end(); ++iter)
+		total += iter->second;
+	EXPECT_EQ(63, total);
+	EXPECT_EQ(3, constant.end() - constant.begin());
+
+	// entries are pairs of references made on the fly, so only one pass is promised
+	static_assert(std::is_same_v<std::input_iterator_tag,
+		std::iterator_traits<nids::flat_map<int, int>::iterator>::iterator_category>);
+}
+
+TEST(FlatMap, BatchInsertMatchesStdMap)
+{
+	std::mt19937 random(9);
+	nids::flat_map<uint32_t, std::string> map;
+	std::map<uint32_t, std::string> expected;
+	for (int round{ 0 }; round < 10; ++round)
+	{
+		std::vector<std::pair<uint32_t, std::string>> batch;
+		for (int index{ 0 }; index < 200; ++index)
+		{
+			uint32_t key = random() % 3000;
+			// keys repeat across rounds but never within one, so the kept value is known
+			if (std::find_if(batch.begin(), batch.end(), [key](const auto& entry) { return entry.first == key; }) == batch.end())
+				batch.emplace_back(key, std::to_string(key * round));
+		}
+		map.insert(batch.begin(), batch.end());
+		expected.insert(batch.begin(), batch.end());
+	}
+
+	ASSERT_EQ(expected.size(), map.size());
+	size_t index{ 0 };
+	for (const std::pair<const uint32_t, std::string>& entry : expected)
+	{
+		ASSERT_EQ(entry.first, map.keys()[index]);
+		ASSERT_EQ(entry.second, map.values()[index]);
+		++index;
+	}
+}
+
+TEST(FlatMap, EmptyCopiesAndMoves)
+{
+	nids::flat_map<int, int> empty;
+	nids::flat_map<int, int> assigned;
+	assigned = empty;
+	EXPECT_TRUE(assigned.empty());
+	nids::flat_map<int, int> moved(std::move(assigned));
+	EXPECT_TRUE(moved.empty());
+
+	moved[1] = 10;
+	nids::flat_map<int, int> copy = moved;
+	moved = std::move(empty);
+	EXPECT_TRUE(moved.empty());
+	ASSERT_EQ(1, copy.size());
+	EXPECT_EQ(10, *copy.get(1));
+}
@@ -0,0 +1,198 @@
+//**************************************
+// mapped_vector_tests.cpp
+//
+// Holds the unit tests for the
+// mapped_vector class
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+
+#ifndef _WIN32
+#include "../nids/mapped_vector.h"
+#include <stdio.h>
+#include <string>
+
+namespace
+{
+	using nids_tests::TempFile;
+	using nids_tests::Pair;
+
+	long FileSize(const std::string& path)
+	{
+		struct stat status;
+		return stat(path.c_str(), &status) == 0 ? static_cast<long>(status.st_size) : -1;
+	}
+}
+
+//**************************************
+// Open / close tests
+//**************************************
+TEST(MappedVectorOpen, CreatesEmptyFile)
+{
+	TempFile file("nids_mapped_create.bin");
+	nids::mapped_vector<int> v(file.path.c_str());
+	ASSERT_TRUE(v.is_open());
+	EXPECT_EQ(0, v.size());
+	EXPECT_TRUE(v.empty());
+	EXPECT_TRUE(v.begin() == v.end());
+}
+
+TEST(MappedVectorOpen, MissingFileWithoutCreate)
+{
+	TempFile file("nids_mapped_missing.bin");
+	nids::mapped_vector<int> v;
+	EXPECT_FALSE(v.open(file.path.c_str(), false));
+	EXPECT_FALSE(v.is_open());
+}
+
+TEST(MappedVectorOpen, ReopensContents)
+{
+	TempFile file("nids_mapped_reopen.bin");
+	{
+		nids::mapped_vector<int> v(file.path.c_str());
+		for (int index{ 0 }; index < 100000; ++index)
+			v.push_back(index);
+		EXPECT_TRUE(v.flush());
+	}
+
+	nids::mapped_vector<int> v(file.path.c_str());
+	ASSERT_TRUE(v.is_open());
+	ASSERT_EQ(100000, v.size());
+	for (int index{ 0 }; index < 100000; ++index)
+		ASSERT_EQ(index, v[index]);
+
+	// and keeps growing from where it left off
+	v.push_back(-1);
+	EXPECT_EQ(-1, v[100000]);
+}
+
+TEST(MappedVectorOpen, CloseTrimsFile)
+{
+	TempFile file("nids_mapped_trim.bin");
+	{
+		nids::mapped_vector<int64_t> v(file.path.c_str());
+		v.reserve(1000);
+		v.push_back(1);
+		v.push_back(2);
+	}
+	EXPECT_EQ(static_cast<long>(nids::mapped_vector<int64_t>::HEADER_SIZE + 2 * sizeof(int64_t)), FileSize(file.path));
+}
+
+TEST(MappedVectorOpen, RejectsOtherElementSize)
+{
+	TempFile file("nids_mapped_element.bin");
+	{
+		nids::mapped_vector<int32_t> v(file.path.c_str());
+		v.push_back(1);
+	}
+	nids::mapped_vector<int64_t> other;
+	EXPECT_FALSE(other.open(file.path.c_str()));
+}
+
+TEST(MappedVectorOpen, RejectsForeignFile)
+{
+	TempFile file("nids_mapped_foreign.bin");
+	FILE* stream = fopen(file.path.c_str(), "wb");
+	ASSERT_NE(nullptr, stream);
+	char junk[100] = "not a mapped vector";
+	fwrite(junk, 1, sizeof(junk), stream);
+	fclose(stream);
+
+	nids::mapped_vector<int> v;
+	EXPECT_FALSE(v.open(file.path.c_str()));
+}
+
+//**************************************
+// Mutation tests
+//**************************************
+TEST(MappedVectorMutate, ResizeGrowsAndShrinks)
+{
+	TempFile file("nids_mapped_resize.bin");
+	nids::mapped_vector<Pair> v(file.path.c_str());
+	EXPECT_EQ(64, v.resize(64, Pair{ 7, 0.5f }));
+	EXPECT_EQ(static_cast<long>(nids::mapped_vector<Pair>::HEADER_SIZE + 64 * sizeof(Pair)), FileSize(file.path));
+	EXPECT_EQ(7, v.data()[63].key);
+
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(Pair{ index, 1.0f });
+	EXPECT_EQ(4, v.resize(4));
+	EXPECT_EQ(4, v.size());
+	EXPECT_EQ(3, v[3].key);
+}
+
+TEST(MappedVectorMutate, PushBackOwnElement)
+{
+	TempFile file("nids_mapped_alias.bin");
+	nids::mapped_vector<int> v(file.path.c_str());
+	v.push_back(42);
+	for (int index{ 0 }; index < 1000; ++index)
+		v.push_back(v[0]);
+	for (size_t index{ 0 }; index < v.size(); ++index)
+		ASSERT_EQ(42, v[index]);
+}
+
+TEST(MappedVectorMutate, WritesThroughData)
+{
+	TempFile file("nids_mapped_data.bin");
+	{
+		nids::mapped_vector<int> v(file.path.c_str());
+		v.resize(16, 0);
+		for (int index{ 0 }; index < 16; ++index)
+			v.push_back(index);
+		v.data()[5] = 500;
+		v.flush(nids::FlushMode::FLUSH_ASYNC);
+	}
+	nids::mapped_vector<int> v(file.path.c_str());
+	EXPECT_EQ(500, v[5]);
+	EXPECT_EQ(120 - 5 + 500, nids::sum(v));
+}
+
+TEST(MappedVectorMutate, ViewsSliceTheMapping)
+{
+	TempFile file("nids_mapped_view.bin");
+	nids::mapped_vector<int> v(file.path.c_str());
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(index);
+
+	nids::span<int> slice = v.view(40, 10);
+	EXPECT_EQ(v.data() + 40, slice.data());
+	nids::fill(slice, -1);
+	EXPECT_EQ(-1, v[49]);
+	EXPECT_EQ(50, v[50]);
+	EXPECT_EQ(100, static_cast<const nids::mapped_vector<int>&>(v).view().size());
+}
+
+TEST(MappedVectorMutate, ResizeUninitializedPersists)
+{
+	TempFile file("nids_mapped_uninitialized.bin");
+	{
+		nids::mapped_vector<uint32_t> v(file.path.c_str());
+		v.resize_uninitialized(1000);
+		for (uint32_t index{ 0 }; index < 1000; ++index)
+			v.data()[index] = index * 3;
+	}
+	nids::mapped_vector<uint32_t> v(file.path.c_str());
+	ASSERT_EQ(1000, v.size());
+	EXPECT_EQ(999 * 3, v[999]);
+}
+
+TEST(MappedVectorMutate, MoveKeepsFile)
+{
+	TempFile file("nids_mapped_move.bin");
+	nids::mapped_vector<int> v(file.path.c_str());
+	v.push_back(1);
+	nids::mapped_vector<int> moved(std::move(v));
+	EXPECT_FALSE(v.is_open());
+	ASSERT_TRUE(moved.is_open());
+	moved.push_back(2);
+	EXPECT_EQ(2, moved.size());
+
+	int total{ 0 };
+	for (nids::mapped_vector<int>::iterator iter = moved.begin(); iter != moved.end(); ++iter)
+		total += *iter;
+	EXPECT_EQ(3, total);
+}
+#endif
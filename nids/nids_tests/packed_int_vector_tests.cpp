@@ -0,0 +1,212 @@
+//**************************************
+// packed_int_vector_tests.cpp
+//
+// Holds the unit tests for the
+// packed_int_vector class and the bit
+// packing it is built on
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+	//**************************************
+	// Checks every value of packed through
+	// the subscript operator and the
+	// iterator against expected
+	//**************************************
+	template<typename Packed, typename Type>
+	void ExpectSameValues(const Packed& packed, const std::vector<Type>& expected)
+	{
+		ASSERT_EQ(expected.size(), packed.size());
+		for (size_t index{ 0 }; index < expected.size(); ++index)
+			ASSERT_EQ(expected[index], packed[index]) << "index " << index;
+
+		size_t index{ 0 };
+		for (Type value : packed)
+			ASSERT_EQ(expected[index++], value) << "index " << index - 1;
+		EXPECT_EQ(expected.size(), index);
+	}
+}
+
+//**************************************
+// Bit packing tests
+//**************************************
+TEST(PackedBits, UnpackMatchesPackAtEveryWidth)
+{
+	std::mt19937 random(7);
+	for (unsigned bits{ 0 }; bits <= 32; ++bits)
+	{
+		SCOPED_TRACE(bits);
+		uint32_t values[nids::PACKED_BLOCK_SIZE];
+		for (uint32_t& value : values)
+			value = bits == 0 ? 0 : static_cast<uint32_t>(random() & ((uint64_t{ 1 } << bits) - 1));
+
+		uint32_t words[nids::PACKED_LANES * 32] = {};
+		nids::pack_block(values, bits, words);
+		for (size_t index{ 0 }; index < nids::PACKED_BLOCK_SIZE; ++index)
+			ASSERT_EQ(values[index], nids::unpack_value(words, bits, index));
+
+		// the scalar loop and the SSE2 kernels
+		for (nids::SimdLevel level : { nids::SimdLevel::SIMD_SCALAR, nids::supported_simd_level() })
+		{
+			nids::set_simd_level(level);
+			uint32_t unpacked[nids::PACKED_BLOCK_SIZE];
+			nids::unpack_block(words, bits, unpacked);
+			for (size_t index{ 0 }; index < nids::PACKED_BLOCK_SIZE; ++index)
+				ASSERT_EQ(values[index], unpacked[index]);
+		}
+		nids::set_simd_level(nids::supported_simd_level());
+	}
+}
+
+//**************************************
+// Encoding tests
+//**************************************
+TEST(PackedIntVectorEncoding, StartsEmpty)
+{
+	nids::packed_int_vector<> packed;
+	EXPECT_TRUE(packed.empty());
+	EXPECT_EQ(0, packed.block_count());
+	EXPECT_TRUE(packed.begin() == packed.end());
+	EXPECT_EQ(0, packed.compressed_bytes());
+
+	// values live in the iterator's block buffer, so it only promises one pass
+	static_assert(std::is_same_v<std::input_iterator_tag,
+		std::iterator_traits<nids::packed_int_vector<>::iterator>::iterator_category>);
+}
+
+TEST(PackedIntVectorEncoding, SortedIdsUseDeltas)
+{
+	std::mt19937 random(11);
+	std::vector<unsigned long> ids;
+	unsigned long id{ 1000000000 };
+	for (int index{ 0 }; index < 10000; ++index)
+	{
+		id += 1 + random() % 200;
+		ids.push_back(id);
+	}
+
+	nids::packed_int_vector<unsigned long> packed(ids.begin(), ids.end());
+	ExpectSameValues(packed, ids);
+	EXPECT_EQ(nids::BlockEncoding::BLOCK_DELTA, packed.header(0).encoding);
+	EXPECT_EQ(10, packed.header(0).bits);
+	EXPECT_LT(packed.compressed_bytes() * 5, sizeof(unsigned long) * ids.size());
+	EXPECT_EQ(ids.back(), packed.back());
+}
+
+TEST(PackedIntVectorEncoding, UnsortedValuesUseFrames)
+{
+	std::mt19937 random(13);
+	std::vector<uint32_t> values;
+	for (int index{ 0 }; index < 1000; ++index)
+		values.push_back(5000 + random() % 1000);
+
+	nids::packed_int_vector<uint32_t> packed(values.begin(), values.end());
+	ExpectSameValues(packed, values);
+	EXPECT_EQ(nids::BlockEncoding::BLOCK_FRAME, packed.header(0).encoding);
+	EXPECT_EQ(10, packed.header(0).bits);
+}
+
+TEST(PackedIntVectorEncoding, WideRangesStayRaw)
+{
+	std::mt19937_64 random(17);
+	std::vector<uint64_t> values;
+	for (int index{ 0 }; index < 300; ++index)
+		values.push_back(random());
+
+	nids::packed_int_vector<uint64_t> packed(values.begin(), values.end());
+	ExpectSameValues(packed, values);
+	EXPECT_EQ(nids::BlockEncoding::BLOCK_RAW, packed.header(1).encoding);
+}
+
+TEST(PackedIntVectorEncoding, SignedAndConstantValues)
+{
+	std::vector<int64_t> values;
+	for (int index{ 0 }; index < 128; ++index)
+		values.push_back(-42);
+	for (int index{ 0 }; index < 200; ++index)
+		values.push_back(index % 2 == 0 ? -index : index * 1000);
+
+	nids::packed_int_vector<int64_t> packed(values.begin(), values.end());
+	ExpectSameValues(packed, values);
+	EXPECT_EQ(0, packed.header(0).bits);
+}
+
+//**************************************
+// Decoding tests
+//**************************************
+TEST(PackedIntVectorDecoding, DecodeBlockIncludesPendingValues)
+{
+	nids::packed_int_vector<int> packed;
+	for (int index{ 0 }; index < 300; ++index)
+		packed.push_back(index * 3);
+	EXPECT_EQ(3, packed.block_count());
+
+	int values[nids::packed_int_vector<int>::BLOCK_SIZE];
+	EXPECT_EQ(128, packed.decode_block(1, values));
+	EXPECT_EQ(128 * 3, values[0]);
+	EXPECT_EQ(44, packed.decode_block(2, values));
+	EXPECT_EQ(299 * 3, values[43]);
+
+	packed.clear();
+	EXPECT_TRUE(packed.empty());
+	packed.push_back(5);
+	EXPECT_EQ(5, packed[0]);
+}
+
+TEST(PackedIntVectorDecoding, SameResultsAtEveryLevel)
+{
+	std::vector<uint64_t> values;
+	for (uint64_t index{ 0 }; index < 2000; ++index)
+		values.push_back(index * index);
+
+	nids::packed_int_vector<uint64_t> packed(values.begin(), values.end());
+	for (nids::SimdLevel level : { nids::SimdLevel::SIMD_SCALAR, nids::supported_simd_level() })
+	{
+		nids::set_simd_level(level);
+		ExpectSameValues(packed, values);
+	}
+	nids::set_simd_level(nids::supported_simd_level());
+}
+
+//**************************************
+// Copy and move tests
+//**************************************
+TEST(PackedIntVectorCopy, EmptyCopiesAndMoves)
+{
+	nids::packed_int_vector<int> empty;
+	nids::packed_int_vector<int> copy = empty;
+	EXPECT_TRUE(copy.empty());
+	nids::packed_int_vector<int> moved = std::move(copy);
+	EXPECT_TRUE(moved.empty());
+
+	moved.push_back(4);
+	moved = empty;
+	EXPECT_TRUE(moved.empty());
+	moved = std::move(empty);
+	EXPECT_TRUE(moved.begin() == moved.end());
+}
+
+TEST(PackedIntVectorCopy, PartBlockCopiesAndMoves)
+{
+	// five values all wait in the pending block, nothing is packed yet
+	std::vector<int> values = { 3, 1, 4, 1, 5 };
+	nids::packed_int_vector<int> packed(values.begin(), values.end());
+
+	nids::packed_int_vector<int> copy = packed;
+	ExpectSameValues(copy, values);
+	nids::packed_int_vector<int> moved(std::move(packed));
+	ExpectSameValues(moved, values);
+
+	nids::packed_int_vector<int> assigned;
+	assigned = copy;
+	ExpectSameValues(assigned, values);
+	assigned = std::move(moved);
+	ExpectSameValues(assigned, values);
+}
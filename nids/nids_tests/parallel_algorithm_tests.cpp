@@ -0,0 +1,214 @@
+//**************************************
+// parallel_algorithm_tests.cpp
+//
+// Holds the unit tests for the thread
+// pool and the parallel algorithms
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// sizes that run sequentially, barely split, and split across every thread
+	const size_t SIZES[] = { 0, 1, 1000, 40000, 1000003 };
+
+	//**************************************
+	// Builds a nids::vector of count
+	// random ints
+	//**************************************
+	nids::vector<int> RandomInts(size_t count, unsigned seed = 7)
+	{
+		std::mt19937 random(seed);
+		nids::vector<int> v;
+		v.reserve(count);
+		for (size_t index{ 0 }; index < count; ++index)
+			v.push_back(static_cast<int>(random() % 1000) - 500);
+		return v;
+	}
+}
+
+//**************************************
+// Thread pool tests
+//**************************************
+TEST(ThreadPool, RunsEveryIndexOnce)
+{
+	nids::thread_pool pool(4);
+	EXPECT_EQ(4, pool.size());
+	std::vector<std::atomic<int>> hits(1000);
+	pool.run(hits.size(), [&](size_t index) { ++hits[index]; });
+	for (std::atomic<int>& hit : hits)
+		EXPECT_EQ(1, hit.load());
+}
+
+TEST(ThreadPool, SingleThreadRunsInline)
+{
+	nids::thread_pool pool(1);
+	EXPECT_EQ(1, pool.size());
+	size_t total{ 0 };
+	pool.run(100, [&](size_t index) { total += index; });
+	EXPECT_EQ(4950, total);
+}
+
+TEST(ThreadPool, NestedRunsFinish)
+{
+	nids::thread_pool pool(3);
+	std::atomic<size_t> total{ 0 };
+	pool.run(16, [&](size_t)
+	{
+		pool.run(16, [&](size_t index) { total += index; });
+	});
+	EXPECT_EQ(16 * 120, total.load());
+}
+
+TEST(ThreadPool, MoreTasksThanQueues)
+{
+	nids::thread_pool pool(2);
+	std::atomic<size_t> count{ 0 };
+	pool.run(nids::thread_pool::QUEUE_CAPACITY * 4, [&](size_t) { ++count; });
+	EXPECT_EQ(nids::thread_pool::QUEUE_CAPACITY * 4, count.load());
+}
+
+//**************************************
+// Chunking tests
+//**************************************
+TEST(ParallelChunks, InnerBoundariesAreCacheLineAligned)
+{
+	nids::vector<int> v = RandomInts(1000003);
+	const int* data = v.data();
+	size_t chunks{ 16 };
+	size_t previous{ 0 };
+	for (size_t chunk{ 1 }; chunk < chunks; ++chunk)
+	{
+		size_t start = nids::parallel_chunk_start(data, v.size(), chunks, chunk);
+		EXPECT_EQ(0, reinterpret_cast<uintptr_t>(data + start) % nids::CACHE_LINE_SIZE);
+		EXPECT_GT(start, previous);
+		previous = start;
+	}
+	EXPECT_EQ(v.size(), nids::parallel_chunk_start(data, v.size(), chunks, chunks));
+}
+
+TEST(ParallelChunks, SmallRangesStaySequential)
+{
+	nids::thread_pool pool(4);
+	EXPECT_EQ(1, nids::parallel_chunk_count(pool, 1000, sizeof(int)));
+	EXPECT_EQ(16, nids::parallel_chunk_count(pool, 1 << 24, sizeof(int)));
+	nids::thread_pool single(1);
+	EXPECT_EQ(1, nids::parallel_chunk_count(single, 1 << 24, sizeof(int)));
+}
+
+//**************************************
+// Algorithm tests
+//**************************************
+TEST(ParallelAlgorithm, ForEachVisitsEveryElement)
+{
+	nids::thread_pool pool(4);
+	for (size_t size : SIZES)
+	{
+		nids::vector<int> v = RandomInts(size);
+		std::vector<int> expected(v.data(), v.data() + v.size());
+		nids::parallel_for_each(pool, v.begin(), v.end(), [](int& value) { value *= 3; });
+		for (size_t index{ 0 }; index < size; ++index)
+			ASSERT_EQ(expected[index] * 3, v[index]);
+	}
+}
+
+TEST(ParallelAlgorithm, TransformWritesOutput)
+{
+	nids::thread_pool pool(4);
+	for (size_t size : SIZES)
+	{
+		nids::vector<int> v = RandomInts(size);
+		nids::vector<double> out;
+		out.resize_uninitialized(size);
+		nids::parallel_transform(pool, v.data(), v.data() + v.size(), out.data(), [](int value) { return value * 0.5; });
+		for (size_t index{ 0 }; index < size; ++index)
+			ASSERT_EQ(v[index] * 0.5, out[index]);
+	}
+}
+
+TEST(ParallelAlgorithm, ReduceMatchesAccumulate)
+{
+	nids::thread_pool pool(4);
+	for (size_t size : SIZES)
+	{
+		nids::vector<int> v = RandomInts(size);
+		long long expected = std::accumulate(v.data(), v.data() + v.size(), 10LL);
+		EXPECT_EQ(expected, nids::parallel_reduce(pool, v.begin(), v.end(), 10LL));
+		int largest = nids::parallel_reduce(pool, v.begin(), v.end(), -1000, [](int a, int b) { return a > b ? a : b; });
+		EXPECT_EQ(size ? *std::max_element(v.data(), v.data() + v.size()) : -1000, largest);
+	}
+}
+
+TEST(ParallelAlgorithm, InclusiveScanMatchesPartialSum)
+{
+	nids::thread_pool pool(4);
+	for (size_t size : SIZES)
+	{
+		nids::vector<int> v = RandomInts(size);
+		std::vector<int> expected(size);
+		std::partial_sum(v.data(), v.data() + v.size(), expected.data());
+
+		nids::vector<int> out;
+		out.resize_uninitialized(size);
+		nids::parallel_inclusive_scan(pool, v.data(), v.data() + v.size(), out.data());
+		for (size_t index{ 0 }; index < size; ++index)
+			ASSERT_EQ(expected[index], out[index]);
+
+		// in place
+		nids::parallel_inclusive_scan(pool, v.begin(), v.end(), v.begin());
+		for (size_t index{ 0 }; index < size; ++index)
+			ASSERT_EQ(expected[index], v[index]);
+	}
+}
+
+TEST(ParallelAlgorithm, CopyIfKeepsOrder)
+{
+	nids::thread_pool pool(4);
+	for (size_t size : SIZES)
+	{
+		nids::vector<int> v = RandomInts(size);
+		std::vector<int> expected;
+		std::copy_if(v.data(), v.data() + v.size(), std::back_inserter(expected), [](int value) { return value % 3 == 0; });
+
+		nids::vector<int> out;
+		out.resize_uninitialized(size);
+		int* end = nids::parallel_copy_if(pool, v.data(), v.data() + v.size(), out.data(), [](int value) { return value % 3 == 0; });
+		ASSERT_EQ(expected.size(), static_cast<size_t>(end - out.data()));
+		for (size_t index{ 0 }; index < expected.size(); ++index)
+			ASSERT_EQ(expected[index], out[index]);
+	}
+}
+
+TEST(ParallelAlgorithm, SortMatchesStdSort)
+{
+	nids::thread_pool pool(4);
+	for (size_t size : SIZES)
+	{
+		nids::vector<int> v = RandomInts(size);
+		std::vector<int> expected(v.data(), v.data() + v.size());
+		std::sort(expected.begin(), expected.end());
+		nids::parallel_sort(pool, v.begin(), v.end());
+		for (size_t index{ 0 }; index < size; ++index)
+			ASSERT_EQ(expected[index], v[index]);
+
+		nids::parallel_sort(pool, v.begin(), v.end(), std::greater<>());
+		EXPECT_TRUE(std::is_sorted(v.data(), v.data() + v.size(), std::greater<>()));
+	}
+}
+
+TEST(ParallelAlgorithm, DefaultPoolWorks)
+{
+	nids::vector<int> v = RandomInts(200000);
+	long long expected = std::accumulate(v.data(), v.data() + v.size(), 0LL);
+	EXPECT_EQ(expected, nids::parallel_reduce(v.begin(), v.end(), 0LL));
+	nids::parallel_sort(v.begin(), v.end());
+	EXPECT_TRUE(std::is_sorted(v.data(), v.data() + v.size()));
+}
@@ -6,4 +6,21 @@
 #pragma once
 
 #include "gtest/gtest.h"
+#include "test_files.h"
+#include "../nids/algorithm.h"
+#include "../nids/aligned_allocator.h"
 #include "../nids/vector.h"
+#include "../nids/arena.h"
+#include "../nids/bit_vector.h"
+#include "../nids/concurrent_vector.h"
+#include "../nids/cow_vector.h"
+#include "../nids/flat_hash_map.h"
+#include "../nids/flat_map.h"
+#include "../nids/packed_int_vector.h"
+#include "../nids/parallel_algorithm.h"
+#include "../nids/ring_buffer.h"
+#include "../nids/segmented_vector.h"
+#include "../nids/small_vector.h"
+#include "../nids/sort.h"
+#include "../nids/soa_vector.h"
+#include "../nids/span.h"
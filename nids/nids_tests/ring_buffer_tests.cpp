@@ -0,0 +1,249 @@
+//**************************************
+// ring_buffer_tests.cpp
+//
+// Holds the unit tests for ring_buffer
+// and spsc_ring_buffer
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	//**************************************
+	// Pushes count numbers starting at
+	// first and pops as many, so the front
+	// walks around the array
+	//**************************************
+	template<typename Buffer>
+	void Rotate(Buffer& buffer, int first, int count)
+	{
+		for (int index{ 0 }; index < count; ++index)
+		{
+			buffer.push_back(first + index);
+			buffer.pop_front();
+		}
+	}
+}
+
+//**************************************
+// Ring buffer tests
+//**************************************
+TEST(RingBuffer, GrowsKeepingOrder)
+{
+	nids::ring_buffer<int> buffer;
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(0, buffer.capacity());
+
+	// wrap the front around before each growth
+	std::deque<int> expected;
+	for (int round{ 0 }; round < 10; ++round)
+	{
+		for (int index{ 0 }; index < 7; ++index)
+		{
+			EXPECT_TRUE(buffer.push_back(round * 100 + index));
+			expected.push_back(round * 100 + index);
+		}
+		buffer.pop_front();
+		expected.pop_front();
+		ASSERT_EQ(expected.size(), buffer.size());
+		for (size_t index{ 0 }; index < expected.size(); ++index)
+			ASSERT_EQ(expected[index], buffer[index]);
+	}
+	EXPECT_EQ(64, buffer.capacity());
+	EXPECT_EQ(expected.front(), buffer.front());
+	EXPECT_EQ(expected.back(), buffer.back());
+
+	buffer.pop_back();
+	EXPECT_EQ(expected[expected.size() - 2], buffer.back());
+	buffer.clear();
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(64, buffer.capacity());
+}
+
+TEST(RingBuffer, NonTrivialTypesSurviveGrowth)
+{
+	nids::ring_buffer<std::string> buffer(4);
+	EXPECT_EQ(4, buffer.capacity());
+	for (int index{ 0 }; index < 3; ++index)
+		buffer.push_back(std::string(30, 'a' + index));
+	buffer.pop_front();
+	for (int index{ 3 }; index < 40; ++index)
+		buffer.emplace_back(30, 'a' + index % 26);
+
+	// pushing an element of the buffer while it grows
+	while (!buffer.full())
+		buffer.push_back("x");
+	buffer.push_back(buffer.front());
+
+	EXPECT_EQ(std::string(30, 'b'), buffer.front());
+	EXPECT_EQ(buffer.front(), buffer.back());
+
+	nids::ring_buffer<std::string> copy = buffer;
+	ASSERT_EQ(buffer.size(), copy.size());
+	for (size_t index{ 0 }; index < buffer.size(); ++index)
+		ASSERT_EQ(buffer[index], copy[index]);
+	nids::ring_buffer<std::string> moved = std::move(copy);
+	EXPECT_TRUE(copy.empty());
+	EXPECT_EQ(buffer.size(), moved.size());
+}
+
+TEST(RingBuffer, FixedCapacityRejects)
+{
+	nids::fixed_ring_buffer<int> buffer(5);
+	ASSERT_EQ(8, buffer.capacity());
+	for (int index{ 0 }; index < 8; ++index)
+		EXPECT_TRUE(buffer.push_back(index));
+	EXPECT_TRUE(buffer.full());
+	EXPECT_FALSE(buffer.push_back(8));
+	EXPECT_EQ(8, buffer.capacity());
+
+	std::vector<int> more = { 10, 11, 12 };
+	buffer.pop_front();
+	buffer.pop_front();
+	EXPECT_EQ(2, buffer.push_back(nids::span<const int>(more.data(), more.size())));
+	EXPECT_EQ(11, buffer.back());
+	EXPECT_EQ(2, buffer.front());
+}
+
+TEST(RingBuffer, BulkPushAndPopAcrossTheEnd)
+{
+	nids::ring_buffer<int> buffer(16);
+	Rotate(buffer, 0, 13);
+
+	std::vector<int> batch;
+	for (int index{ 0 }; index < 10; ++index)
+		batch.push_back(index);
+	EXPECT_EQ(10, buffer.push_back(nids::span<const int>(batch.data(), batch.size())));
+
+	// the batch starts three from the end and wraps
+	std::pair<nids::span<int>, nids::span<int>> pieces = buffer.spans();
+	EXPECT_EQ(3, pieces.first.size());
+	EXPECT_EQ(7, pieces.second.size());
+	EXPECT_EQ(3, pieces.second[0]);
+
+	// growing past the end unwraps it
+	EXPECT_EQ(10, buffer.push_back(nids::span<const int>(batch.data(), batch.size())));
+	EXPECT_EQ(32, buffer.capacity());
+	for (size_t index{ 0 }; index < 20; ++index)
+		ASSERT_EQ(static_cast<int>(index % 10), buffer[index]);
+
+	std::vector<int> output(15);
+	EXPECT_EQ(15, buffer.pop_front(nids::span<int>(output.data(), output.size())));
+	EXPECT_EQ(9, output[9]);
+	EXPECT_EQ(4, output[14]);
+	EXPECT_EQ(5, buffer.pop_front(nids::span<int>(output.data(), output.size())));
+	EXPECT_EQ(9, output[4]);
+	EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, BreadthFirstFrontier)
+{
+	// visits a 64 x 64 grid from a corner, level by level
+	const int side{ 64 };
+	std::vector<int> distance(side * side, -1);
+	nids::ring_buffer<int> frontier;
+	distance[0] = 0;
+	frontier.push_back(0);
+	while (!frontier.empty())
+	{
+		int cell = frontier.front();
+		frontier.pop_front();
+		int neighbors[] = { cell + 1, cell + side };
+		for (int neighbor : neighbors)
+			if ((neighbor != cell + 1 || neighbor % side != 0) && neighbor < side * side && distance[neighbor] < 0)
+			{
+				distance[neighbor] = distance[cell] + 1;
+				frontier.push_back(neighbor);
+			}
+	}
+	EXPECT_EQ(2 * (side - 1), distance.back());
+	EXPECT_LE(frontier.capacity(), 128);
+}
+
+//**************************************
+// SPSC ring buffer tests
+//**************************************
+TEST(SpscRingBuffer, SingleThreadedFifo)
+{
+	nids::spsc_ring_buffer<std::string> buffer(3);
+	ASSERT_EQ(4, buffer.capacity());
+	EXPECT_TRUE(buffer.empty());
+
+	std::string output;
+	EXPECT_FALSE(buffer.try_pop(output));
+	for (int index{ 0 }; index < 4; ++index)
+		EXPECT_TRUE(buffer.try_push(std::to_string(index)));
+	EXPECT_FALSE(buffer.try_push("full"));
+	EXPECT_EQ(4, buffer.size());
+
+	EXPECT_TRUE(buffer.try_pop(output));
+	EXPECT_EQ("0", output);
+	std::vector<std::string> more = { "4", "5" };
+	EXPECT_EQ(1, buffer.try_push(nids::span<const std::string>(more.data(), more.size())));
+
+	std::vector<std::string> all(10);
+	EXPECT_EQ(4, buffer.try_pop(nids::span<std::string>(all.data(), all.size())));
+	EXPECT_EQ("1", all[0]);
+	EXPECT_EQ("4", all[3]);
+	EXPECT_TRUE(buffer.empty());
+
+	// left over elements are destroyed with the buffer
+	buffer.try_push("left over");
+}
+
+TEST(SpscRingBuffer, HandsOffBetweenThreads)
+{
+	const uint64_t count{ 200000 };
+	nids::spsc_ring_buffer<uint64_t> buffer(1024);
+
+	std::thread producer([&buffer, count]
+	{
+		uint64_t batch[64];
+		uint64_t next{ 0 };
+		while (next < count)
+		{
+			// alternate single and bulk pushes
+			size_t pushed{ 0 };
+			if (next % 3 == 0)
+				pushed = buffer.try_push(next) ? 1 : 0;
+			else
+			{
+				size_t size{ 0 };
+				for (; size < 64 && next + size < count; ++size)
+					batch[size] = next + size;
+				pushed = buffer.try_push(nids::span<const uint64_t>(batch, size));
+			}
+			next += pushed;
+			// let the consumer run if it shares the core
+			if (pushed == 0)
+				std::this_thread::yield();
+		}
+	});
+
+	uint64_t expected{ 0 };
+	bool ordered{ true };
+	uint64_t batch[50];
+	while (expected < count)
+	{
+		size_t popped = buffer.try_pop(nids::span<uint64_t>(batch, 50));
+		for (size_t index{ 0 }; index < popped; ++index)
+			ordered = ordered && batch[index] == expected++;
+		uint64_t single;
+		if (buffer.try_pop(single))
+			ordered = ordered && single == expected++;
+		else if (popped == 0)
+			std::this_thread::yield();
+	}
+	producer.join();
+
+	EXPECT_TRUE(ordered);
+	EXPECT_EQ(count, expected);
+	EXPECT_TRUE(buffer.empty());
+}
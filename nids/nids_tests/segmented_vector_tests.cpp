@@ -0,0 +1,185 @@
+//**************************************
+// segmented_vector_tests.cpp
+//
+// Holds the unit tests for the
+// segmented_vector class and its
+// iterator
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <algorithm>
+#include <string>
+
+// small segments so the tests cross plenty of them
+template<typename Type>
+using small_segment_vector = nids::segmented_vector<Type, 8>;
+
+//**************************************
+// Push back tests
+//**************************************
+TEST(SegmentedVectorPush, IndexesAcrossSegments)
+{
+	small_segment_vector<int> v;
+	EXPECT_TRUE(v.empty());
+	for (int index{ 0 }; index < 1000; ++index)
+		v.push_back(index);
+	ASSERT_EQ(1000, v.size());
+	EXPECT_EQ(1000, v.capacity());
+	for (int index{ 0 }; index < 1000; ++index)
+		EXPECT_EQ(index, v[index]);
+	EXPECT_EQ(999, *v.back());
+}
+
+TEST(SegmentedVectorPush, ReferencesStayValid)
+{
+	small_segment_vector<std::string> v;
+	v.push_back("first");
+	std::string* first = &v[0];
+	std::string& firstRef = v[0];
+	for (int index{ 0 }; index < 500; ++index)
+		v.push_back(v[0]);
+	EXPECT_EQ(first, &v[0]);
+	EXPECT_EQ("first", firstRef);
+	EXPECT_EQ("first", v[500]);
+}
+
+TEST(SegmentedVectorPush, PushBackIAndEmplace)
+{
+	small_segment_vector<std::string> v;
+	v.push_back_i(std::string("a"));
+	v.emplace_back(3, 'b');
+	v.push_back_i(v[1]);
+	EXPECT_EQ(3, v.size());
+	EXPECT_EQ("bbb", v[2]);
+}
+
+TEST(SegmentedVectorPush, DefaultSegmentSize)
+{
+	EXPECT_EQ(16384, nids::default_segment_size<int>());
+	EXPECT_EQ(1, nids::default_segment_size<char[100000]>());
+}
+
+//**************************************
+// Capacity tests
+//**************************************
+TEST(SegmentedVectorCapacity, ReserveAndResize)
+{
+	small_segment_vector<int> v;
+	EXPECT_EQ(24, v.reserve(20));
+	for (int index{ 0 }; index < 20; ++index)
+		v.push_back(index);
+	EXPECT_EQ(16, v.resize(10));
+	EXPECT_EQ(10, v.size());
+	EXPECT_EQ(9, v[9]);
+	EXPECT_EQ(0, v.resize(0));
+	EXPECT_TRUE(v.empty());
+	v.push_back(5);
+	EXPECT_EQ(5, v[0]);
+}
+
+TEST(SegmentedVectorCapacity, ResizeDefaultInitAndPop)
+{
+	small_segment_vector<std::string> v;
+	v.resize_default_init(20);
+	EXPECT_EQ(20, v.size());
+	EXPECT_TRUE(v[19].empty());
+	v[19] = "last";
+	v.pop_back();
+	EXPECT_EQ(19, v.size());
+	v.clear();
+	EXPECT_TRUE(v.empty());
+	EXPECT_EQ(24, v.capacity());
+}
+
+TEST(SegmentedVectorCapacity, Segments)
+{
+	small_segment_vector<int> v;
+	for (int index{ 0 }; index < 20; ++index)
+		v.push_back(index);
+	ASSERT_EQ(3, v.segment_count());
+	EXPECT_EQ(8, v.segment(0).size());
+	EXPECT_EQ(4, v.segment(2).size());
+	EXPECT_EQ(16, v.segment(2)[0]);
+
+	int total{ 0 };
+	for (size_t segment{ 0 }; segment < v.segment_count(); ++segment)
+		total += nids::sum(v.segment(segment));
+	EXPECT_EQ(190, total);
+}
+
+//**************************************
+// Copy and move tests
+//**************************************
+TEST(SegmentedVectorCopy, CopyAndAssign)
+{
+	small_segment_vector<std::string> v;
+	for (int index{ 0 }; index < 30; ++index)
+		v.push_back(std::to_string(index));
+
+	small_segment_vector<std::string> copy(v);
+	ASSERT_EQ(30, copy.size());
+	EXPECT_EQ("29", copy[29]);
+	EXPECT_NE(&v[0], &copy[0]);
+
+	small_segment_vector<std::string> assigned;
+	assigned.push_back("gone");
+	assigned = v;
+	EXPECT_EQ(30, assigned.size());
+	EXPECT_EQ("0", assigned[0]);
+}
+
+TEST(SegmentedVectorCopy, MoveKeepsAddresses)
+{
+	small_segment_vector<int> v;
+	for (int index{ 0 }; index < 30; ++index)
+		v.push_back(index);
+	int* element = &v[17];
+
+	small_segment_vector<int> moved(std::move(v));
+	EXPECT_TRUE(v.empty());
+	EXPECT_EQ(element, &moved[17]);
+
+	small_segment_vector<int> empty;
+	small_segment_vector<int> movedEmpty(std::move(empty));
+	EXPECT_TRUE(movedEmpty.empty());
+
+	movedEmpty = std::move(moved);
+	EXPECT_EQ(element, &movedEmpty[17]);
+}
+
+//**************************************
+// Iterator tests
+//**************************************
+TEST(SegmentedVectorIterator, RandomAccess)
+{
+	small_segment_vector<int> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(99 - index);
+
+	EXPECT_EQ(100, v.end() - v.begin());
+	auto iter = v.begin() + 40;
+	EXPECT_EQ(59, *iter);
+	EXPECT_EQ(58, iter[1]);
+	iter -= 40;
+	EXPECT_TRUE(iter == v.begin());
+
+	std::sort(v.begin(), v.end());
+	for (int index{ 0 }; index < 100; ++index)
+		EXPECT_EQ(index, v[index]);
+	EXPECT_TRUE(std::binary_search(v.begin(), v.end(), 42));
+}
+
+TEST(SegmentedVectorIterator, ConstRangeFor)
+{
+	small_segment_vector<int> v;
+	for (int index{ 0 }; index < 20; ++index)
+		v.push_back(index);
+	const small_segment_vector<int>& view = v;
+	int total{ 0 };
+	for (int value : view)
+		total += value;
+	EXPECT_EQ(190, total);
+}
@@ -0,0 +1,295 @@
+//**************************************
+// serialize_tests.cpp
+//
+// Holds the unit tests for the binary
+// serialization functions, the
+// streaming writer and reader, and
+// serial_view
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+
+#ifndef _WIN32
+#include "../nids/serialize.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using nids_tests::TempFile;
+	using nids_tests::Pair;
+
+	//**************************************
+	// Reads the whole file at path
+	//**************************************
+	std::vector<unsigned char> ReadBytes(const std::string& path)
+	{
+		std::vector<unsigned char> bytes;
+		FILE* file = fopen(path.c_str(), "rb");
+		if (file == nullptr)
+			return bytes;
+		int value;
+		while ((value = fgetc(file)) != EOF)
+			bytes.push_back(static_cast<unsigned char>(value));
+		fclose(file);
+		return bytes;
+	}
+
+	//**************************************
+	// Replaces the file at path with bytes
+	//**************************************
+	void WriteBytes(const std::string& path, const std::vector<unsigned char>& bytes)
+	{
+		FILE* file = fopen(path.c_str(), "wb");
+		fwrite(bytes.data(), 1, bytes.size(), file);
+		fclose(file);
+	}
+
+	nids::vector<uint32_t> Numbers(uint32_t count)
+	{
+		nids::vector<uint32_t> numbers;
+		for (uint32_t index{ 0 }; index < count; ++index)
+			numbers.push_back(index * 7 + 1);
+		return numbers;
+	}
+}
+
+//**************************************
+// Checksum tests
+//**************************************
+TEST(SerialChecksum, MatchesKnownValues)
+{
+	EXPECT_EQ(0xEF46DB3751D8E999ull, nids::checksum64::of(nullptr, 0));
+	EXPECT_EQ(0xD24EC4F1A98C6E5Bull, nids::checksum64::of("a", 1));
+	EXPECT_EQ(0x44BC2CF5AD770999ull, nids::checksum64::of("abc", 3));
+	// a whole stripe, a 4 byte word, and loose bytes
+	EXPECT_EQ(0xFBCEA83C8A378BF1ull, nids::checksum64::of("Nobody inspects the spammish repetition", 39));
+}
+
+TEST(SerialChecksum, PiecesMatchOneShot)
+{
+	unsigned char bytes[1000];
+	for (size_t index{ 0 }; index < sizeof(bytes); ++index)
+		bytes[index] = static_cast<unsigned char>(index * 31 + 5);
+
+	for (size_t piece : { 1, 3, 7, 31, 32, 33, 100 })
+	{
+		nids::checksum64 sum;
+		for (size_t offset{ 0 }; offset < sizeof(bytes); offset += piece)
+			sum.update(bytes + offset, offset + piece < sizeof(bytes) ? piece : sizeof(bytes) - offset);
+		EXPECT_EQ(nids::checksum64::of(bytes, sizeof(bytes)), sum.digest()) << "piece " << piece;
+	}
+}
+
+//**************************************
+// Whole vector tests
+//**************************************
+TEST(SerialVector, RoundTrips)
+{
+	TempFile file("nids_serial_round.bin");
+	nids::vector<uint32_t> written = Numbers(10000);
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), written));
+
+	std::vector<unsigned char> bytes = ReadBytes(file.path);
+	EXPECT_EQ(sizeof(nids::serial_header) + sizeof(uint32_t) * written.size(), bytes.size());
+
+	nids::vector<uint32_t> read;
+	read.push_back(99);
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::read_vector(file.path.c_str(), read));
+	ASSERT_EQ(written.size(), read.size());
+	for (size_t index{ 0 }; index < written.size(); ++index)
+		ASSERT_EQ(written[index], read[index]);
+}
+
+TEST(SerialVector, RoundTripsStructsAndEmpty)
+{
+	TempFile file("nids_serial_structs.bin");
+	nids::vector<Pair> written;
+	for (int32_t index{ 0 }; index < 100; ++index)
+		written.push_back(Pair{ index, index * 0.5f });
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), written));
+
+	nids::vector<Pair> read;
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::read_vector(file.path.c_str(), read));
+	ASSERT_EQ(100, read.size());
+	EXPECT_EQ(42, read[42].key);
+	EXPECT_EQ(21.0f, read[42].value);
+
+	nids::vector<Pair> empty;
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), empty));
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::read_vector(file.path.c_str(), read));
+	EXPECT_TRUE(read.empty());
+}
+
+TEST(SerialVector, RejectsBadFiles)
+{
+	TempFile file("nids_serial_bad.bin");
+	nids::vector<uint32_t> read;
+	EXPECT_EQ(nids::SerialStatus::SERIAL_IO_ERROR, nids::read_vector(file.path.c_str(), read));
+
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), Numbers(100)));
+	nids::vector<uint64_t> wrongType;
+	EXPECT_EQ(nids::SerialStatus::SERIAL_WRONG_TYPE, nids::read_vector(file.path.c_str(), wrongType));
+
+	// one flipped bit in the elements
+	std::vector<unsigned char> bytes = ReadBytes(file.path);
+	bytes[sizeof(nids::serial_header) + 50] ^= 4;
+	WriteBytes(file.path, bytes);
+	EXPECT_EQ(nids::SerialStatus::SERIAL_BAD_CHECKSUM, nids::read_vector(file.path.c_str(), read));
+	EXPECT_TRUE(read.empty());
+
+	// cut short
+	bytes.resize(bytes.size() - 10);
+	WriteBytes(file.path, bytes);
+	EXPECT_EQ(nids::SerialStatus::SERIAL_IO_ERROR, nids::read_vector(file.path.c_str(), read));
+
+	bytes[0] = 'X';
+	WriteBytes(file.path, bytes);
+	EXPECT_EQ(nids::SerialStatus::SERIAL_BAD_FORMAT, nids::read_vector(file.path.c_str(), read));
+}
+
+TEST(SerialVector, SwapsForeignByteOrder)
+{
+	TempFile file("nids_serial_swap.bin");
+	nids::vector<uint32_t> written = Numbers(50);
+
+	// what a machine of the other endianness would have written
+	nids::serial_header header = nids::make_serial_header<uint32_t>(nids::SerialLayout::LAYOUT_FLAT, 0, 0);
+	nids::vector<uint32_t> swapped = written;
+	nids::byte_swap_elements(swapped.data(), swapped.size());
+	header.magic = nids::byte_swap(header.magic);
+	header.version = nids::byte_swap(header.version);
+	header.byteOrder = nids::byte_swap(header.byteOrder);
+	header.elementSize = nids::byte_swap(header.elementSize);
+	header.count = nids::byte_swap(uint64_t{ swapped.size() });
+	header.checksum = nids::byte_swap(nids::checksum64::of(swapped.data(), sizeof(uint32_t) * swapped.size()));
+
+	std::vector<unsigned char> bytes(sizeof(header) + sizeof(uint32_t) * swapped.size());
+	memcpy(bytes.data(), &header, sizeof(header));
+	memcpy(bytes.data() + sizeof(header), swapped.data(), sizeof(uint32_t) * swapped.size());
+	WriteBytes(file.path, bytes);
+
+	nids::vector<uint32_t> read;
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::read_vector(file.path.c_str(), read));
+	ASSERT_EQ(written.size(), read.size());
+	for (size_t index{ 0 }; index < written.size(); ++index)
+		ASSERT_EQ(written[index], read[index]);
+
+	nids::serial_view<uint32_t> view;
+	EXPECT_EQ(nids::SerialStatus::SERIAL_BYTE_ORDER, view.open(file.path.c_str()));
+}
+
+//**************************************
+// Streaming tests
+//**************************************
+TEST(SerialStream, ChunkedRoundTrip)
+{
+	TempFile file("nids_serial_stream.bin");
+	nids::vector<uint32_t> numbers = Numbers(1000);
+	{
+		int out = ::open(file.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		ASSERT_GE(out, 0);
+		nids::serial_writer<uint32_t> writer(out, 64);
+
+		// small writes are gathered, big ones go straight out
+		for (size_t index{ 0 }; index < 10; ++index)
+			writer.write(numbers[index]);
+		writer.write(nids::span<const uint32_t>(numbers.data() + 10, 300));
+		writer.write(nids::span<const uint32_t>(numbers.data() + 310, 690));
+		EXPECT_EQ(nids::SerialStatus::SERIAL_OK, writer.finish());
+		EXPECT_EQ(1000, writer.count());
+		::close(out);
+	}
+
+	// chunk by chunk, never more than 64 at a time
+	int in = ::open(file.path.c_str(), O_RDONLY);
+	ASSERT_GE(in, 0);
+	nids::serial_reader<uint32_t> reader(in);
+	nids::vector<uint32_t> chunk;
+	size_t total{ 0 };
+	while (reader.next(chunk) == nids::SerialStatus::SERIAL_OK)
+	{
+		EXPECT_LE(chunk.size(), 64);
+		for (size_t index{ 0 }; index < chunk.size(); ++index)
+			ASSERT_EQ(numbers[total + index], chunk[index]);
+		total += chunk.size();
+	}
+	EXPECT_EQ(nids::SerialStatus::SERIAL_END, reader.status());
+	EXPECT_EQ(1000, total);
+	::close(in);
+
+	// or all at once
+	nids::vector<uint32_t> read;
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::read_vector(file.path.c_str(), read));
+	ASSERT_EQ(1000, read.size());
+	EXPECT_EQ(numbers[999], read[999]);
+
+	// a view needs one flat block
+	nids::serial_view<uint32_t> view;
+	EXPECT_EQ(nids::SerialStatus::SERIAL_BAD_FORMAT, view.open(file.path.c_str()));
+}
+
+TEST(SerialStream, ReaderTakesFlatFiles)
+{
+	TempFile file("nids_serial_flat.bin");
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), Numbers(200)));
+
+	int in = ::open(file.path.c_str(), O_RDONLY);
+	ASSERT_GE(in, 0);
+	nids::serial_reader<uint32_t> reader(in);
+	nids::vector<uint32_t> chunk;
+	EXPECT_EQ(nids::SerialStatus::SERIAL_OK, reader.next(chunk));
+	EXPECT_EQ(200, chunk.size());
+	EXPECT_EQ(nids::SerialStatus::SERIAL_END, reader.next(chunk));
+	EXPECT_TRUE(chunk.empty());
+	::close(in);
+}
+
+//**************************************
+// View tests
+//**************************************
+TEST(SerialView, ViewsMappedFile)
+{
+	TempFile file("nids_serial_view.bin");
+	nids::vector<uint32_t> written = Numbers(5000);
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), written));
+
+	nids::serial_view<uint32_t> view;
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, view.open(file.path.c_str()));
+	EXPECT_TRUE(view.is_open());
+	EXPECT_EQ(nids::SerialStatus::SERIAL_OK, view.verify());
+	ASSERT_EQ(written.size(), view.size());
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(view.data()) % 64);
+
+	size_t index{ 0 };
+	for (uint32_t value : view)
+		ASSERT_EQ(written[index++], value);
+	EXPECT_EQ(written[4999], view.view()[4999]);
+
+	nids::serial_view<uint32_t> moved(std::move(view));
+	EXPECT_FALSE(view.is_open());
+	EXPECT_EQ(written[10], moved[10]);
+	moved.close();
+	EXPECT_FALSE(moved.is_open());
+}
+
+TEST(SerialView, ViewsBuffer)
+{
+	TempFile file("nids_serial_buffer.bin");
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, nids::write_vector(file.path.c_str(), Numbers(100)));
+	std::vector<unsigned char> bytes = ReadBytes(file.path);
+
+	nids::serial_view<uint32_t> view;
+	ASSERT_EQ(nids::SerialStatus::SERIAL_OK, view.open(bytes.data(), bytes.size()));
+	EXPECT_EQ(100, view.size());
+	EXPECT_EQ(Numbers(100)[37], view[37]);
+
+	bytes[sizeof(nids::serial_header)] ^= 1;
+	EXPECT_EQ(nids::SerialStatus::SERIAL_BAD_CHECKSUM, view.verify());
+	EXPECT_EQ(nids::SerialStatus::SERIAL_IO_ERROR, view.open(bytes.data(), bytes.size() - 4));
+}
+#endif
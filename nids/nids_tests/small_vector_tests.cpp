@@ -0,0 +1,201 @@
+//**************************************
+// small_vector_tests.cpp
+//
+// Holds the unit tests for the
+// small_vector class
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <string>
+
+//**************************************
+// Inline storage tests
+//**************************************
+TEST(SmallVectorInline, StartsInline)
+{
+	nids::small_vector<int, 8> v;
+	EXPECT_TRUE(v.is_inline());
+	EXPECT_EQ(8, v.capacity());
+	EXPECT_EQ(0, v.size());
+	EXPECT_TRUE(v.begin() == v.end());
+}
+
+TEST(SmallVectorInline, StaysInlineUpToCapacity)
+{
+	nids::small_vector<int, 8> v;
+	for (int index{ 0 }; index < 8; ++index)
+		v.push_back(index);
+	EXPECT_TRUE(v.is_inline());
+	for (int index{ 0 }; index < 8; ++index)
+		EXPECT_EQ(index, v[index]);
+}
+
+TEST(SmallVectorInline, SpillsToHeap)
+{
+	nids::small_vector<int, 4> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(index);
+	EXPECT_FALSE(v.is_inline());
+	EXPECT_EQ(100, v.size());
+	for (int index{ 0 }; index < 100; ++index)
+		EXPECT_EQ(index, v[index]);
+}
+
+TEST(SmallVectorInline, ShrinkMovesBackInline)
+{
+	nids::small_vector<std::string, 2> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(std::to_string(index));
+	EXPECT_FALSE(v.is_inline());
+	v.resize(2);
+	EXPECT_TRUE(v.is_inline());
+	EXPECT_EQ(2, v.size());
+	EXPECT_EQ("0", v[0]);
+	EXPECT_EQ("1", v[1]);
+}
+
+TEST(SmallVectorInline, ResizeInitializes)
+{
+	nids::small_vector<int, 2> v;
+	v.push_back(3);
+	v.resize(6, 9);
+	EXPECT_EQ(6, v.capacity());
+	EXPECT_EQ(3, v[0]);
+	EXPECT_EQ(9, v.data()[5]);
+}
+
+//**************************************
+// Copy and move tests
+//**************************************
+TEST(SmallVectorCopy, CopyInline)
+{
+	nids::small_vector<std::string, 4> v;
+	v.push_back("one");
+	v.push_back("two");
+	nids::small_vector<std::string, 4> w{ v };
+	EXPECT_TRUE(w.is_inline());
+	EXPECT_EQ(2, w.size());
+	EXPECT_EQ("two", w[1]);
+	EXPECT_EQ("two", v[1]);
+}
+
+TEST(SmallVectorCopy, CopyHeap)
+{
+	nids::small_vector<int, 2> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(index);
+	nids::small_vector<int, 2> w;
+	w.push_back(-1);
+	w = v;
+	EXPECT_EQ(10, w.size());
+	EXPECT_NE(v.data(), w.data());
+	EXPECT_EQ(9, w[9]);
+}
+
+TEST(SmallVectorCopy, MoveInline)
+{
+	nids::small_vector<std::string, 4> v;
+	v.push_back(std::string(40, 'x'));
+	nids::small_vector<std::string, 4> w{ std::move(v) };
+	EXPECT_EQ(0, v.size());
+	EXPECT_EQ(1, w.size());
+	EXPECT_EQ(std::string(40, 'x'), w[0]);
+}
+
+TEST(SmallVectorCopy, MoveHeapStealsBlock)
+{
+	nids::small_vector<int, 2> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(index);
+	const int* block = v.data();
+	nids::small_vector<int, 2> w;
+	w = std::move(v);
+	EXPECT_EQ(block, w.data());
+	EXPECT_TRUE(v.is_inline());
+	EXPECT_EQ(0, v.size());
+}
+
+//**************************************
+// Iteration and erase tests
+//**************************************
+TEST(SmallVectorIterate, IteratesInOrder)
+{
+	nids::small_vector<int, 4> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(index);
+	int expected{ 0 };
+	for (int value : v)
+		EXPECT_EQ(expected++, value);
+	EXPECT_EQ(10, expected);
+}
+
+TEST(SmallVectorIterate, EraseShiftsDown)
+{
+	nids::small_vector<int, 4> v;
+	for (int index{ 0 }; index < 4; ++index)
+		v.push_back(index);
+	auto next = v.erase(v.begin());
+	EXPECT_EQ(1, *next);
+	EXPECT_EQ(3, v.size());
+	EXPECT_EQ(3, v[2]);
+}
+
+TEST(SmallVectorIterate, InternalPushBackSurvivesSpill)
+{
+	nids::small_vector<std::string, 1> v;
+	v.push_back(std::string(40, 'y'));
+	for (int index{ 0 }; index < 8; ++index)
+		v.push_back_i(v[0]);
+	for (size_t index{ 0 }; index < v.size(); ++index)
+		EXPECT_EQ(std::string(40, 'y'), v[index]);
+}
+
+//**************************************
+// Bulk operation tests
+//**************************************
+TEST(SmallVectorBulk, AppendSpillsOnce)
+{
+	int source[10]{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	nids::small_vector<int, 4> v;
+	v.append(source, source + 3);
+	EXPECT_TRUE(v.is_inline());
+	v.append(source + 3, source + 10);
+	EXPECT_FALSE(v.is_inline());
+	EXPECT_EQ(10, v.size());
+	for (int index{ 0 }; index < 10; ++index)
+		EXPECT_EQ(index, v[index]);
+}
+
+TEST(SmallVectorBulk, InsertAndEmplace)
+{
+	std::string source[2]{ "b", "c" };
+	nids::small_vector<std::string, 2> v;
+	v.emplace_back("a");
+	v.emplace_back("d");
+	v.insert(v.begin() + 1, source, source + 2);
+	EXPECT_EQ(4, v.size());
+	EXPECT_EQ("a", v[0]);
+	EXPECT_EQ("b", v[1]);
+	EXPECT_EQ("c", v[2]);
+	EXPECT_EQ("d", v[3]);
+	EXPECT_EQ(v.capacity(), v.reserve(3));
+}
+
+//**************************************
+// Uninitialized resize tests
+//**************************************
+TEST(SmallVectorUninitialized, InlineAndHeap)
+{
+	nids::small_vector<uint8_t, 16> v;
+	v.resize_uninitialized(8);
+	EXPECT_TRUE(v.is_inline());
+	memset(v.data(), 0xAB, v.size());
+	v.resize_uninitialized(64);
+	EXPECT_FALSE(v.is_inline());
+	EXPECT_EQ(64, v.size());
+	for (size_t index{ 0 }; index < 8; ++index)
+		EXPECT_EQ(0xAB, v[index]);
+}
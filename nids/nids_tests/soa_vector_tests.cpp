@@ -0,0 +1,154 @@
+//**************************************
+// soa_vector_tests.cpp
+//
+// Holds the unit tests for the
+// soa_vector class and its zip
+// iterator
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+// id, weight, name
+using record_vector = nids::soa_vector<int, float, std::string>;
+
+//**************************************
+// Push back tests
+//**************************************
+TEST(SoaVectorPush, PushBackTuple)
+{
+	record_vector v;
+	EXPECT_TRUE(v.empty());
+	v.push_back(std::make_tuple(1, 0.5f, std::string("one")));
+	v.push_back({ 2, 1.5f, "two" });
+	EXPECT_EQ(2, v.size());
+	EXPECT_EQ(1, v.get<0>(0));
+	EXPECT_EQ(1.5f, v.get<1>(1));
+	EXPECT_EQ("two", v.get<2>(1));
+}
+
+TEST(SoaVectorPush, EmplaceBackAndGrow)
+{
+	record_vector v;
+	for (int index{ 0 }; index < 1000; ++index)
+		v.emplace_back(index, index * 0.25f, std::to_string(index));
+	ASSERT_EQ(1000, v.size());
+	for (int index{ 0 }; index < 1000; ++index)
+	{
+		auto [id, weight, name] = v[index];
+		EXPECT_EQ(index, id);
+		EXPECT_EQ(index * 0.25f, weight);
+		EXPECT_EQ(std::to_string(index), name);
+	}
+}
+
+TEST(SoaVectorPush, ReserveGrowsEveryColumn)
+{
+	record_vector v;
+	EXPECT_EQ(64, v.reserve(64));
+	v.emplace_back(1, 1.0f, "a");
+	EXPECT_EQ(64, v.capacity());
+}
+
+//**************************************
+// Column tests
+//**************************************
+TEST(SoaVectorColumn, ColumnsAreContiguous)
+{
+	nids::soa_vector<int, double> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.emplace_back(index, index * 2.0);
+
+	nids::span<int> ids = v.column<0>();
+	nids::span<double> values = v.column<1>();
+	ASSERT_EQ(100, ids.size());
+	ASSERT_EQ(100, values.size());
+	EXPECT_EQ(&v.get<0>(1), ids.data() + 1);
+	EXPECT_EQ(4950, nids::sum(ids));
+	EXPECT_EQ(9900.0, nids::sum(values));
+	EXPECT_EQ(99.0 * 2.0, nids::max_value(values));
+	EXPECT_EQ(42, nids::find(ids, 42));
+}
+
+TEST(SoaVectorColumn, WriteThroughColumn)
+{
+	nids::soa_vector<int, float> v;
+	for (int index{ 0 }; index < 50; ++index)
+		v.emplace_back(index, 0.0f);
+	nids::fill(v.column<1>(), 3.0f);
+	for (int index{ 0 }; index < 50; ++index)
+		EXPECT_EQ(3.0f, v.get<1>(index));
+
+	const nids::soa_vector<int, float>& view = v;
+	nids::span<const int> ids = view.column<0>();
+	EXPECT_EQ(49, ids.back());
+}
+
+//**************************************
+// Zip iterator tests
+//**************************************
+TEST(SoaVectorIterator, StructuredBindingsWriteThrough)
+{
+	record_vector v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.emplace_back(index, 1.0f, "x");
+
+	for (auto [id, weight, name] : v)
+	{
+		weight = static_cast<float>(id) * 2.0f;
+		name += std::to_string(id);
+	}
+	EXPECT_EQ(18.0f, v.get<1>(9));
+	EXPECT_EQ("x9", v.get<2>(9));
+}
+
+TEST(SoaVectorIterator, Arithmetic)
+{
+	nids::soa_vector<int, char> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.emplace_back(index, static_cast<char>('a' + index));
+
+	record_vector empty;
+	EXPECT_TRUE(empty.begin() == empty.end());
+
+	auto iter = v.begin();
+	EXPECT_EQ(10, v.end() - v.begin());
+	iter += 3;
+	EXPECT_EQ(3, std::get<0>(*iter));
+	EXPECT_EQ('e', std::get<1>(iter[1]));
+	EXPECT_EQ('c', std::get<1>(*iter.previous()));
+	EXPECT_TRUE(iter < iter.next());
+	EXPECT_EQ(9, std::get<0>(*(v.end() - 1)));
+	EXPECT_EQ(-10, v.begin() - v.end());
+}
+
+TEST(SoaVectorIterator, StdAlgorithms)
+{
+	nids::soa_vector<int, char> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.emplace_back(index, static_cast<char>('a' + index));
+
+	static_assert(std::is_same_v<ptrdiff_t, std::iterator_traits<nids::soa_vector<int, char>::iterator>::difference_type>);
+	EXPECT_EQ(10, std::distance(v.begin(), v.end()));
+	EXPECT_EQ(5, std::count_if(v.begin(), v.end(), [](const auto& record) { return std::get<0>(record) % 2 == 0; }));
+	auto found = std::find_if(v.begin(), v.end(), [](const auto& record) { return std::get<1>(record) == 'g'; });
+	EXPECT_EQ(6, found.index());
+}
+
+TEST(SoaVectorIterator, ConstIteration)
+{
+	nids::soa_vector<int, int> v;
+	for (int index{ 0 }; index < 5; ++index)
+		v.emplace_back(index, index * index);
+
+	const nids::soa_vector<int, int>& view = v;
+	int total{ 0 };
+	for (auto [value, square] : view)
+		total += value + square;
+	EXPECT_EQ(10 + 30, total);
+}
@@ -0,0 +1,198 @@
+//**************************************
+// sort_tests.cpp
+//
+// Holds the unit tests for nids::sort,
+// the radix sort, and pdqsort
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// below, at, and well above the radix threshold
+	const size_t SIZES[] = { 0, 1, 2, 23, 500, nids::RADIX_SORT_THRESHOLD, 100000 };
+
+	//**************************************
+	// Builds count random values of Type,
+	// covering negatives and the extremes
+	//**************************************
+	template<typename Type>
+	std::vector<Type> RandomValues(size_t count)
+	{
+		std::mt19937_64 random(count);
+		std::vector<Type> values;
+		for (size_t index{ 0 }; index < count; ++index)
+		{
+			if constexpr (std::is_floating_point_v<Type>)
+				values.push_back(static_cast<Type>(std::uniform_real_distribution<double>(-1e6, 1e6)(random)));
+			else
+				values.push_back(static_cast<Type>(random()));
+		}
+		if (count > 3)
+		{
+			values[0] = std::numeric_limits<Type>::lowest();
+			values[1] = std::numeric_limits<Type>::max();
+			values[2] = 0;
+		}
+		return values;
+	}
+
+	//**************************************
+	// Checks nids::sort against std::sort
+	// for one type
+	//**************************************
+	template<typename Type>
+	void ExpectSortsLikeStd()
+	{
+		for (size_t size : SIZES)
+		{
+			std::vector<Type> values = RandomValues<Type>(size);
+			nids::vector<Type> v;
+			v.reserve(size);
+			for (Type value : values)
+				v.push_back(value);
+
+			std::sort(values.begin(), values.end());
+			nids::sort(v.begin(), v.end());
+			ASSERT_EQ(size, v.size());
+			for (size_t index{ 0 }; index < size; ++index)
+				ASSERT_EQ(values[index], v[index]) << "size " << size << " index " << index;
+		}
+	}
+}
+
+//**************************************
+// Radix sort tests
+//**************************************
+TEST(SortRadix, Int8) { ExpectSortsLikeStd<int8_t>(); }
+TEST(SortRadix, UInt8) { ExpectSortsLikeStd<uint8_t>(); }
+TEST(SortRadix, Int16) { ExpectSortsLikeStd<int16_t>(); }
+TEST(SortRadix, Int32) { ExpectSortsLikeStd<int32_t>(); }
+TEST(SortRadix, UInt32) { ExpectSortsLikeStd<uint32_t>(); }
+TEST(SortRadix, Int64) { ExpectSortsLikeStd<int64_t>(); }
+TEST(SortRadix, UInt64) { ExpectSortsLikeStd<uint64_t>(); }
+TEST(SortRadix, Float) { ExpectSortsLikeStd<float>(); }
+TEST(SortRadix, Double) { ExpectSortsLikeStd<double>(); }
+
+TEST(SortRadix, KeysKeepOrder)
+{
+	EXPECT_LT(nids::radix_key(-1), nids::radix_key(0));
+	EXPECT_LT(nids::radix_key(-2.5f), nids::radix_key(-1.0f));
+	EXPECT_LT(nids::radix_key(-1.0), nids::radix_key(1.0));
+	EXPECT_LT(nids::radix_key(1.0), nids::radix_key(2.0));
+	EXPECT_LT(nids::radix_key(std::numeric_limits<int64_t>::min()), nids::radix_key(std::numeric_limits<int64_t>::max()));
+}
+
+TEST(SortRadix, ReusesScratch)
+{
+	nids::vector<int> scratch;
+	for (int round{ 0 }; round < 3; ++round)
+	{
+		std::vector<int> values = RandomValues<int>(5000);
+		nids::vector<int> v;
+		for (int value : values)
+			v.push_back(value);
+		nids::sort(v.begin(), v.end(), scratch);
+		EXPECT_TRUE(std::is_sorted(v.data(), v.data() + v.size()));
+		EXPECT_EQ(5000, scratch.size());
+	}
+}
+
+TEST(SortRadix, AllEqualSkipsPasses)
+{
+	nids::vector<uint64_t> v;
+	for (int index{ 0 }; index < 5000; ++index)
+		v.push_back(0x0102030405060708ull);
+	nids::sort(v);
+	for (size_t index{ 0 }; index < v.size(); ++index)
+		ASSERT_EQ(0x0102030405060708ull, v[index]);
+}
+
+//**************************************
+// pdqsort tests
+//**************************************
+TEST(SortPdq, CustomCompare)
+{
+	for (size_t size : SIZES)
+	{
+		std::vector<int> values = RandomValues<int>(size);
+		std::vector<int> expected = values;
+		std::sort(expected.begin(), expected.end(), std::greater<>());
+		nids::sort(values.data(), values.data() + values.size(), std::greater<>());
+		EXPECT_EQ(expected, values);
+	}
+}
+
+TEST(SortPdq, Strings)
+{
+	std::mt19937 random(3);
+	nids::vector<std::string> v;
+	std::vector<std::string> expected;
+	for (int index{ 0 }; index < 3000; ++index)
+	{
+		std::string value = std::to_string(random() % 500);
+		v.push_back(value);
+		expected.push_back(value);
+	}
+	std::sort(expected.begin(), expected.end());
+	nids::sort(v.begin(), v.end());
+	for (size_t index{ 0 }; index < expected.size(); ++index)
+		ASSERT_EQ(expected[index], v[index]);
+}
+
+TEST(SortPdq, Patterns)
+{
+	const size_t SIZE = 20000;
+	std::vector<std::vector<int>> patterns(5);
+	for (size_t index{ 0 }; index < SIZE; ++index)
+	{
+		patterns[0].push_back(static_cast<int>(index));
+		patterns[1].push_back(static_cast<int>(SIZE - index));
+		patterns[2].push_back(7);
+		patterns[3].push_back(static_cast<int>(index < SIZE / 2 ? index : SIZE - index));
+		patterns[4].push_back(static_cast<int>(index % 16));
+	}
+	for (std::vector<int>& pattern : patterns)
+	{
+		std::vector<int> expected = pattern;
+		std::sort(expected.begin(), expected.end(), std::greater<>());
+		nids::pdqsort(pattern.begin(), pattern.end(), std::greater<>());
+		EXPECT_EQ(expected, pattern);
+	}
+}
+
+TEST(SortPdq, NonContiguousIterators)
+{
+	nids::segmented_vector<int, 8> v;
+	std::vector<int> expected = RandomValues<int>(1000);
+	for (int value : expected)
+		v.push_back(value);
+	std::sort(expected.begin(), expected.end());
+	nids::sort(v.begin(), v.end());
+	for (size_t index{ 0 }; index < expected.size(); ++index)
+		ASSERT_EQ(expected[index], v[index]);
+}
+
+//**************************************
+// Iterator trait tests
+//**************************************
+TEST(SortIterator, StdSortAcceptsVectorIterator)
+{
+	static_assert(std::is_same_v<std::iterator_traits<nids::vector<int>::iterator>::iterator_category, std::random_access_iterator_tag>);
+	static_assert(std::is_same_v<std::iterator_traits<nids::vector<int>::iterator>::difference_type, ptrdiff_t>);
+
+	nids::vector<int> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(100 - index);
+	std::sort(v.begin(), v.end());
+	EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+	EXPECT_EQ(100, std::distance(v.begin(), v.end()));
+}
@@ -0,0 +1,248 @@
+//**************************************
+// span_tests.cpp
+//
+// Holds the unit tests for span,
+// strided_span, and the vectors and
+// algorithms that take them
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Point
+	{
+		float x;
+		float y;
+		int32_t id;
+	};
+
+	nids::vector<int> Numbers(int count)
+	{
+		nids::vector<int> numbers;
+		for (int index{ 0 }; index < count; ++index)
+			numbers.push_back(index);
+		return numbers;
+	}
+
+	//**************************************
+	// Takes a span the way library code
+	// would, to check what converts to one
+	//**************************************
+	int SumOf(nids::span<const int> elements)
+	{
+		int total{ 0 };
+		for (int element : elements)
+			total += element;
+		return total;
+	}
+}
+
+//**************************************
+// Span tests
+//**************************************
+TEST(Span, ContainersConvert)
+{
+	nids::vector<int> numbers = Numbers(10);
+	EXPECT_EQ(45, SumOf(numbers));
+
+	nids::small_vector<int, 4> small;
+	small.push_back(3);
+	small.push_back(4);
+	EXPECT_EQ(7, SumOf(small));
+
+	nids::span<int> writable = numbers;
+	writable[0] = 100;
+	EXPECT_EQ(100, numbers[0]);
+	EXPECT_EQ(numbers.data(), writable.data());
+	EXPECT_EQ(145, SumOf(writable));
+
+	// only the same element type converts, a base class span would misstep
+	struct Derived : Point { int32_t extra; };
+	static_assert(std::is_convertible_v<nids::vector<Point>&, nids::span<const Point>>);
+	static_assert(!std::is_convertible_v<nids::vector<Derived>&, nids::span<Point>>);
+	static_assert(!std::is_convertible_v<const nids::vector<int>&, nids::span<int>>);
+}
+
+TEST(Span, PointerConstructors)
+{
+	int numbers[] = { 1, 2, 3, 4 };
+	nids::span<int> none(numbers, 0);
+	EXPECT_TRUE(none.empty());
+	EXPECT_EQ(numbers, none.data());
+
+	nids::span<int> counted(numbers, 3);
+	EXPECT_EQ(3, counted.size());
+	nids::span<const int> ranged(numbers + 1, numbers + 4);
+	EXPECT_EQ(3, ranged.size());
+	EXPECT_EQ(9, SumOf(ranged));
+}
+
+TEST(Span, SlicesWithoutCopying)
+{
+	nids::vector<int> numbers = Numbers(100);
+	nids::span<int> middle = numbers.view(10, 20);
+	EXPECT_EQ(numbers.data() + 10, middle.data());
+	EXPECT_EQ(20, middle.size());
+
+	EXPECT_EQ(10, middle.first(3)[0]);
+	EXPECT_EQ(27, middle.last(3)[0]);
+	EXPECT_EQ(25, middle.subspan(15).front());
+	EXPECT_EQ(5, middle.subspan(15).size());
+
+	const nids::vector<int>& constant = numbers;
+	nids::span<const int> all = constant.view();
+	EXPECT_EQ(100, all.size());
+	EXPECT_EQ(99, all.back());
+}
+
+TEST(Span, PartsCoverEverythingOnce)
+{
+	nids::vector<int> numbers = Numbers(103);
+	nids::span<int> all = numbers.view();
+	size_t next{ 0 };
+	for (size_t part{ 0 }; part < 4; ++part)
+	{
+		nids::span<int> piece = all.part(part, 4);
+		EXPECT_EQ(all.data() + next, piece.data());
+		EXPECT_TRUE(piece.size() == 25 || piece.size() == 26);
+		next += piece.size();
+	}
+	EXPECT_EQ(103, next);
+	EXPECT_EQ(0, nids::span<int>().part(2, 3).size());
+}
+
+TEST(Span, WorkersTakeParts)
+{
+	nids::vector<int> numbers = Numbers(10000);
+	nids::span<int> all = numbers.view();
+	std::vector<std::thread> workers;
+	for (size_t part{ 0 }; part < 4; ++part)
+		workers.emplace_back([piece = all.part(part, 4)] { nids::fill(piece, 1); });
+	for (std::thread& worker : workers)
+		worker.join();
+	EXPECT_EQ(10000, nids::count(numbers, 1));
+}
+
+//**************************************
+// Strided span tests
+//**************************************
+TEST(StridedSpan, ViewsStructFields)
+{
+	nids::vector<Point> points;
+	for (int32_t index{ 0 }; index < 10; ++index)
+		points.push_back(Point{ index * 1.0f, index * 2.0f, index });
+
+	nids::strided_span<float> ys = nids::member_span(points, &Point::y);
+	EXPECT_EQ(10, ys.size());
+	EXPECT_EQ(static_cast<ptrdiff_t>(sizeof(Point)), ys.stride());
+	EXPECT_FALSE(ys.is_contiguous());
+	EXPECT_EQ(18.0f, ys.back());
+
+	ys[3] = -1.0f;
+	EXPECT_EQ(-1.0f, points[3].y);
+	EXPECT_EQ(3.0f, points[3].x);
+
+	const nids::vector<Point>& constant = points;
+	nids::strided_span<const int32_t> ids = nids::member_span(constant, &Point::id);
+	size_t index{ 0 };
+	for (int32_t id : ids)
+		EXPECT_EQ(static_cast<int32_t>(index++), id);
+	EXPECT_EQ(10, index);
+	EXPECT_EQ(10, ids.end() - ids.begin());
+}
+
+TEST(StridedSpan, EveryAndReversed)
+{
+	nids::vector<int> numbers = Numbers(10);
+	nids::strided_span<int> all(numbers.view());
+	EXPECT_TRUE(all.is_contiguous());
+
+	nids::strided_span<int> evens = all.every(2);
+	ASSERT_EQ(5, evens.size());
+	EXPECT_EQ(8, evens[4]);
+	EXPECT_EQ(4, all.every(3).size());
+	EXPECT_EQ(9, all.every(3).back());
+
+	nids::strided_span<const int> backwards = all.reversed();
+	EXPECT_EQ(9, backwards.front());
+	EXPECT_EQ(0, backwards.back());
+	EXPECT_EQ(6, backwards.subspan(2, 3)[1]);
+	EXPECT_TRUE(nids::strided_span<int>().reversed().empty());
+}
+
+TEST(StridedSpan, Algorithms)
+{
+	nids::vector<Point> points;
+	for (int32_t index{ 0 }; index < 37; ++index)
+		points.push_back(Point{ static_cast<float>(index % 5), 0.0f, index });
+
+	nids::strided_span<int32_t> ids = nids::member_span(points, &Point::id);
+	EXPECT_EQ(36 * 37 / 2, nids::sum(ids));
+	EXPECT_EQ(0, nids::min_value(ids));
+	EXPECT_EQ(36, nids::max_value(ids));
+	EXPECT_EQ(12, nids::find(ids, 12));
+	EXPECT_EQ(37, nids::find(ids, 99));
+
+	nids::strided_span<float> xs = nids::member_span(points, &Point::x);
+	EXPECT_EQ(8, nids::count(xs, 0.0f));
+	nids::fill(xs, 2.5f);
+	EXPECT_EQ(37, nids::count(xs, 2.5f));
+	EXPECT_EQ(36, points[36].id);
+
+	nids::vector<int> numbers = Numbers(37);
+	nids::strided_span<int> packed(numbers.view());
+	EXPECT_EQ(36 * 37 / 2, nids::sum(packed));
+	EXPECT_TRUE(nids::equal(ids, packed));
+	numbers[5] = 0;
+	EXPECT_FALSE(nids::equal(ids, packed));
+}
+
+//**************************************
+// Container tests
+//**************************************
+TEST(SpanContainers, AlgorithmsTakeSlices)
+{
+	nids::vector<int> numbers = Numbers(1000);
+	EXPECT_EQ(10 + 11 + 12, nids::sum(numbers.view(10, 3)));
+	EXPECT_EQ(3, nids::find(numbers.view(500, 100), 503));
+
+	// sorting a slice leaves the rest alone
+	for (int index{ 0 }; index < 100; ++index)
+		numbers[index] = 99 - index;
+	nids::sort(numbers.view(0, 50));
+	EXPECT_EQ(50, numbers[0]);
+	EXPECT_EQ(99, numbers[49]);
+	EXPECT_EQ(49, numbers[50]);
+}
+
+TEST(SpanContainers, AppendSpans)
+{
+	nids::vector<int> numbers = Numbers(10);
+	nids::vector<int> copy;
+	copy.append(numbers.view(2, 3));
+	ASSERT_EQ(3, copy.size());
+	EXPECT_EQ(4, copy[2]);
+
+	// a slice of itself survives the growth
+	numbers.append(numbers.view(0, 10));
+	EXPECT_EQ(20, numbers.size());
+	EXPECT_EQ(9, numbers[19]);
+
+	nids::segmented_vector<int, 8> segmented;
+	segmented.push_back(-1);
+	segmented.append(numbers);
+	ASSERT_EQ(21, segmented.size());
+	EXPECT_EQ(0, segmented[1]);
+	EXPECT_EQ(9, segmented[20]);
+	EXPECT_EQ(3, segmented.segment_count());
+
+	segmented.append(segmented.segment(0));
+	EXPECT_EQ(29, segmented.size());
+	EXPECT_EQ(-1, segmented[21]);
+}
@@ -0,0 +1,38 @@
+//**************************************
+// test_files.h
+//
+// Holds the fixtures shared by the
+// tests that write files: a scratch
+// file that cleans up after itself,
+// and a small record to store in it
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include "gtest/gtest.h"
+
+namespace nids_tests
+{
+	//**************************************
+	// Scratch file that is deleted when
+	// the test ends
+	//**************************************
+	struct TempFile
+	{
+		std::string path;
+
+		TempFile(const char* name) : path(testing::TempDir() + name) { remove(path.c_str()); }
+		~TempFile() { remove(path.c_str()); }
+	};
+
+	struct Pair
+	{
+		int32_t key;
+		float value;
+	};
+}
@@ -0,0 +1,493 @@
+//**************************************
+// vector_tests.cpp
+//
+// Holds the unit tests for the
+// vector class
+//
+// Author: Nathan Ikola
+// nathan.ikola@gmail.com
+//**************************************
+
+#include "pch.h"
+#include <string>
+#include <vector>
+
+//**************************************
+// Helper type that counts how many
+// instances are currently alive
+//**************************************
+struct LiveCounter
+{
+	static inline int alive = 0;
+	int value;
+
+	LiveCounter(int v) : value(v) { ++alive; }
+	LiveCounter(const LiveCounter& rhs) : value(rhs.value) { ++alive; }
+	LiveCounter(LiveCounter&& rhs) noexcept : value(rhs.value) { rhs.value = -1; ++alive; }
+	LiveCounter& operator=(const LiveCounter&) = default;
+	~LiveCounter() { --alive; }
+};
+
+//**************************************
+// Relocation tests
+//**************************************
+TEST(VectorRelocation, TrivialTypeTraits)
+{
+	EXPECT_TRUE(nids::is_trivially_relocatable_v<int>);
+	EXPECT_FALSE(nids::is_trivially_relocatable_v<std::string>);
+	EXPECT_FALSE(nids::is_trivially_relocatable_v<LiveCounter>);
+}
+
+TEST(VectorRelocation, StringsSurviveGrowth)
+{
+	nids::vector<std::string> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(std::string(32, static_cast<char>('a' + index % 26)));
+
+	EXPECT_EQ(100, v.size());
+	for (int index{ 0 }; index < 100; ++index)
+		EXPECT_EQ(std::string(32, static_cast<char>('a' + index % 26)), v[index]);
+}
+
+TEST(VectorRelocation, StringCopyIsDeep)
+{
+	nids::vector<std::string> v;
+	v.push_back("first string that is too long for small buffer optimization");
+	nids::vector<std::string> w{ v };
+	w[0][0] = 'F';
+	EXPECT_EQ('f', v[0][0]);
+	EXPECT_EQ('F', w[0][0]);
+}
+
+TEST(VectorRelocation, StringCopyAssign)
+{
+	nids::vector<std::string> v;
+	v.push_back("one");
+	v.push_back("two");
+	nids::vector<std::string> w;
+	w.push_back("three");
+	w = v;
+	EXPECT_EQ(2, w.size());
+	EXPECT_EQ("one", w[0]);
+	EXPECT_EQ("two", w[1]);
+}
+
+TEST(VectorRelocation, PushBackMovesRvalue)
+{
+	nids::vector<std::string> v;
+	std::string s(64, 'x');
+	v.push_back(std::move(s));
+	EXPECT_EQ(std::string(64, 'x'), v[0]);
+	EXPECT_TRUE(s.empty());
+}
+
+TEST(VectorRelocation, InternalPushBackSurvivesGrowth)
+{
+	nids::vector<std::string> v;
+	v.push_back("internal reference that is longer than the inline buffer");
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back_i(v[0]);
+	for (size_t index{ 0 }; index < v.size(); ++index)
+		EXPECT_EQ(v[0], v[index]);
+}
+
+TEST(VectorRelocation, DestructorsRun)
+{
+	LiveCounter::alive = 0;
+	{
+		nids::vector<LiveCounter> v;
+		for (int index{ 0 }; index < 50; ++index)
+			v.push_back(LiveCounter{ index });
+		EXPECT_EQ(50, LiveCounter::alive);
+		for (int index{ 0 }; index < 50; ++index)
+			EXPECT_EQ(index, v[index].value);
+	}
+	EXPECT_EQ(0, LiveCounter::alive);
+}
+
+TEST(VectorRelocation, ShrinkingDestroysTail)
+{
+	LiveCounter::alive = 0;
+	nids::vector<LiveCounter> v;
+	for (int index{ 0 }; index < 10; ++index)
+		v.push_back(LiveCounter{ index });
+	v.resize(4);
+	EXPECT_EQ(4, v.size());
+	EXPECT_EQ(4, LiveCounter::alive);
+	v.resize(0);
+	EXPECT_EQ(0, LiveCounter::alive);
+}
+
+TEST(VectorRelocation, TrivialResizeInitializes)
+{
+	nids::vector<int> v;
+	v.push_back(7);
+	v.resize(8, 42);
+	EXPECT_EQ(8, v.capacity());
+	EXPECT_EQ(7, v[0]);
+	EXPECT_EQ(42, v.data()[7]);
+}
+
+//**************************************
+// Growth policy tests
+//**************************************
+TEST(VectorGrowth, DefaultTriples)
+{
+	nids::vector<int> v;
+	v.push_back(1);
+	EXPECT_EQ(3, v.capacity());
+	v.push_back(2);
+	v.push_back(3);
+	EXPECT_EQ(3, v.capacity());
+	v.push_back(4);
+	EXPECT_EQ(9, v.capacity());
+}
+
+TEST(VectorGrowth, GeometricPolicies)
+{
+	EXPECT_EQ(1, nids::growth_2x::next_capacity(0, sizeof(int)));
+	EXPECT_EQ(16, nids::growth_2x::next_capacity(8, sizeof(int)));
+	EXPECT_EQ(2, nids::growth_1_5x::next_capacity(1, sizeof(int)));
+	EXPECT_EQ(15, nids::growth_1_5x::next_capacity(10, sizeof(int)));
+	EXPECT_EQ(1618, nids::growth_golden::next_capacity(1000, sizeof(int)));
+	EXPECT_EQ(8, (nids::geometric_growth<2, 1, 8>::next_capacity(0, sizeof(int))));
+}
+
+TEST(VectorGrowth, GeometricPolicyDoesNotOverflow)
+{
+	const size_t large = std::numeric_limits<size_t>::max() / 2;
+	EXPECT_GT(nids::growth_1_5x::next_capacity(large, 1), large);
+}
+
+TEST(VectorGrowth, FixedChunkPolicy)
+{
+	nids::vector<int, nids::fixed_chunk_growth<64>> v;
+	for (int index{ 0 }; index < 65; ++index)
+		v.push_back(index);
+	EXPECT_EQ(128, v.capacity());
+	EXPECT_EQ(64, v[64]);
+}
+
+TEST(VectorGrowth, PageRoundedPolicy)
+{
+	// small allocations are left alone
+	EXPECT_EQ(2, nids::growth_paged::next_capacity(1, sizeof(int)));
+	// 3000 * 2 * 4 bytes rounds up to 6 pages
+	EXPECT_EQ(6 * 4096 / sizeof(int), nids::growth_paged::next_capacity(3000, sizeof(int)));
+}
+
+TEST(VectorGrowth, PolicyVectorIterates)
+{
+	nids::vector<int, nids::growth_2x> v;
+	for (int index{ 0 }; index < 100; ++index)
+		v.push_back(index);
+	int expected{ 0 };
+	for (auto iter = v.begin(); iter != v.end(); ++iter)
+		EXPECT_EQ(expected++, *iter);
+	EXPECT_EQ(128, v.capacity());
+}
+
+//**************************************
+// Erase tests
+//**************************************
+TEST(VectorErase, EraseMiddle)
+{
+	nids::vector<int> v;
+	for (int index{ 0 }; index < 5; ++index)
+		v.push_back(index);
+	auto next = v.erase(v.begin() + 2);
+	EXPECT_EQ(3, *next);
+	EXPECT_EQ(4, v.size());
+	EXPECT_EQ(1, v[1]);
+	EXPECT_EQ(3, v[2]);
+	EXPECT_EQ(4, v[3]);
+}
+
+TEST(VectorErase, EraseLastReturnsEnd)
+{
+	nids::vector<std::string> v;
+	v.push_back("a");
+	v.push_back("b");
+	auto next = v.erase(v.begin() + 1);
+	EXPECT_TRUE(next == v.end());
+	EXPECT_EQ(1, v.size());
+	EXPECT_EQ("a", v[0]);
+}
+
+//**************************************
+// Bulk operation tests
+//**************************************
+TEST(VectorBulk, ReserveOnlyGrows)
+{
+	nids::vector<int> v;
+	EXPECT_EQ(100, v.reserve(100));
+	EXPECT_EQ(0, v.size());
+	EXPECT_EQ(100, v.reserve(10));
+}
+
+TEST(VectorBulk, AppendPointerRangeGrowsOnce)
+{
+	int source[1000];
+	for (int index{ 0 }; index < 1000; ++index)
+		source[index] = index;
+
+	nids::vector<int> v;
+	v.push_back(-1);
+	v.append(source, source + 1000);
+	EXPECT_EQ(1001, v.size());
+	EXPECT_EQ(1001, v.capacity());
+	EXPECT_EQ(-1, v[0]);
+	EXPECT_EQ(999, v[1000]);
+}
+
+TEST(VectorBulk, AppendFromStdContainer)
+{
+	std::vector<std::string> source{ "a", "b", "c" };
+	nids::vector<std::string> v;
+	v.append(source.begin(), source.end());
+	EXPECT_EQ(3, v.size());
+	EXPECT_EQ("c", v[2]);
+}
+
+TEST(VectorBulk, AppendSelf)
+{
+	nids::vector<std::string> v;
+	v.push_back("first string long enough to live on the heap");
+	v.push_back("second string long enough to live on the heap");
+	v.append(v.begin(), v.end());
+	EXPECT_EQ(4, v.size());
+	EXPECT_EQ(v[0], v[2]);
+	EXPECT_EQ(v[1], v[3]);
+}
+
+TEST(VectorBulk, InsertMiddle)
+{
+	int source[3]{ 10, 11, 12 };
+	nids::vector<int> v;
+	for (int index{ 0 }; index < 4; ++index)
+		v.push_back(index);
+	auto first = v.insert(v.begin() + 2, source, source + 3);
+	EXPECT_EQ(10, *first);
+	int expected[7]{ 0, 1, 10, 11, 12, 2, 3 };
+	EXPECT_EQ(7, v.size());
+	for (int index{ 0 }; index < 7; ++index)
+		EXPECT_EQ(expected[index], v[index]);
+}
+
+TEST(VectorBulk, InsertNonTrivial)
+{
+	std::vector<std::string> source{ "x", "y" };
+	nids::vector<std::string> v;
+	v.push_back("a");
+	v.push_back("b");
+	v.insert(v.begin(), source.begin(), source.end());
+	EXPECT_EQ(4, v.size());
+	EXPECT_EQ("x", v[0]);
+	EXPECT_EQ("y", v[1]);
+	EXPECT_EQ("a", v[2]);
+	EXPECT_EQ("b", v[3]);
+}
+
+TEST(VectorBulk, InsertAtEnd)
+{
+	int source[2]{ 7, 8 };
+	nids::vector<int> v;
+	v.push_back(1);
+	v.insert(v.end(), source, source + 2);
+	EXPECT_EQ(3, v.size());
+	EXPECT_EQ(8, v[2]);
+}
+
+TEST(VectorBulk, EmplaceBack)
+{
+	nids::vector<std::string> v;
+	std::string& s = v.emplace_back(5, 'z');
+	EXPECT_EQ("zzzzz", s);
+	v.emplace_back("abc");
+	EXPECT_EQ(2, v.size());
+	EXPECT_EQ("abc", v[1]);
+}
+
+//**************************************
+// Mapped growth tests
+//**************************************
+// maps anything from one page up, so the tests stay small
+using mapped_int_vector = nids::vector<int, nids::growth_2x, nids::mremap_allocator<4096>>;
+
+TEST(VectorMappedGrowth, CrossesThresholdAndGrows)
+{
+	mapped_int_vector v;
+	for (int index{ 0 }; index < 1000000; ++index)
+		v.push_back(index);
+	for (int index{ 0 }; index < 1000000; ++index)
+		ASSERT_EQ(index, v[index]);
+}
+
+TEST(VectorMappedGrowth, ShrinksBackUnderThreshold)
+{
+	mapped_int_vector v;
+	for (int index{ 0 }; index < 5000; ++index)
+		v.push_back(index);
+	v.resize(100);
+	EXPECT_EQ(100, v.size());
+	for (int index{ 0 }; index < 100; ++index)
+		EXPECT_EQ(index, v[index]);
+	v.push_back(100);
+	EXPECT_EQ(100, v[100]);
+}
+
+TEST(VectorMappedGrowth, NonTrivialElements)
+{
+	nids::vector<std::string, nids::growth_2x, nids::mremap_allocator<4096>> v;
+	for (int index{ 0 }; index < 10000; ++index)
+		v.push_back(std::to_string(index));
+	for (int index{ 0 }; index < 10000; ++index)
+		ASSERT_EQ(std::to_string(index), v[index]);
+}
+
+TEST(VectorMappedGrowth, CopyAndMove)
+{
+	mapped_int_vector v;
+	for (int index{ 0 }; index < 50000; ++index)
+		v.push_back(index);
+	mapped_int_vector copy(v);
+	mapped_int_vector moved(std::move(v));
+	EXPECT_TRUE(nids::equal(copy, moved));
+	EXPECT_EQ(50000, copy.size());
+}
+
+//**************************************
+// Uninitialized resize tests
+//**************************************
+TEST(VectorUninitialized, SetsSizeAndKeepsData)
+{
+	nids::vector<int> v;
+	v.push_back(1);
+	v.push_back(2);
+	EXPECT_EQ(100, v.resize_uninitialized(100));
+	EXPECT_EQ(100, v.size());
+	EXPECT_GE(v.capacity(), 100);
+	EXPECT_EQ(1, v[0]);
+	EXPECT_EQ(2, v[1]);
+
+	EXPECT_EQ(1, v.resize_uninitialized(1));
+	EXPECT_EQ(1, v.size());
+	EXPECT_EQ(1, v[0]);
+}
+
+TEST(VectorUninitialized, FillThroughData)
+{
+	const char text[] = "straight into the vector";
+	nids::vector<char> v;
+	v.resize_uninitialized(sizeof(text));
+	memcpy(v.data(), text, sizeof(text));
+	EXPECT_STREQ(text, v.data());
+}
+
+TEST(VectorUninitialized, DefaultInitConstructs)
+{
+	nids::vector<std::string> v;
+	v.push_back("keep");
+	EXPECT_EQ(10, v.resize_default_init(10));
+	EXPECT_EQ("keep", v[0]);
+	for (size_t index{ 1 }; index < 10; ++index)
+		EXPECT_TRUE(v[index].empty());
+
+	// shrinking destroys the tail
+	v[9] = std::string(100, 'x');
+	EXPECT_EQ(2, v.resize_default_init(2));
+	EXPECT_EQ("keep", v[0]);
+}
+
+//**************************************
+// Stats policy tests
+//**************************************
+namespace
+{
+	NIDS_STATS_TAG(stats_growth_tag);
+	NIDS_STATS_TAG(stats_alias_tag);
+	NIDS_STATS_TAG(stats_copy_tag);
+
+	template<typename Tag>
+	using counted_vector = nids::vector<int, nids::geometric_growth<2, 1>, nids::malloc_allocator, nids::counting_stats<Tag>>;
+}
+
+TEST(VectorStats, NoStatsTakesNoSpace)
+{
+	EXPECT_EQ(sizeof(nids::vector<int>), sizeof(counted_vector<stats_growth_tag>));
+#ifndef NIDS_VECTOR_STATS
+	static_assert(std::is_same_v<nids::optional_stats<stats_growth_tag>, nids::no_stats>);
+#endif
+}
+
+TEST(VectorStats, CountsGrowth)
+{
+	nids::vector_stats_counters& stats = nids::counting_stats<stats_growth_tag>::counters();
+	stats.reset();
+	{
+		counted_vector<stats_growth_tag> v;
+		for (int index{ 0 }; index < 100; ++index)
+			v.push_back(index);
+
+		// 1, 2, 4, ..., 128
+		EXPECT_EQ(1, stats.allocations.load());
+		EXPECT_EQ(7, stats.reallocations.load());
+		EXPECT_EQ(128 * sizeof(int), stats.peak_capacity_bytes.load());
+		EXPECT_LE(stats.copied_bytes.load(), (1 + 2 + 4 + 8 + 16 + 32 + 64) * sizeof(int));
+		EXPECT_EQ(0, stats.destroyed.load());
+	}
+	EXPECT_EQ(1, stats.destroyed.load());
+	EXPECT_EQ(28 * sizeof(int), stats.wasted_bytes.load());
+}
+
+TEST(VectorStats, CountsAliasingHits)
+{
+	nids::vector_stats_counters& stats = nids::counting_stats<stats_alias_tag>::counters();
+	stats.reset();
+	counted_vector<stats_alias_tag> v;
+	v.push_back(5);
+	v.push_back_i(v[0]);
+	v.push_back_i(v[0]);
+	v.push_back_i(v[0]);
+	EXPECT_EQ(4, v.size());
+	for (size_t index{ 0 }; index < v.size(); ++index)
+		EXPECT_EQ(5, v[index]);
+	// only the pushes that had to grow count
+	EXPECT_EQ(2, stats.aliasing_hits.load());
+}
+
+TEST(VectorStats, RollsUpPerTagAndDumps)
+{
+	nids::reset_vector_stats();
+	{
+		counted_vector<stats_copy_tag> a;
+		a.push_back(1);
+		counted_vector<stats_copy_tag> b(a);
+		counted_vector<stats_growth_tag> c;
+		c.reserve(10);
+	}
+
+	bool sawCopy{ false };
+	nids::for_each_vector_stats([&](const nids::vector_stats_counters& stats)
+	{
+		if (strcmp(stats.name, "stats_copy_tag") != 0)
+			return;
+		sawCopy = true;
+		EXPECT_EQ(2, stats.allocations.load());
+		EXPECT_EQ(2, stats.destroyed.load());
+	});
+	EXPECT_TRUE(sawCopy);
+	EXPECT_EQ(1, nids::counting_stats<stats_growth_tag>::counters().allocations.load());
+
+	char buffer[4096] = {};
+	FILE* out = tmpfile();
+	ASSERT_NE(nullptr, out);
+	nids::dump_vector_stats(out);
+	rewind(out);
+	size_t read = fread(buffer, 1, sizeof(buffer) - 1, out);
+	fclose(out);
+	EXPECT_GT(read, 0u);
+	const char* line = strstr(buffer, "stats_copy_tag ");
+	ASSERT_NE(nullptr, line);
+	EXPECT_EQ(strstr(line, "allocations=2"), strstr(line, "allocations="));
+}